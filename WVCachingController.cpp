@@ -0,0 +1,202 @@
+//
+//  WVCachingController.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVCachingController.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include <algorithm>
+#include <math.h>
+
+namespace {
+
+const int kDefaultCachingMs = 300;
+const int kDefaultMinMs = 50;
+const int kDefaultMaxMs = 3000;
+
+// 自适应模式的期望值：抖动的倍数加固定余量（解码与显示的排队时间）
+const double kJitterMultiplier = 4.0;
+const double kMarginMs = 50.0;
+
+// 有卡顿时的乘性增加与稳定时每次的加性减少
+const double kIncreaseFactor = 1.5;
+const int kDecreaseStepMs = 100;
+
+// 丢帧比例超过该值视为缓存不足
+const double kMaxLossRatio = 0.01;
+const unsigned long long kMinDecodedForLoss = 100;
+
+// 卡顿时的缓存时长作为下限保留的稳定会话数（之后网络可能已经好转，允许再次试探）
+const int kStallMemorySessions = 8;
+
+// 没有卡顿的会话至少播放这么久，才用来减小缓存（太短的会话说明不了网络稳定）
+const long long kMinStableSessionMs = 10000;
+
+// 输入时间与实际时间之差超过该值视为跳转或时间轴不连续，不计入抖动
+const double kMaxJitterSampleMs = 2000.0;
+
+// Playing 之后没有缓冲事件的源，输入时间推进这么久后视为初始缓冲完成
+const long long kPrimeFallbackMs = 1000;
+
+// 记住的源上限，超出时整体清空
+const size_t kMaxKnownSources = 256;
+
+} // namespace
+
+WVCachingController::WVCachingController()
+    : mode(WVCachingFixed), minMs(kDefaultMinMs), maxMs(kDefaultMaxMs), targetMs(kDefaultCachingMs),
+      active(false), cachingMs(kDefaultCachingMs) {
+    ResetSessionLocked();
+}
+
+void WVCachingController::Configure(WVCachingMode newMode, int newMinMs, int newMaxMs, int newTargetMs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    mode = newMode;
+    minMs = newMinMs > 0 ? newMinMs : kDefaultMinMs;
+    maxMs = newMaxMs >= minMs ? newMaxMs : (kDefaultMaxMs >= minMs ? kDefaultMaxMs : minMs);
+    targetMs = ClampLocked(newTargetMs > 0 ? newTargetMs : kDefaultCachingMs);
+
+    // 模式变化后旧的结果不再适用
+    sources.clear();
+}
+
+int WVCachingController::ClampLocked(int value) const {
+    if (value < minMs) return minMs;
+    if (value > maxMs) return maxMs;
+    return value;
+}
+
+int WVCachingController::CachingForLocked(const std::string& key) const {
+    if (mode == WVCachingFixed) return targetMs;
+    std::map<std::string, SourceState>::const_iterator it = sources.find(key);
+    return it != sources.end() ? it->second.cachingMs : targetMs;
+}
+
+int WVCachingController::CachingFor(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return CachingForLocked(key);
+}
+
+void WVCachingController::ResetSessionLocked() {
+    playingAtMs = 0;
+    primedAtMs = 0;
+    stalled = false;
+    stalls = 0;
+    jitterMs = 0.0;
+    hasTimeSample = false;
+    lastMediaMs = 0;
+    lastWallMs = 0;
+}
+
+void WVCachingController::BeginSession(const std::string& key, bool playing) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ResetSessionLocked();
+    active = true;
+    source = key;
+    cachingMs = CachingForLocked(key);
+    if (playing) {
+        playingAtMs = primedAtMs = WVClockNowMs();
+    }
+}
+
+void WVCachingController::EndSession(unsigned long long decoded, unsigned long long lost) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!active) return;
+    active = false;
+    if (mode == WVCachingFixed || primedAtMs == 0) return;   // 没有开始播放（连接失败）的会话不说明网络状况
+
+    double lossRatio = decoded >= kMinDecodedForLoss ? static_cast<double>(lost) / decoded : 0.0;
+    bool starved = stalls > 0 || lossRatio > kMaxLossRatio;
+    if (!starved && WVClockNowMs() - primedAtMs < kMinStableSessionMs) return;
+
+    if (sources.size() >= kMaxKnownSources && sources.find(source) == sources.end()) {
+        sources.clear();
+    }
+    std::map<std::string, SourceState>::iterator it = sources.find(source);
+    if (it == sources.end()) {
+        SourceState initial = { cachingMs, 0, 0 };
+        it = sources.insert(std::make_pair(source, initial)).first;
+    }
+    SourceState& state = it->second;
+
+    int next = cachingMs;
+    if (starved) {
+        next = static_cast<int>(cachingMs * kIncreaseFactor);
+        if (mode == WVCachingAdaptive) {
+            int desired = static_cast<int>(kJitterMultiplier * jitterMs + kMarginMs);
+            if (desired > next) next = desired;
+        }
+        state.stalledAtMs = cachingMs;
+        state.stableSessions = 0;
+    } else if (mode == WVCachingAdaptive) {
+        int desired = static_cast<int>(kJitterMultiplier * jitterMs + kMarginMs);
+        next = desired >= cachingMs ? desired : std::max(desired, cachingMs - kDecreaseStepMs);
+        if (state.stalledAtMs > 0 && ++state.stableSessions > kStallMemorySessions) {
+            state.stalledAtMs = 0;
+        }
+        if (state.stalledAtMs > 0 && next < state.stalledAtMs + kDecreaseStepMs) {
+            next = std::min(cachingMs, state.stalledAtMs + kDecreaseStepMs);
+        }
+    } else {
+        next = cachingMs > targetMs ? std::max(targetMs, cachingMs - kDecreaseStepMs) : targetMs;
+    }
+    next = ClampLocked(next);
+    state.cachingMs = next;
+
+    WV_LOG_INFO("网络缓存：%s 本次 %d ms，抖动 %.1f ms，卡顿 %d 次，丢帧 %.2f%%，下次 %d ms",
+                source.c_str(), cachingMs, jitterMs, stalls, lossRatio * 100.0, next);
+}
+
+void WVCachingController::OnPlaying() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!active) return;
+    hasTimeSample = false;   // 暂停期间输入时间停止，恢复后重新取样
+    if (playingAtMs == 0) playingAtMs = WVClockNowMs();
+}
+
+void WVCachingController::OnBuffering(float percent) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!active) return;
+
+    if (percent >= 100.0f) {
+        if (primedAtMs == 0) primedAtMs = WVClockNowMs();
+        stalled = false;
+        hasTimeSample = false;   // 缓冲期间输入时间停止，不计入抖动
+        return;
+    }
+    if (primedAtMs != 0 && !stalled) {
+        stalled = true;
+        ++stalls;
+        WV_LOG_DEBUG("网络缓存：%s 播放中再次缓冲（第 %d 次）", source.c_str(), stalls);
+    }
+}
+
+void WVCachingController::OnTimeChanged(int64_t mediaTimeMs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!active || playingAtMs == 0 || stalled) return;
+
+    long long now = WVClockNowMs();
+    if (primedAtMs == 0 && now - playingAtMs >= kPrimeFallbackMs) {
+        primedAtMs = now;
+    }
+    if (hasTimeSample) {
+        // D = 实际时间增量 - 输入时间增量；数据均匀到达时为 0
+        double delta = static_cast<double>(now - lastWallMs) - static_cast<double>(mediaTimeMs - lastMediaMs);
+        if (fabs(delta) < kMaxJitterSampleMs) {
+            jitterMs += (fabs(delta) - jitterMs) / 16.0;
+        }
+    }
+    hasTimeSample = true;
+    lastMediaMs = mediaTimeMs;
+    lastWallMs = now;
+}
+
+void WVCachingController::GetStats(int* caching, double* jitter, int* stallCount) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (caching) *caching = cachingMs;
+    if (jitter) *jitter = jitterMs;
+    if (stallCount) *stallCount = stalls;
+}
@@ -0,0 +1,113 @@
+//
+//  WVCachingController.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_CACHING_CONTROLLER_H
+#define WV_CACHING_CONTROLLER_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <stdint.h>
+
+// ==================== 网络缓存时长控制 ====================
+//
+// 网络流的 :network-caching / :live-caching 只能在打开媒体时设置。固定的 300 ms 对局域网摄像头
+// 偏大（多出的延迟），对 VPN 后的摄像头偏小（频繁丢帧、卡顿）。
+// 本类统计每次连接（会话）的网络状况，为同一源的下一次连接或重连选择缓存时长：
+//   - 到达抖动：输入时间（TimeChanged，直播流中随数据到达推进）的增量与实际时间增量之差，
+//     按 RFC 3550 的方式平滑（J += (|D| - J) / 16）；
+//   - 卡顿：开始播放后再次进入缓冲（Buffering < 100%）的次数；
+//   - 迟到丢帧：会话内丢弃帧数占解码帧数的比例（数据到得太晚，来不及显示）。
+// 会话结束时按模式更新：
+//   - 自适应：有卡顿或丢帧超过 1% 时乘以 1.5（乘性增加）；否则向 4 倍抖动 + 50 ms 靠近，
+//     每次最多减少 100 ms（加性减少），但保持在最近一次卡顿时的缓存时长之上至少 100 ms
+//     （抖动估计偏低时否则会每隔几次会话就回到卡顿的值），连续 8 次稳定的会话后才忘记这个下限；
+//   - 目标延迟：平时使用目标值，有卡顿时乘以 1.5，之后每次稳定的会话减少 100 ms 回到目标值；
+//   - 固定：始终使用目标值（默认 300 ms，与之前的行为相同）。
+// 结果限制在 [最小, 最大] 之内，按源地址记住。
+// 所有方法线程安全（事件在 VLC 事件线程上调用，会话在命令队列工作线程上开始/结束）。
+
+enum WVCachingMode {
+    WVCachingFixed = 0,
+    WVCachingAdaptive = 1,
+    WVCachingTarget = 2
+};
+
+class WVCachingController {
+public:
+    WVCachingController();
+
+    /**
+     * 设置模式与范围，下一次连接时生效
+     */
+    void Configure(WVCachingMode mode, int minMs, int maxMs, int targetMs);
+
+    /**
+     * 查询源的缓存时长（不开始会话，如预先打开的播放器）
+     */
+    int CachingFor(const std::string& source) const;
+
+    /**
+     * 开始一次网络连接的统计（结束尚未结束的上一次会话，但不用它更新结果）
+     * @param playing 连接已经在播放（如预先打开后切换进来）
+     */
+    void BeginSession(const std::string& source, bool playing);
+
+    /**
+     * 结束会话并更新该源下次使用的缓存时长；没有会话时忽略
+     * @param decoded / lost 会话内累计的解码帧数与丢弃帧数
+     */
+    void EndSession(unsigned long long decoded, unsigned long long lost);
+
+    // 当前播放器的事件（VLC 事件线程）；OnPlaying 在开始与暂停后恢复时调用
+    void OnPlaying();
+    void OnBuffering(float percent);
+    void OnTimeChanged(int64_t mediaTimeMs);
+
+    /**
+     * @param cachingMs 当前会话（没有时为最近一次）使用的缓存时长
+     * @param jitterMs 当前会话的抖动估计
+     * @param stalls 当前会话的卡顿次数
+     */
+    void GetStats(int* cachingMs, double* jitterMs, int* stalls) const;
+
+private:
+    WVCachingController(const WVCachingController&);
+    WVCachingController& operator=(const WVCachingController&);
+
+    int CachingForLocked(const std::string& source) const;
+    int ClampLocked(int cachingMs) const;
+    void ResetSessionLocked();
+
+    mutable std::mutex mutex;
+    WVCachingMode mode;
+    int minMs;
+    int maxMs;
+    int targetMs;
+    // 各源的结果
+    struct SourceState {
+        int cachingMs;             // 下次使用的缓存时长
+        int stalledAtMs;           // 最近一次卡顿时的缓存时长，0 表示没有
+        int stableSessions;        // 之后连续稳定的会话数
+    };
+    std::map<std::string, SourceState> sources;
+
+    // 当前会话
+    bool active;
+    std::string source;
+    int cachingMs;
+    long long playingAtMs;         // Playing 事件的时间，0 表示尚未开始
+    long long primedAtMs;          // 初始缓冲完成的时间，0 表示尚未完成（之后的缓冲才算卡顿）
+    bool stalled;
+    int stalls;
+    double jitterMs;
+    bool hasTimeSample;
+    int64_t lastMediaMs;
+    long long lastWallMs;
+};
+
+#endif // WV_CACHING_CONTROLLER_H
@@ -0,0 +1,33 @@
+//
+//  WVClock.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVClock.h"
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+long long SteadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::atomic<WVClockSource> g_source(SteadyNowMs);
+
+} // namespace
+
+long long WVClockNowMs() {
+    return g_source.load(std::memory_order_acquire)();
+}
+
+void WVClockSetSource(WVClockSource source) {
+    g_source.store(source ? source : SteadyNowMs, std::memory_order_release);
+}
+
+bool WVClockIsSimulated() {
+    return g_source.load(std::memory_order_acquire) != SteadyNowMs;
+}
@@ -0,0 +1,36 @@
+//
+//  WVClock.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_CLOCK_H
+#define WV_CLOCK_H
+
+// ==================== 单调时钟 ====================
+//
+// 网络缓存控制（会话时长、到达抖动）、重连监督（连接超时、无帧检测、退避）、连接调度
+// （排队时间、名额超时）与画质调节（调整后的等待、恢复前的平稳周期）的计时读这个时钟。
+// 默认为 steady_clock；测试与基准可以换成模拟时钟，让策略按模拟的时间线运行而不必真的等待。
+// 使用模拟时钟时监督器、调度器与画质调节器的后台线程不再自行检查，由调用方推进时间后调用各自的 Poll，
+// 结果可以重现。
+
+typedef long long (*WVClockSource)();
+
+/**
+ * 当前时间（毫秒，单调递增，起点不确定）
+ */
+long long WVClockNowMs();
+
+/**
+ * 替换时钟（测试与基准用）；传入 NULL 恢复系统时钟
+ */
+void WVClockSetSource(WVClockSource source);
+
+/**
+ * 是否正在使用替换的时钟
+ */
+bool WVClockIsSimulated();
+
+#endif // WV_CLOCK_H
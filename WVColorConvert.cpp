@@ -0,0 +1,191 @@
+//
+//  WVColorConvert.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVColorConvert.h"
+#include "WVColorConvertKernels.h"
+#include <atomic>
+#include <math.h>
+
+#ifdef WV_COLOR_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+struct KernelTable {
+    WVColorKernel kernel;
+    WVI420RowFunc i420Row;
+    WVNV12RowFunc nv12Row;
+};
+
+const KernelTable kKernelTables[] = {
+    { WVColorKernelScalar, WVI420RowScalar, WVNV12RowScalar },
+#ifdef WV_COLOR_X86
+    { WVColorKernelSSE2, WVI420RowSSE2, WVNV12RowSSE2 },
+    { WVColorKernelAVX2, WVI420RowAVX2, WVNV12RowAVX2 },
+#endif
+};
+
+// -1 表示尚未检测
+std::atomic<int> g_activeKernel(-1);
+
+inline uint8_t Clamp255(int value) {
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+inline void StorePixel(uint8_t* dst, int yTerm, int u, int v, const WVColorParams& p) {
+    const int round = 1 << (WV_COLOR_SHIFT - 1);
+    uint8_t r = Clamp255((yTerm + p.crR * v + round) >> WV_COLOR_SHIFT);
+    uint8_t g = Clamp255((yTerm + p.cbG * u + p.crG * v + round) >> WV_COLOR_SHIFT);
+    uint8_t b = Clamp255((yTerm + p.cbB * u + round) >> WV_COLOR_SHIFT);
+    if (p.order == WVPixelOrderBGRA) {
+        dst[0] = b; dst[1] = g; dst[2] = r;
+    } else {
+        dst[0] = r; dst[1] = g; dst[2] = b;
+    }
+    dst[3] = 255;
+}
+
+#ifdef WV_COLOR_X86
+void CpuId(int leaf, int subleaf, int regs[4]) {
+#ifdef _MSC_VER
+    __cpuidex(regs, leaf, subleaf);
+#else
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    regs[0] = static_cast<int>(a); regs[1] = static_cast<int>(b);
+    regs[2] = static_cast<int>(c); regs[3] = static_cast<int>(d);
+#endif
+}
+
+unsigned long long XGetBV() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+} // namespace
+
+WVColorKernel WVColorCpuKernel() {
+#ifdef WV_COLOR_X86
+    int regs[4] = {0, 0, 0, 0};
+    CpuId(0, 0, regs);
+    int maxLeaf = regs[0];
+
+    CpuId(1, 0, regs);
+    bool sse2 = (regs[3] & (1 << 26)) != 0;
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+
+    // AVX2 还需要操作系统保存 YMM 寄存器状态
+    if (maxLeaf >= 7 && osxsave && avx && (XGetBV() & 0x6) == 0x6) {
+        CpuId(7, 0, regs);
+        if (regs[1] & (1 << 5)) {
+            return WVColorKernelAVX2;
+        }
+    }
+    if (sse2) {
+        return WVColorKernelSSE2;
+    }
+#endif
+    return WVColorKernelScalar;
+}
+
+namespace {
+
+const KernelTable& ActiveTable() {
+    int kernel = g_activeKernel.load(std::memory_order_acquire);
+    if (kernel < 0) {
+        kernel = WVColorCpuKernel();
+        g_activeKernel.store(kernel, std::memory_order_release);
+    }
+    return kKernelTables[kernel];
+}
+
+} // namespace
+
+void WVI420RowScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                     uint8_t* dst, int width, const WVColorParams& params) {
+    for (int x = 0; x < width; ++x) {
+        int yTerm = (y[x] - params.yOffset) * params.yMul;
+        StorePixel(dst + x * 4, yTerm, u[x >> 1] - 128, v[x >> 1] - 128, params);
+    }
+}
+
+void WVNV12RowScalar(const uint8_t* y, const uint8_t* uv,
+                     uint8_t* dst, int width, const WVColorParams& params) {
+    for (int x = 0; x < width; ++x) {
+        int yTerm = (y[x] - params.yOffset) * params.yMul;
+        const uint8_t* chroma = uv + (x >> 1) * 2;
+        StorePixel(dst + x * 4, yTerm, chroma[0] - 128, chroma[1] - 128, params);
+    }
+}
+
+void WVColorParamsInit(WVColorParams* params, WVColorMatrix matrix, WVColorRange range, WVPixelOrder order) {
+    double kr = matrix == WVColorMatrixBT709 ? 0.2126 : 0.299;
+    double kb = matrix == WVColorMatrixBT709 ? 0.0722 : 0.114;
+    double kg = 1.0 - kr - kb;
+
+    double yScale = range == WVColorRangeFull ? 1.0 : 255.0 / 219.0;
+    double cScale = range == WVColorRangeFull ? 1.0 : 255.0 / 224.0;
+    const double one = static_cast<double>(1 << WV_COLOR_SHIFT);
+
+    params->yOffset = static_cast<int16_t>(range == WVColorRangeFull ? 0 : 16);
+    params->yMul = static_cast<int16_t>(floor(yScale * one + 0.5));
+    params->crR = static_cast<int16_t>(floor(2.0 * (1.0 - kr) * cScale * one + 0.5));
+    params->cbB = static_cast<int16_t>(floor(2.0 * (1.0 - kb) * cScale * one + 0.5));
+    params->cbG = static_cast<int16_t>(-floor(2.0 * kb * (1.0 - kb) / kg * cScale * one + 0.5));
+    params->crG = static_cast<int16_t>(-floor(2.0 * kr * (1.0 - kr) / kg * cScale * one + 0.5));
+    params->order = order;
+}
+
+void WVConvertI420(const uint8_t* srcY, int strideY, const uint8_t* srcU, int strideU,
+                   const uint8_t* srcV, int strideV, uint8_t* dst, int dstStride,
+                   int width, int height, const WVColorParams& params) {
+    WVI420RowFunc row = ActiveTable().i420Row;
+    for (int line = 0; line < height; ++line) {
+        row(srcY + line * strideY, srcU + (line >> 1) * strideU, srcV + (line >> 1) * strideV,
+            dst + line * dstStride, width, params);
+    }
+}
+
+void WVConvertNV12(const uint8_t* srcY, int strideY, const uint8_t* srcUV, int strideUV,
+                   uint8_t* dst, int dstStride, int width, int height, const WVColorParams& params) {
+    WVNV12RowFunc row = ActiveTable().nv12Row;
+    for (int line = 0; line < height; ++line) {
+        row(srcY + line * strideY, srcUV + (line >> 1) * strideUV, dst + line * dstStride, width, params);
+    }
+}
+
+WVColorKernel WVColorConvertKernel() {
+    return ActiveTable().kernel;
+}
+
+WVColorKernel WVColorConvertSetKernel(WVColorKernel kernel) {
+    WVColorKernel supported = WVColorCpuKernel();
+    if (kernel > supported) kernel = supported;
+    if (kernel < WVColorKernelScalar) kernel = WVColorKernelScalar;
+    g_activeKernel.store(kernel, std::memory_order_release);
+    return kernel;
+}
+
+const char* WVColorKernelName(WVColorKernel kernel) {
+    switch (kernel) {
+        case WVColorKernelSSE2: return "SSE2";
+        case WVColorKernelAVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
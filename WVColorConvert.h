@@ -0,0 +1,88 @@
+//
+//  WVColorConvert.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_COLOR_CONVERT_H
+#define WV_COLOR_CONVERT_H
+
+#include <stdint.h>
+
+// ==================== YUV → RGB 颜色转换 ====================
+//
+// 帧回调模式下让 VLC 输出平面 I420/NV12，由桥接库自己转换为 BGRA/RGBA，
+// 避免 VLC 内部 swscale 转 RV32 的开销。
+// 实现分为标量参考版本与 SSE2/AVX2 版本，首次调用时按 CPU 能力选择；
+// 三者使用同一套 Q13 定点算法，输出逐字节一致。
+// 色度按最近邻上采样（每 2x2 像素共享一组 UV）。
+
+enum WVColorMatrix {
+    WVColorMatrixBT601 = 0,
+    WVColorMatrixBT709 = 1
+};
+
+enum WVColorRange {
+    WVColorRangeLimited = 0,    // Y: 16-235, UV: 16-240
+    WVColorRangeFull = 1        // Y/UV: 0-255
+};
+
+enum WVPixelOrder {
+    WVPixelOrderBGRA = 0,       // 内存字节序 B,G,R,A（即 VLC 的 RV32）
+    WVPixelOrderRGBA = 1        // 内存字节序 R,G,B,A（WebGL/ImageData）
+};
+
+enum WVColorKernel {
+    WVColorKernelScalar = 0,
+    WVColorKernelSSE2 = 1,
+    WVColorKernelAVX2 = 2
+};
+
+// 定点系数（Q13），由 WVColorParamsInit 计算
+struct WVColorParams {
+    int16_t yOffset;
+    int16_t yMul;
+    int16_t crR;
+    int16_t cbG;
+    int16_t crG;
+    int16_t cbB;
+    WVPixelOrder order;
+};
+
+/**
+ * 按矩阵和范围计算转换系数
+ */
+void WVColorParamsInit(WVColorParams* params, WVColorMatrix matrix, WVColorRange range, WVPixelOrder order);
+
+/**
+ * I420（Y、U、V 三个平面）转 32 位 RGB
+ */
+void WVConvertI420(const uint8_t* srcY, int strideY, const uint8_t* srcU, int strideU,
+                   const uint8_t* srcV, int strideV, uint8_t* dst, int dstStride,
+                   int width, int height, const WVColorParams& params);
+
+/**
+ * NV12（Y 平面 + UV 交错平面）转 32 位 RGB
+ */
+void WVConvertNV12(const uint8_t* srcY, int strideY, const uint8_t* srcUV, int strideUV,
+                   uint8_t* dst, int dstStride, int width, int height, const WVColorParams& params);
+
+/**
+ * CPU 支持的最高实现（不受 WVColorConvertSetKernel 影响，覆盖层混合也按它选择实现）
+ */
+WVColorKernel WVColorCpuKernel();
+
+/**
+ * 当前使用的实现
+ */
+WVColorKernel WVColorConvertKernel();
+
+/**
+ * 强制使用指定实现（超出 CPU 能力时降级为可用的最高实现），返回实际生效的实现
+ */
+WVColorKernel WVColorConvertSetKernel(WVColorKernel kernel);
+
+const char* WVColorKernelName(WVColorKernel kernel);
+
+#endif // WV_COLOR_CONVERT_H
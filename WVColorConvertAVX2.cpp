@@ -0,0 +1,133 @@
+//
+//  WVColorConvertAVX2.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVColorConvertKernels.h"
+
+#ifdef WV_COLOR_X86
+
+#include <immintrin.h>
+
+// 只有本文件中的函数使用 AVX2 指令，由 WVColorConvert.cpp 在运行时确认 CPU 支持后才调用
+#if defined(__GNUC__) || defined(__clang__)
+#define WV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WV_TARGET_AVX2
+#endif
+
+namespace {
+
+// 系数布局与 SSE2 版本相同，见 WVColorConvertSSE2.cpp
+struct Coefficients {
+    __m256i yOffset;
+    __m256i chromaOffset;
+    __m256i yCr;
+    __m256i yCbG;
+    __m256i crG;
+    __m256i yCb;
+    __m256i round;
+    bool rgba;
+};
+
+WV_TARGET_AVX2 inline __m256i Pair(int16_t low, int16_t high) {
+    return _mm256_set1_epi32(static_cast<int>((static_cast<uint32_t>(static_cast<uint16_t>(high)) << 16) |
+                                              static_cast<uint16_t>(low)));
+}
+
+WV_TARGET_AVX2 void InitCoefficients(Coefficients* c, const WVColorParams& p) {
+    c->yOffset = _mm256_set1_epi16(p.yOffset);
+    c->chromaOffset = _mm256_set1_epi16(128);
+    c->yCr = Pair(p.yMul, p.crR);
+    c->yCbG = Pair(p.yMul, p.cbG);
+    c->crG = Pair(p.crG, 0);
+    c->yCb = Pair(p.yMul, p.cbB);
+    c->round = _mm256_set1_epi32(1 << (WV_COLOR_SHIFT - 1));
+    c->rgba = p.order == WVPixelOrderRGBA;
+}
+
+WV_TARGET_AVX2 inline __m256i Finish(__m256i lo, __m256i hi, const Coefficients& c) {
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, c.round), WV_COLOR_SHIFT);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, c.round), WV_COLOR_SHIFT);
+    // unpack 与 pack 都在 128 位通道内进行，二者互逆，元素顺序得以恢复
+    __m256i packed = _mm256_packs_epi32(lo, hi);
+    return _mm256_min_epi16(_mm256_max_epi16(packed, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+}
+
+WV_TARGET_AVX2 inline void Store16(uint8_t* dst, __m256i y, __m256i u, __m256i v, const Coefficients& c) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i yvLo = _mm256_unpacklo_epi16(y, v), yvHi = _mm256_unpackhi_epi16(y, v);
+    __m256i yuLo = _mm256_unpacklo_epi16(y, u), yuHi = _mm256_unpackhi_epi16(y, u);
+    __m256i vLo = _mm256_unpacklo_epi16(v, zero), vHi = _mm256_unpackhi_epi16(v, zero);
+
+    __m256i r = Finish(_mm256_madd_epi16(yvLo, c.yCr), _mm256_madd_epi16(yvHi, c.yCr), c);
+    __m256i g = Finish(_mm256_add_epi32(_mm256_madd_epi16(yuLo, c.yCbG), _mm256_madd_epi16(vLo, c.crG)),
+                       _mm256_add_epi32(_mm256_madd_epi16(yuHi, c.yCbG), _mm256_madd_epi16(vHi, c.crG)), c);
+    __m256i b = Finish(_mm256_madd_epi16(yuLo, c.yCb), _mm256_madd_epi16(yuHi, c.yCb), c);
+    if (c.rgba) {
+        __m256i t = r; r = b; b = t;
+    }
+
+    __m256i bg = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+    __m256i ra = _mm256_or_si256(r, _mm256_set1_epi16(static_cast<short>(0xFF00)));
+    // lo 含像素 0-3、8-11，hi 含像素 4-7、12-15，跨通道重排后按顺序写出
+    __m256i lo = _mm256_unpacklo_epi16(bg, ra);
+    __m256i hi = _mm256_unpackhi_epi16(bg, ra);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+WV_TARGET_AVX2 inline __m256i LoadLuma16(const uint8_t* y, const Coefficients& c) {
+    __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y));
+    return _mm256_sub_epi16(_mm256_cvtepu8_epi16(raw), c.yOffset);
+}
+
+// 8 个 32 位色度值扩展为 16 个 16 位值（每个重复一次）
+WV_TARGET_AVX2 inline __m256i ExpandChroma8(__m256i chroma32, const Coefficients& c) {
+    return _mm256_sub_epi16(_mm256_or_si256(chroma32, _mm256_slli_epi32(chroma32, 16)), c.chromaOffset);
+}
+
+} // namespace
+
+WV_TARGET_AVX2 void WVI420RowAVX2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                                  uint8_t* dst, int width, const WVColorParams& params) {
+    Coefficients c;
+    InitCoefficients(&c, params);
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m256i uu = ExpandChroma8(_mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2))), c);
+        __m256i vv = ExpandChroma8(_mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2))), c);
+        Store16(dst + x * 4, LoadLuma16(y + x, c), uu, vv, c);
+    }
+    if (x < width) {
+        WVI420RowScalar(y + x, u + x / 2, v + x / 2, dst + x * 4, width - x, params);
+    }
+    _mm256_zeroupper();
+}
+
+WV_TARGET_AVX2 void WVNV12RowAVX2(const uint8_t* y, const uint8_t* uv,
+                                  uint8_t* dst, int width, const WVColorParams& params) {
+    Coefficients c;
+    InitCoefficients(&c, params);
+    __m256i lowByte = _mm256_set1_epi32(0xFF);
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        // 16 字节 = 8 组 UV，扩展后每个 32 位元素为 u | v<<8
+        __m256i raw = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x)));
+        __m256i uu = ExpandChroma8(_mm256_and_si256(raw, lowByte), c);
+        __m256i vv = ExpandChroma8(_mm256_srli_epi32(raw, 8), c);
+        Store16(dst + x * 4, LoadLuma16(y + x, c), uu, vv, c);
+    }
+    if (x < width) {
+        WVNV12RowScalar(y + x, uv + x, dst + x * 4, width - x, params);
+    }
+    _mm256_zeroupper();
+}
+
+#endif // WV_COLOR_X86
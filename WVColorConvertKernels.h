@@ -0,0 +1,44 @@
+//
+//  WVColorConvertKernels.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_COLOR_CONVERT_KERNELS_H
+#define WV_COLOR_CONVERT_KERNELS_H
+
+#include "WVColorConvert.h"
+
+// 颜色转换的行级实现，仅供 WVColorConvert*.cpp 内部使用。
+// 每个函数转换一行；SIMD 版本处理对齐部分后用标量版本处理行尾。
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define WV_COLOR_X86 1
+#endif
+
+// 定点精度：系数放大 2^13，结果加 2^12 后右移 13 位（四舍五入）
+#define WV_COLOR_SHIFT 13
+
+typedef void (*WVI420RowFunc)(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                              uint8_t* dst, int width, const WVColorParams& params);
+typedef void (*WVNV12RowFunc)(const uint8_t* y, const uint8_t* uv,
+                              uint8_t* dst, int width, const WVColorParams& params);
+
+void WVI420RowScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                     uint8_t* dst, int width, const WVColorParams& params);
+void WVNV12RowScalar(const uint8_t* y, const uint8_t* uv,
+                     uint8_t* dst, int width, const WVColorParams& params);
+
+#ifdef WV_COLOR_X86
+void WVI420RowSSE2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                   uint8_t* dst, int width, const WVColorParams& params);
+void WVNV12RowSSE2(const uint8_t* y, const uint8_t* uv,
+                   uint8_t* dst, int width, const WVColorParams& params);
+void WVI420RowAVX2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                   uint8_t* dst, int width, const WVColorParams& params);
+void WVNV12RowAVX2(const uint8_t* y, const uint8_t* uv,
+                   uint8_t* dst, int width, const WVColorParams& params);
+#endif
+
+#endif // WV_COLOR_CONVERT_KERNELS_H
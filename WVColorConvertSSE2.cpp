@@ -0,0 +1,131 @@
+//
+//  WVColorConvertSSE2.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVColorConvertKernels.h"
+
+#ifdef WV_COLOR_X86
+
+#include <emmintrin.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WV_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define WV_TARGET_SSE2
+#endif
+
+namespace {
+
+// 每个 32 位元素的低 16 位乘 Y，高 16 位乘 U/V，配合 _mm_madd_epi16 一次得到两项之和
+struct Coefficients {
+    __m128i yOffset;
+    __m128i chromaOffset;
+    __m128i yCr;        // R = y*yMul + v*crR
+    __m128i yCbG;       // G = y*yMul + u*cbG + v*crG
+    __m128i crG;
+    __m128i yCb;        // B = y*yMul + u*cbB
+    __m128i round;
+    bool rgba;
+};
+
+WV_TARGET_SSE2 inline __m128i Pair(int16_t low, int16_t high) {
+    return _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(static_cast<uint16_t>(high)) << 16) |
+                                           static_cast<uint16_t>(low)));
+}
+
+WV_TARGET_SSE2 void InitCoefficients(Coefficients* c, const WVColorParams& p) {
+    c->yOffset = _mm_set1_epi16(p.yOffset);
+    c->chromaOffset = _mm_set1_epi16(128);
+    c->yCr = Pair(p.yMul, p.crR);
+    c->yCbG = Pair(p.yMul, p.cbG);
+    c->crG = Pair(p.crG, 0);
+    c->yCb = Pair(p.yMul, p.cbB);
+    c->round = _mm_set1_epi32(1 << (WV_COLOR_SHIFT - 1));
+    c->rgba = p.order == WVPixelOrderRGBA;
+}
+
+WV_TARGET_SSE2 inline __m128i Finish(__m128i lo, __m128i hi, const Coefficients& c) {
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, c.round), WV_COLOR_SHIFT);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, c.round), WV_COLOR_SHIFT);
+    __m128i packed = _mm_packs_epi32(lo, hi);
+    return _mm_min_epi16(_mm_max_epi16(packed, _mm_setzero_si128()), _mm_set1_epi16(255));
+}
+
+// y/u/v 为 8 个 16 位有符号值（已减去偏移，色度已按像素展开）
+WV_TARGET_SSE2 inline void Store8(uint8_t* dst, __m128i y, __m128i u, __m128i v, const Coefficients& c) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i yvLo = _mm_unpacklo_epi16(y, v), yvHi = _mm_unpackhi_epi16(y, v);
+    __m128i yuLo = _mm_unpacklo_epi16(y, u), yuHi = _mm_unpackhi_epi16(y, u);
+    __m128i vLo = _mm_unpacklo_epi16(v, zero), vHi = _mm_unpackhi_epi16(v, zero);
+
+    __m128i r = Finish(_mm_madd_epi16(yvLo, c.yCr), _mm_madd_epi16(yvHi, c.yCr), c);
+    __m128i g = Finish(_mm_add_epi32(_mm_madd_epi16(yuLo, c.yCbG), _mm_madd_epi16(vLo, c.crG)),
+                       _mm_add_epi32(_mm_madd_epi16(yuHi, c.yCbG), _mm_madd_epi16(vHi, c.crG)), c);
+    __m128i b = Finish(_mm_madd_epi16(yuLo, c.yCb), _mm_madd_epi16(yuHi, c.yCb), c);
+    if (c.rgba) {
+        __m128i t = r; r = b; b = t;
+    }
+
+    // 16 位元素 (b | g<<8) 与 (r | a<<8) 交错得到 32 位像素
+    __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+    __m128i ra = _mm_or_si128(r, _mm_set1_epi16(static_cast<short>(0xFF00)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(bg, ra));
+}
+
+WV_TARGET_SSE2 inline __m128i LoadLuma8(const uint8_t* y, const Coefficients& c) {
+    __m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(y));
+    return _mm_sub_epi16(_mm_unpacklo_epi8(raw, _mm_setzero_si128()), c.yOffset);
+}
+
+// 4 个色度值扩展为 8 个（每个重复一次）
+WV_TARGET_SSE2 inline __m128i ExpandChroma4(__m128i chroma16, const Coefficients& c) {
+    return _mm_sub_epi16(_mm_unpacklo_epi16(chroma16, chroma16), c.chromaOffset);
+}
+
+} // namespace
+
+WV_TARGET_SSE2 void WVI420RowSSE2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                                  uint8_t* dst, int width, const WVColorParams& params) {
+    Coefficients c;
+    InitCoefficients(&c, params);
+    __m128i zero = _mm_setzero_si128();
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        int u4 = 0, v4 = 0;
+        memcpy(&u4, u + x / 2, 4);
+        memcpy(&v4, v + x / 2, 4);
+        __m128i uu = ExpandChroma4(_mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), zero), c);
+        __m128i vv = ExpandChroma4(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v4), zero), c);
+        Store8(dst + x * 4, LoadLuma8(y + x, c), uu, vv, c);
+    }
+    if (x < width) {
+        WVI420RowScalar(y + x, u + x / 2, v + x / 2, dst + x * 4, width - x, params);
+    }
+}
+
+WV_TARGET_SSE2 void WVNV12RowSSE2(const uint8_t* y, const uint8_t* uv,
+                                  uint8_t* dst, int width, const WVColorParams& params) {
+    Coefficients c;
+    InitCoefficients(&c, params);
+    __m128i lowByte = _mm_set1_epi16(0x00FF);
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        // 8 字节 = 4 组 UV，每个 16 位元素为 u | v<<8
+        __m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(uv + x));
+        __m128i uu = ExpandChroma4(_mm_and_si128(raw, lowByte), c);
+        __m128i vv = ExpandChroma4(_mm_srli_epi16(raw, 8), c);
+        Store8(dst + x * 4, LoadLuma8(y + x, c), uu, vv, c);
+    }
+    if (x < width) {
+        WVNV12RowScalar(y + x, uv + x, dst + x * 4, width - x, params);
+    }
+}
+
+#endif // WV_COLOR_X86
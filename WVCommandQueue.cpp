@@ -0,0 +1,143 @@
+//
+//  WVCommandQueue.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVCommandQueue.h"
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace {
+
+// 已结束的命令最多保留的状态记录数
+const size_t kMaxFinishedRecords = 1024;
+
+struct StatusRegistry {
+    std::mutex mutex;
+    std::map<unsigned long long, int> statuses;
+    std::deque<unsigned long long> finished;   // 按结束顺序，用于淘汰旧记录
+};
+
+StatusRegistry& Registry() {
+    static StatusRegistry* registry = new StatusRegistry();
+    return *registry;
+}
+
+std::atomic<unsigned long long>& NextCommandId() {
+    static std::atomic<unsigned long long> nextId(1);
+    return nextId;
+}
+
+void SetStatus(unsigned long long id, int status) {
+    StatusRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.statuses[id] = status;
+
+    if (status == WVCommandQueue::StatusDone || status == WVCommandQueue::StatusCoalesced) {
+        registry.finished.push_back(id);
+        while (registry.finished.size() > kMaxFinishedRecords) {
+            registry.statuses.erase(registry.finished.front());
+            registry.finished.pop_front();
+        }
+    }
+}
+
+bool IsStateCommand(WVCommandQueue::Kind kind) {
+    return kind == WVCommandQueue::KindPlay || kind == WVCommandQueue::KindStop ||
+           kind == WVCommandQueue::KindPause || kind == WVCommandQueue::KindResume;
+}
+
+// 新命令入队时，判断尚未执行的旧命令是否可以被丢弃
+bool Supersedes(WVCommandQueue::Kind incoming, WVCommandQueue::Kind queued) {
+    switch (incoming) {
+        case WVCommandQueue::KindPlay:
+        case WVCommandQueue::KindStop:
+            return IsStateCommand(queued);
+        case WVCommandQueue::KindPause:
+        case WVCommandQueue::KindResume:
+            return queued == WVCommandQueue::KindPause || queued == WVCommandQueue::KindResume;
+        case WVCommandQueue::KindRelease:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+WVCommandQueue::WVCommandQueue() : closing(false) {
+    // 工作线程与队列同生命周期，由线程在关闭后负责销毁队列
+    std::thread(&WVCommandQueue::Run, this).detach();
+}
+
+WVCommandQueue::~WVCommandQueue() {
+}
+
+unsigned long long WVCommandQueue::EnqueueLocked(Kind kind, const std::function<void()>& fn) {
+    std::deque<Command> kept;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (Supersedes(kind, pending[i].kind)) {
+            SetStatus(pending[i].id, StatusCoalesced);
+        } else {
+            kept.push_back(pending[i]);
+        }
+    }
+    pending.swap(kept);
+
+    Command command;
+    command.id = NextCommandId()++;
+    command.kind = kind;
+    command.fn = fn;
+    SetStatus(command.id, StatusPending);
+    pending.push_back(command);
+    cond.notify_one();
+    return command.id;
+}
+
+unsigned long long WVCommandQueue::Post(Kind kind, const std::function<void()>& fn) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closing) return 0;
+    return EnqueueLocked(kind, fn);
+}
+
+unsigned long long WVCommandQueue::Shutdown(const std::function<void()>& fn) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closing) return 0;
+    unsigned long long id = EnqueueLocked(KindRelease, fn);
+    closing = true;
+    return id;
+}
+
+int WVCommandQueue::GetStatus(unsigned long long commandId) {
+    StatusRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::map<unsigned long long, int>::const_iterator it = registry.statuses.find(commandId);
+    return it == registry.statuses.end() ? StatusUnknown : it->second;
+}
+
+void WVCommandQueue::Run() {
+    for (;;) {
+        Command command;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return !pending.empty(); });
+            command = pending.front();
+            pending.pop_front();
+        }
+
+        SetStatus(command.id, StatusRunning);
+        if (command.fn) {
+            command.fn();
+        }
+        SetStatus(command.id, StatusDone);
+
+        if (command.kind == KindRelease) {
+            break;
+        }
+    }
+
+    delete this;
+}
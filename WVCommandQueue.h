@@ -0,0 +1,85 @@
+//
+//  WVCommandQueue.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_COMMAND_QUEUE_H
+#define WV_COMMAND_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+// ==================== 播放器命令队列 ====================
+//
+// 每个播放器一个串行工作线程。wv_* 控制调用只负责入队并立即返回，
+// libvlc_media_player_stop 等可能阻塞数百毫秒的操作在工作线程上执行，
+// 不会卡住 Electron 主进程。
+//
+// 入队时合并冗余命令：新的播放/停止会取代尚未执行的播放/停止/暂停/恢复
+// （play→stop→play 只执行最后一次 play），释放会取代所有未执行命令。
+// 每条命令返回全局唯一的 ID，可通过 Status 查询执行状态。
+
+class WVCommandQueue {
+public:
+    enum Kind {
+        KindPlay,
+        KindPause,
+        KindResume,
+        KindStop,
+        KindRelease,
+        KindTask       // 内部任务（如播放后的画面配置），不参与合并
+    };
+
+    enum Status {
+        StatusUnknown = -1,    // ID 无效或记录已过期
+        StatusPending = 0,     // 排队中
+        StatusRunning = 1,     // 执行中
+        StatusDone = 2,        // 已完成
+        StatusCoalesced = 3    // 被后续命令合并，未执行
+    };
+
+    WVCommandQueue();
+
+    /**
+     * 入队一条命令
+     * @return 命令 ID，队列已关闭时返回 0
+     */
+    unsigned long long Post(Kind kind, const std::function<void()>& fn);
+
+    /**
+     * 入队最后一条命令（KindRelease）并关闭队列。该命令执行完后工作线程退出
+     * 并自行销毁队列对象，调用方此后不能再访问该队列
+     * @return 命令 ID
+     */
+    unsigned long long Shutdown(const std::function<void()>& fn);
+
+    /**
+     * 查询命令状态（全局，播放器释放后仍可查询最近的命令）
+     */
+    static int GetStatus(unsigned long long commandId);
+
+private:
+    struct Command {
+        unsigned long long id;
+        Kind kind;
+        std::function<void()> fn;
+    };
+
+    ~WVCommandQueue();
+    WVCommandQueue(const WVCommandQueue&);
+    WVCommandQueue& operator=(const WVCommandQueue&);
+
+    unsigned long long EnqueueLocked(Kind kind, const std::function<void()>& fn);
+    void Run();
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Command> pending;
+    bool closing;
+};
+
+#endif // WV_COMMAND_QUEUE_H
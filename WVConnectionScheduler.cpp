@@ -0,0 +1,223 @@
+//
+//  WVConnectionScheduler.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVConnectionScheduler.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 检查名额超时的周期
+const int kCheckIntervalMs = 250;
+
+struct Entry {
+    void* player;
+    int priority;
+    unsigned long long ticket;       // 递增，相同优先级时小的先连接
+    WVConnectionScheduler::Opener opener;
+    bool granted;
+    long long requestedAtMs;
+    long long grantedAtMs;
+};
+
+struct SchedulerState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<Entry> entries;      // 每个播放器最多一项（排队中或已占用名额）
+    int maxConcurrent;
+    long long timeoutMs;
+    int inFlight;
+    unsigned long long nextTicket;
+    bool workerStarted;
+    unsigned long long grantedCount;
+    long long totalWaitMs;
+
+    SchedulerState()
+        : maxConcurrent(4), timeoutMs(10000), inFlight(0), nextTicket(1), workerStarted(false),
+          grantedCount(0), totalWaitMs(0) {
+    }
+};
+
+SchedulerState& State() {
+    static SchedulerState* state = new SchedulerState();  // 进程退出时不析构，避免与后台线程竞争
+    return *state;
+}
+
+int FindLocked(SchedulerState& state, void* player) {
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        if (state.entries[i].player == player) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool HasFreeSlotLocked(SchedulerState& state) {
+    return state.maxConcurrent <= 0 || state.inFlight < state.maxConcurrent;
+}
+
+void GrantLocked(SchedulerState& state, Entry& entry, long long now) {
+    entry.granted = true;
+    entry.grantedAtMs = now;
+    ++state.inFlight;
+    ++state.grantedCount;
+    state.totalWaitMs += now - entry.requestedAtMs;
+}
+
+void RemoveLocked(SchedulerState& state, int index) {
+    if (state.entries[index].granted) --state.inFlight;
+    state.entries.erase(state.entries.begin() + index);
+}
+
+// 把空出的名额依次交给排在最前面的申请
+void DispatchLocked(SchedulerState& state) {
+    long long now = WVClockNowMs();
+    while (HasFreeSlotLocked(state)) {
+        Entry* next = NULL;
+        for (size_t i = 0; i < state.entries.size(); ++i) {
+            Entry& entry = state.entries[i];
+            if (entry.granted) continue;
+            if (!next || entry.priority > next->priority ||
+                (entry.priority == next->priority && entry.ticket < next->ticket)) {
+                next = &entry;
+            }
+        }
+        if (!next) return;
+
+        GrantLocked(state, *next, now);
+        WV_LOG_DEBUG("连接调度：播放器 %p 排队 %lld ms 后开始连接（进行中 %d 路）",
+                     next->player, now - next->requestedAtMs, state.inFlight);
+        next->opener(next->ticket);
+    }
+}
+
+void ExpireLocked(SchedulerState& state) {
+    long long now = WVClockNowMs();
+    bool expired = false;
+    for (size_t i = 0; i < state.entries.size();) {
+        Entry& entry = state.entries[i];
+        if (entry.granted && now - entry.grantedAtMs >= state.timeoutMs) {
+            WV_LOG_WARN("连接调度：播放器 %p 连接 %lld ms 仍未出现画面，让出名额", entry.player, now - entry.grantedAtMs);
+            RemoveLocked(state, static_cast<int>(i));
+            expired = true;
+        } else {
+            ++i;
+        }
+    }
+    if (expired) DispatchLocked(state);
+}
+
+void RunScheduler() {
+    SchedulerState& state = State();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    for (;;) {
+        state.cond.wait_for(lock, std::chrono::milliseconds(kCheckIntervalMs));
+        // 模拟时钟下由调用方推进时间后调用 Poll
+        if (WVClockIsSimulated()) continue;
+        ExpireLocked(state);
+    }
+}
+
+} // namespace
+
+bool WVConnectionScheduler::Request(void* player, int priority, const Opener& opener, unsigned long long* ticket) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.workerStarted) {
+        state.workerStarted = true;
+        std::thread(RunScheduler).detach();
+    }
+
+    // 同一播放器的新申请取代旧申请；旧申请占用的名额留给这次连接
+    int index = FindLocked(state, player);
+    if (index >= 0) RemoveLocked(state, index);
+
+    Entry entry;
+    entry.player = player;
+    entry.priority = priority;
+    entry.ticket = state.nextTicket++;
+    entry.opener = opener;
+    entry.granted = false;
+    entry.requestedAtMs = WVClockNowMs();
+    entry.grantedAtMs = 0;
+    if (ticket) *ticket = entry.ticket;
+
+    // 有空闲名额时队列一定为空（名额空出时立即分配），可以直接取得
+    bool granted = HasFreeSlotLocked(state);
+    if (granted) {
+        GrantLocked(state, entry, entry.requestedAtMs);
+    }
+    state.entries.push_back(entry);
+    if (!granted) {
+        WV_LOG_DEBUG("连接调度：播放器 %p 排队等待（进行中 %d 路，排队 %d 路）",
+                     player, state.inFlight, static_cast<int>(state.entries.size()) - state.inFlight);
+    }
+    return granted;
+}
+
+bool WVConnectionScheduler::IsGranted(void* player, unsigned long long ticket) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    int index = FindLocked(state, player);
+    return index >= 0 && state.entries[index].ticket == ticket && state.entries[index].granted;
+}
+
+void WVConnectionScheduler::Release(void* player) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    int index = FindLocked(state, player);
+    if (index < 0 || !state.entries[index].granted) return;
+    RemoveLocked(state, index);
+    DispatchLocked(state);
+}
+
+void WVConnectionScheduler::Cancel(void* player) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    int index = FindLocked(state, player);
+    if (index < 0) return;
+    RemoveLocked(state, index);
+    DispatchLocked(state);
+}
+
+void WVConnectionScheduler::SetPriority(void* player, int priority) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    int index = FindLocked(state, player);
+    if (index >= 0) {
+        state.entries[index].priority = priority;
+    }
+}
+
+void WVConnectionScheduler::Configure(int maxConcurrent, int timeoutMs) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.maxConcurrent = maxConcurrent > 0 ? maxConcurrent : 0;
+    state.timeoutMs = timeoutMs > 0 ? timeoutMs : 10000;
+
+    // 上限提高时排队的申请立即开始
+    DispatchLocked(state);
+}
+
+void WVConnectionScheduler::Poll() {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ExpireLocked(state);
+}
+
+void WVConnectionScheduler::GetStats(int* queued, int* inFlight, double* averageWaitMs) {
+    SchedulerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (queued) *queued = static_cast<int>(state.entries.size()) - state.inFlight;
+    if (inFlight) *inFlight = state.inFlight;
+    if (averageWaitMs) {
+        *averageWaitMs = state.grantedCount > 0 ? static_cast<double>(state.totalWaitMs) / state.grantedCount : 0.0;
+    }
+}
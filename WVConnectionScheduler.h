@@ -0,0 +1,75 @@
+//
+//  WVConnectionScheduler.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_CONNECTION_SCHEDULER_H
+#define WV_CONNECTION_SCHEDULER_H
+
+#include <functional>
+
+// ==================== 网络流连接调度 ====================
+//
+// 打开监控墙时每个播放器的工作线程同时开始连接，25 路 RTSP 的 DESCRIBE/SETUP 握手一起压到 NVR 上，
+// 常常全部超时重来，所有画面反而出现得更晚。
+// 调度器限制同时进行的连接数：播放器打开网络流前申请名额，名额用完时按优先级排队
+// （优先级高的先连接，相同时先到先得）；连接出现首帧、出错、停止或超时后让出名额，
+// 再由调度器通知排在最前面的播放器开始连接。
+// 所有方法线程安全；回调在调用 Release / Cancel 等方法的线程或调度器线程上、持有内部锁时调用，
+// 不能阻塞，也不能回调本类。
+
+class WVConnectionScheduler {
+public:
+    typedef std::function<void(unsigned long long ticket)> Opener;
+
+    /**
+     * 申请一个连接名额；同一播放器之前的申请（排队中或已占用的名额）被取代
+     * @param priority 越大越先连接
+     * @param opener 排队后取得名额时调用（应异步执行），执行前用 IsGranted 确认这次申请仍然有效
+     * @param ticket 本次申请的编号
+     * @return 是否立即取得名额（为 true 时不会调用 opener）
+     */
+    static bool Request(void* player, int priority, const Opener& opener, unsigned long long* ticket);
+
+    /**
+     * 申请 ticket 是否仍是该播放器的当前申请且已取得名额
+     */
+    static bool IsGranted(void* player, unsigned long long ticket);
+
+    /**
+     * 连接已出现首帧或失败，让出名额（没有占用名额时忽略）
+     */
+    static void Release(void* player);
+
+    /**
+     * 取消排队中的申请并让出名额（停止、释放、改为播放本地文件时调用）
+     */
+    static void Cancel(void* player);
+
+    /**
+     * 调整排队中申请的优先级（如播放器变为可见）
+     */
+    static void SetPriority(void* player, int priority);
+
+    /**
+     * @param maxConcurrent 同时进行的连接数上限，<= 0 表示不限
+     * @param timeoutMs 名额最长占用时间（连接既没有出现首帧也没有失败），<= 0 时取 10000
+     */
+    static void Configure(int maxConcurrent, int timeoutMs);
+
+    /**
+     * 立即检查名额超时（平时由后台线程每 250 ms 执行；使用模拟时钟时由调用方推进时间后调用，见 WVClock.h）
+     */
+    static void Poll();
+
+    /**
+     * @param queued 排队中的申请数
+     * @param inFlight 正在进行的连接数
+     * @param averageWaitMs 已取得名额的申请的平均排队时间
+     */
+    static void GetStats(int* queued, int* inFlight, double* averageWaitMs);
+};
+
+#endif // WV_CONNECTION_SCHEDULER_H
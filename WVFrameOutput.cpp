@@ -0,0 +1,196 @@
+//
+//  WVFrameOutput.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVFrameOutput.h"
+#include "WVLog.h"
+#include "WVOverlayRaster.h"
+#include <chrono>
+#include <string.h>
+
+namespace {
+
+const uint32_t kChromaRV32 = 0x32335652u;   // 'R','V','3','2'
+
+unsigned AlignUp(unsigned value, unsigned alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+long long MonotonicMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+WVFrameOutput::WVFrameOutput(const std::string& sharedMemoryName, unsigned requestedWidth, unsigned requestedHeight)
+    : sharedMemoryName(sharedMemoryName), requestedWidth(requestedWidth), requestedHeight(requestedHeight),
+      semiPlanar(false), sourceFullRange(false), frameWidth(0), frameHeight(0), framePitch(0), ring(NULL),
+      overlay(NULL), overlayTimeline(NULL), mediaClock(NULL), overlayVersion(0), colorMatrix(-1), colorRange(-1), framesPublished(0) {
+    memset(planeOffsets, 0, sizeof(planeOffsets));
+    memset(planePitches, 0, sizeof(planePitches));
+}
+
+WVFrameOutput::~WVFrameOutput() {
+    delete ring;
+}
+
+void WVFrameOutput::Attach(libvlc_media_player_t* mediaPlayer) {
+    libvlc_video_set_format_callbacks(mediaPlayer, OnFormat, OnCleanup);
+    libvlc_video_set_callbacks(mediaPlayer, OnLock, OnUnlock, OnDisplay, this);
+}
+
+void WVFrameOutput::SetOverlay(WVOverlayScene* scene, WVOverlayTimeline* timeline, WVMediaClock* clock) {
+    std::lock_guard<std::mutex> lock(mutex);
+    overlay = scene;
+    overlayTimeline = timeline;
+    mediaClock = clock;
+    overlayShapes.clear();
+    overlayVersion = 0;
+}
+
+void WVFrameOutput::SetColorspace(int matrix, int range) {
+    colorMatrix = matrix;
+    colorRange = range;
+}
+
+unsigned WVFrameOutput::OnFormat(void** opaque, char* chroma, unsigned* width, unsigned* height,
+                                 unsigned* pitches, unsigned* lines) {
+    WVFrameOutput* self = static_cast<WVFrameOutput*>(*opaque);
+
+    // 解码器输出 NV12 时保持 NV12，其余一律请求 I420（J420 为全范围的 I420，原样保留），
+    // 需要时由 VLC 缩放到请求的尺寸
+    bool semiPlanar = memcmp(chroma, "NV12", 4) == 0;
+    bool fullRange = memcmp(chroma, "J420", 4) == 0;
+    if (!semiPlanar && !fullRange) {
+        memcpy(chroma, "I420", 4);
+    }
+    if (self->requestedWidth > 0 && self->requestedHeight > 0) {
+        *width = self->requestedWidth;
+        *height = self->requestedHeight;
+    }
+
+    unsigned chromaWidth = (*width + 1) / 2;
+    unsigned alignedLines = AlignUp(*height, 16);
+    pitches[0] = AlignUp(*width, 32);
+    lines[0] = alignedLines;
+    if (semiPlanar) {
+        pitches[1] = AlignUp(chromaWidth * 2, 32);
+        lines[1] = alignedLines / 2;
+    } else {
+        pitches[1] = pitches[2] = AlignUp(chromaWidth, 32);
+        lines[1] = lines[2] = alignedLines / 2;
+    }
+
+    unsigned pitch = AlignUp(*width * 4, 32);
+    unsigned planeCount = semiPlanar ? 2 : 3;
+
+    std::lock_guard<std::mutex> lock(self->mutex);
+    unsigned offset = 0;
+    for (unsigned i = 0; i < 3; ++i) {
+        self->planeOffsets[i] = offset;
+        self->planePitches[i] = i < planeCount ? pitches[i] : 0;
+        if (i < planeCount) offset += pitches[i] * lines[i];
+    }
+    self->decodeBuffer.assign(offset, 0);
+    self->semiPlanar = semiPlanar;
+    self->sourceFullRange = fullRange;
+
+    // 首次创建帧环；尺寸变化时切换到按新尺寸创建的下一代区域（读取方在 acquire 时跟随），
+    // 不在同一名称上重建
+    if (!self->ring) {
+        self->ring = WVFrameRing::Create(self->sharedMemoryName, *width, *height, pitch,
+                                         *height, kChromaRV32);
+        if (!self->ring) {
+            WV_LOG_ERROR("错误：无法创建共享内存帧环（名称可能仍被之前的读取方占用）: %s",
+                         self->sharedMemoryName.c_str());
+        }
+    } else if (self->frameWidth != *width || self->frameHeight != *height) {
+        if (!self->ring->Resize(*width, *height, pitch, *height, kChromaRV32)) {
+            WV_LOG_ERROR("错误：无法按新尺寸 %ux%u 切换共享内存帧环: %s", *width, *height,
+                         self->sharedMemoryName.c_str());
+            return 0;
+        }
+        WV_LOG_INFO("共享内存帧环已切换到第 %u 代: %ux%u", self->ring->Generation(), *width, *height);
+    }
+    self->frameWidth = *width;
+    self->frameHeight = *height;
+    self->framePitch = pitch;
+
+    WV_LOG_INFO("帧回调输出格式: %.4s %ux%u -> BGRA pitch=%u, 转换实现=%s, 共享内存=%s",
+                chroma, *width, *height, pitch, WVColorKernelName(WVColorConvertKernel()),
+                self->sharedMemoryName.c_str());
+    return self->ring ? 1 : 0;
+}
+
+void WVFrameOutput::OnCleanup(void* opaque) {
+    WVFrameOutput* self = static_cast<WVFrameOutput*>(opaque);
+    std::lock_guard<std::mutex> lock(self->mutex);
+    std::vector<uint8_t>().swap(self->decodeBuffer);
+}
+
+void* WVFrameOutput::OnLock(void* opaque, void** planes) {
+    WVFrameOutput* self = static_cast<WVFrameOutput*>(opaque);
+    std::lock_guard<std::mutex> lock(self->mutex);
+    for (unsigned i = 0; i < 3; ++i) {
+        planes[i] = self->decodeBuffer.empty() || self->planePitches[i] == 0
+            ? NULL : &self->decodeBuffer[self->planeOffsets[i]];
+    }
+    return NULL;
+}
+
+void WVFrameOutput::OnUnlock(void*, void*, void* const*) {
+}
+
+void WVFrameOutput::OnDisplay(void* opaque, void*) {
+    WVFrameOutput* self = static_cast<WVFrameOutput*>(opaque);
+    std::lock_guard<std::mutex> lock(self->mutex);
+    if (!self->ring || self->decodeBuffer.empty()) return;
+
+    int matrix = self->colorMatrix;
+    int range = self->colorRange;
+    if (matrix < 0) {
+        matrix = self->frameHeight >= 720 ? WVColorMatrixBT709 : WVColorMatrixBT601;
+    }
+    if (range < 0) {
+        range = self->sourceFullRange ? WVColorRangeFull : WVColorRangeLimited;
+    }
+    WVColorParams params;
+    WVColorParamsInit(&params, static_cast<WVColorMatrix>(matrix), static_cast<WVColorRange>(range),
+                      WVPixelOrderBGRA);
+
+    // 直接转换到共享内存的 back 槽位，消费者持有的 front 槽位不会被触碰
+    const uint8_t* base = &self->decodeBuffer[0];
+    int width = static_cast<int>(self->frameWidth);
+    int height = static_cast<int>(self->frameHeight);
+    if (self->semiPlanar) {
+        WVConvertNV12(base + self->planeOffsets[0], self->planePitches[0],
+                      base + self->planeOffsets[1], self->planePitches[1],
+                      self->ring->BackBuffer(), self->framePitch, width, height, params);
+    } else {
+        WVConvertI420(base + self->planeOffsets[0], self->planePitches[0],
+                      base + self->planeOffsets[1], self->planePitches[1],
+                      base + self->planeOffsets[2], self->planePitches[2],
+                      self->ring->BackBuffer(), self->framePitch, width, height, params);
+    }
+
+    // 覆盖层直接合成进画面，读取方拿到的帧已包含检测框
+    if (self->overlay) {
+        if (self->overlayTimeline) {
+            self->overlayTimeline->Present(self->mediaClock->NowMs(), self->overlay);
+        }
+        // 每帧都是新画面，整体合成，不需要脏区域
+        self->overlay->Snapshot(self->overlayVersion, &self->overlayShapes, &self->overlayVersion, NULL, NULL);
+        if (!self->overlayShapes.empty()) {
+            WVOverlaySurface surface = { self->ring->BackBuffer(), width, height,
+                                         static_cast<int>(self->framePitch) };
+            WVOverlayRenderShapes(surface, self->overlayShapes, 1.0f, 1.0f, 0, 0, width, height);
+        }
+    }
+
+    self->ring->Publish(MonotonicMicros());
+    self->framesPublished++;
+}
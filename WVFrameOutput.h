@@ -0,0 +1,97 @@
+//
+//  WVFrameOutput.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_FRAME_OUTPUT_H
+#define WV_FRAME_OUTPUT_H
+
+#include "WVLibVLC.h"
+#include "WVFrameRing.h"
+#include "WVColorConvert.h"
+#include "WVOverlayScene.h"
+#include "WVOverlayTimeline.h"
+#include "WVMediaClock.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ==================== 帧回调输出 ====================
+//
+// 不依赖窗口的渲染模式：通过 libvlc_video_set_format_callbacks /
+// libvlc_video_set_callbacks 让 VLC 输出平面 I420/NV12（解码器原生格式，VLC 无需转换），
+// 显示时由 WVColorConvert 的 SIMD 实现直接转换为 BGRA 写入共享内存帧环（WVFrameRing）
+// 的 back 槽位并原子发布。
+// 不使用任何 Windows API，可在 Linux 上无界面运行。
+
+class WVFrameOutput {
+public:
+    /**
+     * @param sharedMemoryName 共享内存名称
+     * @param requestedWidth 输出宽度（0 表示使用视频原始宽度）
+     * @param requestedHeight 输出高度（0 表示使用视频原始高度）
+     */
+    WVFrameOutput(const std::string& sharedMemoryName, unsigned requestedWidth, unsigned requestedHeight);
+    ~WVFrameOutput();
+
+    /**
+     * 在媒体播放器上注册格式与帧回调（需在播放之前调用）
+     */
+    void Attach(libvlc_media_player_t* mediaPlayer);
+
+    /**
+     * 设置 YUV 转换使用的矩阵与范围，-1 表示自动（按分辨率选择矩阵，按 VLC 色度格式判断范围）
+     * 可在任意线程调用，下一帧生效
+     */
+    void SetColorspace(int matrix, int range);
+
+    /**
+     * 设置要合成进画面的覆盖层场景（坐标为输出帧像素），NULL 表示不合成
+     * @param timeline 可为 NULL；不为空时每帧先按媒体时钟把到期的条目写入场景
+     */
+    void SetOverlay(WVOverlayScene* scene, WVOverlayTimeline* timeline, WVMediaClock* clock);
+
+    unsigned long long FramesPublished() const { return framesPublished; }
+
+private:
+    WVFrameOutput(const WVFrameOutput&);
+    WVFrameOutput& operator=(const WVFrameOutput&);
+
+    static unsigned OnFormat(void** opaque, char* chroma, unsigned* width, unsigned* height,
+                             unsigned* pitches, unsigned* lines);
+    static void OnCleanup(void* opaque);
+    static void* OnLock(void* opaque, void** planes);
+    static void OnUnlock(void* opaque, void* picture, void* const* planes);
+    static void OnDisplay(void* opaque, void* picture);
+
+    std::string sharedMemoryName;
+    unsigned requestedWidth;
+    unsigned requestedHeight;
+
+    std::mutex mutex;                // 保护格式变化时的缓冲区/帧环重建
+    std::vector<uint8_t> decodeBuffer;   // VLC 写入的平面 YUV
+    bool semiPlanar;                 // true: NV12（Y + UV），false: I420（Y + U + V）
+    bool sourceFullRange;            // VLC 色度为 J420 等全范围格式
+    unsigned planeOffsets[3];
+    unsigned planePitches[3];
+    unsigned frameWidth;
+    unsigned frameHeight;
+    unsigned framePitch;
+    WVFrameRing* ring;
+
+    WVOverlayScene* overlay;
+    WVOverlayTimeline* overlayTimeline;
+    WVMediaClock* mediaClock;
+    std::vector<WVOverlayShape> overlayShapes;   // 覆盖层快照（仅显示回调线程访问）
+    uint64_t overlayVersion;
+
+    std::atomic<int> colorMatrix;    // WVColorMatrix，-1 自动
+    std::atomic<int> colorRange;     // WVColorRange，-1 自动
+
+    std::atomic<unsigned long long> framesPublished;
+};
+
+#endif // WV_FRAME_OUTPUT_H
@@ -0,0 +1,359 @@
+//
+//  WVFrameRing.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVFrameRing.h"
+#include "WVTripleBuffer.h"
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 消费者打开时生产者恰好又切换了一代（上一代已释放）的重试次数
+const int kOpenRetries = 3;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 第 generation 代帧数据区域的名称
+std::string GenerationName(const std::string& name, uint32_t generation) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%u", generation);
+    return name + suffix;
+}
+
+#ifndef _WIN32
+// POSIX 共享内存名必须以 '/' 开头
+std::string PosixName(const std::string& name) {
+    return name.empty() || name[0] == '/' ? name : "/" + name;
+}
+#endif
+
+// 生产者释放区域的名称；已映射的消费者不受影响（Windows 上随最后一个句柄关闭自动释放）
+void UnlinkName(const std::string& mappingName) {
+#ifndef _WIN32
+    shm_unlink(PosixName(mappingName).c_str());
+#else
+    (void)mappingName;
+#endif
+}
+
+} // namespace
+
+WVFrameRing::WVFrameRing()
+    : directory(NULL), base(NULL), size(0), header(NULL), owner(false),
+      backSlot(WVTripleBuffer::InitialBackIndex()), nextFrame(1) {
+}
+
+WVFrameRing::~WVFrameRing() {
+    ReleaseData();
+    Unmap(&directoryMapping);
+    if (owner && directory) UnlinkName(name);
+}
+
+bool WVFrameRing::Map(const std::string& mappingName, size_t mappingSize, bool create, Mapping* mapping) {
+#ifdef _WIN32
+    HANDLE handle = NULL;
+    if (create) {
+        unsigned long long size64 = mappingSize;
+        handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                    static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu),
+                                    mappingName.c_str());
+        // 同名对象仍被其他进程持有时返回的是旧对象（大小可能不同，读取方可能正在读取），不能复用
+        if (handle && GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(handle);
+            return false;
+        }
+    } else {
+        handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str());
+    }
+    if (!handle) return false;
+
+    void* view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, mappingSize);
+    if (!view) {
+        CloseHandle(handle);
+        return false;
+    }
+    mapping->handle = handle;
+    mapping->base = static_cast<uint8_t*>(view);
+    mapping->size = mappingSize;
+    return true;
+#else
+    std::string posixName = PosixName(mappingName);
+    int fd = -1;
+    if (create) {
+        // 同名对象是异常退出的进程留下的：解除名称后新建，仍映射着它的读取方不受影响
+        fd = shm_open(posixName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 && errno == EEXIST) {
+            shm_unlink(posixName.c_str());
+            fd = shm_open(posixName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+    } else {
+        fd = shm_open(posixName.c_str(), O_RDWR, 0);
+    }
+    if (fd < 0) return false;
+
+    if (create) {
+        if (ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+            close(fd);
+            shm_unlink(posixName.c_str());
+            return false;
+        }
+    } else if (mappingSize == 0) {
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        mappingSize = static_cast<size_t>(st.st_size);
+    }
+
+    void* view = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        if (create) shm_unlink(posixName.c_str());
+        return false;
+    }
+
+    mapping->base = static_cast<uint8_t*>(view);
+    mapping->size = mappingSize;
+    return true;
+#endif
+}
+
+void WVFrameRing::Unmap(Mapping* mapping) {
+#ifdef _WIN32
+    if (mapping->base) UnmapViewOfFile(mapping->base);
+    if (mapping->handle) CloseHandle(mapping->handle);
+#else
+    if (mapping->base) munmap(mapping->base, mapping->size);
+#endif
+    *mapping = Mapping();
+}
+
+bool WVFrameRing::CreateGeneration(uint32_t generation, uint32_t width, uint32_t height, uint32_t pitch,
+                                   uint32_t lines, uint32_t chroma, Mapping* mapping) {
+    if (pitch == 0 || height == 0) {
+        return false;
+    }
+    if (lines < height) lines = height;
+
+    size_t headerSize = AlignUp(sizeof(WVFrameRingHeader), 64);
+    size_t slotSize = AlignUp(static_cast<size_t>(pitch) * lines, 64);
+    size_t totalSize = headerSize + slotSize * WV_FRAME_RING_SLOTS;
+    if (!Map(GenerationName(name, generation), totalSize, true, mapping)) {
+        return false;
+    }
+
+    // 在共享内存上构造头部（原子成员需要构造）
+    memset(mapping->base, 0, headerSize);
+    WVFrameRingHeader* created = new (mapping->base) WVFrameRingHeader();
+    created->version = WV_FRAME_RING_VERSION;
+    created->headerSize = static_cast<uint32_t>(headerSize);
+    created->slotCount = WV_FRAME_RING_SLOTS;
+    created->width = width;
+    created->height = height;
+    created->pitch = pitch;
+    created->chroma = chroma;
+    created->generation = generation;
+    created->slotSize = slotSize;
+    WVTripleBuffer::Initialize(created->exchangeState);
+    created->consumerSlot.store(WVTripleBuffer::InitialFrontIndex());
+    created->framesPublished.store(0);
+    created->framesOverwritten.store(0);
+    created->framesConsumed.store(0);
+    for (uint32_t i = 0; i < WV_FRAME_RING_SLOTS; ++i) {
+        created->slots[i].frameNumber = 0;
+        created->slots[i].timestampUs = 0;
+        created->slots[i].dataOffset = headerSize + slotSize * i;
+    }
+
+    // magic 最后写入，消费者以此判断头部已初始化完成
+    std::atomic_thread_fence(std::memory_order_release);
+    created->magic = WV_FRAME_RING_MAGIC;
+    return true;
+}
+
+bool WVFrameRing::OpenGeneration(uint32_t generation, Mapping* mapping) {
+    std::string mappingName = GenerationName(name, generation);
+#ifdef _WIN32
+    // 先映射头部读取总大小，再映射整个区域
+    if (!Map(mappingName, sizeof(WVFrameRingHeader), false, mapping)) {
+        return false;
+    }
+    WVFrameRingHeader* probe = reinterpret_cast<WVFrameRingHeader*>(mapping->base);
+    size_t totalSize = probe->magic == WV_FRAME_RING_MAGIC
+        ? probe->headerSize + probe->slotSize * probe->slotCount : 0;
+    Unmap(mapping);
+    if (totalSize == 0 || !Map(mappingName, totalSize, false, mapping)) {
+        return false;
+    }
+#else
+    if (!Map(mappingName, 0, false, mapping)) {
+        return false;
+    }
+#endif
+
+    WVFrameRingHeader* opened = reinterpret_cast<WVFrameRingHeader*>(mapping->base);
+    if (mapping->size < sizeof(WVFrameRingHeader) || opened->magic != WV_FRAME_RING_MAGIC ||
+        opened->version != WV_FRAME_RING_VERSION || opened->generation != generation) {
+        Unmap(mapping);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
+
+void WVFrameRing::ReleaseData() {
+    uint32_t generation = header ? header->generation : 0;
+    Unmap(&data);
+    if (owner && generation > 0) UnlinkName(GenerationName(name, generation));
+    base = NULL;
+    size = 0;
+    header = NULL;
+}
+
+WVFrameRing* WVFrameRing::Create(const std::string& name, uint32_t width, uint32_t height,
+                                 uint32_t pitch, uint32_t lines, uint32_t chroma) {
+    WVFrameRing* ring = new WVFrameRing();
+    ring->name = name;
+    ring->owner = true;
+    if (!Map(name, AlignUp(sizeof(WVFrameRingDirectory), 64), true, &ring->directoryMapping)) {
+        delete ring;
+        return NULL;
+    }
+    WVFrameRingDirectory* directory = new (ring->directoryMapping.base) WVFrameRingDirectory();
+    directory->version = WV_FRAME_RING_VERSION;
+    directory->generation.store(0);
+    ring->directory = directory;
+
+    if (!ring->CreateGeneration(1, width, height, pitch, lines, chroma, &ring->data)) {
+        delete ring;
+        return NULL;
+    }
+    ring->base = ring->data.base;
+    ring->size = ring->data.size;
+    ring->header = reinterpret_cast<WVFrameRingHeader*>(ring->data.base);
+
+    directory->generation.store(1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    directory->magic = WV_FRAME_RING_DIRECTORY_MAGIC;
+    return ring;
+}
+
+WVFrameRing* WVFrameRing::Open(const std::string& name) {
+    WVFrameRing* ring = new WVFrameRing();
+    ring->name = name;
+    ring->owner = false;
+
+#ifdef _WIN32
+    size_t directorySize = AlignUp(sizeof(WVFrameRingDirectory), 64);
+#else
+    size_t directorySize = 0;
+#endif
+    if (!Map(name, directorySize, false, &ring->directoryMapping)) {
+        delete ring;
+        return NULL;
+    }
+    WVFrameRingDirectory* directory = reinterpret_cast<WVFrameRingDirectory*>(ring->directoryMapping.base);
+    if (ring->directoryMapping.size < sizeof(WVFrameRingDirectory) ||
+        directory->magic != WV_FRAME_RING_DIRECTORY_MAGIC || directory->version != WV_FRAME_RING_VERSION) {
+        delete ring;
+        return NULL;
+    }
+    ring->directory = directory;
+
+    // 读到的代号在打开前可能已被下一代取代并释放，此时按新的代号重试
+    for (int attempt = 0; attempt < kOpenRetries; ++attempt) {
+        uint32_t generation = directory->generation.load(std::memory_order_acquire);
+        if (ring->OpenGeneration(generation, &ring->data)) {
+            ring->base = ring->data.base;
+            ring->size = ring->data.size;
+            ring->header = reinterpret_cast<WVFrameRingHeader*>(ring->data.base);
+            return ring;
+        }
+        if (directory->generation.load(std::memory_order_acquire) == generation) break;
+    }
+    delete ring;
+    return NULL;
+}
+
+uint8_t* WVFrameRing::SlotData(uint32_t slot) const {
+    if (slot >= WV_FRAME_RING_SLOTS) return NULL;
+    return base + header->slots[slot].dataOffset;
+}
+
+void WVFrameRing::Publish(int64_t timestampUs) {
+    WVFrameSlotHeader& slotHeader = header->slots[backSlot];
+    slotHeader.frameNumber = nextFrame++;
+    slotHeader.timestampUs = timestampUs;
+
+    // 交换后 back 槽位变为 middle，换回的槽位成为新的 back
+    if (WVTripleBuffer::Publish(header->exchangeState, &backSlot)) {
+        header->framesOverwritten.fetch_add(1, std::memory_order_relaxed);
+    }
+    header->framesPublished.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool WVFrameRing::Resize(uint32_t width, uint32_t height, uint32_t pitch, uint32_t lines, uint32_t chroma) {
+    uint32_t generation = header->generation + 1;
+    Mapping next;
+    if (!CreateGeneration(generation, width, height, pitch, lines, chroma, &next)) {
+        return false;
+    }
+
+    // 新区域初始化完成后才公布代号；帧号延续，消费者切换后仍单调递增
+    ReleaseData();
+    data = next;
+    base = data.base;
+    size = data.size;
+    header = reinterpret_cast<WVFrameRingHeader*>(data.base);
+    backSlot = WVTripleBuffer::InitialBackIndex();
+    directory->generation.store(generation, std::memory_order_release);
+    return true;
+}
+
+int WVFrameRing::Acquire(bool* fresh) {
+    uint32_t front = header->consumerSlot.load(std::memory_order_relaxed);
+    bool acquired = WVTripleBuffer::Acquire(header->exchangeState, &front);
+    if (acquired) {
+        header->consumerSlot.store(front, std::memory_order_relaxed);
+        header->framesConsumed.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (fresh) *fresh = acquired;
+
+    if (front >= WV_FRAME_RING_SLOTS || header->slots[front].frameNumber == 0) {
+        return -1;
+    }
+    return static_cast<int>(front);
+}
+
+bool WVFrameRing::Follow() {
+    uint32_t generation = directory->generation.load(std::memory_order_acquire);
+    if (generation == header->generation) return false;
+
+    // 新一代打不开（已被更新的一代取代）时保持当前映射，下次再跟随
+    Mapping next;
+    if (!OpenGeneration(generation, &next)) return false;
+    Unmap(&data);
+    data = next;
+    base = data.base;
+    size = data.size;
+    header = reinterpret_cast<WVFrameRingHeader*>(data.base);
+    return true;
+}
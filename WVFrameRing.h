@@ -0,0 +1,160 @@
+//
+//  WVFrameRing.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_FRAME_RING_H
+#define WV_FRAME_RING_H
+
+#include <atomic>
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+// ==================== 共享内存帧环 ====================
+//
+// 帧回调模式下，解码后的画面发布到一块命名共享内存中，渲染进程可以直接映射为
+// ArrayBuffer 读取而无需拷贝。帧数据所在的区域按“代”命名（name.1、name.2 ...），布局：
+//
+//   [WVFrameRingHeader][槽位 0 数据][槽位 1 数据][槽位 2 数据]
+//
+// 三个槽位按三缓冲（WVTripleBuffer）轮换：VLC 直接解码到 back 槽位，显示时原子发布；
+// 消费者 Acquire 后得到的 front 槽位在下次 Acquire 之前不会被生产者改写。
+// 交换状态和消费者持有的槽位都保存在共享内存中，消费者可以在另一个进程。
+//
+// 视频尺寸变化（如切换子码流）时不在原名称上重建（读取方可能正在读取，Windows 上同名映射
+// 还会返回旧的较小的对象）：生产者创建下一代区域，初始化完成后再更新名称 name 对应的
+// 目录区域（WVFrameRingDirectory，生产者存续期间不变）中的当前代号，然后释放上一代。
+// 消费者每次 Acquire 前用 Follow 检查代号，变化时改为映射新一代；已映射的旧区域在
+// 解除映射前一直有效，不会读到被改写或释放的内存。
+
+#define WV_FRAME_RING_MAGIC 0x52465657u   // "WVFR"
+#define WV_FRAME_RING_DIRECTORY_MAGIC 0x44465657u   // "WVFD"
+#define WV_FRAME_RING_VERSION 3u
+#define WV_FRAME_RING_SLOTS 3u
+
+struct WVFrameRingDirectory {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> generation;          // 当前帧数据区域的代号（从 1 开始）
+};
+
+struct WVFrameSlotHeader {
+    uint64_t frameNumber;             // 帧号（从 1 开始，0 表示槽位尚未写入过）
+    int64_t timestampUs;              // 发布时间（单调时钟，微秒）
+    uint64_t dataOffset;              // 槽位数据相对映射起点的偏移
+};
+
+struct WVFrameRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t slotCount;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;                   // 每行字节数
+    uint32_t chroma;                  // 像素格式 FourCC（如 'RV32'）
+    uint32_t generation;              // 本区域的代号
+    uint32_t reserved;
+    uint64_t slotSize;                // 每个槽位的数据字节数
+    std::atomic<uint32_t> exchangeState;       // 三缓冲共享状态
+    std::atomic<uint32_t> consumerSlot;        // 消费者当前持有的 front 槽位
+    std::atomic<uint64_t> framesPublished;
+    std::atomic<uint64_t> framesOverwritten;   // 未被消费就被新帧替换的帧数
+    std::atomic<uint64_t> framesConsumed;
+    WVFrameSlotHeader slots[WV_FRAME_RING_SLOTS];
+};
+
+class WVFrameRing {
+public:
+    /**
+     * 创建（生产者）共享内存帧环；名称已被占用（其他生产者或尚未关闭的读取方）时失败
+     * @param lines 每个槽位分配的行数（VLC 要求按 16 行对齐，不小于 height）
+     * @return 失败返回 NULL
+     */
+    static WVFrameRing* Create(const std::string& name, uint32_t width, uint32_t height,
+                               uint32_t pitch, uint32_t lines, uint32_t chroma);
+
+    /**
+     * 打开（消费者）已存在的共享内存帧环（映射当前一代）
+     * @return 不存在或格式不符返回 NULL
+     */
+    static WVFrameRing* Open(const std::string& name);
+
+    ~WVFrameRing();
+
+    // ---------- 生产者（同一时刻只能有一个） ----------
+
+    /**
+     * 当前 back 槽位的数据指针，生产者直接写入
+     */
+    uint8_t* BackBuffer() const { return SlotData(backSlot); }
+
+    /**
+     * 发布 back 槽位为最新帧，并切换到新的 back 槽位（不会阻塞）
+     */
+    void Publish(int64_t timestampUs);
+
+    /**
+     * 按新尺寸创建下一代区域并切换过去，之后 BackBuffer 指向新区域
+     * @return 失败时保持当前区域并返回 false
+     */
+    bool Resize(uint32_t width, uint32_t height, uint32_t pitch, uint32_t lines, uint32_t chroma);
+
+    // ---------- 消费者（同一时刻只能有一个） ----------
+
+    /**
+     * 取得最新帧。返回的槽位在下一次 Acquire 之前保持不变
+     * @param fresh 可为 NULL，返回是否为上次 Acquire 之后的新帧
+     * @return 槽位索引，尚无帧时返回 -1
+     */
+    int Acquire(bool* fresh);
+
+    /**
+     * 生产者已切换到新的一代时改为映射新区域（之前 Acquire 的槽位随旧区域失效）
+     * @return 是否切换了区域（Header / Base / Size 随之改变）
+     */
+    bool Follow();
+
+    WVFrameRingHeader* Header() const { return header; }
+    uint8_t* Base() const { return base; }
+    size_t Size() const { return size; }
+    uint8_t* SlotData(uint32_t slot) const;
+    const std::string& Name() const { return name; }
+    uint32_t Generation() const { return header->generation; }
+
+private:
+    // 一块命名共享内存的映射
+    struct Mapping {
+        uint8_t* base;
+        size_t size;
+        void* handle;     // Windows: 文件映射句柄
+        Mapping() : base(NULL), size(0), handle(NULL) {}
+    };
+
+    WVFrameRing();
+    WVFrameRing(const WVFrameRing&);
+    WVFrameRing& operator=(const WVFrameRing&);
+
+    static bool Map(const std::string& mappingName, size_t mappingSize, bool create, Mapping* mapping);
+    static void Unmap(Mapping* mapping);
+    bool CreateGeneration(uint32_t generation, uint32_t width, uint32_t height, uint32_t pitch,
+                          uint32_t lines, uint32_t chroma, Mapping* mapping);
+    bool OpenGeneration(uint32_t generation, Mapping* mapping);
+    void ReleaseData();
+
+    std::string name;
+    Mapping directoryMapping;
+    Mapping data;
+    WVFrameRingDirectory* directory;
+    uint8_t* base;
+    size_t size;
+    WVFrameRingHeader* header;
+    bool owner;
+    uint32_t backSlot;    // 生产者当前的 back 槽位
+    uint64_t nextFrame;   // 生产者下一帧帧号
+};
+
+#endif // WV_FRAME_RING_H
@@ -0,0 +1,383 @@
+//
+//  WVGlyphAtlas.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVGlyphAtlas.h"
+#include "WVGlyphRasterizer.h"
+#include "WVOverlayRaster.h"
+#include "WVLog.h"
+#include <list>
+#include <map>
+#include <mutex>
+#include <string.h>
+#include <unordered_map>
+
+namespace {
+
+const int kMinPixelSize = 6;
+const int kMaxPixelSize = 96;
+
+// 每个字号一张图集，宽度固定，高度按需增长；超过上限时清空重建
+const int kAtlasWidth = 1024;
+const int kAtlasMaxHeight = 1024;
+
+// 标签缓存上限（条数与位图总字节数）
+const size_t kMaxCachedLabels = 1024;
+const size_t kMaxCachedBytes = 8 * 1024 * 1024;
+
+struct Glyph {
+    int x;               // 图集中的位置
+    int y;
+    int width;
+    int height;
+    int originX;         // 左上角相对笔位置的偏移（y 向上为正）
+    int originY;
+    int advance;
+};
+
+struct Face {
+    WVGlyphRasterizer* rasterizer;   // 随进程存在
+    int pixelSize;
+    int ascent;
+    int descent;
+    std::map<uint32_t, Glyph> glyphs;
+    std::vector<uint8_t> atlas;   // kAtlasWidth * atlasHeight
+    int atlasHeight;
+    int shelfX;                   // 货架式装箱：当前货架的下一个位置与高度
+    int shelfY;
+    int shelfHeight;
+    unsigned generation;          // 图集每次重建加一
+};
+
+// 文字覆盖率与底框位图共用一个 LRU；底框位图额外以内边距与颜色区分
+struct LabelKey {
+    int pixelSize;
+    bool tag;
+    int padding;
+    uint32_t background;
+    uint32_t color;
+    std::string text;
+
+    bool operator==(const LabelKey& other) const {
+        return pixelSize == other.pixelSize && tag == other.tag && padding == other.padding &&
+               background == other.background && color == other.color && text == other.text;
+    }
+};
+
+struct LabelKeyHash {
+    size_t operator()(const LabelKey& key) const {
+        size_t hash = std::hash<std::string>()(key.text);
+        uint32_t extra[4] = { static_cast<uint32_t>(key.pixelSize) | (key.tag ? 0x80000000u : 0u),
+                              static_cast<uint32_t>(key.padding), key.background, key.color };
+        for (int i = 0; i < 4; ++i) {
+            hash ^= extra[i] + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+struct CachedLabel {
+    std::shared_ptr<const WVLabelBitmap> bitmap;
+    std::shared_ptr<const WVLabelTag> tag;
+    size_t bytes;
+    std::list<const LabelKey*>::iterator order;   // 指向 labels 中的键（无序容器的节点地址不变）
+};
+
+typedef std::unordered_map<LabelKey, CachedLabel, LabelKeyHash> LabelMap;
+
+// 函数内静态对象避免 DLL 加载时的静态初始化顺序问题
+struct AtlasState {
+    std::mutex mutex;
+    std::map<int, Face> faces;
+    std::list<const LabelKey*> recent;          // 最近使用的在前
+    LabelMap labels;
+    size_t cachedBytes;
+
+    AtlasState() : cachedBytes(0) {}
+};
+
+AtlasState& State() {
+    static AtlasState state;
+    return state;
+}
+
+// 非法字节按 U+FFFD 处理
+void DecodeUtf8(const std::string& text, std::vector<uint32_t>* out) {
+    size_t i = 0;
+    while (i < text.size()) {
+        uint8_t lead = static_cast<uint8_t>(text[i]);
+        int extra = lead < 0x80 ? 0 : (lead >> 5) == 0x6 ? 1 : (lead >> 4) == 0xE ? 2 : (lead >> 3) == 0x1E ? 3 : -1;
+        if (extra < 0 || i + extra >= text.size()) {
+            out->push_back(0xFFFD);
+            ++i;
+            continue;
+        }
+        uint32_t codepoint = extra == 0 ? lead : lead & (0x3F >> extra);
+        bool valid = true;
+        for (int k = 1; k <= extra; ++k) {
+            uint8_t next = static_cast<uint8_t>(text[i + k]);
+            if ((next & 0xC0) != 0x80) {
+                valid = false;
+                break;
+            }
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+        if (!valid) {
+            out->push_back(0xFFFD);
+            ++i;
+            continue;
+        }
+        out->push_back(codepoint);
+        i += extra + 1;
+    }
+}
+
+bool AllocateInAtlas(Face* face, int width, int height, int* x, int* y) {
+    if (width > kAtlasWidth || height > kAtlasMaxHeight) return false;
+    if (face->shelfX + width > kAtlasWidth) {
+        face->shelfY += face->shelfHeight;
+        face->shelfX = 0;
+        face->shelfHeight = 0;
+    }
+    if (face->shelfY + height > kAtlasMaxHeight) return false;
+    if (face->shelfY + height > face->atlasHeight) {
+        int grown = face->atlasHeight * 2;
+        if (grown < face->shelfY + height) grown = face->shelfY + height;
+        if (grown > kAtlasMaxHeight) grown = kAtlasMaxHeight;
+        face->atlas.resize(static_cast<size_t>(kAtlasWidth) * grown);
+        face->atlasHeight = grown;
+    }
+    *x = face->shelfX;
+    *y = face->shelfY;
+    face->shelfX += width;
+    if (height > face->shelfHeight) face->shelfHeight = height;
+    return true;
+}
+
+void ResetAtlas(Face* face) {
+    face->glyphs.clear();
+    face->atlas.clear();
+    face->atlasHeight = 0;
+    face->shelfX = 0;
+    face->shelfY = 0;
+    face->shelfHeight = 0;
+    face->generation++;
+}
+
+Face* FaceForSize(AtlasState& state, int pixelSize) {
+    std::map<int, Face>::iterator it = state.faces.find(pixelSize);
+    if (it != state.faces.end()) return it->second.rasterizer ? &it->second : NULL;
+
+    // 创建失败也记录下来，避免每次都重试
+    Face& face = state.faces[pixelSize];
+    face.rasterizer = WVGlyphRasterizer::Create(pixelSize);
+    if (!face.rasterizer) return NULL;
+    face.pixelSize = pixelSize;
+    face.generation = 0;
+    face.ascent = face.rasterizer->Ascent();
+    face.descent = face.rasterizer->Descent();
+    ResetAtlas(&face);
+    WV_LOG_DEBUG("创建 %d 像素标签字体（ascent=%d, descent=%d）", pixelSize, face.ascent, face.descent);
+    return &face;
+}
+
+// 栅格化一个字形并放进图集；图集已满时清空该字号的图集后重试
+const Glyph* FindGlyph(Face* face, uint32_t codepoint) {
+    std::map<uint32_t, Glyph>::iterator it = face->glyphs.find(codepoint);
+    if (it != face->glyphs.end()) return &it->second;
+
+    WVGlyphBitmap bitmap;
+    if (!face->rasterizer->Rasterize(codepoint, &bitmap)) return NULL;
+
+    Glyph glyph;
+    glyph.x = 0;
+    glyph.y = 0;
+    glyph.width = 0;
+    glyph.height = 0;
+    glyph.originX = bitmap.originX;
+    glyph.originY = bitmap.originY;
+    glyph.advance = bitmap.advance;
+
+    // 空白字符没有位图，只有步进
+    if (bitmap.width > 0 && bitmap.height > 0) {
+        if (!AllocateInAtlas(face, bitmap.width, bitmap.height, &glyph.x, &glyph.y)) {
+            WV_LOG_DEBUG("%d 像素标签图集已满，清空重建", face->pixelSize);
+            ResetAtlas(face);
+            if (!AllocateInAtlas(face, bitmap.width, bitmap.height, &glyph.x, &glyph.y)) return NULL;
+        }
+        glyph.width = bitmap.width;
+        glyph.height = bitmap.height;
+        for (int row = 0; row < bitmap.height; ++row) {
+            memcpy(&face->atlas[static_cast<size_t>(glyph.y + row) * kAtlasWidth + glyph.x],
+                   &bitmap.coverage[static_cast<size_t>(row) * bitmap.width], bitmap.width);
+        }
+    }
+    return &(face->glyphs[codepoint] = glyph);
+}
+
+std::shared_ptr<const WVLabelBitmap> ComposeLabel(Face* face, const std::vector<uint32_t>& text) {
+    // 先确定全部字形再按图集位置拼接；查找过程中图集被重建时，之前取到的位置已失效，
+    // 在新图集中重新查找一遍（一条标签的字形总能放进空图集）
+    std::vector<Glyph> glyphs;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        unsigned generation = face->generation;
+        glyphs.clear();
+        for (size_t i = 0; i < text.size(); ++i) {
+            const Glyph* glyph = FindGlyph(face, text[i]);
+            if (glyph) glyphs.push_back(*glyph);
+        }
+        if (face->generation == generation) break;
+    }
+    if (glyphs.empty()) return std::shared_ptr<const WVLabelBitmap>();
+
+    int penStart = glyphs[0].originX < 0 ? -glyphs[0].originX : 0;
+    int width = penStart;
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        width += glyphs[i].advance;
+    }
+    const Glyph& last = glyphs.back();
+    int lastRight = width - last.advance + last.originX + last.width;
+    if (lastRight > width) width = lastRight;
+    if (width <= 0) return std::shared_ptr<const WVLabelBitmap>();
+
+    std::shared_ptr<WVLabelBitmap> bitmap = std::make_shared<WVLabelBitmap>();
+    bitmap->width = width;
+    bitmap->height = face->ascent + face->descent;
+    bitmap->coverage.assign(static_cast<size_t>(bitmap->width) * bitmap->height, 0);
+
+    int pen = penStart;
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const Glyph& glyph = glyphs[i];
+        int left = pen + glyph.originX;
+        int top = face->ascent - glyph.originY;
+        for (int row = 0; row < glyph.height; ++row) {
+            int y = top + row;
+            if (y < 0 || y >= bitmap->height) continue;
+            const uint8_t* src = &face->atlas[static_cast<size_t>(glyph.y + row) * kAtlasWidth + glyph.x];
+            uint8_t* dst = &bitmap->coverage[static_cast<size_t>(y) * bitmap->width];
+            for (int col = 0; col < glyph.width; ++col) {
+                int x = left + col;
+                if (x < 0 || x >= bitmap->width) continue;
+                if (src[col] > dst[x]) dst[x] = src[col];   // 相邻字形重叠处取较大覆盖率
+            }
+        }
+        pen += glyph.advance;
+    }
+    return bitmap;
+}
+
+void EvictLabels(AtlasState& state) {
+    while (!state.recent.empty() &&
+           (state.labels.size() > kMaxCachedLabels || state.cachedBytes > kMaxCachedBytes)) {
+        LabelMap::iterator it = state.labels.find(*state.recent.back());
+        state.recent.pop_back();
+        if (it != state.labels.end()) {
+            state.cachedBytes -= it->second.bytes;
+            state.labels.erase(it);
+        }
+    }
+}
+
+CachedLabel* FindCachedLocked(AtlasState& state, const LabelKey& key) {
+    LabelMap::iterator it = state.labels.find(key);
+    if (it == state.labels.end()) return NULL;
+    state.recent.splice(state.recent.begin(), state.recent, it->second.order);
+    return &it->second;
+}
+
+// 失败的结果（空指针）也缓存，避免每帧重试
+void InsertCachedLocked(AtlasState& state, const LabelKey& key, const CachedLabel& value) {
+    std::pair<LabelMap::iterator, bool> inserted = state.labels.insert(std::make_pair(key, value));
+    CachedLabel& entry = inserted.first->second;
+    state.recent.push_front(&inserted.first->first);
+    entry.order = state.recent.begin();
+    state.cachedBytes += entry.bytes;
+    EvictLabels(state);
+}
+
+LabelKey MakeKey(const std::string& utf8, int pixelSize) {
+    LabelKey key;
+    key.pixelSize = pixelSize;
+    key.tag = false;
+    key.padding = 0;
+    key.background = 0;
+    key.color = 0;
+    key.text = utf8;
+    return key;
+}
+
+int ClampPixelSize(int pixelSize) {
+    if (pixelSize < kMinPixelSize) return kMinPixelSize;
+    if (pixelSize > kMaxPixelSize) return kMaxPixelSize;
+    return pixelSize;
+}
+
+std::shared_ptr<const WVLabelBitmap> LabelLocked(AtlasState& state, const LabelKey& key) {
+    CachedLabel* cached = FindCachedLocked(state, key);
+    if (cached) return cached->bitmap;
+
+    CachedLabel entry;
+    entry.bytes = 0;
+    Face* face = FaceForSize(state, key.pixelSize);
+    if (face) {
+        std::vector<uint32_t> text;
+        DecodeUtf8(key.text, &text);
+        entry.bitmap = ComposeLabel(face, text);
+        if (entry.bitmap) entry.bytes = entry.bitmap->coverage.size();
+    }
+    InsertCachedLocked(state, key, entry);
+    return entry.bitmap;
+}
+
+// 与帧上的绘制方式相同：先填充不透明底色，再用同一套行混合实现叠加文字，结果逐字节一致
+std::shared_ptr<const WVLabelTag> ComposeTag(const WVLabelBitmap& label, int padding,
+                                             uint32_t background, uint32_t color) {
+    std::shared_ptr<WVLabelTag> tag = std::make_shared<WVLabelTag>();
+    tag->width = label.width + padding * 2;
+    tag->height = label.height + padding * 2;
+    tag->pixels.assign(static_cast<size_t>(tag->width) * tag->height, background);
+    WVOverlaySurface surface = { reinterpret_cast<uint8_t*>(&tag->pixels[0]), tag->width, tag->height,
+                                 tag->width * 4 };
+    WVOverlayBlendMask(surface, padding, padding, &label.coverage[0], label.width, label.width, label.height, color);
+    return tag;
+}
+
+} // namespace
+
+std::shared_ptr<const WVLabelBitmap> WVGlyphAtlas::Label(const std::string& utf8, int pixelSize) {
+    if (utf8.empty()) return std::shared_ptr<const WVLabelBitmap>();
+    LabelKey key = MakeKey(utf8, ClampPixelSize(pixelSize));
+
+    AtlasState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return LabelLocked(state, key);
+}
+
+std::shared_ptr<const WVLabelTag> WVGlyphAtlas::Tag(const std::string& utf8, int pixelSize, int padding,
+                                                    uint32_t background, uint32_t color) {
+    if (utf8.empty() || (background >> 24) != 0xFF) return std::shared_ptr<const WVLabelTag>();
+    if (padding < 0) padding = 0;
+    LabelKey key = MakeKey(utf8, ClampPixelSize(pixelSize));
+    key.tag = true;
+    key.padding = padding;
+    key.background = background;
+    key.color = color;
+
+    AtlasState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    CachedLabel* cached = FindCachedLocked(state, key);
+    if (cached) return cached->tag;
+
+    CachedLabel entry;
+    entry.bytes = 0;
+    std::shared_ptr<const WVLabelBitmap> label = LabelLocked(state, MakeKey(utf8, key.pixelSize));
+    if (label) {
+        entry.tag = ComposeTag(*label, padding, background, color);
+        entry.bytes = entry.tag->pixels.size() * 4;
+    }
+    InsertCachedLocked(state, key, entry);
+    return entry.tag;
+}
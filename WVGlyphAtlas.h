@@ -0,0 +1,64 @@
+//
+//  WVGlyphAtlas.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_GLYPH_ATLAS_H
+#define WV_GLYPH_ATLAS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// ==================== 覆盖层文字标签 ====================
+//
+// 检测框的类别、置信度标签。每帧调用字体 API 绘制文字开销很大，这里分两级缓存：
+//   - 字形图集：每个字号一张 8 位覆盖率图集，字形第一次出现时由 WVGlyphRasterizer
+//     （Windows 为 GDI，其他平台为 FreeType）栅格化一次，之后只从图集复制；
+//   - 标签缓存：由图集字形拼好的整条标签位图，按 (字号, 文本) 放入 LRU；
+//     底框不透明时（常见情况）另外缓存合成好底色与文字的 BGRA 底框位图，
+//     按 (字号, 文本, 内边距, 颜色) 放入同一个 LRU。
+// 重复出现的标签（同一类别、同样的置信度）每帧只是一次查找加一次逐行复制
+// （底框半透明时为一次填充加一次 alpha 混合）。
+// 图集满时整体清空重建；已经拼好的标签持有自己的位图，不受影响。
+// 图集与缓存由全部播放器共享（窗口模式与帧回调模式），随进程存在，所有方法线程安全。
+
+struct WVLabelBitmap {
+    int width;
+    int height;
+    std::vector<uint8_t> coverage;    // width * height，0-255
+};
+
+// 合成好的标签底框（底色加文字），预乘 BGRA，完全不透明
+struct WVLabelTag {
+    int width;
+    int height;
+    std::vector<uint32_t> pixels;     // width * height
+};
+
+class WVGlyphAtlas {
+public:
+    /**
+     * 取得渲染好的标签，未缓存时栅格化
+     * @param utf8 标签文本（UTF-8，超出基本多文种平面的字符显示为 ?）
+     * @param pixelSize 字号（像素），限制在 6-96
+     * @return 标签位图；文本为空或字体不可用时返回空指针
+     */
+    static std::shared_ptr<const WVLabelBitmap> Label(const std::string& utf8, int pixelSize);
+
+    /**
+     * 取得合成好的标签底框，未缓存时由 Label 的结果合成；
+     * 结果与先填充 background 再以 color 混合 Label 位图（左上角偏移 padding）逐字节一致
+     * @param padding 文字四周的内边距（像素）
+     * @param background 底框颜色（预乘 BGRA），必须完全不透明
+     * @param color 文字颜色（预乘 BGRA），alpha 为 0 时只有底色
+     * @return 文本为空、底色不是完全不透明或字体不可用时返回空指针
+     */
+    static std::shared_ptr<const WVLabelTag> Tag(const std::string& utf8, int pixelSize, int padding,
+                                                 uint32_t background, uint32_t color);
+};
+
+#endif // WV_GLYPH_ATLAS_H
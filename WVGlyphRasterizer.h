@@ -0,0 +1,51 @@
+//
+//  WVGlyphRasterizer.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_GLYPH_RASTERIZER_H
+#define WV_GLYPH_RASTERIZER_H
+
+#include <vector>
+#include <stdint.h>
+
+// ==================== 标签字形栅格化 ====================
+//
+// WVGlyphAtlas 为每个字号创建一个栅格化对象，字形第一次出现时栅格化为 8 位覆盖率后放进图集。
+// 构建时按平台选择实现：Windows 使用 GDI（WVGlyphRasterizerGDI.cpp，微软雅黑），
+// 其他平台使用 FreeType（WVGlyphRasterizerFreeType.cpp，由 fontconfig 选择支持中文的无衬线字体）；
+// 没有 FreeType 时使用 WVGlyphRasterizerNull.cpp，不绘制标签文字。
+// 只在图集的锁内调用，实现不需要线程安全。
+
+struct WVGlyphBitmap {
+    int width;
+    int height;
+    int originX;                      // 左上角相对笔位置的偏移（y 向上为正）
+    int originY;
+    int advance;
+    std::vector<uint8_t> coverage;    // width * height，0-255
+};
+
+class WVGlyphRasterizer {
+public:
+    /**
+     * @param pixelSize 字号（像素）
+     * @return 字体不可用时返回 NULL
+     */
+    static WVGlyphRasterizer* Create(int pixelSize);
+
+    virtual ~WVGlyphRasterizer() {}
+
+    virtual int Ascent() const = 0;
+    virtual int Descent() const = 0;
+
+    /**
+     * 栅格化一个字符；空白字符返回空位图，只有步进
+     * @return 失败返回 false
+     */
+    virtual bool Rasterize(uint32_t codepoint, WVGlyphBitmap* glyph) = 0;
+};
+
+#endif // WV_GLYPH_RASTERIZER_H
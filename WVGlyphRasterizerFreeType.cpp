@@ -0,0 +1,195 @@
+//
+//  WVGlyphRasterizerFreeType.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVGlyphRasterizer.h"
+#include "WVLog.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef WV_HAVE_FONTCONFIG
+#include <fontconfig/fontconfig.h>
+#endif
+
+namespace {
+
+// 没有 fontconfig（或没有匹配结果）时依次尝试的字体文件
+const char* const kFallbackFonts[] = {
+    "/System/Library/Fonts/PingFang.ttc",
+    "/System/Library/Fonts/STHeiti Light.ttc",
+    "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc",
+    "/usr/share/fonts/noto-cjk/NotoSansCJK-Regular.ttc",
+    "/usr/share/fonts/truetype/wqy/wqy-microhei.ttc",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+    "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+};
+
+struct FontFile {
+    std::string path;
+    int index;
+};
+
+bool FileExists(const char* path) {
+    struct stat info;
+    return stat(path, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+// 环境变量 WV_LABEL_FONT 可指定字体文件；否则优先选择支持中文的无衬线字体
+FontFile FindFontFile() {
+    FontFile file;
+    file.index = 0;
+
+    const char* configured = getenv("WV_LABEL_FONT");
+    if (configured && configured[0] && FileExists(configured)) {
+        file.path = configured;
+        return file;
+    }
+
+#ifdef WV_HAVE_FONTCONFIG
+    if (FcInit()) {
+        FcPattern* pattern = FcNameParse(reinterpret_cast<const FcChar8*>("sans-serif:lang=zh-cn"));
+        if (pattern) {
+            FcConfigSubstitute(NULL, pattern, FcMatchPattern);
+            FcDefaultSubstitute(pattern);
+            FcResult result;
+            FcPattern* match = FcFontMatch(NULL, pattern, &result);
+            if (match) {
+                FcChar8* path = NULL;
+                int index = 0;
+                if (FcPatternGetString(match, FC_FILE, 0, &path) == FcResultMatch && path) {
+                    file.path = reinterpret_cast<const char*>(path);
+                    if (FcPatternGetInteger(match, FC_INDEX, 0, &index) == FcResultMatch) file.index = index;
+                }
+                FcPatternDestroy(match);
+            }
+            FcPatternDestroy(pattern);
+        }
+        if (!file.path.empty()) return file;
+    }
+#endif
+
+    for (size_t i = 0; i < sizeof(kFallbackFonts) / sizeof(kFallbackFonts[0]); ++i) {
+        if (FileExists(kFallbackFonts[i])) {
+            file.path = kFallbackFonts[i];
+            return file;
+        }
+    }
+    return file;
+}
+
+// 库与字体文件只查找一次，所有字号共用（只在图集的锁内使用）
+struct FreeTypeState {
+    FT_Library library;
+    FontFile font;
+    bool ready;
+
+    FreeTypeState() : library(NULL), ready(false) {
+        if (FT_Init_FreeType(&library) != 0) {
+            WV_LOG_ERROR("错误：FreeType 初始化失败，标签文字不可用");
+            library = NULL;
+            return;
+        }
+        font = FindFontFile();
+        if (font.path.empty()) {
+            WV_LOG_ERROR("错误：没有找到标签字体，可以用环境变量 WV_LABEL_FONT 指定字体文件");
+            return;
+        }
+        WV_LOG_INFO("标签字体：%s（%d）", font.path.c_str(), font.index);
+        ready = true;
+    }
+};
+
+FreeTypeState& State() {
+    static FreeTypeState* state = new FreeTypeState();  // 进程退出时不析构
+    return *state;
+}
+
+class FreeTypeRasterizer : public WVGlyphRasterizer {
+public:
+    FreeTypeRasterizer(FT_Face face, int ascent, int descent) : face_(face), ascent_(ascent), descent_(descent) {}
+
+    ~FreeTypeRasterizer() {
+        FT_Done_Face(face_);
+    }
+
+    int Ascent() const { return ascent_; }
+    int Descent() const { return descent_; }
+
+    bool Rasterize(uint32_t codepoint, WVGlyphBitmap* glyph) {
+        // 字体不包含的字符显示为 ?
+        FT_UInt index = FT_Get_Char_Index(face_, codepoint);
+        if (index == 0) index = FT_Get_Char_Index(face_, '?');
+        if (FT_Load_Glyph(face_, index, FT_LOAD_RENDER | FT_LOAD_TARGET_NORMAL) != 0) return false;
+
+        FT_GlyphSlot slot = face_->glyph;
+        const FT_Bitmap& bitmap = slot->bitmap;
+        glyph->originX = slot->bitmap_left;
+        glyph->originY = slot->bitmap_top;
+        glyph->advance = static_cast<int>((slot->advance.x + 32) >> 6);
+        glyph->width = 0;
+        glyph->height = 0;
+        glyph->coverage.clear();
+
+        // 空白字符没有位图，只有步进
+        if (bitmap.width == 0 || bitmap.rows == 0) return true;
+        if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) return false;
+
+        int width = static_cast<int>(bitmap.width);
+        int height = static_cast<int>(bitmap.rows);
+        glyph->width = width;
+        glyph->height = height;
+        glyph->coverage.resize(static_cast<size_t>(width) * height);
+
+        // 灰度级数不是 256 时按比例扩展到 0-255
+        int levels = bitmap.num_grays > 1 ? bitmap.num_grays - 1 : 255;
+        for (int row = 0; row < height; ++row) {
+            const uint8_t* src = bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch;
+            uint8_t* dst = &glyph->coverage[static_cast<size_t>(row) * width];
+            if (levels == 255) {
+                memcpy(dst, src, width);
+                continue;
+            }
+            for (int col = 0; col < width; ++col) {
+                uint32_t level = src[col] > levels ? levels : src[col];
+                dst[col] = static_cast<uint8_t>((level * 255 + levels / 2) / levels);
+            }
+        }
+        return true;
+    }
+
+private:
+    FT_Face face_;
+    int ascent_;
+    int descent_;
+};
+
+} // namespace
+
+WVGlyphRasterizer* WVGlyphRasterizer::Create(int pixelSize) {
+    FreeTypeState& state = State();
+    if (!state.ready) return NULL;
+
+    FT_Face face = NULL;
+    if (FT_New_Face(state.library, state.font.path.c_str(), state.font.index, &face) != 0) {
+        WV_LOG_ERROR("错误：无法打开标签字体 %s", state.font.path.c_str());
+        return NULL;
+    }
+    if (FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(pixelSize)) != 0) {
+        WV_LOG_ERROR("错误：无法创建 %d 像素的标签字体", pixelSize);
+        FT_Done_Face(face);
+        return NULL;
+    }
+
+    // 26.6 定点数，ascent 向上取整、descent 向下取整，保证字形不被裁掉
+    const FT_Size_Metrics& metrics = face->size->metrics;
+    int ascent = static_cast<int>((metrics.ascender + 63) >> 6);
+    int descent = static_cast<int>((-metrics.descender + 63) >> 6);
+    return new FreeTypeRasterizer(face, ascent, descent);
+}
@@ -0,0 +1,109 @@
+//
+//  WVGlyphRasterizerGDI.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include <windows.h>
+#include "WVGlyphRasterizer.h"
+#include "WVLog.h"
+
+namespace {
+
+// 覆盖中文与拉丁字符，Windows 7 起各语言版本都自带
+const wchar_t kFontFace[] = L"Microsoft YaHei";
+
+// 所有字号共用一个内存 DC（只在图集的锁内使用）
+HDC SharedDC() {
+    static HDC dc = CreateCompatibleDC(NULL);
+    return dc;
+}
+
+class GDIRasterizer : public WVGlyphRasterizer {
+public:
+    GDIRasterizer(HFONT font, int ascent, int descent) : font_(font), ascent_(ascent), descent_(descent) {}
+
+    ~GDIRasterizer() {
+        DeleteObject(font_);
+    }
+
+    int Ascent() const { return ascent_; }
+    int Descent() const { return descent_; }
+
+    bool Rasterize(uint32_t codepoint, WVGlyphBitmap* glyph) {
+        HDC dc = SharedDC();
+        // GetGlyphOutlineW 只接受 UTF-16 码元
+        UINT character = codepoint > 0xFFFF ? '?' : static_cast<UINT>(codepoint);
+        MAT2 identity = { { 0, 1 }, { 0, 0 }, { 0, 0 }, { 0, 1 } };
+        GLYPHMETRICS metrics;
+        SelectObject(dc, font_);
+        DWORD size = GetGlyphOutlineW(dc, character, GGO_GRAY8_BITMAP, &metrics, 0, NULL, &identity);
+        if (size == GDI_ERROR) return false;
+
+        glyph->width = 0;
+        glyph->height = 0;
+        glyph->originX = metrics.gmptGlyphOrigin.x;
+        glyph->originY = metrics.gmptGlyphOrigin.y;
+        glyph->advance = metrics.gmCellIncX;
+        glyph->coverage.clear();
+
+        // 空白字符没有位图，只有步进
+        if (size == 0) return true;
+
+        std::vector<uint8_t> buffer(size);
+        if (GetGlyphOutlineW(dc, character, GGO_GRAY8_BITMAP, &metrics, size, &buffer[0], &identity) == GDI_ERROR) {
+            return false;
+        }
+        int width = static_cast<int>(metrics.gmBlackBoxX);
+        int height = static_cast<int>(metrics.gmBlackBoxY);
+        int pitch = (width + 3) & ~3;   // GDI 位图每行按 4 字节对齐
+        if (static_cast<size_t>(pitch) * height > buffer.size()) return false;
+
+        glyph->width = width;
+        glyph->height = height;
+        glyph->coverage.resize(static_cast<size_t>(width) * height);
+
+        // GGO_GRAY8_BITMAP 的灰度为 0-64，扩展到 0-255
+        for (int row = 0; row < height; ++row) {
+            const uint8_t* src = &buffer[static_cast<size_t>(row) * pitch];
+            uint8_t* dst = &glyph->coverage[static_cast<size_t>(row) * width];
+            for (int col = 0; col < width; ++col) {
+                uint32_t level = src[col] > 64 ? 64 : src[col];
+                dst[col] = static_cast<uint8_t>((level * 255 + 32) / 64);
+            }
+        }
+        return true;
+    }
+
+private:
+    HFONT font_;
+    int ascent_;
+    int descent_;
+};
+
+} // namespace
+
+WVGlyphRasterizer* WVGlyphRasterizer::Create(int pixelSize) {
+    HDC dc = SharedDC();
+    if (!dc) {
+        WV_LOG_ERROR("错误：无法创建标签栅格化使用的 DC");
+        return NULL;
+    }
+
+    HFONT font = CreateFontW(-pixelSize, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET,
+                             OUT_TT_PRECIS, CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY,
+                             DEFAULT_PITCH | FF_SWISS, kFontFace);
+    if (!font) {
+        WV_LOG_ERROR("错误：无法创建 %d 像素的标签字体", pixelSize);
+        return NULL;
+    }
+
+    SelectObject(dc, font);
+    TEXTMETRICW metrics;
+    if (!GetTextMetricsW(dc, &metrics)) {
+        DeleteObject(font);
+        return NULL;
+    }
+    return new GDIRasterizer(font, metrics.tmAscent, metrics.tmDescent);
+}
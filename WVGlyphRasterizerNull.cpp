@@ -0,0 +1,21 @@
+//
+//  WVGlyphRasterizerNull.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVGlyphRasterizer.h"
+#include "WVLog.h"
+#include <stddef.h>
+
+// 构建时没有找到 FreeType：检测框照常绘制，不绘制标签
+WVGlyphRasterizer* WVGlyphRasterizer::Create(int pixelSize) {
+    static bool warned = false;   // 只在图集的锁内调用
+    if (!warned) {
+        warned = true;
+        WV_LOG_WARN("构建时未启用字体栅格化（没有 FreeType），覆盖层标签不绘制文字");
+    }
+    (void)pixelSize;
+    return NULL;
+}
@@ -0,0 +1,107 @@
+//
+//  WVInstancePool.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVInstancePool.h"
+#include "WVVlcLog.h"
+#include <map>
+#include <mutex>
+
+namespace {
+
+struct PoolEntry {
+    libvlc_instance_t* instance;
+    int refCount;
+};
+
+// 键为参数拼接后的字符串；函数内静态对象避免 DLL 加载时的静态初始化顺序问题
+std::mutex& PoolMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, PoolEntry>& PoolEntries() {
+    static std::map<std::string, PoolEntry> entries;
+    return entries;
+}
+
+std::string MakeKey(const std::vector<std::string>& args) {
+    std::string key;
+    for (size_t i = 0; i < args.size(); ++i) {
+        key += args[i];
+        key += '\n';  // 参数本身不会包含换行，用作分隔符
+    }
+    return key;
+}
+
+} // namespace
+
+libvlc_instance_t* WVInstancePool::Acquire(const std::vector<std::string>& args, bool* created) {
+    if (created) *created = false;
+
+    std::string key = MakeKey(args);
+    std::lock_guard<std::mutex> lock(PoolMutex());
+
+    std::map<std::string, PoolEntry>& entries = PoolEntries();
+    std::map<std::string, PoolEntry>::iterator it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.refCount++;
+        return it->second.instance;
+    }
+
+    // 在锁内创建，保证相同参数并发创建时只会初始化一次
+    std::vector<const char*> argv;
+    argv.reserve(args.size());
+    for (size_t i = 0; i < args.size(); ++i) {
+        argv.push_back(args[i].c_str());
+    }
+
+    libvlc_instance_t* instance = libvlc_new(static_cast<int>(argv.size()),
+                                             argv.empty() ? NULL : &argv[0]);
+    if (!instance) {
+        return NULL;
+    }
+
+    // VLC 自身的日志转入桥接库日志管线（过滤、去重、限速）
+    libvlc_log_set(instance, WVVlcLogCallback, NULL);
+
+    PoolEntry entry;
+    entry.instance = instance;
+    entry.refCount = 1;
+    entries[key] = entry;
+
+    if (created) *created = true;
+    return instance;
+}
+
+void WVInstancePool::Release(libvlc_instance_t* instance) {
+    if (!instance) return;
+
+    bool destroy = false;
+    {
+        std::lock_guard<std::mutex> lock(PoolMutex());
+        std::map<std::string, PoolEntry>& entries = PoolEntries();
+        for (std::map<std::string, PoolEntry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.instance != instance) continue;
+            if (--it->second.refCount <= 0) {
+                entries.erase(it);
+                destroy = true;
+            }
+            break;
+        }
+    }
+
+    // libvlc_release 可能耗时（卸载模块），放在锁外执行
+    if (destroy) {
+        libvlc_log_unset(instance);
+        libvlc_release(instance);
+    }
+}
+
+size_t WVInstancePool::InstanceCount() {
+    std::lock_guard<std::mutex> lock(PoolMutex());
+    return PoolEntries().size();
+}
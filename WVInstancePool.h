@@ -0,0 +1,44 @@
+//
+//  WVInstancePool.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_INSTANCE_POOL_H
+#define WV_INSTANCE_POOL_H
+
+#include "WVLibVLC.h"
+#include <string>
+#include <vector>
+
+// ==================== libVLC 实例池 ====================
+//
+// libvlc_new 每次都会重新扫描插件目录并重建模块库，开销很大。
+// 实例池按参数集合对实例做引用计数：参数完全相同的播放器共享同一个
+// libvlc_instance_t，最后一个使用者释放时才真正调用 libvlc_release。
+// 所有方法线程安全。
+
+class WVInstancePool {
+public:
+    /**
+     * 获取（或创建）与参数集合对应的共享实例，引用计数加一
+     * @param args libVLC 启动参数（顺序敏感，作为实例的键）
+     * @param created 可选，返回本次是否新建了实例
+     * @return 实例指针，libvlc_new 失败时返回 NULL
+     */
+    static libvlc_instance_t* Acquire(const std::vector<std::string>& args, bool* created = NULL);
+
+    /**
+     * 引用计数减一，归零时释放实例
+     * @param instance 由 Acquire 返回的实例
+     */
+    static void Release(libvlc_instance_t* instance);
+
+    /**
+     * 当前存活的实例数量（调试/统计用）
+     */
+    static size_t InstanceCount();
+};
+
+#endif // WV_INSTANCE_POOL_H
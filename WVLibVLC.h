@@ -0,0 +1,24 @@
+//
+//  WVLibVLC.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_LIBVLC_H
+#define WV_LIBVLC_H
+
+// 在包含 VLC 头文件之前，定义缺失的类型
+// 这是 VLC SDK 3.0.20 的一个已知问题的解决方案
+#if defined(_WIN32) && !defined(_SSIZE_T_DEFINED)
+#define _SSIZE_T_DEFINED
+#ifdef _WIN64
+typedef __int64 ssize_t;
+#else
+typedef int ssize_t;
+#endif
+#endif
+
+#include <vlc/vlc.h>
+
+#endif // WV_LIBVLC_H
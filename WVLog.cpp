@@ -0,0 +1,264 @@
+//
+//  WVLog.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVLog.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+
+const size_t kRingCapacity = 4096;        // 必须是 2 的幂
+const size_t kMaxMessageLength = 512;     // 超长消息会被截断
+
+struct LogEntry {
+    long long timestampUs;                // 系统时间（微秒）
+    int level;
+    unsigned long threadId;
+    char message[kMaxMessageLength];
+};
+
+// Vyukov 有界队列的槽位：sequence 标记槽位属于生产者还是消费者
+struct LogCell {
+    std::atomic<size_t> sequence;
+    LogEntry entry;
+};
+
+struct LogRing {
+    LogCell cells[kRingCapacity];
+
+    // 生产者与消费者的游标分别放在独立缓存行，避免伪共享
+    char pad0[64];
+    std::atomic<size_t> enqueuePos;
+    char pad1[64];
+    std::atomic<size_t> dequeuePos;
+    char pad2[64];
+
+    std::atomic<unsigned long long> dropped;
+    std::atomic<int> sinks;
+    std::atomic<bool> consumerIdle;
+
+    // 仅用于消费者休眠唤醒和文件目标配置，生产者写入路径不加锁
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::string filePath;
+    bool filePathChanged;
+
+    LogRing() : enqueuePos(0), dequeuePos(0), dropped(0),
+                sinks(WVLogSinkStderr | WVLogSinkDebugger), consumerIdle(false),
+                filePathChanged(false) {
+        for (size_t i = 0; i < kRingCapacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+};
+
+void ConsumerLoop(LogRing* ring);
+
+LogRing* Ring() {
+    // 进程生命周期内不释放，后台线程可以安全访问
+    static LogRing* ring = NULL;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        ring = new LogRing();
+        std::thread(ConsumerLoop, ring).detach();
+    });
+    return ring;
+}
+
+unsigned long CurrentThreadId() {
+#ifdef _WIN32
+    return GetCurrentThreadId();
+#else
+    return static_cast<unsigned long>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+}
+
+char LevelTag(int level) {
+    switch (level) {
+        case WVLogError: return 'E';
+        case WVLogWarning: return 'W';
+        case WVLogInfo: return 'I';
+        default: return 'D';
+    }
+}
+
+void FormatLine(const LogEntry& entry, char* line, size_t size) {
+    time_t seconds = static_cast<time_t>(entry.timestampUs / 1000000);
+    int millis = static_cast<int>((entry.timestampUs / 1000) % 1000);
+    struct tm local;
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    snprintf(line, size, "[WinVLCBridge] %02d:%02d:%02d.%03d [%c][%lu] %s\n",
+             local.tm_hour, local.tm_min, local.tm_sec, millis,
+             LevelTag(entry.level), entry.threadId, entry.message);
+}
+
+void WriteEntry(const LogEntry& entry, int sinks, FILE* file) {
+    char line[kMaxMessageLength + 64];
+    FormatLine(entry, line, sizeof(line));
+
+    if (sinks & WVLogSinkStderr) {
+        fputs(line, stderr);
+    }
+    if ((sinks & WVLogSinkFile) && file) {
+        fputs(line, file);
+    }
+#ifdef _WIN32
+    if (sinks & WVLogSinkDebugger) {
+        // 转换为宽字符输出到 Windows 调试器（避免 DebugView 中文乱码）
+        wchar_t wideLine[kMaxMessageLength + 64];
+        MultiByteToWideChar(CP_UTF8, 0, line, -1, wideLine, sizeof(wideLine) / sizeof(wideLine[0]));
+        OutputDebugStringW(wideLine);
+    }
+#endif
+}
+
+void ConsumerLoop(LogRing* ring) {
+    FILE* file = NULL;
+
+    for (;;) {
+        // 文件目标变更只在消费者线程上打开/关闭文件
+        {
+            std::lock_guard<std::mutex> lock(ring->mutex);
+            if (ring->filePathChanged) {
+                ring->filePathChanged = false;
+                if (file) {
+                    fclose(file);
+                    file = NULL;
+                }
+                if (!ring->filePath.empty()) {
+                    file = fopen(ring->filePath.c_str(), "a");
+                }
+            }
+        }
+
+        int sinks = ring->sinks.load(std::memory_order_relaxed);
+        size_t pos = ring->dequeuePos.load(std::memory_order_relaxed);
+        size_t drained = 0;
+
+        for (;;) {
+            LogCell& cell = ring->cells[pos & (kRingCapacity - 1)];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence != pos + 1) break;  // 空，或生产者尚未写完
+
+            WriteEntry(cell.entry, sinks, file);
+            cell.sequence.store(pos + kRingCapacity, std::memory_order_release);
+            ++pos;
+            ++drained;
+        }
+        ring->dequeuePos.store(pos, std::memory_order_release);
+
+        if (drained > 0) {
+            fflush(stderr);  // 按批刷新，而不是每条日志刷新一次
+            if (file) fflush(file);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(ring->mutex);
+        ring->consumerIdle.store(true);
+        ring->cond.wait_for(lock, std::chrono::milliseconds(50));
+        ring->consumerIdle.store(false);
+    }
+}
+
+} // namespace
+
+std::atomic<int> g_logLevel(WVLogInfo);
+
+void WVLogWriteV(WVLogLevel level, const char* format, va_list args) {
+    LogRing* ring = Ring();
+
+    // 申请槽位
+    size_t pos = ring->enqueuePos.load(std::memory_order_relaxed);
+    LogCell* cell = NULL;
+    for (;;) {
+        cell = &ring->cells[pos & (kRingCapacity - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (ring->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 缓冲区已满，丢弃
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = ring->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // 直接格式化到槽位中，避免额外拷贝
+    LogEntry& entry = cell->entry;
+    entry.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    entry.level = level;
+    entry.threadId = CurrentThreadId();
+    vsnprintf(entry.message, sizeof(entry.message), format, args);
+
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    if (ring->consumerIdle.load(std::memory_order_relaxed)) {
+        ring->cond.notify_one();
+    }
+}
+
+void WVLogWrite(WVLogLevel level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    WVLogWriteV(level, format, args);
+    va_end(args);
+}
+
+void WVLogSetLevel(int level) {
+    if (level < WVLogError) level = WVLogError;
+    if (level > WVLogDebug) level = WVLogDebug;
+    g_logLevel.store(level, std::memory_order_relaxed);
+}
+
+void WVLogSetSinks(int sinks, const char* filePath) {
+    LogRing* ring = Ring();
+    {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        if (filePath) {
+            ring->filePath = filePath;
+            ring->filePathChanged = true;
+        }
+    }
+    ring->sinks.store(sinks);
+    ring->cond.notify_one();
+}
+
+unsigned long long WVLogDroppedCount() {
+    return Ring()->dropped.load(std::memory_order_relaxed);
+}
+
+void WVLogFlush(int timeoutMs) {
+    LogRing* ring = Ring();
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    size_t target = ring->enqueuePos.load(std::memory_order_acquire);
+    while (ring->dequeuePos.load(std::memory_order_acquire) < target &&
+           std::chrono::steady_clock::now() < deadline) {
+        ring->cond.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
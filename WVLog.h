@@ -0,0 +1,104 @@
+//
+//  WVLog.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_LOG_H
+#define WV_LOG_H
+
+#include <atomic>
+#include <stdarg.h>
+
+// ==================== 日志 ====================
+//
+// 调用线程只做格式化并写入无锁环形缓冲区（多生产者单消费者），
+// 由后台线程统一输出到各个目标（stderr、文件、Windows 调试器）。
+// 缓冲区满时丢弃新日志并计数，调用方永远不会被 I/O 阻塞。
+
+enum WVLogLevel {
+    WVLogError = 0,
+    WVLogWarning = 1,
+    WVLogInfo = 2,
+    WVLogDebug = 3
+};
+
+// 编译期日志级别：高于该级别的日志宏展开为死代码（if (0)），参数不会被求值，
+// 但仍参与类型检查，避免仅用于日志的变量产生未使用警告。
+// 未指定时 Release（NDEBUG）保留到 Info，Debug 构建保留全部
+#ifndef WV_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define WV_LOG_COMPILE_LEVEL 2
+#else
+#define WV_LOG_COMPILE_LEVEL 3
+#endif
+#endif
+
+// 运行期日志级别（默认 Info），高于该级别的日志在格式化之前直接返回
+extern std::atomic<int> g_logLevel;
+
+#define WV_LOG_AT(level, ...) \
+    do { \
+        if ((level) <= g_logLevel.load(std::memory_order_relaxed)) { \
+            WVLogWrite((level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define WV_LOG_ERROR(...) WV_LOG_AT(WVLogError, __VA_ARGS__)
+
+#if WV_LOG_COMPILE_LEVEL >= 1
+#define WV_LOG_WARN(...) WV_LOG_AT(WVLogWarning, __VA_ARGS__)
+#else
+#define WV_LOG_WARN(...) do { if (0) WVLogWrite(WVLogWarning, __VA_ARGS__); } while (0)
+#endif
+
+#if WV_LOG_COMPILE_LEVEL >= 2
+#define WV_LOG_INFO(...) WV_LOG_AT(WVLogInfo, __VA_ARGS__)
+#else
+#define WV_LOG_INFO(...) do { if (0) WVLogWrite(WVLogInfo, __VA_ARGS__); } while (0)
+#endif
+
+#if WV_LOG_COMPILE_LEVEL >= 3
+#define WV_LOG_DEBUG(...) WV_LOG_AT(WVLogDebug, __VA_ARGS__)
+#else
+#define WV_LOG_DEBUG(...) do { if (0) WVLogWrite(WVLogDebug, __VA_ARGS__); } while (0)
+#endif
+
+// 输出目标（可组合）
+enum WVLogSink {
+    WVLogSinkStderr = 1,
+    WVLogSinkFile = 2,
+    WVLogSinkDebugger = 4
+};
+
+/**
+ * 写入一条日志（格式化后入队，立即返回）。不检查级别，业务代码应使用 WV_LOG_* 宏
+ */
+void WVLogWrite(WVLogLevel level, const char* format, ...);
+void WVLogWriteV(WVLogLevel level, const char* format, va_list args);
+
+/**
+ * 设置运行期日志级别（WVLogLevel）
+ */
+void WVLogSetLevel(int level);
+
+/**
+ * 设置输出目标
+ * @param sinks WVLogSink 组合
+ * @param filePath 文件目标路径（追加写入），为 NULL 时保持原路径
+ */
+void WVLogSetSinks(int sinks, const char* filePath);
+
+/**
+ * 因缓冲区满而丢弃的日志条数
+ */
+unsigned long long WVLogDroppedCount();
+
+/**
+ * 等待后台线程输出完缓冲区中的日志
+ * @param timeoutMs 最长等待时间
+ */
+void WVLogFlush(int timeoutMs);
+
+#endif // WV_LOG_H
@@ -0,0 +1,69 @@
+//
+//  WVMediaClock.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVMediaClock.h"
+#include <chrono>
+
+namespace {
+
+// 采样与外推值相差超过该值时直接跳到采样值（seek、卡顿恢复），否则只做小幅修正，
+// 避免 TimeChanged 事件的抖动让覆盖层前后跳动
+const int64_t kResyncThresholdMs = 40;
+const int64_t kCorrectionDivisor = 8;
+
+int64_t MonotonicMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+WVMediaClock::WVMediaClock() : anchorMediaMs(-1), anchorMicros(0), playing(false) {
+}
+
+void WVMediaClock::Reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    anchorMediaMs = -1;
+    anchorMicros = 0;
+    playing = false;
+}
+
+int64_t WVMediaClock::PredictLocked(int64_t nowUs) const {
+    if (anchorMediaMs < 0) return -1;
+    if (!playing) return anchorMediaMs;
+    return anchorMediaMs + (nowUs - anchorMicros) / 1000;
+}
+
+void WVMediaClock::OnTimeChanged(int64_t mediaTimeMs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int64_t nowUs = MonotonicMicros();
+    int64_t predicted = PredictLocked(nowUs);
+    int64_t error = mediaTimeMs - predicted;
+
+    if (predicted < 0 || !playing || error > kResyncThresholdMs || error < -kResyncThresholdMs) {
+        anchorMediaMs = mediaTimeMs;
+    } else {
+        anchorMediaMs = predicted + error / kCorrectionDivisor;
+    }
+    anchorMicros = nowUs;
+}
+
+void WVMediaClock::SetPlaying(bool isPlaying) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (playing == isPlaying) return;
+
+    int64_t nowUs = MonotonicMicros();
+    // 暂停时冻结在外推值，恢复时从当前时刻继续外推
+    anchorMediaMs = PredictLocked(nowUs);
+    anchorMicros = nowUs;
+    playing = isPlaying;
+}
+
+int64_t WVMediaClock::NowMs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return PredictLocked(MonotonicMicros());
+}
@@ -0,0 +1,54 @@
+//
+//  WVMediaClock.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_MEDIA_CLOCK_H
+#define WV_MEDIA_CLOCK_H
+
+#include <mutex>
+#include <stdint.h>
+
+// ==================== 媒体时钟 ====================
+//
+// 由 libvlc_MediaPlayerTimeChanged / Playing / Paused 事件驱动的播放时间估计。
+// 事件只是稀疏的采样点，两次事件之间按单调时钟外推，读取时不调用任何 libVLC 函数，
+// 因此可以在 UI 线程或 VLC 的显示回调中安全使用（libvlc_media_player_get_time
+// 会获取播放器锁，stop 期间可能被阻塞）。
+
+class WVMediaClock {
+public:
+    WVMediaClock();
+
+    /**
+     * 新媒体开始前清空状态
+     */
+    void Reset();
+
+    /**
+     * TimeChanged 事件（VLC 事件线程）
+     */
+    void OnTimeChanged(int64_t mediaTimeMs);
+
+    /**
+     * Playing / Paused / Stopped 事件（VLC 事件线程）
+     */
+    void SetPlaying(bool playing);
+
+    /**
+     * 当前播放时间（毫秒），尚无采样时返回 -1
+     */
+    int64_t NowMs() const;
+
+private:
+    int64_t PredictLocked(int64_t nowUs) const;
+
+    mutable std::mutex mutex;
+    int64_t anchorMediaMs;     // 最近一次校准的媒体时间，-1 表示无
+    int64_t anchorMicros;      // 校准时的单调时钟
+    bool playing;
+};
+
+#endif // WV_MEDIA_CLOCK_H
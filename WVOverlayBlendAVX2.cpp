@@ -0,0 +1,90 @@
+//
+//  WVOverlayBlendAVX2.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayBlendKernels.h"
+
+#ifdef WV_OVERLAY_X86
+
+#include <immintrin.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WV_TARGET_AVX2
+#endif
+
+namespace {
+
+// 与 SSE2 版本相同，每次处理 8 个像素；unpack/pack 都在 128 位通道内进行，顺序互相抵消
+
+WV_TARGET_AVX2 inline __m256i Div255(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+WV_TARGET_AVX2 inline __m256i Over(__m256i dst16, __m256i src16, __m256i inverse16) {
+    return _mm256_add_epi16(src16, Div255(_mm256_mullo_epi16(dst16, inverse16)));
+}
+
+WV_TARGET_AVX2 inline __m256i BroadcastAlpha(__m256i pixels16) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)),
+                                  _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+} // namespace
+
+WV_TARGET_AVX2 void WVBlendSolidRowAVX2(uint32_t* row, int count, uint32_t color) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), zero);
+    const __m256i inverse = _mm256_set1_epi16(static_cast<short>(255 - (color >> 24)));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(row + i);
+        __m256i dst = _mm256_loadu_si256(p);
+        __m256i lo = Over(_mm256_unpacklo_epi8(dst, zero), src, inverse);
+        __m256i hi = Over(_mm256_unpackhi_epi8(dst, zero), src, inverse);
+        _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+    }
+    if (i < count) {
+        WVBlendSolidRowScalar(row + i, count - i, color);
+    }
+    _mm256_zeroupper();
+}
+
+WV_TARGET_AVX2 void WVBlendMaskRowAVX2(uint32_t* row, const uint8_t* mask, int count, uint32_t color) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi16(255);
+    const __m256i color16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), zero);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        long long coverage;
+        memcpy(&coverage, mask + i, 8);
+        if (coverage == 0) continue;
+
+        __m256i m = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i)));
+        m = _mm256_or_si256(m, _mm256_slli_epi32(m, 8));
+        m = _mm256_or_si256(m, _mm256_slli_epi32(m, 16));
+
+        __m256i srcLo = Div255(_mm256_mullo_epi16(color16, _mm256_unpacklo_epi8(m, zero)));
+        __m256i srcHi = Div255(_mm256_mullo_epi16(color16, _mm256_unpackhi_epi8(m, zero)));
+
+        __m256i* p = reinterpret_cast<__m256i*>(row + i);
+        __m256i dst = _mm256_loadu_si256(p);
+        __m256i lo = Over(_mm256_unpacklo_epi8(dst, zero), srcLo, _mm256_sub_epi16(full, BroadcastAlpha(srcLo)));
+        __m256i hi = Over(_mm256_unpackhi_epi8(dst, zero), srcHi, _mm256_sub_epi16(full, BroadcastAlpha(srcHi)));
+        _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+    }
+    if (i < count) {
+        WVBlendMaskRowScalar(row + i, mask + i, count - i, color);
+    }
+    _mm256_zeroupper();
+}
+
+#endif // WV_OVERLAY_X86
@@ -0,0 +1,38 @@
+//
+//  WVOverlayBlendKernels.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_OVERLAY_BLEND_KERNELS_H
+#define WV_OVERLAY_BLEND_KERNELS_H
+
+#include <stdint.h>
+
+// 覆盖层混合的行级实现，仅供 WVOverlayRaster.cpp / WVOverlayBlend*.cpp 内部使用。
+// 颜色均为合法的预乘 alpha BGRA（各通道不大于 alpha），按 source-over 混合：dst = src + dst * (255 - srcA) / 255，
+// 除以 255 统一使用 ((x + 128) + ((x + 128) >> 8)) >> 8，各实现输出逐字节一致。
+// SIMD 版本处理对齐部分后用标量版本处理行尾。
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define WV_OVERLAY_X86 1
+#endif
+
+// 单色混合一行（调用方已处理 alpha 为 0 / 255 的情况）
+typedef void (*WVBlendSolidRowFunc)(uint32_t* row, int count, uint32_t color);
+
+// 按 8 位覆盖率混合一行：src = color * mask / 255
+typedef void (*WVBlendMaskRowFunc)(uint32_t* row, const uint8_t* mask, int count, uint32_t color);
+
+void WVBlendSolidRowScalar(uint32_t* row, int count, uint32_t color);
+void WVBlendMaskRowScalar(uint32_t* row, const uint8_t* mask, int count, uint32_t color);
+
+#ifdef WV_OVERLAY_X86
+void WVBlendSolidRowSSE2(uint32_t* row, int count, uint32_t color);
+void WVBlendMaskRowSSE2(uint32_t* row, const uint8_t* mask, int count, uint32_t color);
+void WVBlendSolidRowAVX2(uint32_t* row, int count, uint32_t color);
+void WVBlendMaskRowAVX2(uint32_t* row, const uint8_t* mask, int count, uint32_t color);
+#endif
+
+#endif // WV_OVERLAY_BLEND_KERNELS_H
@@ -0,0 +1,89 @@
+//
+//  WVOverlayBlendSSE2.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayBlendKernels.h"
+
+#ifdef WV_OVERLAY_X86
+
+#include <emmintrin.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WV_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define WV_TARGET_SSE2
+#endif
+
+namespace {
+
+// 8 个 16 位值除以 255（输入不超过 255 * 255）
+WV_TARGET_SSE2 inline __m128i Div255(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// src16 / inverse16 为两个像素展开成的 16 位通道
+WV_TARGET_SSE2 inline __m128i Over(__m128i dst16, __m128i src16, __m128i inverse16) {
+    return _mm_add_epi16(src16, Div255(_mm_mullo_epi16(dst16, inverse16)));
+}
+
+// 每个 16 位通道替换为所在像素的 alpha
+WV_TARGET_SSE2 inline __m128i BroadcastAlpha(__m128i pixels16) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+} // namespace
+
+WV_TARGET_SSE2 void WVBlendSolidRowSSE2(uint32_t* row, int count, uint32_t color) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+    const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - (color >> 24)));
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(row + i);
+        __m128i dst = _mm_loadu_si128(p);
+        __m128i lo = Over(_mm_unpacklo_epi8(dst, zero), src, inverse);
+        __m128i hi = Over(_mm_unpackhi_epi8(dst, zero), src, inverse);
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    if (i < count) {
+        WVBlendSolidRowScalar(row + i, count - i, color);
+    }
+}
+
+WV_TARGET_SSE2 void WVBlendMaskRowSSE2(uint32_t* row, const uint8_t* mask, int count, uint32_t color) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int coverage;
+        memcpy(&coverage, mask + i, 4);
+        if (coverage == 0) continue;
+
+        // 4 个覆盖率各自复制到所在像素的 4 个字节，再与像素一样展开为 16 位
+        __m128i m = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(coverage), zero), zero);
+        m = _mm_or_si128(m, _mm_slli_epi32(m, 8));
+        m = _mm_or_si128(m, _mm_slli_epi32(m, 16));
+
+        __m128i srcLo = Div255(_mm_mullo_epi16(color16, _mm_unpacklo_epi8(m, zero)));
+        __m128i srcHi = Div255(_mm_mullo_epi16(color16, _mm_unpackhi_epi8(m, zero)));
+
+        __m128i* p = reinterpret_cast<__m128i*>(row + i);
+        __m128i dst = _mm_loadu_si128(p);
+        __m128i lo = Over(_mm_unpacklo_epi8(dst, zero), srcLo, _mm_sub_epi16(full, BroadcastAlpha(srcLo)));
+        __m128i hi = Over(_mm_unpackhi_epi8(dst, zero), srcHi, _mm_sub_epi16(full, BroadcastAlpha(srcHi)));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    if (i < count) {
+        WVBlendMaskRowScalar(row + i, mask + i, count - i, color);
+    }
+}
+
+#endif // WV_OVERLAY_X86
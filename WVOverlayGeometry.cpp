@@ -0,0 +1,480 @@
+//
+//  WVOverlayGeometry.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayGeometry.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+// 每个像素行的子扫描线数；每条子扫描线对完整覆盖的像素贡献 64（4 条合计 256，截断为 255）
+const int kSubScanlines = 4;
+const int kSubScanlineWeight = 64;
+
+const int kMaxPolygonPoints = 4096;
+const int kMaxMaskSide = 4096;
+
+// 单个播放器蒙版存储的上限
+const size_t kMaxStoredMasks = 1024;
+const size_t kMaxStoredBytes = 64 * 1024 * 1024;
+
+// 八边形近似圆角连接
+const int kJoinSegments = 8;
+
+struct Edge {
+    float x0;
+    float y0;
+    float y1;
+    float dxdy;
+    int winding;
+
+    bool operator<(const Edge& other) const { return y0 < other.y0; }
+};
+
+struct Crossing {
+    float x;
+    int winding;
+
+    bool operator<(const Crossing& other) const { return x < other.x; }
+};
+
+// 子扫描线上 [a, b) 区间（相对位图左边界）计入累加行：两端的部分像素直接累加，
+// 中间的完整像素记在差分数组里，整行结束后一次前缀和
+void AddSpan(std::vector<int>& partial, std::vector<int>& delta, float a, float b, int width) {
+    if (a < 0.0f) a = 0.0f;
+    if (b > static_cast<float>(width)) b = static_cast<float>(width);
+    if (a >= b) return;
+
+    int ia = static_cast<int>(a);
+    int ib = static_cast<int>(b);
+    if (ia == ib) {
+        partial[ia] += static_cast<int>((b - a) * kSubScanlineWeight + 0.5f);
+        return;
+    }
+    partial[ia] += static_cast<int>((ia + 1 - a) * kSubScanlineWeight + 0.5f);
+    delta[ia + 1] += kSubScanlineWeight;
+    delta[ib] -= kSubScanlineWeight;
+    if (ib < width) {
+        partial[ib] += static_cast<int>((b - ib) * kSubScanlineWeight + 0.5f);
+    }
+}
+
+float SignedArea(const std::vector<WVOverlayPoint>& contour) {
+    float area = 0.0f;
+    for (size_t i = 0, j = contour.size() - 1; i < contour.size(); j = i++) {
+        area += contour[j].x * contour[i].y - contour[i].x * contour[j].y;
+    }
+    return area * 0.5f;
+}
+
+// 描边轮廓统一为正方向，非零规则下重叠部分只计一次
+void PushOriented(std::vector<WVOverlayPoint>& contour, std::vector<std::vector<WVOverlayPoint> >* out) {
+    if (SignedArea(contour) < 0.0f) std::reverse(contour.begin(), contour.end());
+    out->push_back(contour);
+}
+
+inline bool Finite(float value) {
+    return value == value && value > -1e30f && value < 1e30f;
+}
+
+// 积分图中某个位置的采样点：下标与小数部分（在 index 与 index + 1 之间线性插值）
+struct SamplePoint {
+    int index;
+    double fraction;
+};
+
+SamplePoint MakeSample(double position, int size) {
+    SamplePoint sample;
+    sample.index = static_cast<int>(position);
+    if (sample.index >= size) sample.index = size - 1;
+    sample.fraction = position - sample.index;
+    return sample;
+}
+
+inline double Clamp(double value, double low, double high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+} // namespace
+
+bool WVRasterizeContours(const std::vector<std::vector<WVOverlayPoint> >& contours, bool nonZero,
+                         int clipWidth, int clipHeight, WVCoverageBitmap* out) {
+    std::vector<Edge> edges;
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    bool first = true;
+    for (size_t c = 0; c < contours.size(); ++c) {
+        const std::vector<WVOverlayPoint>& contour = contours[c];
+        for (size_t i = 0, j = contour.size() - 1; i < contour.size(); j = i++) {
+            const WVOverlayPoint& p = contour[j];
+            const WVOverlayPoint& q = contour[i];
+            if (first) {
+                minX = maxX = q.x;
+                minY = maxY = q.y;
+                first = false;
+            }
+            minX = std::min(minX, q.x);
+            maxX = std::max(maxX, q.x);
+            minY = std::min(minY, q.y);
+            maxY = std::max(maxY, q.y);
+            if (p.y == q.y) continue;   // 水平边不与扫描线相交
+
+            Edge edge;
+            bool down = q.y > p.y;
+            const WVOverlayPoint& top = down ? p : q;
+            const WVOverlayPoint& bottom = down ? q : p;
+            edge.x0 = top.x;
+            edge.y0 = top.y;
+            edge.y1 = bottom.y;
+            edge.dxdy = (bottom.x - top.x) / (bottom.y - top.y);
+            edge.winding = down ? 1 : -1;
+            edges.push_back(edge);
+        }
+    }
+    if (edges.empty()) return false;
+
+    int x0 = std::max(0, static_cast<int>(floorf(minX)));
+    int y0 = std::max(0, static_cast<int>(floorf(minY)));
+    int x1 = std::min(clipWidth, static_cast<int>(ceilf(maxX)));
+    int y1 = std::min(clipHeight, static_cast<int>(ceilf(maxY)));
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    out->x = x0;
+    out->y = y0;
+    out->width = x1 - x0;
+    out->height = y1 - y0;
+    out->coverage.assign(static_cast<size_t>(out->width) * out->height, 0);
+
+    std::vector<int> partial(out->width + 1);
+    std::vector<int> delta(out->width + 1);
+    std::vector<Crossing> crossings;
+    bool any = false;
+
+    // 活动边表：边按上端排序，子扫描线下移时加入新的边、移除已经结束的边，
+    // 每条子扫描线只计算与它相交的边（描边展开后边数是顶点数的十几倍）
+    std::sort(edges.begin(), edges.end());
+    std::vector<const Edge*> active;
+    size_t next = 0;
+
+    for (int row = y0; row < y1; ++row) {
+        std::fill(partial.begin(), partial.end(), 0);
+        std::fill(delta.begin(), delta.end(), 0);
+
+        for (int sub = 0; sub < kSubScanlines; ++sub) {
+            float sy = row + (sub + 0.5f) / kSubScanlines;
+            while (next < edges.size() && edges[next].y0 <= sy) {
+                active.push_back(&edges[next++]);
+            }
+            crossings.clear();
+            size_t kept = 0;
+            for (size_t e = 0; e < active.size(); ++e) {
+                const Edge& edge = *active[e];
+                if (sy >= edge.y1) continue;
+                active[kept++] = active[e];
+                Crossing crossing = { edge.x0 + (sy - edge.y0) * edge.dxdy - x0, edge.winding };
+                crossings.push_back(crossing);
+            }
+            active.resize(kept);
+            std::sort(crossings.begin(), crossings.end());
+
+            int winding = 0;
+            for (size_t k = 0; k + 1 < crossings.size(); ++k) {
+                winding += nonZero ? crossings[k].winding : 1;
+                bool inside = nonZero ? winding != 0 : (winding & 1) != 0;
+                if (inside) {
+                    AddSpan(partial, delta, crossings[k].x, crossings[k + 1].x, out->width);
+                }
+            }
+        }
+
+        uint8_t* dst = &out->coverage[static_cast<size_t>(row - y0) * out->width];
+        int running = 0;
+        for (int x = 0; x < out->width; ++x) {
+            running += delta[x];
+            int value = running + partial[x];
+            if (value > 0) {
+                dst[x] = static_cast<uint8_t>(value > 255 ? 255 : value);
+                any = true;
+            }
+        }
+    }
+    return any;
+}
+
+void WVStrokeContours(const std::vector<WVOverlayPoint>& polygon, float lineWidth,
+                      std::vector<std::vector<WVOverlayPoint> >* out) {
+    float half = lineWidth * 0.5f;
+    if (!(half > 0.0f)) return;
+
+    std::vector<WVOverlayPoint> contour;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const WVOverlayPoint& p = polygon[i];
+        const WVOverlayPoint& q = polygon[(i + 1) % polygon.size()];
+
+        // 线段展开为矩形
+        float dx = q.x - p.x;
+        float dy = q.y - p.y;
+        float length = sqrtf(dx * dx + dy * dy);
+        if (length > 1e-4f) {
+            float nx = -dy / length * half;
+            float ny = dx / length * half;
+            WVOverlayPoint quad[4] = { { p.x + nx, p.y + ny }, { q.x + nx, q.y + ny },
+                                       { q.x - nx, q.y - ny }, { p.x - nx, p.y - ny } };
+            contour.assign(quad, quad + 4);
+            PushOriented(contour, out);
+        }
+
+        // 顶点处的连接
+        contour.clear();
+        for (int k = 0; k < kJoinSegments; ++k) {
+            float angle = (k + 0.5f) * 6.2831853f / kJoinSegments;
+            WVOverlayPoint point = { p.x + cosf(angle) * half, p.y + sinf(angle) * half };
+            contour.push_back(point);
+        }
+        PushOriented(contour, out);
+    }
+}
+
+WVOverlayGeometry::WVOverlayGeometry() : maskWidth(0), maskHeight(0) {
+    fillCache.clipWidth = -1;
+    strokeCache.clipWidth = -1;
+}
+
+std::shared_ptr<const WVOverlayGeometry> WVOverlayGeometry::CreatePolygon(const float* coordinates, int count,
+                                                                          float* boxX, float* boxY,
+                                                                          float* boxWidth, float* boxHeight) {
+    if (count < 3 || count > kMaxPolygonPoints) return std::shared_ptr<const WVOverlayGeometry>();
+
+    float minX = coordinates[0], maxX = coordinates[0];
+    float minY = coordinates[1], maxY = coordinates[1];
+    for (int i = 0; i < count; ++i) {
+        float x = coordinates[i * 2];
+        float y = coordinates[i * 2 + 1];
+        if (!Finite(x) || !Finite(y)) return std::shared_ptr<const WVOverlayGeometry>();
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    std::shared_ptr<WVOverlayGeometry> geometry(new WVOverlayGeometry());
+    float width = maxX - minX;
+    float height = maxY - minY;
+    geometry->points.resize(count);
+    for (int i = 0; i < count; ++i) {
+        geometry->points[i].x = width > 0.0f ? (coordinates[i * 2] - minX) / width : 0.0f;
+        geometry->points[i].y = height > 0.0f ? (coordinates[i * 2 + 1] - minY) / height : 0.0f;
+    }
+    *boxX = minX;
+    *boxY = minY;
+    *boxWidth = width;
+    *boxHeight = height;
+    return geometry;
+}
+
+std::shared_ptr<const WVOverlayGeometry> WVOverlayGeometry::CreateMask(int width, int height,
+                                                                       const uint32_t* runs, size_t runCount) {
+    if (width <= 0 || height <= 0 || width > kMaxMaskSide || height > kMaxMaskSide) {
+        return std::shared_ptr<const WVOverlayGeometry>();
+    }
+    uint64_t total = 0;
+    for (size_t i = 0; i < runCount; ++i) {
+        total += runs[i];
+    }
+    if (total > static_cast<uint64_t>(width) * height) return std::shared_ptr<const WVOverlayGeometry>();
+
+    std::shared_ptr<WVOverlayGeometry> geometry(new WVOverlayGeometry());
+    geometry->maskWidth = width;
+    geometry->maskHeight = height;
+    geometry->runs.assign(runs, runs + runCount);
+    return geometry;
+}
+
+bool WVOverlayGeometry::SamePolygon(const WVOverlayGeometry& other) const {
+    if (IsMask() || other.IsMask() || points.size() != other.points.size()) return false;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].x != other.points[i].x || points[i].y != other.points[i].y) return false;
+    }
+    return true;
+}
+
+size_t WVOverlayGeometry::ByteSize() const {
+    return points.size() * sizeof(WVOverlayPoint) + runs.size() * sizeof(uint32_t);
+}
+
+void WVOverlayGeometry::Polygon(float x, float y, float width, float height, std::vector<WVOverlayPoint>* out) const {
+    out->resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        (*out)[i].x = x + points[i].x * width;
+        (*out)[i].y = y + points[i].y * height;
+    }
+}
+
+bool WVOverlayGeometry::CacheHit(const CacheSlot& slot, const float key[5], int clipWidth, int clipHeight) {
+    if (slot.clipWidth != clipWidth || slot.clipHeight != clipHeight) return false;
+    for (int i = 0; i < 5; ++i) {
+        if (slot.key[i] != key[i]) return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const WVCoverageBitmap> WVOverlayGeometry::RenderFill(float x, float y, float width, float height,
+                                                                      bool nonZero, int clipWidth,
+                                                                      int clipHeight) const {
+    float key[5] = { x, y, width, height, nonZero ? 1.0f : 0.0f };
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (CacheHit(fillCache, key, clipWidth, clipHeight)) return fillCache.bitmap;
+
+    std::shared_ptr<WVCoverageBitmap> bitmap = std::make_shared<WVCoverageBitmap>();
+    bool drawn;
+    if (IsMask()) {
+        drawn = RenderMask(x, y, width, height, clipWidth, clipHeight, bitmap.get());
+    } else {
+        std::vector<std::vector<WVOverlayPoint> > contours(1);
+        Polygon(x, y, width, height, &contours[0]);
+        drawn = WVRasterizeContours(contours, nonZero, clipWidth, clipHeight, bitmap.get());
+    }
+
+    std::copy(key, key + 5, fillCache.key);
+    fillCache.clipWidth = clipWidth;
+    fillCache.clipHeight = clipHeight;
+    fillCache.bitmap = drawn ? bitmap : std::shared_ptr<WVCoverageBitmap>();
+    return fillCache.bitmap;
+}
+
+std::shared_ptr<const WVCoverageBitmap> WVOverlayGeometry::RenderStroke(float x, float y, float width, float height,
+                                                                        float lineWidth, int clipWidth,
+                                                                        int clipHeight) const {
+    if (IsMask()) return std::shared_ptr<const WVCoverageBitmap>();
+
+    float key[5] = { x, y, width, height, lineWidth };
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (CacheHit(strokeCache, key, clipWidth, clipHeight)) return strokeCache.bitmap;
+
+    std::vector<WVOverlayPoint> polygon;
+    Polygon(x, y, width, height, &polygon);
+    std::vector<std::vector<WVOverlayPoint> > contours;
+    WVStrokeContours(polygon, lineWidth, &contours);
+
+    std::shared_ptr<WVCoverageBitmap> bitmap = std::make_shared<WVCoverageBitmap>();
+    bool drawn = WVRasterizeContours(contours, true, clipWidth, clipHeight, bitmap.get());
+
+    std::copy(key, key + 5, strokeCache.key);
+    strokeCache.clipWidth = clipWidth;
+    strokeCache.clipHeight = clipHeight;
+    strokeCache.bitmap = drawn ? bitmap : std::shared_ptr<WVCoverageBitmap>();
+    return strokeCache.bitmap;
+}
+
+bool WVOverlayGeometry::RenderMask(float x, float y, float width, float height, int clipWidth, int clipHeight,
+                                   WVCoverageBitmap* out) const {
+    if (!(width > 0.0f) || !(height > 0.0f) || !Finite(x) || !Finite(y)) return false;
+
+    int x0 = std::max(0, static_cast<int>(floorf(x)));
+    int y0 = std::max(0, static_cast<int>(floorf(y)));
+    int x1 = std::min(clipWidth, static_cast<int>(ceilf(x + width)));
+    int y1 = std::min(clipHeight, static_cast<int>(ceilf(y + height)));
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    // 解码游程并建立积分图（每个源像素计 1，第 0 行、第 0 列为 0）
+    size_t stride = static_cast<size_t>(maskWidth) + 1;
+    std::vector<uint8_t> bits(static_cast<size_t>(maskWidth) * maskHeight, 0);
+    size_t offset = 0;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        if ((i & 1) && runs[i] > 0) memset(&bits[offset], 1, runs[i]);
+        offset += runs[i];
+    }
+    std::vector<uint32_t> sat(stride * (maskHeight + 1), 0);
+    for (int row = 0; row < maskHeight; ++row) {
+        const uint8_t* src = &bits[static_cast<size_t>(row) * maskWidth];
+        const uint32_t* above = &sat[row * stride];
+        uint32_t* current = &sat[(row + 1) * stride];
+        uint32_t rowSum = 0;
+        for (int col = 0; col < maskWidth; ++col) {
+            rowSum += src[col];
+            current[col + 1] = above[col + 1] + rowSum;
+        }
+    }
+
+    out->x = x0;
+    out->y = y0;
+    out->width = x1 - x0;
+    out->height = y1 - y0;
+    out->coverage.assign(static_cast<size_t>(out->width) * out->height, 0);
+
+    // 每个目标像素覆盖的源区域取平均。积分图在采样点之间双线性插值，对分段常数的源图像
+    // 即为精确的面积积分；按行先在 v 方向求出 [v0, v1) 的列积分，再按列做差，每个像素只剩一次插值
+    double scaleX = maskWidth / static_cast<double>(width);
+    double scaleY = maskHeight / static_cast<double>(height);
+    double footprint = scaleX * scaleY;
+    std::vector<SamplePoint> columns(out->width + 1);
+    for (int col = x0; col <= x1; ++col) {
+        columns[col - x0] = MakeSample(Clamp((col - x) * scaleX, 0.0, maskWidth), maskWidth);
+    }
+    std::vector<double> band(stride);
+    std::vector<double> edges(out->width + 1);
+    bool any = false;
+    for (int row = y0; row < y1; ++row) {
+        SamplePoint top = MakeSample(Clamp((row - y) * scaleY, 0.0, maskHeight), maskHeight);
+        SamplePoint bottom = MakeSample(Clamp((row + 1 - y) * scaleY, 0.0, maskHeight), maskHeight);
+        const uint32_t* top0 = &sat[top.index * stride];
+        const uint32_t* top1 = top0 + stride;
+        const uint32_t* bottom0 = &sat[bottom.index * stride];
+        const uint32_t* bottom1 = bottom0 + stride;
+        for (size_t i = 0; i < stride; ++i) {
+            double upper = top0[i] + (static_cast<double>(top1[i]) - top0[i]) * top.fraction;
+            double lower = bottom0[i] + (static_cast<double>(bottom1[i]) - bottom0[i]) * bottom.fraction;
+            band[i] = lower - upper;
+        }
+        for (size_t k = 0; k < columns.size(); ++k) {
+            const SamplePoint& column = columns[k];
+            edges[k] = band[column.index] + (band[column.index + 1] - band[column.index]) * column.fraction;
+        }
+
+        uint8_t* dst = &out->coverage[static_cast<size_t>(row - y0) * out->width];
+        for (int k = 0; k < out->width; ++k) {
+            int value = static_cast<int>((edges[k + 1] - edges[k]) / footprint * 255.0 + 0.5);
+            if (value > 0) {
+                dst[k] = static_cast<uint8_t>(value > 255 ? 255 : value);
+                any = true;
+            }
+        }
+    }
+    return any;
+}
+
+WVOverlayMaskStore::WVOverlayMaskStore() : totalBytes(0) {
+}
+
+bool WVOverlayMaskStore::Upload(uint32_t maskId, int width, int height, const uint32_t* runs, size_t runCount) {
+    std::shared_ptr<const WVOverlayGeometry> mask = WVOverlayGeometry::CreateMask(width, height, runs, runCount);
+    if (!mask) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<uint32_t, std::shared_ptr<const WVOverlayGeometry> >::iterator it = masks.find(maskId);
+    size_t replaced = it != masks.end() ? it->second->ByteSize() : 0;
+    if (it == masks.end() && masks.size() >= kMaxStoredMasks) return false;
+    if (totalBytes - replaced + mask->ByteSize() > kMaxStoredBytes) return false;
+
+    totalBytes = totalBytes - replaced + mask->ByteSize();
+    masks[maskId] = mask;
+    return true;
+}
+
+void WVOverlayMaskStore::Release(uint32_t maskId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<uint32_t, std::shared_ptr<const WVOverlayGeometry> >::iterator it = masks.find(maskId);
+    if (it == masks.end()) return;
+    totalBytes -= it->second->ByteSize();
+    masks.erase(it);
+}
+
+std::shared_ptr<const WVOverlayGeometry> WVOverlayMaskStore::Find(uint32_t maskId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<uint32_t, std::shared_ptr<const WVOverlayGeometry> >::const_iterator it = masks.find(maskId);
+    return it != masks.end() ? it->second : std::shared_ptr<const WVOverlayGeometry>();
+}
@@ -0,0 +1,144 @@
+//
+//  WVOverlayGeometry.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_OVERLAY_GEOMETRY_H
+#define WV_OVERLAY_GEOMETRY_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+// ==================== 覆盖层多边形与分割蒙版 ====================
+//
+// 区域多边形和逐目标分割蒙版先转换为 8 位覆盖率位图，再用覆盖率混合内核合成。
+//   - 多边形：扫描线光栅化，每个像素行 4 条子扫描线，水平方向按交点位置精确累计覆盖率，
+//     支持奇偶与非零两种填充规则；描边展开为每段一个矩形、每个顶点一个八边形的轮廓，
+//     按非零规则一次光栅化，重叠处不会重复混合。
+//   - 蒙版：行优先的二值游程编码，按 ID 上传一次，之后的命令只引用 ID；
+//     缩放到目标外框时按每个目标像素覆盖的源面积取平均（积分图），边缘自然抗锯齿。
+// 几何对象不可变，顶点按外框归一化保存，因此 MOVE 与插值对多边形、蒙版同样有效。
+// 每个几何对象缓存最近一次的光栅化结果，外框不变时每帧只做混合。
+
+struct WVOverlayPoint {
+    float x;
+    float y;
+};
+
+// 覆盖率位图，左上角位于 (x, y)
+struct WVCoverageBitmap {
+    int x;
+    int y;
+    int width;
+    int height;
+    std::vector<uint8_t> coverage;   // width * height，0-255
+};
+
+/**
+ * 光栅化若干闭合轮廓，结果裁剪到 [0, clipWidth) x [0, clipHeight)
+ * @param nonZero true 为非零规则，false 为奇偶规则
+ * @return 结果为空（完全在裁剪区域外、面积为 0）时返回 false
+ */
+bool WVRasterizeContours(const std::vector<std::vector<WVOverlayPoint> >& contours, bool nonZero,
+                         int clipWidth, int clipHeight, WVCoverageBitmap* out);
+
+/**
+ * 闭合折线的描边轮廓（按非零规则光栅化）
+ */
+void WVStrokeContours(const std::vector<WVOverlayPoint>& polygon, float lineWidth,
+                      std::vector<std::vector<WVOverlayPoint> >* out);
+
+class WVOverlayGeometry {
+public:
+    /**
+     * 由绝对坐标的顶点创建多边形，返回顶点外框
+     * @param points [x0, y0, x1, y1, ...]
+     * @return 顶点少于 3 个或坐标非法时返回空指针
+     */
+    static std::shared_ptr<const WVOverlayGeometry> CreatePolygon(const float* points, int count,
+                                                                  float* boxX, float* boxY,
+                                                                  float* boxWidth, float* boxHeight);
+
+    /**
+     * 由游程编码创建蒙版：游程交替表示 0 与 1 的像素个数，从 0 开始，行优先；
+     * 总长度不足 width * height 时其余为 0
+     * @return 参数非法或游程总长超出时返回空指针
+     */
+    static std::shared_ptr<const WVOverlayGeometry> CreateMask(int width, int height,
+                                                               const uint32_t* runs, size_t runCount);
+
+    bool IsMask() const { return maskWidth > 0; }
+
+    /**
+     * 多边形顶点是否相同（重复提交同一多边形时复用已有对象，不产生脏区域）
+     */
+    bool SamePolygon(const WVOverlayGeometry& other) const;
+
+    size_t ByteSize() const;
+
+    /**
+     * 按像素外框渲染（缓存最近一次结果，外框与参数不变时直接返回）
+     */
+    std::shared_ptr<const WVCoverageBitmap> RenderFill(float x, float y, float width, float height, bool nonZero,
+                                                       int clipWidth, int clipHeight) const;
+    std::shared_ptr<const WVCoverageBitmap> RenderStroke(float x, float y, float width, float height,
+                                                         float lineWidth, int clipWidth, int clipHeight) const;
+
+private:
+    WVOverlayGeometry();
+
+    struct CacheSlot {
+        float key[5];
+        int clipWidth;
+        int clipHeight;
+        std::shared_ptr<const WVCoverageBitmap> bitmap;
+    };
+
+    void Polygon(float x, float y, float width, float height, std::vector<WVOverlayPoint>* out) const;
+    bool RenderMask(float x, float y, float width, float height, int clipWidth, int clipHeight,
+                    WVCoverageBitmap* out) const;
+    static bool CacheHit(const CacheSlot& slot, const float key[5], int clipWidth, int clipHeight);
+
+    std::vector<WVOverlayPoint> points;   // 多边形：相对外框归一化到 0-1
+    int maskWidth;                        // 蒙版：尺寸与游程
+    int maskHeight;
+    std::vector<uint32_t> runs;
+
+    mutable std::mutex cacheMutex;
+    mutable CacheSlot fillCache;
+    mutable CacheSlot strokeCache;
+};
+
+// ==================== 蒙版存储 ====================
+//
+// 每个播放器一份，覆盖层场景与时间线共用。重新上传同一 ID 只影响之后的 MASK 命令，
+// 已经引用旧蒙版的图形保持不变；总占用有上限。所有方法线程安全。
+
+class WVOverlayMaskStore {
+public:
+    WVOverlayMaskStore();
+
+    /**
+     * @return 参数非法或超出存储上限时返回 false
+     */
+    bool Upload(uint32_t maskId, int width, int height, const uint32_t* runs, size_t runCount);
+
+    void Release(uint32_t maskId);
+
+    std::shared_ptr<const WVOverlayGeometry> Find(uint32_t maskId) const;
+
+private:
+    WVOverlayMaskStore(const WVOverlayMaskStore&);
+    WVOverlayMaskStore& operator=(const WVOverlayMaskStore&);
+
+    mutable std::mutex mutex;
+    std::map<uint32_t, std::shared_ptr<const WVOverlayGeometry> > masks;
+    size_t totalBytes;
+};
+
+#endif // WV_OVERLAY_GEOMETRY_H
@@ -0,0 +1,414 @@
+//
+//  WVOverlayRaster.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayRaster.h"
+#include "WVOverlayBlendKernels.h"
+#include "WVGlyphAtlas.h"
+#include "WVOverlayGeometry.h"
+#include <atomic>
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+struct KernelTable {
+    WVColorKernel kernel;
+    WVBlendSolidRowFunc solidRow;
+    WVBlendMaskRowFunc maskRow;
+};
+
+const KernelTable kKernelTables[] = {
+    { WVColorKernelScalar, WVBlendSolidRowScalar, WVBlendMaskRowScalar },
+#ifdef WV_OVERLAY_X86
+    { WVColorKernelSSE2, WVBlendSolidRowSSE2, WVBlendMaskRowSSE2 },
+    { WVColorKernelAVX2, WVBlendSolidRowAVX2, WVBlendMaskRowAVX2 },
+#endif
+};
+
+// -1 表示尚未检测
+std::atomic<int> g_activeKernel(-1);
+
+const KernelTable& ActiveTable() {
+    int kernel = g_activeKernel.load(std::memory_order_acquire);
+    if (kernel < 0) {
+        kernel = WVColorCpuKernel();
+        g_activeKernel.store(kernel, std::memory_order_release);
+    }
+    return kKernelTables[kernel];
+}
+
+// 超出该范围的坐标一定在表面之外，先钳位再取整，避免 float 转 int 溢出（NaN 也落到下界）
+const float kCoordinateLimit = 16777216.0f;
+
+inline int RoundToInt(float value) {
+    if (!(value > -kCoordinateLimit)) value = -kCoordinateLimit;
+    if (value > kCoordinateLimit) value = kCoordinateLimit;
+    return static_cast<int>(floorf(value + 0.5f));
+}
+
+bool ClipRect(const WVOverlaySurface& surface, int* x0, int* y0, int* x1, int* y1) {
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 > surface.width) *x1 = surface.width;
+    if (*y1 > surface.height) *y1 = surface.height;
+    return *x0 < *x1 && *y0 < *y1;
+}
+
+inline uint32_t* Row(const WVOverlaySurface& surface, int y) {
+    return reinterpret_cast<uint32_t*>(surface.pixels + static_cast<size_t>(y) * surface.stride);
+}
+
+// dst * inverse / 255 + src。除以 255 使用 ((x + 128) + ((x + 128) >> 8)) >> 8（对 0..255*255 精确），
+// 两个通道一组（B/R、G/A）并行计算，每组 16 位内不会进位到相邻通道。
+// 颜色是合法的预乘值（各通道不大于 alpha）时结果不超过 255，无需饱和
+inline uint32_t OverPixel(uint32_t dst, uint32_t src, uint32_t inverse) {
+    uint32_t rb = (dst & 0x00FF00FF) * inverse + 0x00800080;
+    uint32_t ga = ((dst >> 8) & 0x00FF00FF) * inverse + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    ga = ((ga + ((ga >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    return src + (rb | (ga << 8));
+}
+
+} // namespace
+
+void WVBlendSolidRowScalar(uint32_t* row, int count, uint32_t color) {
+    uint32_t inverse = 255 - (color >> 24);
+    for (int i = 0; i < count; ++i) {
+        row[i] = OverPixel(row[i], color, inverse);
+    }
+}
+
+void WVBlendMaskRowScalar(uint32_t* row, const uint8_t* mask, int count, uint32_t color) {
+    for (int i = 0; i < count; ++i) {
+        uint32_t coverage = mask[i];
+        if (coverage == 0) continue;
+        uint32_t src = OverPixel(color, 0, coverage);   // 各通道 color * coverage / 255
+        row[i] = OverPixel(row[i], src, 255 - (src >> 24));
+    }
+}
+
+void WVOverlayClearRect(const WVOverlaySurface& surface, int x0, int y0, int x1, int y1) {
+    if (!ClipRect(surface, &x0, &y0, &x1, &y1)) return;
+    for (int y = y0; y < y1; ++y) {
+        memset(Row(surface, y) + x0, 0, static_cast<size_t>(x1 - x0) * 4);
+    }
+}
+
+void WVOverlayFillRect(const WVOverlaySurface& surface, int x0, int y0, int x1, int y1, uint32_t color) {
+    uint32_t alpha = color >> 24;
+    if (alpha == 0) return;
+    if (!ClipRect(surface, &x0, &y0, &x1, &y1)) return;
+
+    int count = x1 - x0;
+    if (alpha == 255) {
+        for (int y = y0; y < y1; ++y) {
+            uint32_t* row = Row(surface, y) + x0;
+            for (int i = 0; i < count; ++i) row[i] = color;
+        }
+        return;
+    }
+    WVBlendSolidRowFunc blend = ActiveTable().solidRow;
+    for (int y = y0; y < y1; ++y) {
+        blend(Row(surface, y) + x0, count, color);
+    }
+}
+
+void WVOverlayBlendMask(const WVOverlaySurface& surface, int x, int y, const uint8_t* mask, int maskStride,
+                        int width, int height, uint32_t color) {
+    if ((color >> 24) == 0) return;
+    int x0 = x, y0 = y, x1 = x + width, y1 = y + height;
+    if (!ClipRect(surface, &x0, &y0, &x1, &y1)) return;
+
+    WVBlendMaskRowFunc blend = ActiveTable().maskRow;
+    for (int row = y0; row < y1; ++row) {
+        blend(Row(surface, row) + x0, mask + static_cast<size_t>(row - y) * maskStride + (x0 - x), x1 - x0, color);
+    }
+}
+
+void WVOverlayStrokeRect(const WVOverlaySurface& surface, float x, float y, float width, float height,
+                         float lineWidth, uint32_t color) {
+    WVOverlayDrawRect(surface, x, y, width, height, lineWidth, color, 0);
+}
+
+namespace {
+
+// 分块合成时每块的行数：一块的目标行（1080p 约 120 KB）留在 L2 中，
+// 竖边每行只有几个像素，逐个图形从上到下绘制时几乎每行都是缓存和 TLB 未命中
+const int kRenderStripRows = 16;
+
+// 单色矩形块；mask 不为空时为覆盖率位图（左上角位于 x0, y0，每行 x1 - x0 字节），
+// image 不为空时为不透明的 BGRA 位图（每行 x1 - x0 像素），直接复制
+struct BlendRect {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+    uint32_t color;
+    const uint8_t* mask;
+    const uint32_t* image;
+};
+
+inline void PushRect(std::vector<BlendRect>* out, int x0, int y0, int x1, int y1, uint32_t color) {
+    if ((color >> 24) == 0 || x0 >= x1 || y0 >= y1) return;
+    BlendRect rect = { x0, y0, x1, y1, color, NULL, NULL };
+    out->push_back(rect);
+}
+
+// 复制不透明位图的 [y0, y1) 行，自动裁剪
+void CopyImageRows(const WVOverlaySurface& surface, const BlendRect& rect, int y0, int y1) {
+    int x0 = rect.x0, x1 = rect.x1;
+    if (!ClipRect(surface, &x0, &y0, &x1, &y1)) return;
+    int stride = rect.x1 - rect.x0;
+    for (int y = y0; y < y1; ++y) {
+        memcpy(Row(surface, y) + x0, rect.image + static_cast<size_t>(y - rect.y0) * stride + (x0 - rect.x0),
+               static_cast<size_t>(x1 - x0) * 4);
+    }
+}
+
+// 合成期间保持标签位图有效
+struct LabelRefs {
+    std::vector<std::shared_ptr<const WVLabelBitmap> > bitmaps;
+    std::vector<std::shared_ptr<const WVLabelTag> > tags;
+};
+
+inline int LineWidthPixels(const WVOverlaySurface& surface, float lineWidth) {
+    int line = RoundToInt(lineWidth);
+    if (line > surface.width + surface.height) line = surface.width + surface.height;
+    return line < 1 ? 1 : line;
+}
+
+// 把矩形拆成互不重叠的填充块与边框块（按绘制顺序），未裁剪
+void RectPieces(const WVOverlaySurface& surface, float x, float y, float width, float height,
+                float lineWidth, uint32_t strokeColor, uint32_t fillColor, std::vector<BlendRect>* out) {
+    int line = LineWidthPixels(surface, lineWidth);
+    float half = line * 0.5f;
+
+    int outerX0 = RoundToInt(x - half);
+    int outerY0 = RoundToInt(y - half);
+    int outerX1 = outerX0 + RoundToInt(width) + line;
+    int outerY1 = outerY0 + RoundToInt(height) + line;
+
+    // 完全在表面之外（常见于跟踪框移出画面）时不做任何事
+    if (outerX1 <= 0 || outerY1 <= 0 || outerX0 >= surface.width || outerY0 >= surface.height) return;
+
+    if ((strokeColor >> 24) == 0) {
+        PushRect(out, RoundToInt(x), RoundToInt(y), RoundToInt(x + width), RoundToInt(y + height), fillColor);
+        return;
+    }
+
+    // 框太小时边框连成一片
+    if (outerX1 - outerX0 <= line * 2 || outerY1 - outerY0 <= line * 2) {
+        PushRect(out, outerX0, outerY0, outerX1, outerY1, strokeColor);
+        return;
+    }
+
+    // 填充只覆盖边框以内，半透明的填充与边框不重复混合
+    PushRect(out, outerX0 + line, outerY0 + line, outerX1 - line, outerY1 - line, fillColor);
+
+    PushRect(out, outerX0, outerY0, outerX1, outerY0 + line, strokeColor);                   // 上
+    PushRect(out, outerX0, outerY1 - line, outerX1, outerY1, strokeColor);                   // 下
+    PushRect(out, outerX0, outerY0 + line, outerX0 + line, outerY1 - line, strokeColor);     // 左
+    PushRect(out, outerX1 - line, outerY0 + line, outerX1, outerY1 - line, strokeColor);     // 右
+}
+
+// 标签：底框（边框颜色）贴在框外侧左上角，放不下（超出场景顶部）时放到框内侧；
+// 判断使用场景坐标（加回 originY），局部重绘与整体重绘的位置一致。
+// 底框不透明时使用缓存的合成位图，每帧只复制；半透明时先填充底框再混合文字
+void LabelPieces(const WVOverlaySurface& surface, const WVOverlayShape& shape, float x, float y,
+                 float lineScale, int originY, std::vector<BlendRect>* out, LabelRefs* refs) {
+    int pixelSize = RoundToInt(shape.labelSize * lineScale);
+    if (pixelSize <= 0) return;
+    int padding = RoundToInt(WVOverlayLabelPadding(shape.labelSize) * lineScale);
+    if (padding < 1) padding = 1;
+
+    std::shared_ptr<const WVLabelTag> tag;
+    std::shared_ptr<const WVLabelBitmap> bitmap;
+    int tagWidth = 0;
+    int tagHeight = 0;
+    if ((shape.strokeColor >> 24) == 0xFF) {
+        tag = WVGlyphAtlas::Tag(shape.label, pixelSize, padding, shape.strokeColor, shape.labelColor);
+        if (!tag) return;
+        tagWidth = tag->width;
+        tagHeight = tag->height;
+    } else {
+        bitmap = WVGlyphAtlas::Label(shape.label, pixelSize);
+        if (!bitmap) return;
+        tagWidth = bitmap->width + padding * 2;
+        tagHeight = bitmap->height + padding * 2;
+    }
+
+    int line = LineWidthPixels(surface, shape.lineWidth * lineScale);
+    int tagX0 = RoundToInt(x - line * 0.5f);
+    int outerY0 = RoundToInt(y - line * 0.5f);
+    int tagY0 = outerY0 - tagHeight;
+    if (tagY0 + originY < 0) tagY0 = outerY0;
+    int tagX1 = tagX0 + tagWidth;
+    if (tagX1 <= 0 || tagY0 + tagHeight <= 0 || tagX0 >= surface.width || tagY0 >= surface.height) return;
+
+    if (tag) {
+        BlendRect image = { tagX0, tagY0, tagX1, tagY0 + tagHeight, 0, NULL, &tag->pixels[0] };
+        out->push_back(image);
+        refs->tags.push_back(tag);
+        return;
+    }
+    PushRect(out, tagX0, tagY0, tagX1, tagY0 + tagHeight, shape.strokeColor);
+    if ((shape.labelColor >> 24) != 0) {
+        BlendRect text = { tagX0 + padding, tagY0 + padding, tagX0 + padding + bitmap->width,
+                           tagY0 + padding + bitmap->height, shape.labelColor, &bitmap->coverage[0], NULL };
+        out->push_back(text);
+        refs->bitmaps.push_back(bitmap);
+    }
+}
+
+// 多边形与蒙版：覆盖率位图按完整表面的像素坐标光栅化并缓存在几何对象中，
+// 局部重绘只是按 origin 平移引用；位图在合成期间由 bitmaps 保持有效
+void GeometryPieces(const WVOverlayShape& shape, float scaleX, float scaleY, float lineScale,
+                    int originX, int originY, int fullWidth, int fullHeight, std::vector<BlendRect>* out,
+                    std::vector<std::shared_ptr<const WVCoverageBitmap> >* bitmaps) {
+    if (!shape.geometry) return;
+    float x = shape.x * scaleX;
+    float y = shape.y * scaleY;
+    float width = shape.width * scaleX;
+    float height = shape.height * scaleY;
+
+    std::shared_ptr<const WVCoverageBitmap> layers[2];
+    uint32_t colors[2] = { shape.fillColor, shape.strokeColor };
+    if ((shape.fillColor >> 24) != 0) {
+        layers[0] = shape.geometry->RenderFill(x, y, width, height, shape.fillRule == WVOverlayFillNonZero,
+                                               fullWidth, fullHeight);
+    }
+    if (shape.kind == WVOverlayShapePolygon && (shape.strokeColor >> 24) != 0) {
+        layers[1] = shape.geometry->RenderStroke(x, y, width, height, shape.lineWidth * lineScale,
+                                                 fullWidth, fullHeight);
+    }
+    for (int i = 0; i < 2; ++i) {
+        const std::shared_ptr<const WVCoverageBitmap>& bitmap = layers[i];
+        if (!bitmap) continue;
+        BlendRect rect = { bitmap->x - originX, bitmap->y - originY, bitmap->x - originX + bitmap->width,
+                           bitmap->y - originY + bitmap->height, colors[i], &bitmap->coverage[0], NULL };
+        out->push_back(rect);
+        bitmaps->push_back(bitmap);
+    }
+}
+
+} // namespace
+
+void WVOverlayDrawRect(const WVOverlaySurface& surface, float x, float y, float width, float height,
+                       float lineWidth, uint32_t strokeColor, uint32_t fillColor) {
+    std::vector<BlendRect> pieces;
+    RectPieces(surface, x, y, width, height, lineWidth, strokeColor, fillColor, &pieces);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        const BlendRect& rect = pieces[i];
+        WVOverlayFillRect(surface, rect.x0, rect.y0, rect.x1, rect.y1, rect.color);
+    }
+}
+
+WVColorKernel WVOverlayBlendKernel() {
+    return ActiveTable().kernel;
+}
+
+WVColorKernel WVOverlayBlendSetKernel(WVColorKernel kernel) {
+    WVColorKernel supported = WVColorCpuKernel();
+    if (kernel > supported) kernel = supported;
+    if (kernel < WVColorKernelScalar) kernel = WVColorKernelScalar;
+    g_activeKernel.store(kernel, std::memory_order_release);
+    return kernel;
+}
+
+WVOverlaySurface WVOverlaySubSurface(const WVOverlaySurface& surface, int x0, int y0, int x1, int y1) {
+    WVOverlaySurface sub = { surface.pixels + static_cast<size_t>(y0) * surface.stride + x0 * 4,
+                             x1 - x0, y1 - y0, surface.stride };
+    return sub;
+}
+
+void WVOverlayRenderShapes(const WVOverlaySurface& surface, const std::vector<WVOverlayShape>& shapes,
+                           float scaleX, float scaleY, int originX, int originY, int fullWidth, int fullHeight) {
+    if (shapes.empty()) return;
+
+    std::vector<BlendRect> pieces;
+    LabelRefs labels;
+    std::vector<std::shared_ptr<const WVCoverageBitmap> > coverages;
+    pieces.reserve(shapes.size() * 5);
+    int minY = surface.height;
+    int maxY = 0;
+    float lineScale = (scaleX + scaleY) * 0.5f;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        const WVOverlayShape& shape = shapes[i];
+        switch (shape.kind) {
+            case WVOverlayShapeRect:
+                RectPieces(surface, shape.x * scaleX - originX, shape.y * scaleY - originY,
+                           shape.width * scaleX, shape.height * scaleY,
+                           shape.lineWidth * lineScale, shape.strokeColor, shape.fillColor, &pieces);
+                if (!shape.label.empty()) {
+                    LabelPieces(surface, shape, shape.x * scaleX - originX, shape.y * scaleY - originY,
+                                lineScale, originY, &pieces, &labels);
+                }
+                break;
+            case WVOverlayShapePolygon:
+            case WVOverlayShapeMask:
+                GeometryPieces(shape, scaleX, scaleY, lineScale, originX, originY, fullWidth, fullHeight,
+                               &pieces, &coverages);
+                if (!shape.label.empty()) {
+                    LabelPieces(surface, shape, shape.x * scaleX - originX, shape.y * scaleY - originY,
+                                lineScale, originY, &pieces, &labels);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        if (pieces[i].y0 < minY) minY = pieces[i].y0;
+        if (pieces[i].y1 > maxY) maxY = pieces[i].y1;
+    }
+    if (minY < 0) minY = 0;
+    if (maxY > surface.height) maxY = surface.height;
+
+    if (minY >= maxY) return;
+
+    // 按行分块合成；块内仍按图形顺序混合，每个像素的混合顺序与逐个图形绘制相同。
+    // 先按块分桶（计数、前缀和、按图形顺序填入），每块只遍历与它相交的图形，
+    // 数百个检测框时不必每块都扫描全部图形
+    int stripCount = (maxY - minY + kRenderStripRows - 1) / kRenderStripRows;
+    std::vector<int> stripStart(stripCount + 1, 0);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        const BlendRect& rect = pieces[i];
+        if (rect.y1 <= minY || rect.y0 >= maxY || rect.x1 <= 0 || rect.x0 >= surface.width) continue;
+        int first = rect.y0 > minY ? (rect.y0 - minY) / kRenderStripRows : 0;
+        int last = (rect.y1 < maxY ? rect.y1 - minY - 1 : maxY - minY - 1) / kRenderStripRows;
+        for (int strip = first; strip <= last; ++strip) ++stripStart[strip + 1];
+    }
+    for (int strip = 0; strip < stripCount; ++strip) stripStart[strip + 1] += stripStart[strip];
+    std::vector<int> stripPieces(stripStart[stripCount]);
+    std::vector<int> fill(stripStart.begin(), stripStart.end() - 1);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        const BlendRect& rect = pieces[i];
+        if (rect.y1 <= minY || rect.y0 >= maxY || rect.x1 <= 0 || rect.x0 >= surface.width) continue;
+        int first = rect.y0 > minY ? (rect.y0 - minY) / kRenderStripRows : 0;
+        int last = (rect.y1 < maxY ? rect.y1 - minY - 1 : maxY - minY - 1) / kRenderStripRows;
+        for (int strip = first; strip <= last; ++strip) stripPieces[fill[strip]++] = static_cast<int>(i);
+    }
+
+    for (int strip = 0; strip < stripCount; ++strip) {
+        int stripY0 = minY + strip * kRenderStripRows;
+        int stripY1 = stripY0 + kRenderStripRows < maxY ? stripY0 + kRenderStripRows : maxY;
+        for (int k = stripStart[strip]; k < stripStart[strip + 1]; ++k) {
+            const BlendRect& rect = pieces[stripPieces[k]];
+            int y0 = rect.y0 > stripY0 ? rect.y0 : stripY0;
+            int y1 = rect.y1 < stripY1 ? rect.y1 : stripY1;
+            if (rect.image) {
+                CopyImageRows(surface, rect, y0, y1);
+            } else if (rect.mask) {
+                int maskStride = rect.x1 - rect.x0;
+                WVOverlayBlendMask(surface, rect.x0, y0, rect.mask + static_cast<size_t>(y0 - rect.y0) * maskStride,
+                                   maskStride, maskStride, y1 - y0, rect.color);
+            } else {
+                WVOverlayFillRect(surface, rect.x0, y0, rect.x1, y1, rect.color);
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+//
+//  WVOverlayRaster.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_OVERLAY_RASTER_H
+#define WV_OVERLAY_RASTER_H
+
+#include "WVOverlayScene.h"
+#include "WVColorConvert.h"
+#include <vector>
+#include <stdint.h>
+
+// ==================== 覆盖层软件光栅化 ====================
+//
+// 把覆盖层图形以预乘 alpha 的 source-over 混合绘制到 32 位 BGRA 表面上。
+// 同一套代码用于两种目标：
+//   - 覆盖层窗口的 DIB（初始全透明，结果交给 UpdateLayeredWindow 做逐像素 alpha）
+//   - 帧回调模式下解码后的视频帧（不透明，直接合成进画面）
+// 行级混合按 CPU 能力选择标量、SSE2 或 AVX2 实现（与颜色转换相同的检测），输出逐字节一致。
+
+struct WVOverlaySurface {
+    uint8_t* pixels;
+    int width;
+    int height;
+    int stride;           // 每行字节数
+};
+
+/**
+ * 将 [x0, x1) x [y0, y1) 区域清为全透明（自动裁剪）
+ */
+void WVOverlayClearRect(const WVOverlaySurface& surface, int x0, int y0, int x1, int y1);
+
+/**
+ * 以预乘颜色混合填充 [x0, x1) x [y0, y1) 区域（自动裁剪）
+ */
+void WVOverlayFillRect(const WVOverlaySurface& surface, int x0, int y0, int x1, int y1, uint32_t color);
+
+/**
+ * 以 8 位覆盖率蒙版混合单色（蒙版 0 为不绘制，255 为完整颜色），左上角位于 (x, y)，自动裁剪
+ * @param maskStride 蒙版每行字节数
+ */
+void WVOverlayBlendMask(const WVOverlaySurface& surface, int x, int y, const uint8_t* mask, int maskStride,
+                        int width, int height, uint32_t color);
+
+/**
+ * 绘制矩形边框，线条以边为中心（与 GDI+ DrawRectangle 一致），四条边互不重叠
+ */
+void WVOverlayStrokeRect(const WVOverlaySurface& surface, float x, float y, float width, float height,
+                         float lineWidth, uint32_t color);
+
+/**
+ * 绘制矩形：先填充边框以内的区域，再绘制边框；任一颜色 alpha 为 0 时跳过对应部分，
+ * 没有边框时填充整个矩形。坐标可以任意超出表面（包括极大值），按表面裁剪
+ */
+void WVOverlayDrawRect(const WVOverlaySurface& surface, float x, float y, float width, float height,
+                       float lineWidth, uint32_t strokeColor, uint32_t fillColor);
+
+/**
+ * 按顺序绘制全部图形
+ * 像素坐标 = 图形坐标 * scale - origin；重绘局部区域时传入子表面及其左上角作为 origin
+ * @param scaleX / scaleY 图形坐标到表面像素的缩放（如 DPI 缩放）
+ * @param fullWidth / fullHeight 完整表面的尺寸：多边形与蒙版按完整表面光栅化并缓存，
+ *                               局部重绘与整体重绘共用同一份覆盖率位图
+ */
+void WVOverlayRenderShapes(const WVOverlaySurface& surface, const std::vector<WVOverlayShape>& shapes,
+                           float scaleX, float scaleY, int originX, int originY, int fullWidth, int fullHeight);
+
+/**
+ * 当前使用的混合实现
+ */
+WVColorKernel WVOverlayBlendKernel();
+
+/**
+ * 强制使用指定的混合实现（超出 CPU 能力时降级），返回实际生效的实现
+ */
+WVColorKernel WVOverlayBlendSetKernel(WVColorKernel kernel);
+
+/**
+ * 表面中 [x0, x1) x [y0, y1) 区域的子表面（调用方保证区域已裁剪）
+ */
+WVOverlaySurface WVOverlaySubSurface(const WVOverlaySurface& surface, int x0, int y0, int x1, int y1);
+
+#endif // WV_OVERLAY_RASTER_H
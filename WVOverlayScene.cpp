@@ -0,0 +1,378 @@
+//
+//  WVOverlayScene.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayScene.h"
+#include "WVOverlayGeometry.h"
+#include <set>
+#include <string.h>
+
+namespace {
+
+// 脏区域超过该数量时整体重绘，避免逐块清除的开销超过一次全量重绘
+const size_t kMaxDirtyRegions = 64;
+
+uint32_t ToByte(float value) {
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 255;
+    return static_cast<uint32_t>(value * 255.0f + 0.5f);
+}
+
+uint32_t Premultiply(uint32_t red, uint32_t green, uint32_t blue, uint32_t alpha) {
+    uint32_t r = (red * alpha + 127) / 255;
+    uint32_t g = (green * alpha + 127) / 255;
+    uint32_t b = (blue * alpha + 127) / 255;
+    return b | (g << 8) | (r << 16) | (alpha << 24);
+}
+
+// 在 UTF-8 字符边界处截断到不超过 maxBytes
+void TruncateUtf8(std::string* text, size_t maxBytes) {
+    if (text->size() <= maxBytes) return;
+    size_t end = maxBytes;
+    while (end > 0 && (static_cast<uint8_t>((*text)[end]) & 0xC0) == 0x80) {
+        --end;
+    }
+    text->resize(end);
+}
+
+// 命令缓冲区读取（不要求对齐）
+class CommandReader {
+public:
+    CommandReader(const uint8_t* data, size_t length) : data(data), remaining(length) {}
+
+    bool Empty() const { return remaining == 0; }
+    bool Has(size_t bytes) const { return remaining >= bytes; }
+
+    uint32_t ReadU32() {
+        uint32_t value;
+        memcpy(&value, data, 4);
+        data += 4;
+        remaining -= 4;
+        return value;
+    }
+
+    // 读取 length 字节的文本，共消耗 consumed 字节（含补齐）
+    std::string ReadString(size_t length, size_t consumed) {
+        std::string value(reinterpret_cast<const char*>(data), length);
+        data += consumed;
+        remaining -= consumed;
+        return value;
+    }
+
+    float ReadFloat() {
+        float value;
+        memcpy(&value, data, 4);
+        data += 4;
+        remaining -= 4;
+        return value;
+    }
+
+private:
+    const uint8_t* data;
+    size_t remaining;
+};
+
+} // namespace
+
+uint32_t WVOverlayPackColor(float red, float green, float blue, float alpha) {
+    return Premultiply(ToByte(red), ToByte(green), ToByte(blue), ToByte(alpha));
+}
+
+uint32_t WVOverlayPackColorARGB(uint32_t argb) {
+    return Premultiply((argb >> 16) & 0xFF, (argb >> 8) & 0xFF, argb & 0xFF, argb >> 24);
+}
+
+bool WVOverlayShapeEqual(const WVOverlayShape& a, const WVOverlayShape& b) {
+    return a.id == b.id && a.kind == b.kind && a.x == b.x && a.y == b.y &&
+           a.width == b.width && a.height == b.height && a.lineWidth == b.lineWidth &&
+           a.strokeColor == b.strokeColor && a.fillColor == b.fillColor &&
+           a.labelSize == b.labelSize && a.labelColor == b.labelColor && a.label == b.label &&
+           a.fillRule == b.fillRule && a.maskId == b.maskId && a.geometry == b.geometry;
+}
+
+float WVOverlayLabelPadding(float labelSize) {
+    float padding = labelSize / 6.0f;
+    return padding < 1.0f ? 1.0f : padding;
+}
+
+WVOverlayBounds WVOverlayShapeBounds(const WVOverlayShape& shape) {
+    float half = (shape.lineWidth < 1.0f ? 1.0f : shape.lineWidth) * 0.5f + 1.0f;
+    WVOverlayBounds bounds = { shape.x - half, shape.y - half,
+                               shape.x + shape.width + half, shape.y + shape.height + half };
+    if (!shape.label.empty() && shape.labelSize > 0.0f) {
+        // 标签贴在框的左上角外侧（靠近顶部时放到内侧），两种位置都包含在内
+        size_t characters = 0;
+        for (size_t i = 0; i < shape.label.size(); ++i) {
+            if ((static_cast<uint8_t>(shape.label[i]) & 0xC0) != 0x80) characters++;
+        }
+        float padding = WVOverlayLabelPadding(shape.labelSize);
+        float tagWidth = characters * shape.labelSize * 1.2f + padding * 2.0f;
+        float tagHeight = shape.labelSize * 1.5f + padding * 2.0f;
+        if (shape.y - half - tagHeight < bounds.y0) bounds.y0 = shape.y - half - tagHeight;
+        if (shape.y + half + tagHeight > bounds.y1) bounds.y1 = shape.y + half + tagHeight;
+        if (shape.x - half + tagWidth > bounds.x1) bounds.x1 = shape.x - half + tagWidth;
+    }
+    return bounds;
+}
+
+WVOverlayScene::WVOverlayScene() : maskStore(NULL), version(0), dirtyAll(false) {
+}
+
+void WVOverlayScene::SetMaskStore(WVOverlayMaskStore* store) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maskStore = store;
+}
+
+void WVOverlayScene::MarkDirty(const WVOverlayShape& shape) {
+    if (dirtyAll) return;
+    if (dirtyRegions.size() >= kMaxDirtyRegions) {
+        dirtyRegions.clear();
+        dirtyAll = true;
+        return;
+    }
+    dirtyRegions.push_back(WVOverlayShapeBounds(shape));
+}
+
+WVOverlayShape* WVOverlayScene::Find(uint32_t id) {
+    std::map<uint32_t, size_t>::iterator it = indexById.find(id);
+    return it != indexById.end() ? &shapes[it->second] : NULL;
+}
+
+void WVOverlayScene::Upsert(const WVOverlayShape& shape) {
+    WVOverlayShape* existing = Find(shape.id);
+    if (existing) {
+        if (WVOverlayShapeEqual(*existing, shape)) return;
+        MarkDirty(*existing);
+        *existing = shape;
+    } else {
+        indexById[shape.id] = shapes.size();
+        shapes.push_back(shape);
+    }
+    MarkDirty(shape);
+}
+
+bool WVOverlayScene::Remove(uint32_t id) {
+    std::map<uint32_t, size_t>::iterator it = indexById.find(id);
+    if (it == indexById.end()) return false;
+
+    size_t index = it->second;
+    MarkDirty(shapes[index]);
+    shapes.erase(shapes.begin() + index);
+    indexById.erase(it);
+    // 保持绘制顺序，后续图形的下标前移
+    for (size_t i = index; i < shapes.size(); ++i) {
+        indexById[shapes[i].id] = i;
+    }
+    return true;
+}
+
+void WVOverlayScene::RemoveAll() {
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        MarkDirty(shapes[i]);
+    }
+    shapes.clear();
+    indexById.clear();
+}
+
+void WVOverlayScene::ReplaceLocked(const std::vector<WVOverlayShape>& replacement) {
+    // 先删除新集合中没有的 ID，再逐个与同 ID 的旧图形比较，未变化的图形不产生脏区域
+    std::set<uint32_t> keep;
+    for (size_t i = 0; i < replacement.size(); ++i) {
+        keep.insert(replacement[i].id);
+    }
+    for (size_t i = shapes.size(); i > 0; --i) {
+        uint32_t id = shapes[i - 1].id;
+        if (keep.find(id) == keep.end()) {
+            Remove(id);
+        }
+    }
+    for (size_t i = 0; i < replacement.size(); ++i) {
+        Upsert(replacement[i]);
+    }
+}
+
+void WVOverlayScene::ReplaceRectangles(const float* rects, int count, float lineWidth, uint32_t strokeColor) {
+    std::vector<WVOverlayShape> replacement(count > 0 ? count : 0);
+    for (int i = 0; i < count; ++i) {
+        WVOverlayShape& shape = replacement[i];
+        shape.id = static_cast<uint32_t>(i + 1);
+        shape.kind = WVOverlayShapeRect;
+        shape.x = rects[i * 4];
+        shape.y = rects[i * 4 + 1];
+        shape.width = rects[i * 4 + 2];
+        shape.height = rects[i * 4 + 3];
+        shape.lineWidth = lineWidth;
+        shape.strokeColor = strokeColor;
+        shape.fillColor = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ReplaceLocked(replacement);
+    version++;
+}
+
+void WVOverlayScene::ReplaceShapes(const std::vector<WVOverlayShape>& replacement) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ReplaceLocked(replacement);
+    version++;
+}
+
+void WVOverlayScene::Shapes(std::vector<WVOverlayShape>* out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    *out = shapes;
+}
+
+int WVOverlayScene::Apply(const uint8_t* commands, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    CommandReader reader(commands, length);
+    int applied = 0;
+    int result = 0;
+
+    while (!reader.Empty()) {
+        if (!reader.Has(8)) {
+            result = -1;
+            break;
+        }
+        uint32_t op = reader.ReadU32();
+        uint32_t id = reader.ReadU32();
+
+        if (op == WVOverlayOpAdd) {
+            if (!reader.Has(24)) { result = -1; break; }
+            WVOverlayShape shape;
+            shape.id = id;
+            shape.kind = WVOverlayShapeRect;
+            shape.x = reader.ReadFloat();
+            shape.y = reader.ReadFloat();
+            shape.width = reader.ReadFloat();
+            shape.height = reader.ReadFloat();
+            shape.lineWidth = reader.ReadFloat();
+            shape.strokeColor = WVOverlayPackColorARGB(reader.ReadU32());
+            shape.fillColor = 0;
+            shape.labelSize = 0.0f;
+            shape.labelColor = 0;
+            shape.fillRule = WVOverlayFillEvenOdd;
+            shape.maskId = 0;
+            Upsert(shape);
+        } else if (op == WVOverlayOpPolygon) {
+            if (!reader.Has(20)) { result = -1; break; }
+            WVOverlayShape shape = WVOverlayShape();
+            shape.id = id;
+            shape.kind = WVOverlayShapePolygon;
+            shape.lineWidth = reader.ReadFloat();
+            shape.strokeColor = WVOverlayPackColorARGB(reader.ReadU32());
+            shape.fillColor = WVOverlayPackColorARGB(reader.ReadU32());
+            shape.fillRule = reader.ReadU32() == WVOverlayFillNonZero ? WVOverlayFillNonZero : WVOverlayFillEvenOdd;
+            uint32_t count = reader.ReadU32();
+            if (count > kWVOverlayMaxPolygonPoints || !reader.Has(static_cast<size_t>(count) * 8)) {
+                result = -1;
+                break;
+            }
+            std::vector<float> points(static_cast<size_t>(count) * 2);
+            for (size_t i = 0; i < points.size(); ++i) {
+                points[i] = reader.ReadFloat();
+            }
+            shape.geometry = WVOverlayGeometry::CreatePolygon(points.empty() ? NULL : &points[0],
+                                                              static_cast<int>(count), &shape.x, &shape.y,
+                                                              &shape.width, &shape.height);
+            if (shape.geometry) {
+                // 顶点未变时沿用已有几何对象，图形比较相等时不产生脏区域，光栅化缓存也继续有效
+                WVOverlayShape* existing = Find(id);
+                if (existing && existing->geometry && existing->geometry->SamePolygon(*shape.geometry)) {
+                    shape.geometry = existing->geometry;
+                }
+                Upsert(shape);
+            }
+        } else if (op == WVOverlayOpMask) {
+            if (!reader.Has(24)) { result = -1; break; }
+            WVOverlayShape shape = WVOverlayShape();
+            shape.id = id;
+            shape.kind = WVOverlayShapeMask;
+            shape.x = reader.ReadFloat();
+            shape.y = reader.ReadFloat();
+            shape.width = reader.ReadFloat();
+            shape.height = reader.ReadFloat();
+            shape.maskId = reader.ReadU32();
+            shape.fillColor = WVOverlayPackColorARGB(reader.ReadU32());
+            shape.geometry = maskStore ? maskStore->Find(shape.maskId) : std::shared_ptr<const WVOverlayGeometry>();
+            if (shape.geometry) Upsert(shape);
+        } else if (op == WVOverlayOpMove) {
+            if (!reader.Has(16)) { result = -1; break; }
+            WVOverlayShape* existing = Find(id);
+            WVOverlayShape shape = existing ? *existing : WVOverlayShape();
+            shape.x = reader.ReadFloat();
+            shape.y = reader.ReadFloat();
+            shape.width = reader.ReadFloat();
+            shape.height = reader.ReadFloat();
+            if (existing) Upsert(shape);
+        } else if (op == WVOverlayOpStyle) {
+            if (!reader.Has(8)) { result = -1; break; }
+            WVOverlayShape* existing = Find(id);
+            WVOverlayShape shape = existing ? *existing : WVOverlayShape();
+            shape.lineWidth = reader.ReadFloat();
+            shape.strokeColor = WVOverlayPackColorARGB(reader.ReadU32());
+            if (existing) Upsert(shape);
+        } else if (op == WVOverlayOpFill) {
+            if (!reader.Has(4)) { result = -1; break; }
+            WVOverlayShape* existing = Find(id);
+            WVOverlayShape shape = existing ? *existing : WVOverlayShape();
+            shape.fillColor = WVOverlayPackColorARGB(reader.ReadU32());
+            if (existing) Upsert(shape);
+        } else if (op == WVOverlayOpLabel) {
+            if (!reader.Has(12)) { result = -1; break; }
+            float size = reader.ReadFloat();
+            uint32_t color = reader.ReadU32();
+            uint32_t byteLength = reader.ReadU32();
+            size_t padded = (static_cast<size_t>(byteLength) + 3) & ~static_cast<size_t>(3);
+            if (!reader.Has(padded)) { result = -1; break; }
+            std::string text = reader.ReadString(byteLength, padded);
+            WVOverlayShape* existing = Find(id);
+            if (existing) {
+                WVOverlayShape shape = *existing;
+                TruncateUtf8(&text, kWVOverlayMaxLabelBytes);
+                shape.label.swap(text);
+                shape.labelSize = size;
+                shape.labelColor = WVOverlayPackColorARGB(color);
+                Upsert(shape);
+            }
+        } else if (op == WVOverlayOpRemove) {
+            Remove(id);
+        } else if (op == WVOverlayOpClear) {
+            RemoveAll();
+        } else {
+            result = -1;
+            break;
+        }
+        applied++;
+    }
+
+    if (applied > 0) version++;
+    return result < 0 ? -1 : applied;
+}
+
+void WVOverlayScene::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (shapes.empty()) return;
+    RemoveAll();
+    version++;
+}
+
+uint64_t WVOverlayScene::Version() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return version;
+}
+
+bool WVOverlayScene::Snapshot(uint64_t knownVersion, std::vector<WVOverlayShape>* out, uint64_t* outVersion,
+                              std::vector<WVOverlayBounds>* dirty, bool* outDirtyAll) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (version == knownVersion) return false;
+    *out = shapes;   // 复用调用方已有的容量
+    *outVersion = version;
+    if (dirty) dirty->swap(dirtyRegions);
+    if (outDirtyAll) *outDirtyAll = dirtyAll;
+    dirtyRegions.clear();
+    dirtyAll = false;
+    return true;
+}
@@ -0,0 +1,191 @@
+//
+//  WVOverlayScene.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_OVERLAY_SCENE_H
+#define WV_OVERLAY_SCENE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// ==================== 覆盖层场景 ====================
+//
+// 每个播放器一份保留模式（retained）的图形列表，图形有稳定的 ID。
+// 调用方（JS 线程）只修改场景并递增版本号；渲染方（覆盖层窗口或帧回调线程）
+// 发现版本变化时才复制一份快照重新绘制，调用本身不做任何绘制。
+//
+// 场景同时记录自上次快照以来的脏区域（变化图形的旧外框与新外框），
+// 窗口模式只清除并重绘这些区域。
+//
+// 增量命令缓冲区（Apply）：若干条小端序记录首尾相接，每条以 uint32 操作码和 uint32 ID 开头：
+//   ADD    (1) id, x, y, w, h, lineWidth (float), color (uint32 0xAARRGGBB)   32 字节，ID 已存在时替换
+//   MOVE   (2) id, x, y, w, h                                                24 字节
+//   STYLE  (3) id, lineWidth, color                                          16 字节
+//   REMOVE (4) id                                                             8 字节
+//   CLEAR  (5) id（忽略）                                                     8 字节
+//   FILL   (6) id, color (uint32 0xAARRGGBB，alpha 为 0 表示不填充)           12 字节
+//   LABEL  (7) id, size (float), color (uint32 0xAARRGGBB), byteLength (uint32), UTF-8 文本
+//              20 字节 + 文本按 4 字节补齐；byteLength 为 0 时移除标签
+//   POLYGON(8) id, lineWidth, strokeColor, fillColor (uint32 0xAARRGGBB), fillRule (uint32，0 奇偶 / 1 非零),
+//              count (uint32), 顶点 [x, y] (float) * count      28 + 8 * count 字节，ID 已存在时替换；
+//              外框取顶点的包围盒，之后的 MOVE 按外框缩放平移整个多边形
+//   MASK   (9) id, x, y, w, h (float), maskId (uint32), color (uint32 0xAARRGGBB)   32 字节，ID 已存在时替换；
+//              maskId 需先通过 wv_player_overlay_upload_mask 上传，未知的 maskId 忽略
+
+// 与 WinVLCBridge.h 中的 WV_OVERLAY_OP_* 取值一致
+enum WVOverlayOp {
+    WVOverlayOpAdd = 1,
+    WVOverlayOpMove = 2,
+    WVOverlayOpStyle = 3,
+    WVOverlayOpRemove = 4,
+    WVOverlayOpClear = 5,
+    WVOverlayOpFill = 6,
+    WVOverlayOpLabel = 7,
+    WVOverlayOpPolygon = 8,
+    WVOverlayOpMask = 9
+};
+
+// 标签文本的最大字节数，超出部分在字符边界处截断
+const size_t kWVOverlayMaxLabelBytes = 128;
+
+// 单个多边形的最大顶点数
+const uint32_t kWVOverlayMaxPolygonPoints = 4096;
+
+enum WVOverlayShapeKind {
+    WVOverlayShapeRect = 0,
+    WVOverlayShapePolygon = 1,
+    WVOverlayShapeMask = 2
+};
+
+enum WVOverlayFillRule {
+    WVOverlayFillEvenOdd = 0,
+    WVOverlayFillNonZero = 1
+};
+
+class WVOverlayGeometry;
+class WVOverlayMaskStore;
+
+struct WVOverlayShape {
+    uint32_t id;
+    int kind;                  // WVOverlayShapeKind
+    float x;
+    float y;
+    float width;
+    float height;
+    float lineWidth;
+    uint32_t strokeColor;      // 预乘 alpha 的 BGRA（见 WVOverlayPackColor）
+    uint32_t fillColor;        // 同上，0 表示不填充
+    std::string label;         // UTF-8，空表示没有标签
+    float labelSize;           // 标签字号（与坐标同一单位）
+    uint32_t labelColor;       // 标签文字颜色（预乘 BGRA），标签底色使用 strokeColor
+    int fillRule;              // WVOverlayFillRule（多边形）
+    uint32_t maskId;           // 蒙版 ID（蒙版）
+    std::shared_ptr<const WVOverlayGeometry> geometry;   // 多边形顶点或蒙版数据，矩形为空
+};
+
+// 场景坐标下的区域 [x0, x1) x [y0, y1)
+struct WVOverlayBounds {
+    float x0;
+    float y0;
+    float x1;
+    float y1;
+};
+
+/**
+ * 0.0-1.0 的颜色分量转换为预乘 alpha 的 BGRA（内存字节序 B,G,R,A）
+ */
+uint32_t WVOverlayPackColor(float red, float green, float blue, float alpha);
+
+/**
+ * 0xAARRGGBB（非预乘）转换为预乘 alpha 的 BGRA
+ */
+uint32_t WVOverlayPackColorARGB(uint32_t argb);
+
+/**
+ * 两个图形的 ID、几何与样式是否完全相同
+ */
+bool WVOverlayShapeEqual(const WVOverlayShape& a, const WVOverlayShape& b);
+
+/**
+ * 标签底框的内边距（与字号同一单位）
+ */
+float WVOverlayLabelPadding(float labelSize);
+
+/**
+ * 图形绘制后可能覆盖的范围（含线宽与标签，标签宽度按每个字符 1.2 个字号估算上限）
+ */
+WVOverlayBounds WVOverlayShapeBounds(const WVOverlayShape& shape);
+
+class WVOverlayScene {
+public:
+    WVOverlayScene();
+
+    /**
+     * 设置 MASK 命令查找蒙版用的存储（可为 NULL，此时 MASK 命令被忽略）
+     */
+    void SetMaskStore(WVOverlayMaskStore* store);
+
+    /**
+     * 用矩形数组替换全部图形（wv_player_update_rectangles），第 i 个矩形的 ID 为 i + 1
+     * @param rects [x, y, w, h] * count
+     */
+    void ReplaceRectangles(const float* rects, int count, float lineWidth, uint32_t strokeColor);
+
+    /**
+     * 用给定的图形集合替换全部图形，按 ID 比较，只有变化的图形产生脏区域
+     */
+    void ReplaceShapes(const std::vector<WVOverlayShape>& replacement);
+
+    /**
+     * 复制当前全部图形
+     */
+    void Shapes(std::vector<WVOverlayShape>* out) const;
+
+    /**
+     * 执行增量命令缓冲区（格式见文件头），整个缓冲区在一次加锁内生效
+     * @return 执行的命令条数；缓冲区格式错误时返回 -1（错误之前的命令仍然生效）
+     */
+    int Apply(const uint8_t* commands, size_t length);
+
+    void Clear();
+
+    uint64_t Version() const;
+
+    /**
+     * 版本号与 knownVersion 不同时复制图形列表，并取走累计的脏区域
+     * @param dirty 可为 NULL（不关心脏区域，如每帧整体合成）
+     * @param dirtyAll 可为 NULL，返回是否需要整体重绘
+     * @return 是否有更新
+     */
+    bool Snapshot(uint64_t knownVersion, std::vector<WVOverlayShape>* shapes, uint64_t* version,
+                  std::vector<WVOverlayBounds>* dirty, bool* dirtyAll);
+
+private:
+    WVOverlayScene(const WVOverlayScene&);
+    WVOverlayScene& operator=(const WVOverlayScene&);
+
+    void ReplaceLocked(const std::vector<WVOverlayShape>& replacement);
+    void Upsert(const WVOverlayShape& shape);
+    bool Remove(uint32_t id);
+    void RemoveAll();
+    WVOverlayShape* Find(uint32_t id);
+    void MarkDirty(const WVOverlayShape& shape);
+
+    mutable std::mutex mutex;
+    WVOverlayMaskStore* maskStore;
+    std::vector<WVOverlayShape> shapes;       // 按添加顺序绘制
+    std::map<uint32_t, size_t> indexById;
+    uint64_t version;
+
+    std::vector<WVOverlayBounds> dirtyRegions;
+    bool dirtyAll;                            // 脏区域过多时退化为整体重绘
+};
+
+#endif // WV_OVERLAY_SCENE_H
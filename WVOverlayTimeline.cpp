@@ -0,0 +1,202 @@
+//
+//  WVOverlayTimeline.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayTimeline.h"
+#include "WVLog.h"
+#include <algorithm>
+#include <map>
+
+namespace {
+
+// 约 4 秒的 30 Hz 检测结果，超过时丢弃最早的条目
+const size_t kMaxEntries = 120;
+
+const int kDefaultToleranceMs = 20;
+const int kDefaultExpiryMs = 500;
+const int kDefaultMaxExtrapolationMs = 200;
+
+typedef std::map<uint32_t, const WVOverlayShape*> ShapeIndex;
+
+void IndexShapes(const std::vector<WVOverlayShape>& shapes, ShapeIndex* index) {
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        (*index)[shapes[i].id] = &shapes[i];
+    }
+}
+
+bool SameShapes(const std::vector<WVOverlayShape>& a, const std::vector<WVOverlayShape>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!WVOverlayShapeEqual(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+// 几何属性按 from + (to - from) * t 计算；t 大于 1 时即为外推。样式沿用 from
+void Blend(const WVOverlayShape& from, const WVOverlayShape& to, float t, WVOverlayShape* out) {
+    *out = from;
+    out->x = from.x + (to.x - from.x) * t;
+    out->y = from.y + (to.y - from.y) * t;
+    out->width = from.width + (to.width - from.width) * t;
+    out->height = from.height + (to.height - from.height) * t;
+    if (out->width < 0.0f) out->width = 0.0f;
+    if (out->height < 0.0f) out->height = 0.0f;
+}
+
+} // namespace
+
+WVOverlayTimeline::WVOverlayTimeline()
+    : toleranceMs(kDefaultToleranceMs), expiryMs(kDefaultExpiryMs), clockOffsetMs(0),
+      interpolation(WVOverlayInterpolationNone), maxExtrapolationMs(kDefaultMaxExtrapolationMs) {
+    current.timestampMs = -1;
+    previous.timestampMs = -1;
+}
+
+int WVOverlayTimeline::Submit(int64_t mediaTimeMs, const uint8_t* commands, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int applied = authoring.Apply(commands, length);
+
+    Entry entry;
+    entry.timestampMs = mediaTimeMs;
+    authoring.Shapes(&entry.shapes);
+
+    // 通常按时间顺序到达，从尾部找插入位置；同一时间的新条目替换旧条目
+    std::deque<Entry>::iterator it = entries.end();
+    while (it != entries.begin() && (it - 1)->timestampMs > mediaTimeMs) {
+        --it;
+    }
+    if (it != entries.begin() && (it - 1)->timestampMs == mediaTimeMs) {
+        (it - 1)->shapes.swap(entry.shapes);
+    } else {
+        entries.insert(it, entry);
+    }
+
+    while (entries.size() > kMaxEntries) {
+        entries.pop_front();
+        WV_LOG_DEBUG("覆盖层时间线已满，丢弃最早的条目");
+    }
+    return applied;
+}
+
+void WVOverlayTimeline::Configure(int tolerance, int expiry, int clockOffset) {
+    std::lock_guard<std::mutex> lock(mutex);
+    toleranceMs = tolerance < 0 ? 0 : tolerance;
+    expiryMs = expiry <= 0 ? kDefaultExpiryMs : expiry;
+    clockOffsetMs = clockOffset;
+}
+
+void WVOverlayTimeline::SetInterpolation(WVOverlayInterpolation mode, int maxExtrapolation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    interpolation = mode;
+    maxExtrapolationMs = maxExtrapolation < 0 ? kDefaultMaxExtrapolationMs : maxExtrapolation;
+}
+
+void WVOverlayTimeline::SetMaskStore(WVOverlayMaskStore* store) {
+    authoring.SetMaskStore(store);
+}
+
+void WVOverlayTimeline::Reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    authoring.Clear();
+    current.timestampMs = -1;
+    current.shapes.clear();
+    previous.timestampMs = -1;
+    previous.shapes.clear();
+    presented.clear();
+}
+
+bool WVOverlayTimeline::Empty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.empty() && current.timestampMs < 0;
+}
+
+bool WVOverlayTimeline::Present(int64_t mediaTimeMs, WVOverlayScene* scene) {
+    if (mediaTimeMs < 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    int64_t now = mediaTimeMs + clockOffsetMs;
+
+    // 找到 now + 容差之前最新的条目，更早的条目已经过期
+    size_t due = 0;
+    while (due < entries.size() && entries[due].timestampMs <= now + toleranceMs) {
+        ++due;
+    }
+    if (due > 0) {
+        Entry& latest = entries[due - 1];
+        if (latest.timestampMs >= now - expiryMs) {
+            // 被替换的关键帧留作速度估计；一次跳过多个条目时用其中最后一个
+            if (due >= 2) {
+                std::swap(previous, entries[due - 2]);
+            } else {
+                std::swap(previous, current);
+            }
+            std::swap(current, latest);
+        }
+        entries.erase(entries.begin(), entries.begin() + due);
+    }
+    if (current.timestampMs < 0) return false;
+
+    // 检测结果中断（或 seek 到了没有结果的位置）时不让旧框一直停留
+    if (current.timestampMs < now - expiryMs) {
+        current.timestampMs = -1;
+        current.shapes.clear();
+        previous.timestampMs = -1;
+        previous.shapes.clear();
+        presented.clear();
+        scene->ReplaceShapes(presented);
+        return true;
+    }
+
+    std::vector<WVOverlayShape> frame;
+    if (interpolation == WVOverlayInterpolationNone) {
+        frame = current.shapes;
+    } else {
+        Interpolate(now, &frame);
+    }
+    if (SameShapes(frame, presented)) return false;
+
+    scene->ReplaceShapes(frame);
+    presented.swap(frame);
+    return true;
+}
+
+void WVOverlayTimeline::Interpolate(int64_t now, std::vector<WVOverlayShape>* out) const {
+    *out = current.shapes;
+    int64_t elapsed = now - current.timestampMs;
+    if (elapsed <= 0) return;
+
+    const Entry* other = NULL;
+    float t = 0.0f;
+    if (interpolation == WVOverlayInterpolationLinear) {
+        // 在当前关键帧与下一关键帧之间按时间比例插值；间隔超过过期时间说明中间有中断，不插值
+        if (entries.empty()) return;
+        const Entry& next = entries.front();
+        int64_t span = next.timestampMs - current.timestampMs;
+        if (span <= 0 || span > expiryMs) return;
+        other = &next;
+        t = elapsed >= span ? 1.0f : static_cast<float>(elapsed) / static_cast<float>(span);
+    } else {
+        // 以 previous → current 的速度继续运动：位置 = current + (current - previous) * (外推时长 / 关键帧间隔)
+        if (previous.timestampMs < 0) return;
+        int64_t span = current.timestampMs - previous.timestampMs;
+        if (span <= 0 || span > expiryMs) return;
+        if (elapsed > maxExtrapolationMs) elapsed = maxExtrapolationMs;
+        other = &previous;
+        t = -static_cast<float>(elapsed) / static_cast<float>(span);
+    }
+
+    ShapeIndex index;
+    IndexShapes(other->shapes, &index);
+    for (size_t i = 0; i < out->size(); ++i) {
+        WVOverlayShape& shape = (*out)[i];
+        ShapeIndex::const_iterator it = index.find(shape.id);
+        if (it == index.end() || it->second->kind != shape.kind) continue;
+        WVOverlayShape blended;
+        Blend(shape, *it->second, t, &blended);
+        shape = blended;
+    }
+}
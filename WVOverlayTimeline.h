@@ -0,0 +1,105 @@
+//
+//  WVOverlayTimeline.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_OVERLAY_TIMELINE_H
+#define WV_OVERLAY_TIMELINE_H
+
+#include "WVOverlayScene.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+// ==================== 覆盖层时间线 ====================
+//
+// 检测结果带着它所对应的媒体时间提交，先进入时间线，等画面播放到该时间时才写入场景，
+// 使检测框与显示的视频帧对齐（检测方处理的是延迟的流副本，直接更新会落在错误的帧上）。
+//
+// 提交内容沿用 WVOverlayScene 的增量命令格式，按提交顺序依次作用于时间线内部的
+// 编辑场景，每个条目保存作用后的完整图形集合，因此既可以每次提交全集，也可以只提交变化。
+// 呈现时取媒体时间 + 容差之前最新的条目，更早的条目随之丢弃；最新条目也早于
+// 媒体时间 - 过期时间时清空覆盖层。条目数有上限，时间线占用的内存有界。
+//
+// 检测频率（5-10 Hz）远低于帧率时，可按 ID 在关键帧之间插值，每次呈现都输出平滑的位置：
+//   线性插值：在当前关键帧与下一个关键帧之间按时间比例插值，需要下一关键帧已经提交
+//             （即显示延迟不小于检测间隔，通常由 network-caching 保证），否则停在当前关键帧；
+//   恒速外推：用最近两个关键帧估计速度，从当前关键帧向后外推，外推时长有上限。
+// 只有前后关键帧中都存在的 ID 参与插值，新出现或消失的图形在关键帧处直接生效。
+
+enum WVOverlayInterpolation {
+    WVOverlayInterpolationNone = 0,
+    WVOverlayInterpolationLinear = 1,
+    WVOverlayInterpolationVelocity = 2
+};
+
+class WVOverlayTimeline {
+public:
+    WVOverlayTimeline();
+
+    /**
+     * 提交一组带媒体时间的覆盖层命令
+     * @return 执行的命令条数，格式错误返回 -1
+     */
+    int Submit(int64_t mediaTimeMs, const uint8_t* commands, size_t length);
+
+    /**
+     * @param toleranceMs 条目时间早于当前媒体时间 + 容差即可呈现
+     * @param expiryMs 呈现中的条目早于当前媒体时间超过该值时清空覆盖层
+     * @param clockOffsetMs 加到媒体时间上的修正（补偿时钟与实际显示帧之间的固定偏差）
+     */
+    void Configure(int toleranceMs, int expiryMs, int clockOffsetMs);
+
+    /**
+     * @param maxExtrapolationMs 恒速外推的最长时间（超过后停在外推终点）
+     */
+    void SetInterpolation(WVOverlayInterpolation mode, int maxExtrapolationMs);
+
+    /**
+     * MASK 命令引用的蒙版存储（转给内部的编辑场景）
+     */
+    void SetMaskStore(WVOverlayMaskStore* store);
+
+    /**
+     * 清空全部条目（新媒体开始、停止时）
+     */
+    void Reset();
+
+    bool Empty() const;
+
+    /**
+     * 按当前媒体时间把到期的条目（开启插值时为插值结果）写入场景，每帧调用
+     * @return 场景是否被修改
+     */
+    bool Present(int64_t mediaTimeMs, WVOverlayScene* scene);
+
+private:
+    WVOverlayTimeline(const WVOverlayTimeline&);
+    WVOverlayTimeline& operator=(const WVOverlayTimeline&);
+
+    struct Entry {
+        int64_t timestampMs;
+        std::vector<WVOverlayShape> shapes;
+    };
+
+    void Interpolate(int64_t now, std::vector<WVOverlayShape>* out) const;
+
+    mutable std::mutex mutex;
+    std::deque<Entry> entries;            // 按时间排序，尚未呈现
+    WVOverlayScene authoring;             // 累积提交的增量命令
+
+    int toleranceMs;
+    int expiryMs;
+    int clockOffsetMs;
+    WVOverlayInterpolation interpolation;
+    int maxExtrapolationMs;
+
+    Entry current;                        // 当前呈现的关键帧，timestampMs 为 -1 表示未呈现
+    Entry previous;                       // 上一关键帧（恒速外推估计速度），timestampMs 为 -1 表示没有
+    std::vector<WVOverlayShape> presented;  // 上次写入场景的图形，未变化时不再写入
+};
+
+#endif // WV_OVERLAY_TIMELINE_H
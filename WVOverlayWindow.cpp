@@ -0,0 +1,286 @@
+//
+//  WVOverlayWindow.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVOverlayWindow.h"
+#include "WVOverlayRaster.h"
+#include "WVLog.h"
+#include <string.h>
+
+namespace {
+
+const wchar_t kOverlayWindowClass[] = L"WVOverlayWindow";
+
+// 按媒体时间呈现时的刷新周期（约一个 60 Hz 显示帧，实际精度受系统定时器限制）
+const UINT_PTR kTimelineTimerId = 1;
+const UINT kTimelineTimerIntervalMs = 15;
+
+} // namespace
+
+WVOverlayWindow::WVOverlayWindow(HWND videoWindow, float scaleX, float scaleY)
+    : hwnd(NULL), videoWindow(videoWindow), scaleX(scaleX), scaleY(scaleY),
+      memoryDC(NULL), bitmap(NULL), previousBitmap(NULL), bits(NULL), width(0), height(0),
+      timedScene(NULL), timeline(NULL), clock(NULL), renderedVersion(0),
+      suspended(false) {
+}
+
+WVOverlayWindow::~WVOverlayWindow() {
+    ReleaseSurface();
+}
+
+bool WVOverlayWindow::RegisterWindowClass() {
+    static bool registered = false;
+    if (registered) return true;
+    
+    WNDCLASSEXW wc = {0};
+    wc.cbSize = sizeof(WNDCLASSEXW);
+    wc.lpfnWndProc = WindowProc;
+    wc.hInstance = GetModuleHandle(NULL);
+    wc.lpszClassName = kOverlayWindowClass;
+    
+    if (RegisterClassExW(&wc) || GetLastError() == ERROR_CLASS_ALREADY_EXISTS) {
+        registered = true;
+    }
+    return registered;
+}
+
+WVOverlayWindow* WVOverlayWindow::Create(HWND videoWindow, float scaleX, float scaleY) {
+    if (!RegisterWindowClass()) {
+        WV_LOG_ERROR("错误：无法注册覆盖层窗口类");
+        return NULL;
+    }
+    
+    RECT rect;
+    GetWindowRect(videoWindow, &rect);
+    
+    WVOverlayWindow* overlay = new WVOverlayWindow(videoWindow, scaleX, scaleY);
+    // 以视频窗口为所有者：始终位于其上方，随其最小化/隐藏
+    HWND hwnd = CreateWindowExW(
+        WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_NOACTIVATE | WS_EX_TOOLWINDOW,
+        kOverlayWindowClass,
+        L"Overlay Window",
+        WS_POPUP,
+        rect.left, rect.top,
+        rect.right - rect.left, rect.bottom - rect.top,
+        videoWindow,
+        NULL,
+        GetModuleHandle(NULL),
+        overlay
+    );
+    if (!hwnd) {
+        WV_LOG_ERROR("错误：无法创建覆盖层窗口，错误码: %d", GetLastError());
+        delete overlay;
+        return NULL;
+    }
+    
+    WV_LOG_DEBUG("覆盖层窗口创建成功: HWND=0x%p", hwnd);
+    return overlay;
+}
+
+LRESULT CALLBACK WVOverlayWindow::WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    switch (msg) {
+        case WM_NCCREATE: {
+            CREATESTRUCTW* create = reinterpret_cast<CREATESTRUCTW*>(lParam);
+            WVOverlayWindow* overlay = static_cast<WVOverlayWindow*>(create->lpCreateParams);
+            overlay->hwnd = hwnd;
+            SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<intptr_t>(overlay));
+            break;
+        }
+        case WM_NCHITTEST:
+            return HTTRANSPARENT;   // 鼠标穿透
+        case WM_TIMER: {
+            WVOverlayWindow* overlay = reinterpret_cast<WVOverlayWindow*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+            if (overlay && wParam == kTimelineTimerId) {
+                overlay->OnTimer();
+            }
+            return 0;
+        }
+        case WM_NCDESTROY: {
+            WVOverlayWindow* overlay = reinterpret_cast<WVOverlayWindow*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+            SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0);
+            delete overlay;
+            break;
+        }
+    }
+    return DefWindowProcW(hwnd, msg, wParam, lParam);
+}
+
+bool WVOverlayWindow::EnsureSurface(int surfaceWidth, int surfaceHeight) {
+    if (bitmap && surfaceWidth == width && surfaceHeight == height) {
+        return true;
+    }
+    ReleaseSurface();
+    if (surfaceWidth <= 0 || surfaceHeight <= 0) {
+        return false;
+    }
+    
+    BITMAPINFO info;
+    memset(&info, 0, sizeof(info));
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = surfaceWidth;
+    info.bmiHeader.biHeight = -surfaceHeight;   // 自上而下
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+    
+    HDC screenDC = GetDC(NULL);
+    memoryDC = CreateCompatibleDC(screenDC);
+    void* pixels = NULL;
+    bitmap = CreateDIBSection(screenDC, &info, DIB_RGB_COLORS, &pixels, NULL, 0);
+    ReleaseDC(NULL, screenDC);
+    if (!memoryDC || !bitmap) {
+        WV_LOG_ERROR("错误：无法创建覆盖层绘制表面 %dx%d", surfaceWidth, surfaceHeight);
+        ReleaseSurface();
+        return false;
+    }
+    
+    previousBitmap = SelectObject(memoryDC, bitmap);
+    bits = static_cast<uint8_t*>(pixels);
+    width = surfaceWidth;
+    height = surfaceHeight;
+    memset(bits, 0, static_cast<size_t>(width) * height * 4);
+    return true;
+}
+
+void WVOverlayWindow::ReleaseSurface() {
+    if (memoryDC) {
+        if (previousBitmap) SelectObject(memoryDC, previousBitmap);
+        DeleteDC(memoryDC);
+    }
+    if (bitmap) DeleteObject(bitmap);
+    memoryDC = NULL;
+    bitmap = NULL;
+    previousBitmap = NULL;
+    bits = NULL;
+    width = 0;
+    height = 0;
+}
+
+void WVOverlayWindow::Render(WVOverlayScene& scene) {
+    RECT rect;
+    GetClientRect(videoWindow, &rect);
+    bool resized = rect.right != width || rect.bottom != height;
+    
+    uint64_t version = renderedVersion;
+    bool dirtyAll = false;
+    bool changed = scene.Snapshot(renderedVersion, &shapes, &version, &dirtyRegions, &dirtyAll);
+    if (!changed && !resized) return;
+    if (!EnsureSurface(rect.right, rect.bottom)) return;
+    renderedVersion = version;
+    
+    if (resized || dirtyAll) {
+        RedrawRegion(0, 0, width, height);
+        Present(NULL);
+        return;
+    }
+    
+    // 只清除并重绘变化图形的旧/新外框（扩大 2 像素覆盖取整误差）
+    RECT bounds = { width, height, 0, 0 };
+    for (size_t i = 0; i < dirtyRegions.size(); ++i) {
+        const WVOverlayBounds& region = dirtyRegions[i];
+        int x0 = static_cast<int>(region.x0 * scaleX) - 2;
+        int y0 = static_cast<int>(region.y0 * scaleY) - 2;
+        int x1 = static_cast<int>(region.x1 * scaleX) + 3;
+        int y1 = static_cast<int>(region.y1 * scaleY) + 3;
+        if (x0 < 0) x0 = 0;
+        if (y0 < 0) y0 = 0;
+        if (x1 > width) x1 = width;
+        if (y1 > height) y1 = height;
+        if (x0 >= x1 || y0 >= y1) continue;
+        
+        RedrawRegion(x0, y0, x1, y1);
+        if (x0 < bounds.left) bounds.left = x0;
+        if (y0 < bounds.top) bounds.top = y0;
+        if (x1 > bounds.right) bounds.right = x1;
+        if (y1 > bounds.bottom) bounds.bottom = y1;
+    }
+    if (bounds.left < bounds.right && bounds.top < bounds.bottom) {
+        Present(&bounds);
+    }
+}
+
+void WVOverlayWindow::RedrawRegion(int x0, int y0, int x1, int y1) {
+    WVOverlaySurface surface = { bits, width, height, width * 4 };
+    WVOverlayClearRect(surface, x0, y0, x1, y1);
+    WVOverlayRenderShapes(WVOverlaySubSurface(surface, x0, y0, x1, y1), shapes, scaleX, scaleY, x0, y0,
+                          width, height);
+}
+
+void WVOverlayWindow::Present(const RECT* dirtyRect) {
+    if (suspended) return;
+    
+    RECT rect;
+    GetWindowRect(videoWindow, &rect);
+    POINT position = { rect.left, rect.top };
+    SIZE size = { width, height };
+    POINT source = { 0, 0 };
+    BLENDFUNCTION blend = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+    
+    UPDATELAYEREDWINDOWINFO info;
+    memset(&info, 0, sizeof(info));
+    info.cbSize = sizeof(info);
+    info.pptDst = &position;
+    info.psize = &size;
+    info.hdcSrc = memoryDC;
+    info.pptSrc = &source;
+    info.pblend = &blend;
+    info.dwFlags = ULW_ALPHA;
+    info.prcDirty = dirtyRect;   // NULL 表示整个窗口
+    
+    if (!UpdateLayeredWindowIndirect(hwnd, &info)) {
+        WV_LOG_WARN("警告：覆盖层提交失败，错误码: %d", GetLastError());
+        return;
+    }
+    if (!IsWindowVisible(hwnd)) {
+        ShowWindow(hwnd, SW_SHOWNOACTIVATE);
+    }
+}
+
+void WVOverlayWindow::SyncPosition() {
+    RECT rect;
+    GetWindowRect(videoWindow, &rect);
+    SetWindowPos(hwnd, NULL, rect.left, rect.top, 0, 0, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+void WVOverlayWindow::AttachTimeline(WVOverlayScene* scene, WVOverlayTimeline* attachedTimeline,
+                                     WVMediaClock* attachedClock) {
+    if (timeline) return;
+    
+    timedScene = scene;
+    timeline = attachedTimeline;
+    clock = attachedClock;
+    SetTimer(hwnd, kTimelineTimerId, kTimelineTimerIntervalMs, NULL);
+}
+
+void WVOverlayWindow::OnTimer() {
+    if (!timeline) return;
+    
+    if (timeline->Present(clock->NowMs(), timedScene)) {
+        Render(*timedScene);
+    }
+}
+
+void WVOverlayWindow::SetSuspended(bool value) {
+    if (suspended == value) return;
+    suspended = value;
+    if (suspended) {
+        ShowWindow(hwnd, SW_HIDE);
+    } else if (bits) {
+        Present(NULL);
+    }
+}
+
+void WVOverlayWindow::Detach() {
+    KillTimer(hwnd, kTimelineTimerId);
+    timedScene = NULL;
+    timeline = NULL;
+    clock = NULL;
+    ShowWindow(hwnd, SW_HIDE);
+}
+
+void WVOverlayWindow::Close() {
+    PostMessageW(hwnd, WM_CLOSE, 0, 0);
+}
@@ -0,0 +1,101 @@
+//
+//  WVOverlayWindow.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_OVERLAY_WINDOW_H
+#define WV_OVERLAY_WINDOW_H
+
+#include <windows.h>
+#include "WVOverlayScene.h"
+#include "WVOverlayTimeline.h"
+#include "WVMediaClock.h"
+#include <vector>
+
+// ==================== 覆盖层窗口 ====================
+//
+// 窗口模式下覆盖在视频窗口之上的分层窗口（WS_EX_LAYERED，由视频窗口拥有，始终在其上方，
+// 鼠标穿透）。内容画在一块常驻的 32 位 DIB 上并通过 UpdateLayeredWindow 以逐像素 alpha
+// 提交：不使用颜色键，不走 WM_PAINT，DIB 与内存 DC 只在尺寸变化时重建。
+// 场景的脏区域只在这些区域内清除重绘，并通过 UpdateLayeredWindowIndirect 只提交其外接矩形。
+// 所有方法都必须在创建窗口的 UI 线程上调用。
+
+class WVOverlayWindow {
+public:
+    /**
+     * 在视频窗口上方创建覆盖层窗口
+     * @param scaleX / scaleY 图形坐标（CSS 像素）到窗口像素的 DPI 缩放
+     */
+    static WVOverlayWindow* Create(HWND videoWindow, float scaleX, float scaleY);
+
+    /**
+     * 场景有变化时重新绘制并提交
+     */
+    void Render(WVOverlayScene& scene);
+
+    /**
+     * 启用按媒体时间呈现：窗口定时器按媒体时钟把时间线中到期的条目写入场景并重绘
+     * 重复调用无副作用
+     */
+    void AttachTimeline(WVOverlayScene* scene, WVOverlayTimeline* timeline, WVMediaClock* clock);
+
+    /**
+     * 停止定时器、隐藏窗口并解除对场景/时间线的引用（释放播放器前调用）
+     */
+    void Detach();
+
+    /**
+     * 播放器不可见时隐藏覆盖层；期间照常绘制到表面但不提交，恢复时一次提交整个窗口
+     */
+    void SetSuspended(bool suspended);
+
+    /**
+     * 跟随视频窗口的位置与大小
+     */
+    void SyncPosition();
+
+    /**
+     * 关闭窗口；对象在窗口销毁（WM_NCDESTROY）时自行删除，可在任意线程调用
+     */
+    void Close();
+
+private:
+    WVOverlayWindow(HWND videoWindow, float scaleX, float scaleY);
+    ~WVOverlayWindow();
+    WVOverlayWindow(const WVOverlayWindow&);
+    WVOverlayWindow& operator=(const WVOverlayWindow&);
+
+    static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+    static bool RegisterWindowClass();
+
+    bool EnsureSurface(int surfaceWidth, int surfaceHeight);
+    void ReleaseSurface();
+    void OnTimer();
+    void RedrawRegion(int x0, int y0, int x1, int y1);
+    void Present(const RECT* dirtyRect);
+
+    HWND hwnd;
+    HWND videoWindow;
+    float scaleX;
+    float scaleY;
+
+    HDC memoryDC;
+    HBITMAP bitmap;
+    HGDIOBJ previousBitmap;
+    uint8_t* bits;
+    int width;
+    int height;
+
+    WVOverlayScene* timedScene;           // AttachTimeline 之后由定时器驱动
+    WVOverlayTimeline* timeline;
+    WVMediaClock* clock;
+
+    std::vector<WVOverlayShape> shapes;   // 最近一次绘制的场景快照
+    std::vector<WVOverlayBounds> dirtyRegions;
+    uint64_t renderedVersion;
+    bool suspended;
+};
+
+#endif // WV_OVERLAY_WINDOW_H
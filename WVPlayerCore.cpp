@@ -0,0 +1,1612 @@
+//
+//  WVPlayerCore.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WinVLCBridge.h"
+#include "WVPlayerWrapper.h"
+#include "WVLog.h"
+#include "WVVlcLog.h"
+#include "WVQualityGovernor.h"
+#include "WVReconnectSupervisor.h"
+#include "WVConnectionScheduler.h"
+#include <atomic>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdio.h>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+// 播放器中与平台无关的部分：帧回调模式、媒体创建与播放控制、覆盖层、画质调节、重连与连接调度。
+// 窗口模式见 WinVLCBridge.cpp
+
+// ==================== 工具函数 ====================
+
+static void ApplyQualityLevel(WVPlayerWrapper* wrapper, int level);
+static void Reconnect(WVPlayerWrapper* wrapper, unsigned long long generation);
+static void OnStandbyFirstFrame(WVPlayerWrapper* wrapper, libvlc_media_player_t* source);
+static void StartStandby(WVPlayerWrapper* wrapper, const std::string& requestedSource,
+                         const std::string& sourcePath, int rendition, bool autoSwap);
+static void CancelStandby(WVPlayerWrapper* wrapper, libvlc_media_player_t* source);
+static void PlayStandby(WVPlayerWrapper* wrapper, unsigned long long generation, unsigned long long ticket);
+
+// 单调时钟（微秒），用于测量启动耗时
+static long long MonotonicMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 视频输出创建后配置缩放和宽高比（在命令队列工作线程上执行）
+static void ConfigureVideoOutput(WVPlayerWrapper* wrapper) {
+    // 首帧已出现，连接名额交给下一个排队的播放器
+    WVConnectionScheduler::Release(wrapper);
+    
+    // 设置视频自动适配窗口，保持宽高比（letterbox/pillarbox效果）
+    // scale = 0 表示自动适配
+    libvlc_video_set_scale(wrapper->mediaPlayer, 0);
+    
+    // 获取视频实际尺寸
+    unsigned int videoWidth = 0, videoHeight = 0;
+    if (wrapper->videoWindow &&
+        libvlc_video_get_size(wrapper->mediaPlayer, 0, &videoWidth, &videoHeight) == 0) {
+        WV_LOG_DEBUG("视频原始尺寸: %ux%u", videoWidth, videoHeight);
+        if (wrapper->wall) {
+            wrapper->wall->ReportResolution(wrapper->wallTile, videoWidth, videoHeight);
+        }
+        WV_LOG_DEBUG("窗口尺寸: %dx%d", wrapper->videoWidth, wrapper->videoHeight);
+        
+        // 计算宽高比
+        float videoAspect = (float)videoWidth / (float)videoHeight;
+        float windowAspect = (float)wrapper->videoWidth / (float)wrapper->videoHeight;
+        
+        if (videoAspect > windowAspect) {
+            WV_LOG_DEBUG("视频更宽，将产生上下黑边（letterbox）");
+        } else {
+            WV_LOG_DEBUG("视频更高，将产生左右黑边（pillarbox）");
+        }
+    }
+    
+    // 记录从发起播放到画面配置完成的耗时（同一次播放只记录首次）
+    if (wrapper->playRequestedAt > 0) {
+        long long latencyUs = MonotonicMicros() - wrapper->playRequestedAt;
+        wrapper->playRequestedAt = 0;
+        wrapper->firstFrameLatencyUs = latencyUs;
+        if (wrapper->replacingSource) {
+            wrapper->switchGapUs = latencyUs;
+            wrapper->replacingSource = false;
+        }
+        WV_LOG_INFO("视频适配模式已设置完成，首帧配置耗时: %.1f ms", latencyUs / 1000.0);
+    } else {
+        WV_LOG_INFO("视频适配模式已设置完成");
+    }
+}
+
+// 按 suspendRequested 关闭或恢复视频与音频轨道（在命令队列工作线程上执行）
+// 关闭轨道会销毁解码器与视频输出，输入线程仍在读取，网络会话保持；
+// 恢复时重建解码器，画面从下一个关键帧开始
+static void ApplyDecodeSuspension(WVPlayerWrapper* wrapper) {
+    bool suspend = wrapper->suspendRequested;
+    if (suspend == wrapper->decodeSuspended) return;
+    
+    if (suspend) {
+        // 轨道在开始播放后才存在，尚未播放时由 Playing 事件再次触发
+        libvlc_state_t state = libvlc_media_player_get_state(wrapper->mediaPlayer);
+        if (state != libvlc_Playing && state != libvlc_Paused) return;
+        
+        wrapper->suspendedVideoTrack = libvlc_video_get_track(wrapper->mediaPlayer);
+        wrapper->suspendedAudioTrack = libvlc_audio_get_track(wrapper->mediaPlayer);
+        libvlc_video_set_track(wrapper->mediaPlayer, -1);
+        libvlc_audio_set_track(wrapper->mediaPlayer, -1);
+        wrapper->decodeSuspended = true;
+        WV_LOG_INFO("播放器不可见，已停止解码（视频轨道 %d，音频轨道 %d）",
+                    wrapper->suspendedVideoTrack, wrapper->suspendedAudioTrack);
+    } else {
+        if (wrapper->suspendedVideoTrack >= 0) {
+            libvlc_video_set_track(wrapper->mediaPlayer, wrapper->suspendedVideoTrack);
+        }
+        if (wrapper->suspendedAudioTrack >= 0) {
+            libvlc_audio_set_track(wrapper->mediaPlayer, wrapper->suspendedAudioTrack);
+        }
+        wrapper->decodeSuspended = false;
+        WV_LOG_INFO("播放器恢复可见，重新开始解码");
+    }
+}
+
+// VLC 事件回调：视频开始播放
+// 事件回调运行在 VLC 的线程上，不能阻塞，也不应在回调中调用播放器的 libVLC 函数
+static void OnMediaPlayerPlaying(const libvlc_event_t*, void* userData) {
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(userData);
+    if (!wrapper || !wrapper->mediaPlayer) return;
+    
+    WV_LOG_INFO("视频开始播放事件触发，等待视频输出创建后设置适配模式...");
+    
+    // 播放开始前已设为不可见：轨道创建后再关闭
+    if (wrapper->suspendRequested) {
+        wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper] {
+            ApplyDecodeSuspension(wrapper);
+        });
+    }
+}
+
+// VLC 事件回调：视频输出创建（或数量变化），此时才能可靠地设置缩放
+static void OnMediaPlayerVout(const libvlc_event_t* event, void* userData) {
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(userData);
+    if (!wrapper || !wrapper->mediaPlayer) return;
+    if (event->u.media_player_vout.new_count <= 0) return;
+    
+    // 交给命令队列工作线程执行，不占用 VLC 事件线程
+    wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper] {
+        ConfigureVideoOutput(wrapper);
+    });
+}
+
+// VLC 事件回调：预先打开新源的播放器（替换之前与当前播放器持有同一个 owner）
+static void OnStandbyPlayerEvent(const libvlc_event_t* event, WVPlayerWrapper* wrapper,
+                                 libvlc_media_player_t* source) {
+    if (event->type == libvlc_MediaPlayerVout && event->u.media_player_vout.new_count > 0) {
+        wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, source] {
+            OnStandbyFirstFrame(wrapper, source);
+        });
+    } else if (event->type == libvlc_MediaPlayerEncounteredError) {
+        wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, source] {
+            CancelStandby(wrapper, source);
+        });
+    }
+}
+
+// VLC 事件分发（由播放器池转发，userData 为当前持有该播放器的 WVPlayerWrapper）
+static void OnMediaPlayerEvent(const libvlc_event_t* event, void* userData) {
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(userData);
+    
+    // 切换码流期间两个播放器的事件都转发到这里，只有当前播放器的事件影响播放状态
+    libvlc_media_player_t* source = static_cast<libvlc_media_player_t*>(event->p_obj);
+    bool current;
+    {
+        std::lock_guard<std::mutex> lock(wrapper->playerMutex);
+        current = source == wrapper->mediaPlayer;
+    }
+    if (!current) {
+        OnStandbyPlayerEvent(event, wrapper, source);
+        return;
+    }
+    
+    switch (event->type) {
+        case libvlc_MediaPlayerPlaying:
+            wrapper->mediaClock->SetPlaying(true);
+            wrapper->caching->OnPlaying();
+            OnMediaPlayerPlaying(event, userData);
+            break;
+        case libvlc_MediaPlayerBuffering:
+            wrapper->caching->OnBuffering(event->u.media_player_buffering.new_cache);
+            break;
+        case libvlc_MediaPlayerVout:
+            OnMediaPlayerVout(event, userData);
+            break;
+        case libvlc_MediaPlayerTimeChanged:
+            wrapper->mediaClock->OnTimeChanged(event->u.media_player_time_changed.new_time);
+            wrapper->caching->OnTimeChanged(event->u.media_player_time_changed.new_time);
+            break;
+        case libvlc_MediaPlayerPaused:
+        case libvlc_MediaPlayerStopped:
+            wrapper->mediaClock->SetPlaying(false);
+            break;
+        case libvlc_MediaPlayerEncounteredError:
+            WVConnectionScheduler::Release(wrapper);
+            break;
+        default:
+            break;
+    }
+}
+
+// 判断字符串是否为网络流地址
+static bool IsNetworkStream(const std::string& source) {
+    std::string lower = source;
+    for (auto& c : lower) c = tolower(c);
+    
+    return lower.find("http://") == 0 ||
+           lower.find("https://") == 0 ||
+           lower.find("rtsp://") == 0 ||
+           lower.find("rtmp://") == 0 ||
+           lower.find("rtmps://") == 0 ||
+           lower.find("rtp://") == 0;
+}
+
+#ifdef _WIN32
+// 转换路径为标准格式
+static std::string NormalizePath(const std::string& path) {
+    if (IsNetworkStream(path)) {
+        return path;
+    }
+    
+    // 对于本地文件，确保使用正斜杠
+    std::string normalized = path;
+    for (auto& c : normalized) {
+        if (c == '\\') c = '/';
+    }
+    return normalized;
+}
+#endif
+
+// 构建默认的 libVLC 启动参数
+// Windows 上插件目录位于 DLL 同级的 plugins 目录；其他平台使用 libVLC 安装时的插件目录（或 VLC_PLUGIN_PATH）
+static std::vector<std::string> BuildDefaultVlcArgs() {
+    std::vector<std::string> vlcArgs;
+#ifdef _WIN32
+    // 获取 DLL 所在目录，用于定位 VLC 插件
+    char dllPath[MAX_PATH];
+    HMODULE hModule = NULL;
+    GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       (LPCSTR)&wv_create_frame_player, &hModule);
+    GetModuleFileNameA(hModule, dllPath, MAX_PATH);
+    
+    // 获取 DLL 所在目录
+    std::string dllDir = dllPath;
+    size_t lastSlash = dllDir.find_last_of("\\/");
+    if (lastSlash != std::string::npos) {
+        dllDir = dllDir.substr(0, lastSlash);
+    }
+    
+    // 构建插件路径
+    vlcArgs.push_back("--plugin-path=" + dllDir + "\\plugins");
+#endif
+    vlcArgs.push_back("--file-caching=50");
+    vlcArgs.push_back("--network-caching=100");
+    vlcArgs.push_back("--avcodec-fast");
+    vlcArgs.push_back("--no-sub-autodetect-file");
+    vlcArgs.push_back("--no-video-title-show");
+    vlcArgs.push_back("--no-snapshot-preview");
+    vlcArgs.push_back("--no-osd");
+    vlcArgs.push_back("--no-video-title");           // 不显示视频标题
+    vlcArgs.push_back("--no-mouse-events");          // 禁用鼠标事件
+    vlcArgs.push_back("--no-keyboard-events");       // 禁用键盘事件
+    return vlcArgs;
+}
+
+// 播放器池水位（可通过 wv_player_pool_configure 修改）
+static std::atomic<int> g_poolLowWatermark(2);
+static std::atomic<int> g_poolHighWatermark(8);
+static std::atomic<bool> g_poolConfigured(false);
+
+// 首次使用时按默认水位配置播放器池并开始预热（多个线程同时创建播放器时只有一个执行配置）
+static void EnsurePlayerPoolConfigured(const std::vector<std::string>& vlcArgs) {
+    bool expected = false;
+    if (!g_poolConfigured.compare_exchange_strong(expected, true)) return;
+    
+    int lowWatermark = g_poolLowWatermark;
+    int highWatermark = g_poolHighWatermark;
+    WVPlayerPool::SetEventDispatcher(OnMediaPlayerEvent);
+    WVPlayerPool::Configure(vlcArgs, lowWatermark, highWatermark);
+    WV_LOG_INFO("播放器池已配置：低水位=%d, 高水位=%d", lowWatermark, highWatermark);
+}
+
+// 创建覆盖层场景、时间线、蒙版存储与媒体时钟（两种模式共用）
+static void CreateOverlayState(WVPlayerWrapper* wrapper) {
+    wrapper->overlayMasks = new WVOverlayMaskStore();
+    wrapper->overlayScene = new WVOverlayScene();
+    wrapper->overlayScene->SetMaskStore(wrapper->overlayMasks);
+    wrapper->overlayTimeline = new WVOverlayTimeline();
+    wrapper->overlayTimeline->SetMaskStore(wrapper->overlayMasks);
+    wrapper->mediaClock = new WVMediaClock();
+}
+
+// 取得当前播放器的引用（任意线程），用完后调用 libvlc_media_player_release
+// 锁内只增加引用，不在持有 playerMutex 时调用会获取播放器锁的函数（事件回调也会获取 playerMutex）
+static libvlc_media_player_t* RetainMediaPlayer(WVPlayerWrapper* wrapper) {
+    std::lock_guard<std::mutex> lock(wrapper->playerMutex);
+    libvlc_media_player_retain(wrapper->mediaPlayer);
+    return wrapper->mediaPlayer;
+}
+
+// 读取当前媒体的解码统计与播放器状态（任意线程，state、durationMs 可为 NULL）
+// 通过播放器取得媒体的引用，不访问工作线程上会被替换的 currentMedia
+// 时长取自媒体项（只获取媒体项的锁）；libvlc_media_player_get_length 会获取输入线程的锁，可能阻塞
+static bool ReadDecodeStats(WVPlayerWrapper* wrapper, libvlc_media_stats_t* stats, libvlc_state_t* state,
+                            long long* durationMs = NULL) {
+    libvlc_media_player_t* mediaPlayer = RetainMediaPlayer(wrapper);
+    libvlc_media_t* media = libvlc_media_player_get_media(mediaPlayer);
+    if (state) *state = libvlc_media_player_get_state(mediaPlayer);
+    libvlc_media_player_release(mediaPlayer);
+    if (!media) return false;
+    
+    if (durationMs) *durationMs = libvlc_media_get_duration(media);
+    int ok = libvlc_media_get_stats(media, stats);
+    libvlc_media_release(media);
+    return ok != 0;
+}
+
+// 结束当前网络连接的缓存统计（在命令队列工作线程上、替换或停止当前媒体之前调用）
+static void EndCachingSession(WVPlayerWrapper* wrapper) {
+    libvlc_media_stats_t stats;
+    if (ReadDecodeStats(wrapper, &stats, NULL)) {
+        wrapper->caching->EndSession(static_cast<unsigned long long>(stats.i_decoded_video),
+                                     static_cast<unsigned long long>(stats.i_lost_pictures));
+    } else {
+        wrapper->caching->EndSession(0, 0);
+    }
+}
+
+// 登记到画质调节器：调节器线程读取解码统计，级别变化交给命令队列工作线程
+static void RegisterQualityGovernor(WVPlayerWrapper* wrapper) {
+    WVQualityGovernor::Register(wrapper,
+        [wrapper](WVQualitySample* sample) {
+            libvlc_media_stats_t stats;
+            libvlc_state_t state;
+            if (!ReadDecodeStats(wrapper, &stats, &state)) return false;
+            sample->decoded = static_cast<unsigned long long>(stats.i_decoded_video);
+            sample->lost = static_cast<unsigned long long>(stats.i_lost_pictures);
+            sample->playing = !wrapper->suspendRequested && state == libvlc_Playing;
+            return true;
+        },
+        [wrapper](int level) {
+            wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, level] {
+                ApplyQualityLevel(wrapper, level);
+            });
+        });
+}
+
+// 登记到重连监督器：监督器线程读取状态与显示帧数，重连交给命令队列工作线程
+static void RegisterReconnectSupervisor(WVPlayerWrapper* wrapper) {
+    WVReconnectSupervisor::Register(wrapper,
+        [wrapper](WVHealthSample* sample) {
+            // 在监督器持有内部锁时调用：只读取不会阻塞在输入线程上的信息
+            libvlc_media_stats_t stats;
+            libvlc_state_t state;
+            long long durationMs = -1;
+            if (!ReadDecodeStats(wrapper, &stats, &state, &durationMs)) return false;
+            
+            // 有时长的媒体播放到结尾是正常结束；直播流没有时长，Ended 说明连接被关闭
+            bool ended = state == libvlc_Ended && durationMs > 0;
+            sample->frames = static_cast<unsigned long long>(stats.i_displayed_pictures);
+            sample->active = state == libvlc_Opening || state == libvlc_Buffering || state == libvlc_Playing;
+            sample->paused = state == libvlc_Paused;
+            sample->failed = state == libvlc_Error || (state == libvlc_Ended && !ended);
+            sample->finished = ended;
+            sample->suspended = wrapper->suspendRequested;
+            sample->queued = wrapper->connectQueued;
+            return true;
+        },
+        [wrapper](unsigned long long generation) {
+            wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, generation] {
+                Reconnect(wrapper, generation);
+            });
+        });
+}
+
+
+bool WVPlayerCheckout(WVPlayerWrapper* wrapper) {
+    std::vector<std::string> vlcArgs = BuildDefaultVlcArgs();
+    EnsurePlayerPoolConfigured(vlcArgs);
+    
+    wrapper->pooledPlayer = WVPlayerPool::Checkout(vlcArgs, wrapper);
+    if (!wrapper->pooledPlayer) {
+        WV_LOG_ERROR("错误：无法初始化 libVLC 或创建媒体播放器");
+        return false;
+    }
+    wrapper->vlcInstance = wrapper->pooledPlayer->instance;
+    wrapper->mediaPlayer = wrapper->pooledPlayer->mediaPlayer;
+    wrapper->eventManager = wrapper->pooledPlayer->eventManager;
+    return true;
+}
+
+void WVPlayerStart(WVPlayerWrapper* wrapper) {
+    CreateOverlayState(wrapper);
+    
+    // 创建控制命令队列（独立工作线程）
+    wrapper->commandQueue = new WVCommandQueue();
+    wrapper->caching = new WVCachingController();
+    RegisterQualityGovernor(wrapper);
+    RegisterReconnectSupervisor(wrapper);
+}
+
+// ==================== 公共 API 实现 ====================
+
+void* wv_create_frame_player(const char* sharedMemoryName, int width, int height) {
+    if (!sharedMemoryName || !*sharedMemoryName) {
+        WV_LOG_ERROR("错误：共享内存名称为空");
+        return NULL;
+    }
+    
+    WVPlayerWrapper* wrapper = new WVPlayerWrapper();  // 值初始化，所有成员清零
+    wrapper->videoWidth = width > 0 ? width : 0;
+    wrapper->videoHeight = height > 0 ? height : 0;
+    wrapper->activeRendition = -1;
+    wrapper->activeSurface = -1;
+    wrapper->renditionWidth = wrapper->videoWidth;
+    wrapper->renditionHeight = wrapper->videoHeight;
+    
+    if (!WVPlayerCheckout(wrapper)) {
+        delete wrapper;
+        return NULL;
+    }
+    // 帧回调注册后无法还原为窗口模式，释放时不放回池中
+    wrapper->pooledPlayer->reusable = false;
+    
+    // 命令队列尚无命令，播放开始前帧回调已经注册
+    WVPlayerStart(wrapper);
+    wrapper->frameOutput = new WVFrameOutput(sharedMemoryName, wrapper->videoWidth, wrapper->videoHeight);
+    wrapper->frameOutput->SetOverlay(wrapper->overlayScene, wrapper->overlayTimeline, wrapper->mediaClock);
+    wrapper->frameOutput->Attach(wrapper->mediaPlayer);
+    
+    WV_LOG_INFO("帧回调播放器创建成功 - 共享内存: %s, 输出尺寸: %dx%d（0 表示原始尺寸）",
+                sharedMemoryName, wrapper->videoWidth, wrapper->videoHeight);
+    return wrapper;
+}
+
+void wv_frame_player_set_colorspace(void* playerHandle, int matrix, int range) {
+    if (!playerHandle) return;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    if (!wrapper->frameOutput) {
+        WV_LOG_WARN("警告：非帧回调播放器，忽略颜色空间设置");
+        return;
+    }
+    wrapper->frameOutput->SetColorspace(matrix, range);
+}
+
+// 以下 Do* 函数在播放器命令队列的工作线程上执行
+
+// 画质调节器各级别的解码选项（avcodec 在打开解码器时读取），级别越高包含越低级别的设置
+static void AddQualityOptions(libvlc_media_t* media, int level) {
+    if (level >= WVQualityKeyframes) {
+        libvlc_media_add_option(media, ":avcodec-skip-frame=3");       // 跳过非关键帧
+    } else if (level >= WVQualityReduced) {
+        libvlc_media_add_option(media, ":avcodec-skip-frame=1");       // 跳过非参考帧
+    }
+    if (level >= WVQualityReduced) {
+        libvlc_media_add_option(media, ":avcodec-skiploopfilter=4");   // 跳过全部环路滤波
+    }
+}
+
+// 创建媒体对象并加上网络、解码线程与画质选项，失败时返回 NULL
+// @param standby 为 standby 打开：监控墙只计算线程数（记在 standbyThreads），替换当前源时才登记
+static libvlc_media_t* CreateMedia(WVPlayerWrapper* wrapper, const std::string& sourcePath, bool standby) {
+    WV_LOG_DEBUG("原始路径: %s", sourcePath.c_str());
+    
+    // 创建媒体对象
+    libvlc_media_t* media = NULL;
+    
+    if (IsNetworkStream(sourcePath)) {
+        // 网络流
+        WV_LOG_DEBUG("检测到网络流，使用 location 方式");
+        media = libvlc_media_new_location(wrapper->vlcInstance, sourcePath.c_str());
+        
+        // 设置网络流选项（缓存时长按该源之前连接的网络状况选择）
+        if (media) {
+            int cachingMs = wrapper->caching->CachingFor(sourcePath);
+            char option[48];
+            snprintf(option, sizeof(option), ":network-caching=%d", cachingMs);
+            libvlc_media_add_option(media, option);
+            snprintf(option, sizeof(option), ":live-caching=%d", cachingMs);
+            libvlc_media_add_option(media, option);
+            WV_LOG_DEBUG("网络缓存: %d ms", cachingMs);
+            libvlc_media_add_option(media, ":clock-jitter=0");
+            libvlc_media_add_option(media, ":clock-synchro=0");
+        }
+    } else {
+        // 本地文件 - 检查文件是否存在
+#ifdef _WIN32
+        DWORD fileAttr = GetFileAttributesA(sourcePath.c_str());
+        bool exists = fileAttr != INVALID_FILE_ATTRIBUTES;
+#else
+        struct stat fileInfo;
+        bool exists = stat(sourcePath.c_str(), &fileInfo) == 0;
+#endif
+        if (!exists) {
+            WV_LOG_ERROR("错误：文件不存在: %s", sourcePath.c_str());
+            return NULL;
+        }
+        
+        WV_LOG_DEBUG("文件存在，准备创建媒体对象");
+        
+#ifdef _WIN32
+        // 将路径转换为 file:/// URI 格式（VLC 更可靠地支持这种格式）
+        std::string normalizedPath = NormalizePath(sourcePath);
+        std::string fileUri = "file:///" + normalizedPath;
+        
+        WV_LOG_DEBUG("使用 URI: %s", fileUri.c_str());
+        
+        // 使用 location 方式创建本地文件媒体（比 new_path 更可靠）
+        media = libvlc_media_new_location(wrapper->vlcInstance, fileUri.c_str());
+        
+        if (!media) {
+            WV_LOG_WARN("location 方式失败，尝试 path 方式");
+            // 如果失败，尝试使用 new_path（使用原始路径）
+            media = libvlc_media_new_path(wrapper->vlcInstance, sourcePath.c_str());
+        }
+#else
+        // 绝对路径由 libVLC 转换为 file:// URI（相对路径按当前目录解析）
+        media = libvlc_media_new_path(wrapper->vlcInstance, sourcePath.c_str());
+#endif
+    }
+    
+    if (!media) {
+        WV_LOG_ERROR("错误：无法创建媒体对象");
+        const char* vlcError = libvlc_errmsg();
+        if (vlcError) {
+            WV_LOG_ERROR("VLC 错误信息: %s", vlcError);
+        }
+        return NULL;
+    }
+    
+    WV_LOG_DEBUG("媒体对象创建成功");
+    
+    // 监控墙的块在墙的线程预算内限制解码线程数（在打开解码器时生效）
+    if (wrapper->wall) {
+        int threads = standby ? wrapper->wall->PlanPlay(wrapper->wallTile, sourcePath)
+                              : wrapper->wall->BeginPlay(wrapper->wallTile, sourcePath);
+        if (standby) wrapper->standbyThreads = threads;
+        char option[32];
+        snprintf(option, sizeof(option), ":avcodec-threads=%d", threads);
+        libvlc_media_add_option(media, option);
+        WV_LOG_DEBUG("监控墙块 %d 解码线程数: %d", wrapper->wallTile, threads);
+    }
+    
+    AddQualityOptions(media, wrapper->qualityLevel);
+    return media;
+}
+
+// 按请求的源选择要打开的地址：登记过的码流（或未指定源）按显示尺寸选择
+static std::string ResolveSource(WVPlayerWrapper* wrapper, const std::string& requestedSource, int* rendition) {
+    *rendition = -1;
+    if (!wrapper->renditions.Empty() &&
+        (requestedSource.empty() || wrapper->renditions.Find(requestedSource) >= 0)) {
+        *rendition = wrapper->renditions.Select(wrapper->renditionWidth, wrapper->renditionHeight);
+        WV_LOG_INFO("按显示尺寸 %dx%d 选择码流 %d", wrapper->renditionWidth, wrapper->renditionHeight, *rendition);
+        return wrapper->renditions.Source(*rendition);
+    }
+    return requestedSource;
+}
+
+// 连接调度的优先级：可见的播放器先连接，其次按 wv_player_set_priority 设置的优先级
+static int ConnectionPriority(WVPlayerWrapper* wrapper) {
+    const int kVisibleBoost = 1000;
+    return (wrapper->suspendRequested ? 0 : kVisibleBoost) + WVQualityGovernor::Priority(wrapper);
+}
+
+// 打开已解析的源并开始播放（网络流已取得连接名额）
+static void OpenSource(WVPlayerWrapper* wrapper, const std::string& sourcePath, long long startTimeMs) {
+    wrapper->connectQueued = false;
+    EndCachingSession(wrapper);
+    
+    libvlc_media_t* media = CreateMedia(wrapper, sourcePath, false);
+    if (!media) {
+        WVConnectionScheduler::Release(wrapper);   // 没有发起连接，名额交给下一个排队的播放器
+        return;
+    }
+    if (startTimeMs > 0) {
+        char option[48];
+        snprintf(option, sizeof(option), ":start-time=%.3f", startTimeMs / 1000.0);
+        libvlc_media_add_option(media, option);
+    }
+    
+    // 登记了多码流的窗口播放器渲染到子窗口，之后的切换在两个子窗口之间交替
+    if (wrapper->surfacesReady) {
+        if (wrapper->activeSurface < 0) wrapper->activeSurface = 0;
+        WVWindowBindSurface(wrapper, wrapper->mediaPlayer, wrapper->activeSurface, true);
+    }
+    
+    // 设置媒体并播放
+    // 释放旧的媒体对象（如果存在）
+    if (wrapper->currentMedia) {
+        libvlc_media_release(wrapper->currentMedia);
+    }
+    
+    // 保存当前媒体对象的引用
+    wrapper->currentMedia = media;
+    
+    // 替换正在显示的源时，从这里到新源首帧之间没有画面
+    libvlc_state_t previousState = libvlc_media_player_get_state(wrapper->mediaPlayer);
+    wrapper->replacingSource = previousState == libvlc_Playing || previousState == libvlc_Paused;
+    
+    libvlc_media_player_set_media(wrapper->mediaPlayer, media);
+    
+    // 新媒体的轨道重新选择；不可见时由 Playing 事件再次关闭
+    wrapper->decodeSuspended = false;
+    
+    // 新媒体的时间轴从头开始，上一段的时间线条目不再有效
+    wrapper->mediaClock->Reset();
+    wrapper->overlayTimeline->Reset();
+    
+    wrapper->playRequestedAt = MonotonicMicros();
+    wrapper->firstFrameLatencyUs = 0;
+    if (IsNetworkStream(sourcePath)) {
+        wrapper->caching->BeginSession(sourcePath, false);
+    }
+    int playResult = libvlc_media_player_play(wrapper->mediaPlayer);
+    WVReconnectSupervisor::OnOpen(wrapper, IsNetworkStream(sourcePath));
+    
+    if (playResult != 0) {
+        WVConnectionScheduler::Release(wrapper);
+    }
+    
+    if (playResult == 0) {
+        WV_LOG_INFO("开始播放: %s", sourcePath.c_str());
+        WV_LOG_DEBUG("等待视频准备就绪，将在播放事件中设置缩放模式...");
+    } else {
+        WV_LOG_ERROR("错误：播放失败，返回码: %d", playResult);
+        const char* vlcError = libvlc_errmsg();
+        if (vlcError) {
+            WV_LOG_ERROR("VLC 错误信息: %s", vlcError);
+        }
+    }
+}
+
+static void DoPlay(WVPlayerWrapper* wrapper, const std::string& requestedSource, long long startTimeMs = 0) {
+    CancelStandby(wrapper, NULL);
+    wrapper->playSource = requestedSource;
+    
+    std::string sourcePath = ResolveSource(wrapper, requestedSource, &wrapper->activeRendition);
+    // 画质调节器降到子码流级别时改为打开子码流
+    if (wrapper->qualityLevel >= WVQualitySubstream && !wrapper->substreamSource.empty()) {
+        sourcePath = wrapper->substreamSource;
+    }
+    if (sourcePath.empty()) {
+        WV_LOG_ERROR("错误：没有可播放的源（未登记码流）");
+        return;
+    }
+    
+    if (!IsNetworkStream(sourcePath)) {
+        WVConnectionScheduler::Cancel(wrapper);   // 放弃排队中的网络流
+        wrapper->connectQueued = false;
+        wrapper->connectWaitUs = 0;
+        OpenSource(wrapper, sourcePath, startTimeMs);
+        return;
+    }
+    
+    // 网络流先向连接调度器申请名额；名额用完时排队，当前播放保持不变，取得名额后再打开
+    unsigned long long ticket = 0;
+    wrapper->connectQueuedAt = MonotonicMicros();
+    bool granted = WVConnectionScheduler::Request(wrapper, ConnectionPriority(wrapper),
+        [wrapper, sourcePath, startTimeMs](unsigned long long grantedTicket) {
+            wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, sourcePath, startTimeMs, grantedTicket] {
+                if (!WVConnectionScheduler::IsGranted(wrapper, grantedTicket)) return;
+                wrapper->connectWaitUs = MonotonicMicros() - wrapper->connectQueuedAt;
+                WV_LOG_INFO("连接排队 %.1f ms", wrapper->connectWaitUs / 1000.0);
+                OpenSource(wrapper, sourcePath, startTimeMs);
+            });
+        }, &ticket);
+    if (!granted) {
+        wrapper->connectQueued = true;
+        WV_LOG_INFO("连接名额已满，排队等待: %s", sourcePath.c_str());
+        return;
+    }
+    wrapper->connectWaitUs = 0;
+    OpenSource(wrapper, sourcePath, startTimeMs);
+}
+
+static void DoPause(WVPlayerWrapper* wrapper) {
+    // 使用 set_pause 而不是切换式的 pause，保证合并后的命令语义确定
+    libvlc_media_player_set_pause(wrapper->mediaPlayer, 1);
+    
+    WV_LOG_INFO("播放器已暂停");
+}
+
+static void DoResume(WVPlayerWrapper* wrapper) {
+    // 检查播放器状态
+    libvlc_state_t state = libvlc_media_player_get_state(wrapper->mediaPlayer);
+    
+    if (state == libvlc_Paused) {
+        libvlc_media_player_play(wrapper->mediaPlayer);
+        WV_LOG_INFO("播放器已恢复播放");
+    } else if (state == libvlc_Stopped) {
+        WV_LOG_WARN("警告：播放器处于停止状态，无法恢复播放");
+    } else if (state == libvlc_Playing) {
+        WV_LOG_INFO("提示：播放器已在播放中");
+    } else {
+        WV_LOG_INFO("播放器状态：%d，尝试恢复播放", state);
+        libvlc_media_player_play(wrapper->mediaPlayer);
+    }
+}
+
+static void DoStop(WVPlayerWrapper* wrapper) {
+    CancelStandby(wrapper, NULL);
+    EndCachingSession(wrapper);
+    WVConnectionScheduler::Cancel(wrapper);
+    wrapper->connectQueued = false;
+    
+    // VLC 3 中 stop 会等待输入线程退出，失效的 RTSP 源可能阻塞数百毫秒
+    libvlc_media_player_stop(wrapper->mediaPlayer);
+    WVReconnectSupervisor::OnClose(wrapper);
+    wrapper->overlayTimeline->Reset();
+    wrapper->decodeSuspended = false;
+    
+    WV_LOG_INFO("播放器已停止");
+}
+
+static void DoRelease(WVPlayerWrapper* wrapper) {
+    // 停止播放；之后连接调度器不会再为该播放器投递打开命令
+    CancelStandby(wrapper, NULL);
+    WVConnectionScheduler::Cancel(wrapper);
+    libvlc_media_player_stop(wrapper->mediaPlayer);
+    
+    // 释放当前媒体对象
+    if (wrapper->currentMedia) {
+        libvlc_media_release(wrapper->currentMedia);
+        wrapper->currentMedia = NULL;
+    }
+    
+    // 媒体播放器归还预热池（解除事件转发；超过高水位时才真正销毁）
+    if (wrapper->pooledPlayer) {
+        WVPlayerPool::Return(wrapper->pooledPlayer);
+        wrapper->pooledPlayer = NULL;
+        WV_LOG_INFO("媒体播放器已归还播放器池");
+    }
+    
+    // 播放器已停止，帧回调不会再被调用
+    delete wrapper->frameOutput;
+    wrapper->frameOutput = NULL;
+    
+    WVWindowDestroy(wrapper);
+    delete wrapper->overlayTimeline;
+    delete wrapper->overlayScene;
+    delete wrapper->overlayMasks;
+    delete wrapper->mediaClock;
+    delete wrapper->caching;
+    
+    delete wrapper;
+    
+    WV_LOG_INFO("播放器资源已释放");
+}
+
+// 切换画质级别（由画质调节器触发）。解码选项只在打开解码器时生效：正在播放时在隐藏的子窗口中
+// 以新级别预先打开当前源，出现画面后替换（可跳转的媒体从当前位置继续，期间保持旧画面）；
+// 帧回调播放器、尚未出图或不可见时直接重新打开，其他状态下在下次播放时生效
+static void ApplyQualityLevel(WVPlayerWrapper* wrapper, int level) {
+    if (level == wrapper->qualityLevel) return;
+    wrapper->qualityLevel = level;
+    
+    libvlc_state_t state = libvlc_media_player_get_state(wrapper->mediaPlayer);
+    if (state != libvlc_Opening && state != libvlc_Buffering && state != libvlc_Playing) return;
+    
+    std::string source = wrapper->playSource;
+    if (!wrapper->surfacesReady || wrapper->suspendRequested || state != libvlc_Playing) {
+        long long startTimeMs = 0;
+        if (libvlc_media_player_is_seekable(wrapper->mediaPlayer)) {
+            startTimeMs = libvlc_media_player_get_time(wrapper->mediaPlayer);
+        }
+        WV_LOG_INFO("画质级别 %d，重新打开: %s", level, source.c_str());
+        DoPlay(wrapper, source, startTimeMs);
+        return;
+    }
+    
+    // 已预先打开调用方的其他源时不打断，新级别在切换后的下次打开时生效；
+    // 进行中的码流切换按旧级别打开，放弃后以新级别重新预先打开
+    if (wrapper->standby && !wrapper->standbyAutoSwap) {
+        WV_LOG_INFO("画质级别 %d，已预先打开其他源，下次打开时生效", level);
+        return;
+    }
+    CancelStandby(wrapper, NULL);
+    
+    int rendition = -1;
+    std::string sourcePath = ResolveSource(wrapper, source, &rendition);
+    if (level >= WVQualitySubstream && !wrapper->substreamSource.empty()) {
+        sourcePath = wrapper->substreamSource;
+    }
+    if (sourcePath.empty()) return;
+    WV_LOG_INFO("画质级别 %d，预先打开后切换: %s", level, sourcePath.c_str());
+    StartStandby(wrapper, source, sourcePath, rendition, true);
+}
+
+// 重新打开当前源（由重连监督器触发）。投递之后有新的播放或停止时放弃
+static void Reconnect(WVPlayerWrapper* wrapper, unsigned long long generation) {
+    if (!WVReconnectSupervisor::IsCurrent(wrapper, generation)) return;
+    
+    std::string source = wrapper->playSource;
+    WV_LOG_INFO("重新连接: %s", source.c_str());
+    DoPlay(wrapper, source);
+}
+
+// 在隐藏的子窗口中用另一个播放器（静音）打开新的源，画面出现后由 CompleteStandby 替换当前播放器
+// @param requestedSource 替换后的 playSource
+// @param rendition 替换后的 activeRendition（不是登记的码流时为 -1）
+// @param autoSwap 出现画面后立即替换（码流切换，可跳转的媒体从当前位置继续）；为 false 时等待 wv_player_swap
+static void StartStandby(WVPlayerWrapper* wrapper, const std::string& requestedSource,
+                         const std::string& sourcePath, int rendition, bool autoSwap) {
+    WVPooledPlayer* standby = WVPlayerPool::Checkout(wrapper->pooledPlayer->instanceArgs, wrapper);
+    if (!standby) {
+        WV_LOG_ERROR("错误：无法创建预先打开用的播放器");
+        return;
+    }
+    wrapper->standbyThreads = 0;
+    libvlc_media_t* media = CreateMedia(wrapper, sourcePath, true);
+    if (!media) {
+        WVPlayerPool::Return(standby);
+        return;
+    }
+    if (autoSwap && libvlc_media_player_is_seekable(wrapper->mediaPlayer)) {
+        char option[48];
+        snprintf(option, sizeof(option), ":start-time=%.3f",
+                 libvlc_media_player_get_time(wrapper->mediaPlayer) / 1000.0);
+        libvlc_media_add_option(media, option);
+    }
+    
+    int surface = wrapper->activeSurface == 0 ? 1 : 0;
+    WVWindowBindSurface(wrapper, standby->mediaPlayer, surface, false);
+    libvlc_audio_set_mute(standby->mediaPlayer, 1);
+    libvlc_media_player_set_media(standby->mediaPlayer, media);
+    libvlc_media_release(media);   // 播放器持有自己的引用
+    
+    // 先登记再播放：Vout 事件投递的 OnStandbyFirstFrame 一定在本任务之后执行
+    wrapper->standby = standby;
+    unsigned long long generation = ++wrapper->standbyGeneration;
+    wrapper->standbySource = requestedSource;
+    wrapper->standbyPath = sourcePath;
+    wrapper->standbyRendition = rendition;
+    wrapper->standbyReady = false;
+    wrapper->standbyAutoSwap = autoSwap;
+    wrapper->swapRequestedAt = autoSwap ? MonotonicMicros() : 0;
+    
+    if (!IsNetworkStream(sourcePath)) {
+        PlayStandby(wrapper, generation, 0);
+        return;
+    }
+    
+    // 网络流同样先申请连接名额（以 standby 播放器登记，不取代当前播放器的申请）；排队期间保持当前画面
+    unsigned long long ticket = 0;
+    bool granted = WVConnectionScheduler::Request(standby, ConnectionPriority(wrapper),
+        [wrapper, generation](unsigned long long grantedTicket) {
+            wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, generation, grantedTicket] {
+                PlayStandby(wrapper, generation, grantedTicket);
+            });
+        }, &ticket);
+    if (!granted) {
+        WV_LOG_INFO("连接名额已满，预先打开排队等待: %s", sourcePath.c_str());
+        return;
+    }
+    PlayStandby(wrapper, generation, 0);
+}
+
+// 开始播放已登记的 standby；ticket 不为 0 时是排队后取得名额，standby 已被取消或替换时放弃
+// （按代数判断：取消后归还的播放器可能被新的 standby 再次取出，指针相同）
+static void PlayStandby(WVPlayerWrapper* wrapper, unsigned long long generation, unsigned long long ticket) {
+    WVPooledPlayer* standby = wrapper->standby;
+    if (!standby || wrapper->standbyGeneration != generation) return;
+    if (ticket != 0 && !WVConnectionScheduler::IsGranted(standby, ticket)) return;
+    
+    if (libvlc_media_player_play(standby->mediaPlayer) != 0) {
+        WV_LOG_ERROR("错误：预先打开失败: %s", wrapper->standbySource.c_str());
+        CancelStandby(wrapper, NULL);
+        return;
+    }
+    WV_LOG_INFO("开始预先打开: %s", wrapper->standbySource.c_str());
+}
+
+// 放弃预先打开的源；source 不为 NULL 时只在它仍是 standby 时放弃（处理过期的事件）
+static void CancelStandby(WVPlayerWrapper* wrapper, libvlc_media_player_t* source) {
+    WVPooledPlayer* standby = wrapper->standby;
+    if (source && (!standby || standby->mediaPlayer != source)) return;
+    
+    wrapper->standbySource.clear();
+    wrapper->standbyPath.clear();
+    wrapper->standbyThreads = 0;       // 监控墙的登记仍是正在显示的源，不需要改动
+    wrapper->standbyReady = false;
+    wrapper->swapRequestedAt = 0;
+    if (!standby) return;
+    
+    wrapper->standby = NULL;
+    WVConnectionScheduler::Cancel(standby);
+    libvlc_media_player_stop(standby->mediaPlayer);
+    WVPlayerPool::Return(standby);
+    if (source) {
+        WV_LOG_WARN("警告：预先打开的源播放出错，保持当前画面");
+    }
+}
+
+// 替换为已出现画面的 standby：显示其子窗口、隐藏旧窗口，替换当前播放器并归还旧播放器
+static void CompleteStandby(WVPlayerWrapper* wrapper) {
+    WVPooledPlayer* standby = wrapper->standby;
+    
+    int surface = wrapper->activeSurface == 0 ? 1 : 0;
+    WVWindowSwapSurface(wrapper, wrapper->activeSurface, surface);
+    
+    EndCachingSession(wrapper);
+    WVPooledPlayer* previous = wrapper->pooledPlayer;
+    {
+        std::lock_guard<std::mutex> lock(wrapper->playerMutex);
+        wrapper->pooledPlayer = standby;
+        wrapper->mediaPlayer = standby->mediaPlayer;
+        wrapper->eventManager = standby->eventManager;
+    }
+    if (wrapper->swapRequestedAt > 0) {
+        wrapper->switchGapUs = MonotonicMicros() - wrapper->swapRequestedAt;
+    }
+    wrapper->standby = NULL;
+    // 新源替换当前源后才登记到监控墙（之后上报的分辨率也按新源记录）
+    if (wrapper->wall && wrapper->standbyThreads > 0) {
+        wrapper->wall->CommitPlay(wrapper->wallTile, wrapper->standbyPath, wrapper->standbyThreads);
+    }
+    wrapper->standbyPath.clear();
+    wrapper->standbyThreads = 0;
+    wrapper->activeSurface = surface;
+    wrapper->activeRendition = wrapper->standbyRendition;
+    wrapper->playSource.swap(wrapper->standbySource);
+    wrapper->standbySource.clear();
+    wrapper->standbyReady = false;
+    wrapper->swapRequestedAt = 0;
+    if (wrapper->currentMedia) {
+        libvlc_media_release(wrapper->currentMedia);
+    }
+    wrapper->currentMedia = libvlc_media_player_get_media(wrapper->mediaPlayer);
+    libvlc_audio_set_mute(wrapper->mediaPlayer, 0);
+    char* mrl = wrapper->currentMedia ? libvlc_media_get_mrl(wrapper->currentMedia) : NULL;
+    bool network = mrl && IsNetworkStream(mrl);
+    if (network) {
+        wrapper->caching->BeginSession(mrl, true);
+    }
+    libvlc_free(mrl);
+    WVReconnectSupervisor::OnOpen(wrapper, network);
+    if (libvlc_media_player_get_state(wrapper->mediaPlayer) == libvlc_Paused) {
+        libvlc_media_player_set_pause(wrapper->mediaPlayer, 0);
+    }
+    
+    // 新源的时间轴重新开始；它的 Playing 事件在替换前已被过滤
+    wrapper->mediaClock->Reset();
+    wrapper->mediaClock->SetPlaying(true);
+    wrapper->overlayTimeline->Reset();
+    ConfigureVideoOutput(wrapper);
+    
+    // 切换期间变为不可见时，对新播放器同样停止解码
+    wrapper->decodeSuspended = false;
+    ApplyDecodeSuspension(wrapper);
+    
+    // 旧播放器的 stop 可能阻塞数百毫秒，此时新画面已经显示
+    libvlc_media_player_stop(previous->mediaPlayer);
+    WVPlayerPool::Return(previous);
+    WV_LOG_INFO("已切换到预先打开的源: %s（耗时 %.1f ms）", wrapper->playSource.c_str(),
+                wrapper->switchGapUs / 1000.0);
+}
+
+// standby 的视频输出已创建（首帧已解码）：码流切换或已请求切换时立即替换，否则等待 wv_player_swap
+static void OnStandbyFirstFrame(WVPlayerWrapper* wrapper, libvlc_media_player_t* source) {
+    WVPooledPlayer* standby = wrapper->standby;
+    if (!standby || standby->mediaPlayer != source || wrapper->standbyReady) return;
+    
+    wrapper->standbyReady = true;
+    WVConnectionScheduler::Release(standby);   // 首帧已出现，让出预先打开占用的名额
+    if (wrapper->standbyAutoSwap || wrapper->swapRequestedAt > 0) {
+        CompleteStandby(wrapper);
+        return;
+    }
+    
+    // 本地文件停在首帧等待切换；直播流继续接收，切换时是最新画面
+    if (libvlc_media_player_is_seekable(standby->mediaPlayer)) {
+        libvlc_media_player_set_pause(standby->mediaPlayer, 1);
+    }
+    WV_LOG_INFO("预先打开完成，等待切换: %s", wrapper->standbySource.c_str());
+}
+
+// 显示尺寸变化后重新选择码流（在命令队列工作线程上执行）
+void WVPlayerUpdateRendition(WVPlayerWrapper* wrapper, int width, int height) {
+    wrapper->renditionWidth = width;
+    wrapper->renditionHeight = height;
+    if (wrapper->activeRendition < 0 || !wrapper->surfacesReady) return;
+    if (wrapper->standby && !wrapper->standbyAutoSwap) return;   // 已预先打开其他源，切换后再按尺寸选择
+    
+    int rendition = wrapper->renditions.Select(width, height);
+    if (wrapper->standby && wrapper->standbyRendition != rendition) {
+        CancelStandby(wrapper, NULL);
+    }
+    if (rendition < 0 || rendition == wrapper->activeRendition || wrapper->standby) return;
+    
+    // 不可见、未在播放或已由画质调节器切到子码流时保持当前码流，下次播放时按新尺寸选择
+    if (wrapper->suspendRequested) return;
+    if (wrapper->qualityLevel >= WVQualitySubstream && !wrapper->substreamSource.empty()) return;
+    if (libvlc_media_player_get_state(wrapper->mediaPlayer) != libvlc_Playing) return;
+    
+    StartStandby(wrapper, wrapper->playSource, wrapper->renditions.Source(rendition), rendition, true);
+}
+
+static void DoPrepare(WVPlayerWrapper* wrapper, const std::string& requestedSource) {
+    CancelStandby(wrapper, NULL);
+    
+    int rendition = -1;
+    std::string sourcePath = ResolveSource(wrapper, requestedSource, &rendition);
+    if (sourcePath.empty()) {
+        WV_LOG_ERROR("错误：没有可预先打开的源（未登记码流）");
+        return;
+    }
+    if (!wrapper->surfacesReady) {
+        // 帧回调模式只有一个输出，无法同时打开两个源，切换时直接播放
+        wrapper->standbySource = requestedSource;
+        WV_LOG_INFO("帧回调播放器不支持预先打开，切换时直接播放: %s", sourcePath.c_str());
+        return;
+    }
+    StartStandby(wrapper, requestedSource, sourcePath, rendition, false);
+}
+
+static void DoSwap(WVPlayerWrapper* wrapper) {
+    if (!wrapper->standby) {
+        if (wrapper->standbySource.empty()) {
+            WV_LOG_WARN("警告：没有预先打开的源，忽略切换");
+            return;
+        }
+        std::string source;
+        source.swap(wrapper->standbySource);
+        DoPlay(wrapper, source);
+        return;
+    }
+    
+    wrapper->swapRequestedAt = MonotonicMicros();
+    if (wrapper->standbyReady) {
+        CompleteStandby(wrapper);
+    } else {
+        WV_LOG_INFO("预先打开的源尚未出现画面，出现后切换");
+    }
+}
+
+unsigned long long wv_player_play(void* playerHandle, const char* source) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    // source 为空时播放登记的码流（没有登记时由工作线程报错）
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    std::string sourcePath = source ? source : "";
+    
+    unsigned long long commandId = wrapper->commandQueue->Post(WVCommandQueue::KindPlay, [wrapper, sourcePath] {
+        DoPlay(wrapper, sourcePath);
+    });
+    
+    if (!wrapper->videoWindow || wrapper->hidden) {
+        WV_LOG_DEBUG("播放命令已入队: %llu", commandId);
+        return commandId;
+    }
+    
+    // 窗口操作留在调用线程（窗口所属线程）
+    WVWindowRaise(wrapper);
+    WV_LOG_DEBUG("视频窗口已更新并设置 Z-order 为顶层，播放命令已入队: %llu", commandId);
+    return commandId;
+}
+
+unsigned long long wv_player_pause(void* playerHandle) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    return wrapper->commandQueue->Post(WVCommandQueue::KindPause, [wrapper] {
+        DoPause(wrapper);
+    });
+}
+
+unsigned long long wv_player_resume(void* playerHandle) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    return wrapper->commandQueue->Post(WVCommandQueue::KindResume, [wrapper] {
+        DoResume(wrapper);
+    });
+}
+
+unsigned long long wv_player_stop(void* playerHandle) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    return wrapper->commandQueue->Post(WVCommandQueue::KindStop, [wrapper] {
+        DoStop(wrapper);
+    });
+}
+
+int wv_player_add_rendition(void* playerHandle, const char* source, int width, int height) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return -1;
+    }
+    if (!source || !*source || width <= 0 || height <= 0) {
+        WV_LOG_ERROR("错误：无效的码流参数");
+        return -1;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    bool surfaces = WVWindowEnsureSurfaces(wrapper);
+    std::string rendition = source;
+    wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, rendition, width, height, surfaces] {
+        if (!wrapper->renditions.Add(rendition, width, height)) {
+            WV_LOG_ERROR("错误：码流数量已达上限（%d）: %s",
+                         static_cast<int>(WVRenditionSet::kMaxRenditions), rendition.c_str());
+            return;
+        }
+        if (surfaces) wrapper->surfacesReady = true;
+        WV_LOG_INFO("登记码流 %dx%d: %s", width, height, rendition.c_str());
+    });
+    return 0;
+}
+
+unsigned long long wv_player_prepare(void* playerHandle, const char* source) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    bool surfaces = WVWindowEnsureSurfaces(wrapper);
+    std::string sourcePath = source ? source : "";
+    return wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, sourcePath, surfaces] {
+        if (surfaces) wrapper->surfacesReady = true;
+        DoPrepare(wrapper, sourcePath);
+    });
+}
+
+unsigned long long wv_player_swap(void* playerHandle) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    return wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper] {
+        DoSwap(wrapper);
+    });
+}
+
+double wv_player_get_switch_gap(void* playerHandle) {
+    if (!playerHandle) return -1.0;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    long long gapUs = wrapper->switchGapUs;
+    return gapUs > 0 ? gapUs / 1000.0 : -1.0;
+}
+
+void wv_player_set_caching_policy(void* playerHandle, int mode, int minMs, int maxMs, int targetMs) {
+    if (!playerHandle) return;
+    if (mode != WV_CACHING_FIXED && mode != WV_CACHING_ADAPTIVE && mode != WV_CACHING_TARGET) {
+        WV_LOG_ERROR("错误：无效的网络缓存模式 %d", mode);
+        return;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->caching->Configure(static_cast<WVCachingMode>(mode), minMs, maxMs, targetMs);
+    WV_LOG_INFO("网络缓存模式：%d，范围 %d-%d ms，目标 %d ms", mode, minMs, maxMs, targetMs);
+}
+
+void wv_player_get_caching_stats(void* playerHandle, int* cachingMs, double* jitterMs, int* stalls) {
+    if (!playerHandle) return;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->caching->GetStats(cachingMs, jitterMs, stalls);
+}
+
+void wv_player_clear_renditions(void* playerHandle) {
+    if (!playerHandle) return;
+    
+    // 当前播放继续，下次播放时不再按尺寸选择
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper] {
+        if (wrapper->standby && wrapper->standbyAutoSwap) {
+            CancelStandby(wrapper, NULL);
+        }
+        wrapper->renditions.Clear();
+        wrapper->activeRendition = -1;
+    });
+}
+
+unsigned long long wv_player_release(void* playerHandle) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return 0;
+    }
+    
+    // 监控墙的块由 wv_wall_release 统一释放，单独释放会在墙的块列表中留下悬空指针
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    if (wrapper->wall) {
+        WV_LOG_ERROR("错误：监控墙第 %d 块不能单独释放，请调用 wv_wall_release", wrapper->wallTile);
+        return 0;
+    }
+    return WVPlayerRelease(wrapper);
+}
+
+// 释放播放器（独立播放器或监控墙的块，UI 线程）
+unsigned long long WVPlayerRelease(WVPlayerWrapper* wrapper) {
+    // 之后画质调节器与重连监督器不会再读取统计或投递级别变化、重连
+    WVQualityGovernor::Unregister(wrapper);
+    WVReconnectSupervisor::Unregister(wrapper);
+    
+    // 立即隐藏窗口，实际的停止与释放在工作线程上完成
+    WVWindowDetach(wrapper);
+    
+    return wrapper->commandQueue->Shutdown([wrapper] {
+        DoRelease(wrapper);
+    });
+}
+
+// 窗口模式立即提交场景变化；帧回调模式在下一帧合成
+static void RenderOverlay(WVPlayerWrapper* wrapper) {
+    WVWindowRenderOverlay(wrapper);
+}
+
+void wv_player_update_rectangles(void* playerHandle, const float* rects, int rectCount, float lineWidth,
+                                 float red, float green, float blue, float alpha) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return;
+    }
+    if (rectCount < 0 || (rectCount > 0 && !rects)) {
+        WV_LOG_ERROR("错误：矩形数组无效");
+        return;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->overlayScene->ReplaceRectangles(rects, rectCount, lineWidth,
+                                             WVOverlayPackColor(red, green, blue, alpha));
+    RenderOverlay(wrapper);
+    WV_LOG_DEBUG("覆盖层已更新: %d 个矩形", rectCount);
+}
+
+int wv_player_overlay_apply(void* playerHandle, const void* commands, int length) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return -1;
+    }
+    if (length < 0 || (length > 0 && !commands)) {
+        WV_LOG_ERROR("错误：覆盖层命令缓冲区无效");
+        return -1;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    int applied = wrapper->overlayScene->Apply(static_cast<const uint8_t*>(commands), static_cast<size_t>(length));
+    if (applied < 0) {
+        WV_LOG_WARN("警告：覆盖层命令缓冲区格式错误（%d 字节），已执行错误之前的命令", length);
+    }
+    RenderOverlay(wrapper);
+    return applied;
+}
+
+int wv_player_overlay_upload_mask(void* playerHandle, unsigned int maskId, int width, int height,
+                                  const unsigned int* runs, int runCount) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return -1;
+    }
+    if (runCount < 0 || (runCount > 0 && !runs)) {
+        WV_LOG_ERROR("错误：蒙版游程数组无效");
+        return -1;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    if (!wrapper->overlayMasks->Upload(maskId, width, height, runs, static_cast<size_t>(runCount))) {
+        WV_LOG_ERROR("错误：蒙版 %u 上传失败（%dx%d，%d 个游程）", maskId, width, height, runCount);
+        return -1;
+    }
+    return 0;
+}
+
+void wv_player_overlay_release_mask(void* playerHandle, unsigned int maskId) {
+    if (!playerHandle) return;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->overlayMasks->Release(maskId);
+}
+
+int wv_player_overlay_submit(void* playerHandle, long long mediaTimeMs, const void* commands, int length) {
+    if (!playerHandle) {
+        WV_LOG_ERROR("错误：播放器句柄为空");
+        return -1;
+    }
+    if (length < 0 || (length > 0 && !commands)) {
+        WV_LOG_ERROR("错误：覆盖层命令缓冲区无效");
+        return -1;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    int applied = wrapper->overlayTimeline->Submit(mediaTimeMs, static_cast<const uint8_t*>(commands),
+                                                   static_cast<size_t>(length));
+    if (applied < 0) {
+        WV_LOG_WARN("警告：覆盖层命令缓冲区格式错误（%d 字节），已执行错误之前的命令", length);
+    }
+    
+    // 窗口模式由覆盖层窗口的定时器按媒体时钟呈现；帧回调模式在每帧显示时呈现
+    WVWindowAttachOverlayTimeline(wrapper);
+    return applied;
+}
+
+void wv_player_overlay_set_sync(void* playerHandle, int toleranceMs, int expiryMs, int clockOffsetMs) {
+    if (!playerHandle) return;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->overlayTimeline->Configure(toleranceMs, expiryMs, clockOffsetMs);
+    WV_LOG_INFO("覆盖层同步参数：容差=%d ms, 过期=%d ms, 时钟修正=%d ms", toleranceMs, expiryMs, clockOffsetMs);
+}
+
+void wv_player_overlay_set_interpolation(void* playerHandle, int mode, int maxExtrapolationMs) {
+    if (!playerHandle) return;
+    if (mode != WV_OVERLAY_INTERP_NONE && mode != WV_OVERLAY_INTERP_LINEAR && mode != WV_OVERLAY_INTERP_VELOCITY) {
+        WV_LOG_ERROR("错误：无效的覆盖层插值方式 %d", mode);
+        return;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->overlayTimeline->SetInterpolation(static_cast<WVOverlayInterpolation>(mode), maxExtrapolationMs);
+    WV_LOG_INFO("覆盖层插值方式：%d, 最长外推=%d ms", mode, maxExtrapolationMs);
+}
+
+long long wv_player_get_media_time(void* playerHandle) {
+    if (!playerHandle) return -1;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    return wrapper->mediaClock->NowMs();
+}
+
+void wv_player_clear_rectangles(void* playerHandle) {
+    if (!playerHandle) return;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->overlayScene->Clear();
+    RenderOverlay(wrapper);
+}
+
+void WVPlayerUpdateVisibility(WVPlayerWrapper* wrapper) {
+    bool hidden = wrapper->visibilityMode == WV_VISIBILITY_HIDDEN ||
+                  (wrapper->visibilityMode == WV_VISIBILITY_AUTO && WVWindowIsMinimized(wrapper));
+    if (hidden == wrapper->hidden) return;
+    wrapper->hidden = hidden;
+    
+    WVWindowSetHidden(wrapper, hidden);
+    
+    wrapper->suspendRequested = hidden;
+    WVConnectionScheduler::SetPriority(wrapper, ConnectionPriority(wrapper));
+    wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper] {
+        ApplyDecodeSuspension(wrapper);
+    });
+}
+
+void wv_player_set_visibility(void* playerHandle, int visibility) {
+    if (!playerHandle) return;
+    if (visibility != WV_VISIBILITY_HIDDEN && visibility != WV_VISIBILITY_VISIBLE &&
+        visibility != WV_VISIBILITY_AUTO) {
+        WV_LOG_ERROR("错误：无效的可见性 %d", visibility);
+        return;
+    }
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    wrapper->visibilityMode = visibility;
+    
+    // 自动模式由视频窗口的定时器检测父窗口是否最小化（帧回调模式没有窗口，等同可见）
+    WVWindowSetAutoVisibility(wrapper, visibility == WV_VISIBILITY_AUTO);
+    WVPlayerUpdateVisibility(wrapper);
+}
+
+double wv_player_get_first_frame_latency(void* playerHandle) {
+    if (!playerHandle) return -1.0;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    long long latencyUs = wrapper->firstFrameLatencyUs;
+    return latencyUs > 0 ? latencyUs / 1000.0 : -1.0;
+}
+
+int wv_player_get_decode_stats(void* playerHandle, unsigned long long* decoded,
+                               unsigned long long* displayed, unsigned long long* lost) {
+    if (!playerHandle) return -1;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    libvlc_media_stats_t stats;
+    if (!ReadDecodeStats(wrapper, &stats, NULL)) return -1;
+    
+    if (decoded) *decoded = static_cast<unsigned long long>(stats.i_decoded_video);
+    if (displayed) *displayed = static_cast<unsigned long long>(stats.i_displayed_pictures);
+    if (lost) *lost = static_cast<unsigned long long>(stats.i_lost_pictures);
+    return 0;
+}
+
+void wv_quality_governor_configure(int enabled, float cpuHighPercent, float cpuLowPercent,
+                                   float lossHighPercent, int maxLevel) {
+    WVQualityPolicy policy;
+    policy.enabled = enabled != 0;
+    policy.cpuHighPercent = cpuHighPercent > 0.0f ? cpuHighPercent : 85.0f;
+    policy.cpuLowPercent = cpuLowPercent > 0.0f ? cpuLowPercent : 60.0f;
+    policy.lossHighPercent = lossHighPercent > 0.0f ? lossHighPercent : 5.0f;
+    policy.maxLevel = maxLevel;
+    WVQualityGovernor::Configure(policy);
+    WV_LOG_INFO("画质调节器：%s，CPU 上限=%.0f%%，下限=%.0f%%，丢帧上限=%.1f%%，最大级别=%d",
+                policy.enabled ? "启用" : "停用", policy.cpuHighPercent, policy.cpuLowPercent,
+                policy.lossHighPercent, maxLevel);
+}
+
+void wv_quality_governor_get_stats(float* processCpuPercent, int* degradedCount) {
+    WVQualityGovernor::GetStats(processCpuPercent, degradedCount);
+}
+
+void wv_player_set_priority(void* playerHandle, int priority) {
+    if (!playerHandle) return;
+    
+    WVQualityGovernor::SetPriority(playerHandle, priority);
+    WVConnectionScheduler::SetPriority(playerHandle, ConnectionPriority(static_cast<WVPlayerWrapper*>(playerHandle)));
+}
+
+void wv_player_set_substream(void* playerHandle, const char* source) {
+    if (!playerHandle) return;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    std::string substream = source ? source : "";
+    wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, substream] {
+        wrapper->substreamSource = substream;
+    });
+    WVQualityGovernor::SetSubstreamAvailable(wrapper, !substream.empty());
+}
+
+int wv_player_get_quality_level(void* playerHandle) {
+    if (!playerHandle) return 0;
+    
+    return WVQualityGovernor::Level(playerHandle);
+}
+
+void wv_reconnect_configure(int enabled, int initialDelayMs, int maxDelayMs, int maxAttempts,
+                            int stallTimeoutMs, int maxConcurrent) {
+    WVReconnectPolicy policy;
+    policy.enabled = enabled != 0;
+    policy.initialDelayMs = initialDelayMs;
+    policy.maxDelayMs = maxDelayMs;
+    policy.maxAttempts = maxAttempts;
+    policy.stallTimeoutMs = stallTimeoutMs;
+    policy.maxConcurrent = maxConcurrent;
+    WVReconnectSupervisor::Configure(policy);
+    WV_LOG_INFO("自动重连：%s，退避 %d-%d ms，最多 %d 次，无帧 %d ms 视为卡住，同时重连 %d 路",
+                enabled ? "启用" : "停用", initialDelayMs, maxDelayMs, maxAttempts, stallTimeoutMs, maxConcurrent);
+}
+
+void wv_reconnect_get_stats(int* inFlight, int* waiting) {
+    WVReconnectSupervisor::GetStats(inFlight, waiting);
+}
+
+int wv_player_get_health(void* playerHandle) {
+    if (!playerHandle) return WV_HEALTH_IDLE;
+    return WVReconnectSupervisor::Health(playerHandle);
+}
+
+void wv_player_get_reconnect_stats(void* playerHandle, int* attempts, int* reconnects) {
+    if (!playerHandle) return;
+    WVReconnectSupervisor::GetPlayerStats(playerHandle, attempts, reconnects);
+}
+
+void wv_connection_scheduler_configure(int maxConcurrent, int timeoutMs) {
+    WVConnectionScheduler::Configure(maxConcurrent, timeoutMs);
+    WV_LOG_INFO("连接调度：同时连接 %d 路（0 表示不限），名额最长占用 %d ms", maxConcurrent > 0 ? maxConcurrent : 0, timeoutMs);
+}
+
+void wv_connection_scheduler_get_stats(int* queued, int* inFlight, double* averageWaitMs) {
+    WVConnectionScheduler::GetStats(queued, inFlight, averageWaitMs);
+}
+
+double wv_player_get_connect_wait(void* playerHandle) {
+    if (!playerHandle) return 0.0;
+    
+    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+    long long waitUs = wrapper->connectWaitUs;
+    return waitUs / 1000.0;
+}
+
+int wv_command_status(unsigned long long commandId) {
+    return WVCommandQueue::GetStatus(commandId);
+}
+
+void wv_set_log_level(int level) {
+    WVLogSetLevel(level);
+}
+
+void* wv_frame_ring_open(const char* sharedMemoryName) {
+    if (!sharedMemoryName) return NULL;
+    
+    WVFrameRing* ring = WVFrameRing::Open(sharedMemoryName);
+    if (!ring) {
+        WV_LOG_WARN("警告：无法打开共享内存帧环: %s", sharedMemoryName);
+    }
+    return ring;
+}
+
+void* wv_frame_ring_get_info(void* ringHandle, unsigned long long* size, int* width, int* height,
+                             int* pitch, int* slotCount) {
+    if (!ringHandle) return NULL;
+    
+    WVFrameRing* ring = static_cast<WVFrameRing*>(ringHandle);
+    WVFrameRingHeader* header = ring->Header();
+    if (size) *size = ring->Size();
+    if (width) *width = header->width;
+    if (height) *height = header->height;
+    if (pitch) *pitch = header->pitch;
+    if (slotCount) *slotCount = header->slotCount;
+    return ring->Base();
+}
+
+int wv_frame_ring_acquire(void* ringHandle, unsigned long long* frameNumber, unsigned long long* dataOffset) {
+    if (!ringHandle) return -1;
+    
+    // 视频尺寸变化后生产者切换到新一代区域，跟随后映射地址与尺寸都已改变
+    WVFrameRing* ring = static_cast<WVFrameRing*>(ringHandle);
+    bool resized = ring->Follow();
+    bool fresh = false;
+    int slot = ring->Acquire(&fresh);
+    if (slot < 0) {
+        if (!resized) return -1;
+        if (frameNumber) *frameNumber = 0;   // 新区域尚无帧
+        if (dataOffset) *dataOffset = 0;
+        return 2;
+    }
+    
+    const WVFrameSlotHeader& slotHeader = ring->Header()->slots[slot];
+    if (frameNumber) *frameNumber = slotHeader.frameNumber;
+    if (dataOffset) *dataOffset = slotHeader.dataOffset;
+    return resized ? 2 : (fresh ? 1 : 0);
+}
+
+void wv_frame_ring_get_stats(void* ringHandle, unsigned long long* published, unsigned long long* overwritten) {
+    if (!ringHandle) return;
+    
+    WVFrameRingHeader* header = static_cast<WVFrameRing*>(ringHandle)->Header();
+    if (published) *published = header->framesPublished.load();
+    if (overwritten) *overwritten = header->framesOverwritten.load();
+}
+
+void wv_frame_ring_close(void* ringHandle) {
+    delete static_cast<WVFrameRing*>(ringHandle);
+}
+
+void wv_set_vlc_log_level(const char* module, int level) {
+    WVVlcLogSetModuleLevel(module, level);
+}
+
+void wv_set_vlc_log_rate_limit(float messagesPerSecond, int burst) {
+    WVVlcLogSetRateLimit(messagesPerSecond, burst);
+}
+
+void wv_set_log_sinks(int sinks, const char* filePath) {
+    WVLogSetSinks(sinks, filePath);
+}
+
+unsigned long long wv_get_log_dropped_count() {
+    return WVLogDroppedCount();
+}
+
+void wv_log_flush(int timeoutMs) {
+    WVLogFlush(timeoutMs);
+}
+
+void wv_player_pool_configure(int lowWatermark, int highWatermark) {
+    if (lowWatermark < 0) lowWatermark = 0;
+    if (highWatermark < lowWatermark) highWatermark = lowWatermark;
+    g_poolLowWatermark = lowWatermark;
+    g_poolHighWatermark = highWatermark;
+    g_poolConfigured = true;
+    
+    WVPlayerPool::SetEventDispatcher(OnMediaPlayerEvent);
+    WVPlayerPool::Configure(BuildDefaultVlcArgs(), lowWatermark, highWatermark);
+    WV_LOG_INFO("播放器池已配置：低水位=%d, 高水位=%d", lowWatermark, highWatermark);
+}
+
+void wv_player_pool_get_stats(unsigned long long* hits, unsigned long long* misses, int* idleCount, int* liveCount) {
+    WVPlayerPoolStats stats = WVPlayerPool::GetStats();
+    if (hits) *hits = stats.hits;
+    if (misses) *misses = stats.misses;
+    if (idleCount) *idleCount = stats.idleCount;
+    if (liveCount) *liveCount = stats.liveCount;
+}
+
+#ifndef _WIN32
+
+// ==================== 窗口模式（不支持） ====================
+
+// 窗口模式只在 Windows 上提供，其他平台的播放器都没有窗口
+bool WVWindowEnsureSurfaces(WVPlayerWrapper*) { return false; }
+void WVWindowBindSurface(WVPlayerWrapper*, libvlc_media_player_t*, int, bool) {}
+void WVWindowSwapSurface(WVPlayerWrapper*, int, int) {}
+void WVWindowRaise(WVPlayerWrapper*) {}
+bool WVWindowIsMinimized(WVPlayerWrapper*) { return false; }
+void WVWindowSetHidden(WVPlayerWrapper*, bool) {}
+void WVWindowSetAutoVisibility(WVPlayerWrapper*, bool) {}
+void WVWindowRenderOverlay(WVPlayerWrapper*) {}
+void WVWindowAttachOverlayTimeline(WVPlayerWrapper*) {}
+void WVWindowDetach(WVPlayerWrapper*) {}
+void WVWindowDestroy(WVPlayerWrapper*) {}
+
+#endif
@@ -0,0 +1,275 @@
+//
+//  WVPlayerPool.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVPlayerPool.h"
+#include "WVInstancePool.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace {
+
+// 池中播放器统一挂接的事件
+const libvlc_event_type_t kPooledEvents[] = {
+    libvlc_MediaPlayerPlaying,
+    libvlc_MediaPlayerVout,
+    libvlc_MediaPlayerTimeChanged,
+    libvlc_MediaPlayerBuffering,
+    libvlc_MediaPlayerPaused,
+    libvlc_MediaPlayerStopped,
+    libvlc_MediaPlayerEncounteredError,
+};
+
+struct PoolState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<WVPooledPlayer*> idle;
+    std::vector<std::string> args;
+    int lowWatermark;
+    int highWatermark;
+    bool configured;
+    bool workerStarted;
+    int creating;                  // 后台正在创建的数量
+    int inUse;                     // 已取出、尚未归还的数量
+    unsigned long long hits;
+    unsigned long long misses;
+    int liveCount;
+    libvlc_callback_t dispatcher;
+
+    PoolState()
+        : lowWatermark(2), highWatermark(8), configured(false), workerStarted(false), creating(0), inUse(0), hits(0), misses(0), liveCount(0), dispatcher(NULL) {}
+};
+
+PoolState& State() {
+    static PoolState* state = new PoolState();  // 进程退出时不析构，避免与后台线程竞争
+    return *state;
+}
+
+// 事件转发：在 ownerMutex 内调用，保证归还后不会再访问已释放的 owner
+void OnPooledPlayerEvent(const libvlc_event_t* event, void* userData) {
+    WVPooledPlayer* player = static_cast<WVPooledPlayer*>(userData);
+    libvlc_callback_t dispatcher = State().dispatcher;
+    if (!dispatcher) return;
+
+    std::lock_guard<std::mutex> lock(player->ownerMutex);
+    if (player->owner) {
+        dispatcher(event, player->owner);
+    }
+}
+
+WVPooledPlayer* CreatePlayer(const std::vector<std::string>& args) {
+    libvlc_instance_t* instance = WVInstancePool::Acquire(args);
+    if (!instance) return NULL;
+
+    libvlc_media_player_t* mediaPlayer = libvlc_media_player_new(instance);
+    if (!mediaPlayer) {
+        WVInstancePool::Release(instance);
+        return NULL;
+    }
+
+    WVPooledPlayer* player = new WVPooledPlayer();
+    player->instance = instance;
+    player->mediaPlayer = mediaPlayer;
+    player->instanceArgs = args;
+    player->owner = NULL;
+    player->reusable = true;
+    player->eventManager = libvlc_media_player_event_manager(mediaPlayer);
+    if (player->eventManager) {
+        for (size_t i = 0; i < sizeof(kPooledEvents) / sizeof(kPooledEvents[0]); ++i) {
+            libvlc_event_attach(player->eventManager, kPooledEvents[i], OnPooledPlayerEvent, player);
+        }
+    }
+    return player;
+}
+
+void DestroyPlayer(WVPooledPlayer* player) {
+    if (player->eventManager) {
+        for (size_t i = 0; i < sizeof(kPooledEvents) / sizeof(kPooledEvents[0]); ++i) {
+            libvlc_event_detach(player->eventManager, kPooledEvents[i], OnPooledPlayerEvent, player);
+        }
+    }
+    libvlc_media_player_release(player->mediaPlayer);
+    WVInstancePool::Release(player->instance);
+    delete player;
+}
+
+// 后台补充/收缩线程
+void PoolWorker() {
+    PoolState& state = State();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    for (;;) {
+        state.cond.wait(lock, [&state] {
+            if (!state.configured) return false;
+            int idle = static_cast<int>(state.idle.size());
+            return idle + state.creating < state.lowWatermark || idle > state.highWatermark;
+        });
+
+        if (static_cast<int>(state.idle.size()) > state.highWatermark) {
+            WVPooledPlayer* surplus = state.idle.back();
+            state.idle.pop_back();
+            state.liveCount--;
+            lock.unlock();
+            DestroyPlayer(surplus);
+            lock.lock();
+            continue;
+        }
+
+        std::vector<std::string> args = state.args;
+        state.creating++;
+        lock.unlock();
+        WVPooledPlayer* player = CreatePlayer(args);
+        lock.lock();
+        state.creating--;
+
+        if (!player) {
+            // 创建失败（如插件路径错误），停止预热，避免反复重试
+            state.configured = false;
+            continue;
+        }
+
+        if (args != state.args || static_cast<int>(state.idle.size()) >= state.highWatermark) {
+            // 创建期间池参数或水位被修改，丢弃
+            lock.unlock();
+            DestroyPlayer(player);
+            lock.lock();
+            continue;
+        }
+
+        state.idle.push_back(player);
+        state.liveCount++;
+    }
+}
+
+void StartWorkerLocked(PoolState& state) {
+    if (state.workerStarted) return;
+    state.workerStarted = true;
+    std::thread(PoolWorker).detach();
+}
+
+} // namespace
+
+void WVPlayerPool::SetEventDispatcher(libvlc_callback_t dispatcher) {
+    PoolState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.dispatcher = dispatcher;
+}
+
+void WVPlayerPool::Configure(const std::vector<std::string>& args, int lowWatermark, int highWatermark) {
+    if (lowWatermark < 0) lowWatermark = 0;
+    if (highWatermark < lowWatermark) highWatermark = lowWatermark;
+
+    std::vector<WVPooledPlayer*> stale;
+    {
+        PoolState& state = State();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (args != state.args) {
+            // 参数变化后旧的空闲播放器无法再复用
+            stale.assign(state.idle.begin(), state.idle.end());
+            state.idle.clear();
+            state.args = args;
+        }
+        // 超过新高水位的空闲播放器立即销毁（水位为 0 时全部销毁，实例随最后一个使用者释放）
+        while (static_cast<int>(state.idle.size()) > highWatermark) {
+            stale.push_back(state.idle.back());
+            state.idle.pop_back();
+        }
+        state.liveCount -= static_cast<int>(stale.size());
+        state.lowWatermark = lowWatermark;
+        state.highWatermark = highWatermark;
+        state.configured = true;
+        StartWorkerLocked(state);
+        state.cond.notify_all();
+    }
+
+    for (size_t i = 0; i < stale.size(); ++i) {
+        DestroyPlayer(stale[i]);
+    }
+}
+
+WVPooledPlayer* WVPlayerPool::Checkout(const std::vector<std::string>& args, void* owner) {
+    PoolState& state = State();
+    WVPooledPlayer* player = NULL;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (args == state.args && !state.idle.empty()) {
+            player = state.idle.front();
+            state.idle.pop_front();
+            state.hits++;
+        } else {
+            state.misses++;
+        }
+        state.inUse++;
+        // 取出后可能低于低水位，唤醒后台补充
+        state.cond.notify_all();
+    }
+
+    if (!player) {
+        player = CreatePlayer(args);
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!player) {
+            state.inUse--;
+            return NULL;
+        }
+        state.liveCount++;
+    }
+
+    std::lock_guard<std::mutex> lock(player->ownerMutex);
+    player->owner = owner;
+    return player;
+}
+
+void WVPlayerPool::Return(WVPooledPlayer* player) {
+    if (!player) return;
+
+    {
+        std::lock_guard<std::mutex> lock(player->ownerMutex);
+        player->owner = NULL;
+    }
+
+    // 重置为刚创建时的状态
+    libvlc_media_player_set_media(player->mediaPlayer, NULL);
+    libvlc_media_player_set_hwnd(player->mediaPlayer, NULL);
+    libvlc_video_set_scale(player->mediaPlayer, 0);
+    libvlc_video_set_aspect_ratio(player->mediaPlayer, NULL);
+    libvlc_audio_set_mute(player->mediaPlayer, 0);
+
+    PoolState& state = State();
+    std::vector<WVPooledPlayer*> released;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.inUse--;
+        if (player->reusable && state.configured && player->instanceArgs == state.args &&
+            static_cast<int>(state.idle.size()) < state.highWatermark) {
+            state.idle.push_back(player);
+        } else {
+            released.push_back(player);
+        }
+        if (state.inUse == 0) {
+            // 没有使用中的播放器：空闲数量收缩到低水位，池保持预热，下次创建仍然命中
+            while (static_cast<int>(state.idle.size()) > state.lowWatermark) {
+                released.push_back(state.idle.back());
+                state.idle.pop_back();
+            }
+        }
+        state.liveCount -= static_cast<int>(released.size());
+    }
+
+    for (size_t i = 0; i < released.size(); ++i) {
+        DestroyPlayer(released[i]);
+    }
+}
+
+WVPlayerPoolStats WVPlayerPool::GetStats() {
+    PoolState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    WVPlayerPoolStats stats;
+    stats.hits = state.hits;
+    stats.misses = state.misses;
+    stats.idleCount = static_cast<int>(state.idle.size());
+    stats.liveCount = state.liveCount;
+    return stats;
+}
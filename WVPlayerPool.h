@@ -0,0 +1,74 @@
+//
+//  WVPlayerPool.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_PLAYER_POOL_H
+#define WV_PLAYER_POOL_H
+
+#include "WVLibVLC.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ==================== 预热播放器池 ====================
+//
+// 池中保存已创建好、并已挂接事件管理器的 libvlc_media_player_t。
+// 创建播放器时直接取出（命中），释放时停止后放回池中而不是销毁。
+// 空闲数量低于低水位时由后台线程补充，高于高水位时多余的播放器被销毁。
+// 最后一个使用中的播放器归还时空闲数量收缩到低水位，池保持预热；空闲播放器持有实例的引用，
+// 只有把水位配置为 0 时实例才随最后一个使用者释放（进程退出时由系统回收）。
+
+struct WVPooledPlayer {
+    libvlc_instance_t* instance;           // 通过 WVInstancePool 获取的实例
+    libvlc_media_player_t* mediaPlayer;
+    libvlc_event_manager_t* eventManager;
+    std::vector<std::string> instanceArgs; // 创建该播放器所用的实例参数
+    bool reusable;                         // 为 false 时归还即销毁（如已注册帧回调，无法还原）
+
+    // 事件转发目标（WVPlayerWrapper），空闲时为 NULL
+    std::mutex ownerMutex;
+    void* owner;
+};
+
+struct WVPlayerPoolStats {
+    unsigned long long hits;     // 直接从池中取出的次数
+    unsigned long long misses;   // 池为空或参数不匹配、同步创建的次数
+    int idleCount;               // 当前空闲数量
+    int liveCount;               // 当前存活的播放器总数（含使用中）
+};
+
+class WVPlayerPool {
+public:
+    /**
+     * 设置事件分发函数。池中每个播放器都会挂接一组固定事件，
+     * 事件发生时以当前 owner 作为 userData 调用该函数（owner 为空时丢弃）
+     */
+    static void SetEventDispatcher(libvlc_callback_t dispatcher);
+
+    /**
+     * 配置池参数并触发预热，超过高水位的空闲播放器立即销毁
+     * @param args 池中播放器使用的实例参数
+     * @param lowWatermark 空闲数量低于该值时后台补充
+     * @param highWatermark 空闲数量超过该值时销毁多余播放器
+     */
+    static void Configure(const std::vector<std::string>& args, int lowWatermark, int highWatermark);
+
+    /**
+     * 取出一个播放器并绑定 owner；池中没有匹配的空闲播放器时同步创建
+     * @return 播放器，创建失败时返回 NULL
+     */
+    static WVPooledPlayer* Checkout(const std::vector<std::string>& args, void* owner);
+
+    /**
+     * 归还播放器（调用方需已停止播放）。解除 owner 绑定并重置状态，
+     * 按水位放回池中或直接销毁；是最后一个使用中的播放器时空闲数量收缩到低水位
+     */
+    static void Return(WVPooledPlayer* player);
+
+    static WVPlayerPoolStats GetStats();
+};
+
+#endif // WV_PLAYER_POOL_H
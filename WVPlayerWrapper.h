@@ -0,0 +1,192 @@
+//
+//  WVPlayerWrapper.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_PLAYER_WRAPPER_H
+#define WV_PLAYER_WRAPPER_H
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "WVLibVLC.h"
+#include "WVPlayerPool.h"
+#include "WVCommandQueue.h"
+#include "WVFrameOutput.h"
+#include "WVOverlayScene.h"
+#include "WVOverlayTimeline.h"
+#include "WVOverlayGeometry.h"
+#include "WVMediaClock.h"
+#include "WVVideoWall.h"
+#include "WVRenditionSet.h"
+#include "WVCachingController.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ==================== 播放器包装结构 ====================
+//
+// 公共 API 的播放器句柄。与平台无关的部分（媒体与播放控制、帧回调模式、覆盖层场景、
+// 画质调节、断线重连、连接调度等）在 WVPlayerCore.cpp，可以在任何平台上构建；
+// 窗口模式（视频窗口、切换用子窗口、覆盖层窗口、监控墙）只在 Windows 上提供，在 WinVLCBridge.cpp。
+// 核心代码需要操作窗口时调用下面的 WVWindow* 函数，由 WinVLCBridge.cpp 实现；
+// 其他平台没有窗口模式，由 WVPlayerCore.cpp 提供空实现。没有窗口的播放器（帧回调模式）调用它们不做任何事。
+
+#ifdef _WIN32
+typedef HWND WVWindowHandle;
+#else
+typedef void* WVWindowHandle;
+#endif
+
+class WVOverlayWindow;
+
+struct WVPlayerWrapper {
+    libvlc_instance_t* vlcInstance;
+    libvlc_media_player_t* mediaPlayer;
+    libvlc_media_t* currentMedia;  // 当前媒体对象
+    WVWindowHandle videoWindow;    // VLC 视频窗口
+    WVWindowHandle parentWindow;   // 父窗口
+    int videoWidth;                // 视频窗口宽度
+    int videoHeight;               // 视频窗口高度
+    int offsetX;                   // 相对于父窗口的X偏移
+    int offsetY;                   // 相对于父窗口的Y偏移
+    float dpiScaleX;               // DPI 水平缩放比例
+    float dpiScaleY;               // DPI 垂直缩放比例（用于计算菜单栏高度）
+    libvlc_event_manager_t* eventManager;  // 事件管理器
+    WVPooledPlayer* pooledPlayer;  // 播放器池中的条目（持有实例、播放器与事件挂接）
+    WVCommandQueue* commandQueue;  // 控制命令队列（VLC 调用在其工作线程上执行）
+    long long playRequestedAt;     // 最近一次发起播放的时间（微秒，仅工作线程访问）
+    std::atomic<long long> firstFrameLatencyUs;  // 最近一次播放到画面配置完成的耗时
+    WVFrameOutput* frameOutput;    // 帧回调模式的输出（窗口模式为 NULL）
+    WVOverlayScene* overlayScene;  // 覆盖层图形（两种模式都有）
+    WVOverlayTimeline* overlayTimeline;  // 带媒体时间提交的覆盖层，按媒体时钟写入 overlayScene
+    WVOverlayMaskStore* overlayMasks;  // 已上传的分割蒙版（场景与时间线共用）
+    WVMediaClock* mediaClock;      // 由播放器事件驱动的播放时间
+    WVOverlayWindow* overlayWindow;  // 窗口模式的覆盖层窗口（首次绘制时创建，UI 线程访问）
+    std::shared_ptr<WVVideoWall> wall;  // 所属监控墙（独立播放器为空），块全部释放后墙才销毁
+    int wallTile;                  // 在监控墙中的序号
+    int visibilityMode;            // WV_VISIBILITY_*（UI 线程访问）
+    bool hidden;                   // 按 visibilityMode 判定的当前可见性（UI 线程访问）
+    std::atomic<bool> suspendRequested;  // 是否应停止解码（UI 线程写，工作线程读）
+    bool decodeSuspended;          // 视频/音频轨道是否已关闭（仅工作线程访问）
+    int suspendedVideoTrack;       // 关闭前的视频轨道 ID
+    int suspendedAudioTrack;       // 关闭前的音频轨道 ID
+    std::string playSource;        // 最近一次请求播放的源（主码流，仅工作线程访问）
+    std::string substreamSource;   // 画质调节器使用的子码流地址（仅工作线程访问）
+    int qualityLevel;              // 当前生效的画质级别 WVQualityLevel（仅工作线程访问）
+    std::mutex playerMutex;        // 保护其他线程对 mediaPlayer 的读取（切换码流时替换播放器）
+    WVRenditionSet renditions;     // 同一画面的多个码流（仅工作线程访问）
+    int activeRendition;           // 当前播放的码流序号，未使用多码流时为 -1（仅工作线程访问）
+    int renditionWidth;            // 选择码流所用的显示尺寸（仅工作线程访问）
+    int renditionHeight;
+    WVWindowHandle surfaces[2];    // 预先打开与切换用的两个渲染子窗口（UI 线程创建，之后不再改变）
+    bool surfacesReady;            // 工作线程是否可以使用 surfaces（仅工作线程访问）
+    int activeSurface;             // 当前播放器渲染的子窗口，-1 表示直接渲染到 videoWindow
+    WVPooledPlayer* standby;       // 预先打开新源（或新码流）的播放器（仅工作线程访问）
+    unsigned long long standbyGeneration;  // 每次开始预先打开时加一，排队后的播放按它识别过期的 standby
+    std::string standbySource;     // standby 的请求源，替换后成为 playSource
+    int standbyRendition;          // standby 打开的码流序号，不是登记的码流时为 -1
+    bool standbyReady;             // standby 已出现画面
+    bool standbyAutoSwap;          // 出现画面后立即替换（码流切换）；预先打开时等待 wv_player_swap
+    std::string standbyPath;       // standby 实际打开的地址（监控墙按它登记）
+    int standbyThreads;            // standby 的解码线程数，替换时登记到监控墙；不属于监控墙时为 0
+    long long swapRequestedAt;     // 请求替换的时间（微秒），0 表示尚未请求
+    std::atomic<long long> switchGapUs;  // 最近一次切换源从请求到新画面显示的耗时
+    bool replacingSource;          // 本次 DoPlay 替换了正在显示的源（首帧耗时即切换耗时）
+    WVCachingController* caching;  // 网络流缓存时长控制（按源记住每次连接的结果）
+    std::atomic<bool> connectQueued;  // 网络流正在连接调度器中排队（当前播放不变）
+    long long connectQueuedAt;     // 开始排队的时间（微秒，仅工作线程访问）
+    std::atomic<long long> connectWaitUs;  // 最近一次打开网络流的排队时间
+};
+
+// ==================== 核心（WVPlayerCore.cpp） ====================
+
+/**
+ * 从预热池取出媒体播放器（事件已挂接），池为空时同步创建；失败时已记录日志
+ */
+bool WVPlayerCheckout(WVPlayerWrapper* wrapper);
+
+/**
+ * 创建覆盖层状态、命令队列与缓存控制，并登记到画质调节器与重连监督器
+ */
+void WVPlayerStart(WVPlayerWrapper* wrapper);
+
+/**
+ * 释放播放器（UI 线程），实际的停止与释放在工作线程上完成
+ * @return 释放命令 ID
+ */
+unsigned long long WVPlayerRelease(WVPlayerWrapper* wrapper);
+
+/**
+ * 显示尺寸变化后重新选择码流（在命令队列工作线程上执行）
+ */
+void WVPlayerUpdateRendition(WVPlayerWrapper* wrapper, int width, int height);
+
+/**
+ * 按可见性模式更新窗口与解码状态（UI 线程）
+ */
+void WVPlayerUpdateVisibility(WVPlayerWrapper* wrapper);
+
+// ==================== 窗口模式（WinVLCBridge.cpp） ====================
+
+/**
+ * 创建预先打开与切换用的两个子窗口（UI 线程），没有窗口或创建失败时返回 false
+ */
+bool WVWindowEnsureSurfaces(WVPlayerWrapper* wrapper);
+
+/**
+ * 让播放器渲染到第 surface 个子窗口（工作线程）
+ * @param show 是否同时显示该子窗口
+ */
+void WVWindowBindSurface(WVPlayerWrapper* wrapper, libvlc_media_player_t* mediaPlayer, int surface, bool show);
+
+/**
+ * 显示子窗口 next 并隐藏 previous（工作线程，previous 为 -1 时只显示）
+ */
+void WVWindowSwapSurface(WVPlayerWrapper* wrapper, int previous, int next);
+
+/**
+ * 开始播放时把视频窗口显示在最上层（UI 线程）
+ */
+void WVWindowRaise(WVPlayerWrapper* wrapper);
+
+/**
+ * 父窗口是否已最小化（自动可见性）
+ */
+bool WVWindowIsMinimized(WVPlayerWrapper* wrapper);
+
+/**
+ * 隐藏或显示视频窗口与覆盖层窗口（UI 线程）
+ */
+void WVWindowSetHidden(WVPlayerWrapper* wrapper, bool hidden);
+
+/**
+ * 开始或停止定时检测父窗口是否最小化（UI 线程）
+ */
+void WVWindowSetAutoVisibility(WVPlayerWrapper* wrapper, bool enabled);
+
+/**
+ * 覆盖层场景变化后立即重绘覆盖层窗口（UI 线程）
+ */
+void WVWindowRenderOverlay(WVPlayerWrapper* wrapper);
+
+/**
+ * 让覆盖层窗口按媒体时钟呈现时间线（UI 线程）
+ */
+void WVWindowAttachOverlayTimeline(WVPlayerWrapper* wrapper);
+
+/**
+ * 释放前立即隐藏窗口，之后窗口的定时器不再访问播放器（UI 线程）
+ */
+void WVWindowDetach(WVPlayerWrapper* wrapper);
+
+/**
+ * 关闭视频窗口与覆盖层窗口（工作线程，窗口由 UI 线程销毁）
+ */
+void WVWindowDestroy(WVPlayerWrapper* wrapper);
+
+#endif // WV_PLAYER_WRAPPER_H
@@ -0,0 +1,363 @@
+//
+//  WVQualityGovernor.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVQualityGovernor.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kSampleIntervalMs = 1000;
+
+// 调整后等待新设置生效（重新打开解码器、统计重新累计）的时间
+const long long kSettleMs = 3000;
+
+// CPU 低于下限且没有丢帧的连续周期数，达到后才恢复一级
+const int kRecoverIntervals = 5;
+
+// 一个周期内解码帧数少于该值时不计算丢帧率（刚开始播放或低帧率源，比例没有意义）
+const unsigned long long kMinDecodedForLoss = 10;
+
+struct Entry {
+    void* player;
+    WVQualityGovernor::Sampler sampler;
+    WVQualityGovernor::Applier applier;
+    int priority;
+    bool substream;
+    int level;
+
+    bool hasBaseline;
+    unsigned long long lastDecoded;
+    unsigned long long lastLost;
+    unsigned long long decodedDelta;   // 最近一个周期的解码帧数
+    float lossPercent;                 // 最近一个周期的丢帧率
+    bool playing;
+};
+
+struct GovernorState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<Entry> entries;
+    WVQualityPolicy policy;
+    bool workerStarted;
+
+    unsigned long long lastCpuTime;    // 进程累计 CPU 时间（100 ns）
+    long long lastSampleMs;
+    float processCpuPercent;
+    long long lastChangeMs;
+    int calmIntervals;
+
+    GovernorState()
+        : workerStarted(false), lastCpuTime(0), lastSampleMs(0), processCpuPercent(0.0f),
+          lastChangeMs(0), calmIntervals(0) {
+        policy.enabled = false;
+        policy.cpuHighPercent = 85.0f;
+        policy.cpuLowPercent = 60.0f;
+        policy.lossHighPercent = 5.0f;
+        policy.maxLevel = WVQualityKeyframes;
+    }
+};
+
+GovernorState& State() {
+    static GovernorState* state = new GovernorState();  // 进程退出时不析构，避免与后台线程竞争
+    return *state;
+}
+
+// 进程累计占用的 CPU 时间（内核 + 用户），单位 100 纳秒
+bool ProcessCpuTime(unsigned long long* cpuTime) {
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) return false;
+    *cpuTime = ((static_cast<unsigned long long>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime) +
+               ((static_cast<unsigned long long>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return false;
+    unsigned long long micros =
+        (static_cast<unsigned long long>(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000ULL +
+        usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    *cpuTime = micros * 10;
+#endif
+    return true;
+}
+
+Entry* FindLocked(GovernorState& state, void* player) {
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        if (state.entries[i].player == player) return &state.entries[i];
+    }
+    return NULL;
+}
+
+// 下一级 / 上一级，没有子码流时跳过 WVQualitySubstream；无法再调整时返回 -1
+int NextLevel(const Entry& entry, int maxLevel) {
+    int level = entry.level + 1;
+    if (level == WVQualitySubstream && !entry.substream) ++level;
+    return level <= maxLevel && level <= WVQualityKeyframes ? level : -1;
+}
+
+int PreviousLevel(const Entry& entry) {
+    int level = entry.level - 1;
+    if (level == WVQualitySubstream && !entry.substream) --level;
+    return level >= WVQualityFull ? level : -1;
+}
+
+void SetLevelLocked(Entry& entry, int level, const char* reason) {
+    WV_LOG_INFO("画质调节：播放器 %p（优先级 %d）级别 %d -> %d（%s）",
+                entry.player, entry.priority, entry.level, level, reason);
+    entry.level = level;
+    entry.hasBaseline = false;   // 新设置重新打开媒体，统计从零开始
+    entry.applier(level);
+}
+
+void SampleProcessCpuLocked(GovernorState& state, long long now) {
+    unsigned long long cpuTime = 0;
+    if (!ProcessCpuTime(&cpuTime)) return;
+
+    if (state.lastSampleMs > 0 && now > state.lastSampleMs) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        if (cores == 0) cores = 1;
+        double busyMs = (cpuTime - state.lastCpuTime) / 10000.0;
+        state.processCpuPercent = static_cast<float>(busyMs * 100.0 / ((now - state.lastSampleMs) * cores));
+    }
+    state.lastCpuTime = cpuTime;
+    state.lastSampleMs = now;
+}
+
+// 读取各播放器的统计，返回是否有正在播放的播放器丢帧率超限
+bool SamplePlayersLocked(GovernorState& state) {
+    bool lossPressure = false;
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        Entry& entry = state.entries[i];
+        WVQualitySample sample;
+        if (!entry.sampler(&sample)) {
+            entry.hasBaseline = false;
+            entry.playing = false;
+            continue;
+        }
+
+        entry.decodedDelta = 0;
+        entry.lossPercent = 0.0f;
+        // 没有基准或统计变小（换了媒体）时只记录基准
+        if (entry.hasBaseline && sample.decoded >= entry.lastDecoded && sample.lost >= entry.lastLost) {
+            entry.decodedDelta = sample.decoded - entry.lastDecoded;
+            if (entry.decodedDelta >= kMinDecodedForLoss) {
+                entry.lossPercent = (sample.lost - entry.lastLost) * 100.0f / entry.decodedDelta;
+            }
+        }
+        entry.hasBaseline = true;
+        entry.lastDecoded = sample.decoded;
+        entry.lastLost = sample.lost;
+        entry.playing = sample.playing;
+
+        if (entry.playing && entry.lossPercent >= state.policy.lossHighPercent) {
+            lossPressure = true;
+        }
+    }
+    return lossPressure;
+}
+
+// 降级优先级最低的一路；优先级相同时选解码量最大的
+bool DegradeOneLocked(GovernorState& state, const char* reason) {
+    Entry* target = NULL;
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        Entry& entry = state.entries[i];
+        if (!entry.playing || entry.priority >= WVQualityGovernor::kMaxPriority) continue;
+        if (NextLevel(entry, state.policy.maxLevel) < 0) continue;
+        if (!target || entry.priority < target->priority ||
+            (entry.priority == target->priority && entry.decodedDelta > target->decodedDelta)) {
+            target = &entry;
+        }
+    }
+    if (!target) return false;
+    SetLevelLocked(*target, NextLevel(*target, state.policy.maxLevel), reason);
+    return true;
+}
+
+// 恢复优先级最高的一路；优先级相同时先恢复降级最多的
+bool RestoreOneLocked(GovernorState& state) {
+    Entry* target = NULL;
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        Entry& entry = state.entries[i];
+        if (PreviousLevel(entry) < 0) continue;
+        if (!target || entry.priority > target->priority ||
+            (entry.priority == target->priority && entry.level > target->level)) {
+            target = &entry;
+        }
+    }
+    if (!target) return false;
+    SetLevelLocked(*target, PreviousLevel(*target), "压力解除");
+    return true;
+}
+
+void EvaluateLocked(GovernorState& state) {
+    long long now = WVClockNowMs();
+    SampleProcessCpuLocked(state, now);
+    bool lossPressure = SamplePlayersLocked(state);
+    if (!state.policy.enabled) return;
+
+    bool settled = now - state.lastChangeMs >= kSettleMs;
+    if (state.processCpuPercent >= state.policy.cpuHighPercent || lossPressure) {
+        state.calmIntervals = 0;
+        if (settled && DegradeOneLocked(state, lossPressure ? "丢帧" : "CPU 占用过高")) {
+            state.lastChangeMs = now;
+        }
+    } else if (state.processCpuPercent < state.policy.cpuLowPercent) {
+        if (++state.calmIntervals >= kRecoverIntervals && settled) {
+            state.calmIntervals = 0;
+            if (RestoreOneLocked(state)) {
+                state.lastChangeMs = now;
+            }
+        }
+    } else {
+        state.calmIntervals = 0;
+    }
+}
+
+void RunGovernor() {
+    GovernorState& state = State();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    for (;;) {
+        state.cond.wait_for(lock, std::chrono::milliseconds(kSampleIntervalMs));
+        // 模拟时钟下由调用方推进时间后调用 Poll
+        if (WVClockIsSimulated()) continue;
+        if (!state.entries.empty()) {
+            EvaluateLocked(state);
+        }
+    }
+}
+
+} // namespace
+
+void WVQualityGovernor::Register(void* player, const Sampler& sampler, const Applier& applier) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (FindLocked(state, player)) return;
+
+    Entry entry;
+    entry.player = player;
+    entry.sampler = sampler;
+    entry.applier = applier;
+    entry.priority = kDefaultPriority;
+    entry.substream = false;
+    entry.level = WVQualityFull;
+    entry.hasBaseline = false;
+    entry.lastDecoded = 0;
+    entry.lastLost = 0;
+    entry.decodedDelta = 0;
+    entry.lossPercent = 0.0f;
+    entry.playing = false;
+    state.entries.push_back(entry);
+
+    if (!state.workerStarted) {
+        state.workerStarted = true;
+        std::thread(RunGovernor).detach();
+    }
+}
+
+void WVQualityGovernor::Unregister(void* player) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        if (state.entries[i].player == player) {
+            state.entries.erase(state.entries.begin() + i);
+            return;
+        }
+    }
+}
+
+void WVQualityGovernor::SetPriority(void* player, int priority) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    if (!entry) return;
+    if (priority < 0) priority = 0;
+    if (priority > kMaxPriority) priority = kMaxPriority;
+    entry->priority = priority;
+
+    // 提升为最高优先级的播放器立即恢复原始画质
+    if (priority >= kMaxPriority && entry->level != WVQualityFull) {
+        SetLevelLocked(*entry, WVQualityFull, "最高优先级");
+    }
+}
+
+int WVQualityGovernor::Priority(void* player) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    return entry ? entry->priority : kDefaultPriority;
+}
+
+void WVQualityGovernor::SetSubstreamAvailable(void* player, bool available) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    if (entry) {
+        entry->substream = available;
+    }
+}
+
+int WVQualityGovernor::Level(void* player) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    return entry ? entry->level : WVQualityFull;
+}
+
+void WVQualityGovernor::Configure(const WVQualityPolicy& policy) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.policy = policy;
+    if (state.policy.cpuLowPercent > state.policy.cpuHighPercent) {
+        state.policy.cpuLowPercent = state.policy.cpuHighPercent;
+    }
+    if (state.policy.maxLevel < WVQualityFull) state.policy.maxLevel = WVQualityFull;
+    if (state.policy.maxLevel > WVQualityKeyframes) state.policy.maxLevel = WVQualityKeyframes;
+    state.calmIntervals = 0;
+
+    // 停用或降低了允许的最大级别时，超出的播放器立即恢复
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        Entry& entry = state.entries[i];
+        if (!state.policy.enabled && entry.level != WVQualityFull) {
+            SetLevelLocked(entry, WVQualityFull, "调节器停用");
+        } else if (entry.level > state.policy.maxLevel) {
+            int level = state.policy.maxLevel;
+            if (level == WVQualitySubstream && !entry.substream) level = WVQualityReduced;
+            SetLevelLocked(entry, level, "策略变化");
+        }
+    }
+}
+
+void WVQualityGovernor::Poll() {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.entries.empty()) {
+        EvaluateLocked(state);
+    }
+}
+
+void WVQualityGovernor::GetStats(float* processCpuPercent, int* degradedCount) {
+    GovernorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (processCpuPercent) *processCpuPercent = state.processCpuPercent;
+    if (degradedCount) {
+        int count = 0;
+        for (size_t i = 0; i < state.entries.size(); ++i) {
+            if (state.entries[i].level != WVQualityFull) ++count;
+        }
+        *degradedCount = count;
+    }
+}
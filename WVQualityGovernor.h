@@ -0,0 +1,103 @@
+//
+//  WVQualityGovernor.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_QUALITY_GOVERNOR_H
+#define WV_QUALITY_GOVERNOR_H
+
+#include <functional>
+
+// ==================== CPU 压力下的画质调节 ====================
+//
+// CPU 饱和时 VLC 在各路之间随机丢弃迟到的帧，重要的画面同样卡顿。
+// 调节器在后台线程上按固定周期采样进程 CPU 占用与各播放器的解码统计（解码帧数/丢弃帧数），
+// 有压力时按优先级从低到高逐路降级，压力解除一段时间后再按优先级从高到低逐路恢复：
+//   - 压力：进程 CPU（占全部逻辑核的百分比）达到上限，或任一播放器的丢帧率达到上限；
+//   - 每次只调整一路一级，调整后等待新的设置生效（重新打开解码器）再看效果；
+//   - 恢复：CPU 低于下限且没有播放器丢帧，连续数个周期后才恢复一级，避免来回振荡；
+//   - 优先级相同时先降级解码量最大的一路；最高优先级的播放器从不降级。
+// 级别的含义与生效方式由播放器通过回调决定（见 WVQualityLevel），调节器只负责选择。
+// 所有方法线程安全；回调在调节器线程上、持有内部锁时调用，不能阻塞，也不能回调本类。
+
+enum WVQualityLevel {
+    WVQualityFull = 0,            // 原始画质
+    WVQualityReduced = 1,         // 跳过非参考帧的解码与全部环路滤波
+    WVQualitySubstream = 2,       // 改用子码流（没有子码流的播放器跳过这一级）
+    WVQualityKeyframes = 3        // 只解码关键帧（帧率降到关键帧间隔）
+};
+
+struct WVQualityPolicy {
+    bool enabled;
+    float cpuHighPercent;         // 进程 CPU 达到该值时降级
+    float cpuLowPercent;          // 低于该值（且没有丢帧）时恢复
+    float lossHighPercent;        // 单路丢帧率（丢弃/解码）达到该值时降级
+    int maxLevel;                 // 最多降到的级别（WVQualityLevel）
+};
+
+struct WVQualitySample {
+    unsigned long long decoded;   // 当前媒体累计解码的视频帧数
+    unsigned long long lost;      // 当前媒体累计丢弃的帧数
+    bool playing;                 // 是否正在播放（停止、暂停、不可见的播放器不参与选择）
+};
+
+class WVQualityGovernor {
+public:
+    typedef std::function<bool(WVQualitySample* sample)> Sampler;
+    typedef std::function<void(int level)> Applier;
+
+    static const int kDefaultPriority = 50;
+    static const int kMaxPriority = 100;   // 该优先级的播放器从不降级
+
+    /**
+     * 登记播放器，首次登记时启动调节器线程
+     * @param sampler 读取解码统计，没有媒体时返回 false
+     * @param applier 切换到新的级别（应异步执行）
+     */
+    static void Register(void* player, const Sampler& sampler, const Applier& applier);
+
+    /**
+     * 注销播放器；返回后不会再调用它的回调
+     */
+    static void Unregister(void* player);
+
+    /**
+     * @param priority 0-100，越大越重要
+     */
+    static void SetPriority(void* player, int priority);
+
+    /**
+     * 播放器的优先级，未登记时返回默认值
+     */
+    static int Priority(void* player);
+
+    /**
+     * 是否配置了子码流（决定能否使用 WVQualitySubstream 级别）
+     */
+    static void SetSubstreamAvailable(void* player, bool available);
+
+    /**
+     * 播放器当前的级别，未登记时返回 0
+     */
+    static int Level(void* player);
+
+    /**
+     * 设置策略并立即生效；停用时所有播放器恢复原始画质
+     */
+    static void Configure(const WVQualityPolicy& policy);
+
+    /**
+     * 立即采样并调整一次（平时由后台线程每秒执行；使用模拟时钟时由调用方推进时间后调用，见 WVClock.h）
+     */
+    static void Poll();
+
+    /**
+     * @param processCpuPercent 最近一个周期的进程 CPU 占用
+     * @param degradedCount 当前处于降级状态的播放器数量
+     */
+    static void GetStats(float* processCpuPercent, int* degradedCount);
+};
+
+#endif // WV_QUALITY_GOVERNOR_H
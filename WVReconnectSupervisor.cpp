@@ -0,0 +1,353 @@
+//
+//  WVReconnectSupervisor.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVReconnectSupervisor.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kSampleIntervalMs = 500;
+
+// 打开后等待首帧的时间下限（RTSP 握手与初始缓冲可能需要数秒）
+const long long kMinConnectTimeoutMs = 10000;
+
+struct Entry {
+    void* player;
+    WVReconnectSupervisor::Sampler sampler;
+    WVReconnectSupervisor::Reconnector reconnector;
+    int state;
+    unsigned long long generation;   // 每次打开或停止时增加，使已投递的重连失效
+    int attempts;
+    int reconnects;
+    bool holdsSlot;                  // 是否占用重连名额
+    long long openedAtMs;
+    long long lastProgressMs;        // 最近一次帧数增长（或不需要检测）的时间
+    unsigned long long lastFrames;
+    long long retryAtMs;             // 计划重连的时间，0 表示没有计划
+};
+
+struct SupervisorState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<Entry> entries;
+    WVReconnectPolicy policy;
+    bool workerStarted;
+    int inFlight;
+    std::minstd_rand random;
+
+    SupervisorState()
+        : workerStarted(false), inFlight(0),
+          random(WVClockIsSimulated() ? 1u :
+                 static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count())) {
+        policy.enabled = true;         // 默认启用：断线的摄像头不依赖调用方重新播放
+        policy.initialDelayMs = 1000;
+        policy.maxDelayMs = 30000;
+        policy.maxAttempts = 0;
+        policy.stallTimeoutMs = 5000;
+        policy.maxConcurrent = 4;
+    }
+};
+
+SupervisorState& State() {
+    static SupervisorState* state = new SupervisorState();  // 进程退出时不析构，避免与后台线程竞争
+    return *state;
+}
+
+Entry* FindLocked(SupervisorState& state, void* player) {
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        if (state.entries[i].player == player) return &state.entries[i];
+    }
+    return NULL;
+}
+
+void ReleaseSlotLocked(SupervisorState& state, Entry& entry) {
+    if (entry.holdsSlot) {
+        entry.holdsSlot = false;
+        --state.inFlight;
+    }
+}
+
+// 第 attempts + 1 次重连前的等待时间：指数退避，在 [间隔/2, 间隔] 之间随机
+long long BackoffMsLocked(SupervisorState& state, int attempts) {
+    long long delay = state.policy.initialDelayMs;
+    for (int i = 0; i < attempts && delay < state.policy.maxDelayMs; ++i) {
+        delay *= 2;
+    }
+    if (delay > state.policy.maxDelayMs) delay = state.policy.maxDelayMs;
+    long long half = delay / 2;
+    return half + static_cast<long long>(state.random() % static_cast<unsigned long long>(delay - half + 1));
+}
+
+// 连接失败、中断或卡住：安排下一次重连，或进入 Failed
+void FailLocked(SupervisorState& state, Entry& entry, long long now, bool stalled, const char* reason) {
+    ReleaseSlotLocked(state, entry);
+    entry.retryAtMs = 0;
+
+    if (!state.policy.enabled) {
+        // 未启用自动重连：卡住的连接可能自行恢复，出错的连接等待再次播放
+        entry.state = stalled ? WVHealthStalled : WVHealthFailed;
+        WV_LOG_WARN("播放器 %p %s（未启用自动重连）", entry.player, reason);
+        return;
+    }
+    if (state.policy.maxAttempts > 0 && entry.attempts >= state.policy.maxAttempts) {
+        entry.state = WVHealthFailed;
+        WV_LOG_ERROR("播放器 %p %s，已连续重连 %d 次，停止重连", entry.player, reason, entry.attempts);
+        return;
+    }
+
+    long long delay = BackoffMsLocked(state, entry.attempts);
+    entry.state = WVHealthStalled;
+    entry.retryAtMs = now + delay;
+    WV_LOG_WARN("播放器 %p %s，%lld ms 后第 %d 次重连", entry.player, reason, delay, entry.attempts + 1);
+}
+
+void GoLiveLocked(SupervisorState& state, Entry& entry, long long now, unsigned long long frames) {
+    ReleaseSlotLocked(state, entry);
+    if (entry.state == WVHealthReconnecting || entry.state == WVHealthStalled) {
+        ++entry.reconnects;
+        WV_LOG_INFO("播放器 %p 已恢复画面（连续重连 %d 次）", entry.player, entry.attempts);
+    }
+    entry.state = WVHealthLive;
+    entry.attempts = 0;
+    entry.retryAtMs = 0;
+    entry.lastFrames = frames;
+    entry.lastProgressMs = now;
+}
+
+void StartReconnectLocked(SupervisorState& state, Entry& entry, long long now) {
+    entry.state = WVHealthReconnecting;
+    entry.retryAtMs = 0;
+    entry.openedAtMs = now;
+    entry.holdsSlot = true;
+    ++entry.attempts;
+    ++state.inFlight;
+    WV_LOG_INFO("播放器 %p 开始第 %d 次重连（进行中 %d 路）", entry.player, entry.attempts, state.inFlight);
+    entry.reconnector(entry.generation);
+}
+
+void EvaluateEntryLocked(SupervisorState& state, Entry& entry, long long now) {
+    if (entry.state == WVHealthIdle || entry.state == WVHealthFailed) return;
+
+    WVHealthSample sample;
+    if (!entry.sampler(&sample)) return;
+
+    // 排队等待连接名额时，采样到的仍是之前的媒体；连接超时与无帧检测从实际打开时算起
+    if (sample.queued) {
+        entry.openedAtMs = now;
+        entry.lastProgressMs = now;
+        return;
+    }
+
+    long long connectTimeout = state.policy.stallTimeoutMs > kMinConnectTimeoutMs ?
+        state.policy.stallTimeoutMs : kMinConnectTimeoutMs;
+    bool progressed = sample.active && (sample.suspended || sample.frames != entry.lastFrames);
+
+    switch (entry.state) {
+        case WVHealthConnecting:
+        case WVHealthReconnecting:
+            if (sample.failed) {
+                FailLocked(state, entry, now, false, "连接失败");
+            } else if (sample.finished) {
+                ReleaseSlotLocked(state, entry);
+                entry.state = WVHealthIdle;
+            } else if (progressed) {
+                GoLiveLocked(state, entry, now, sample.frames);
+            } else if (now - entry.openedAtMs >= connectTimeout) {
+                FailLocked(state, entry, now, false, "连接超时");
+            }
+            break;
+        case WVHealthLive:
+            if (sample.failed) {
+                FailLocked(state, entry, now, false, "连接中断");
+            } else if (sample.finished) {
+                entry.state = WVHealthIdle;
+            } else if (progressed || sample.paused || !sample.active) {
+                entry.lastFrames = sample.frames;
+                entry.lastProgressMs = now;
+            } else if (now - entry.lastProgressMs >= state.policy.stallTimeoutMs) {
+                FailLocked(state, entry, now, true, "长时间没有新的帧");
+            }
+            break;
+        case WVHealthStalled:
+            // 卡住的连接自行恢复时不再重连
+            if (!sample.failed && progressed && !sample.suspended) {
+                GoLiveLocked(state, entry, now, sample.frames);
+            } else if (entry.retryAtMs > 0 && now >= entry.retryAtMs &&
+                       state.inFlight < state.policy.maxConcurrent) {
+                StartReconnectLocked(state, entry, now);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void EvaluateAllLocked(SupervisorState& state) {
+    long long now = WVClockNowMs();
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        EvaluateEntryLocked(state, state.entries[i], now);
+    }
+}
+
+void RunSupervisor() {
+    SupervisorState& state = State();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    for (;;) {
+        state.cond.wait_for(lock, std::chrono::milliseconds(kSampleIntervalMs));
+        // 模拟时钟下由调用方推进时间后调用 Poll
+        if (WVClockIsSimulated()) continue;
+        EvaluateAllLocked(state);
+    }
+}
+
+} // namespace
+
+void WVReconnectSupervisor::Register(void* player, const Sampler& sampler, const Reconnector& reconnector) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (FindLocked(state, player)) return;
+
+    Entry entry;
+    entry.player = player;
+    entry.sampler = sampler;
+    entry.reconnector = reconnector;
+    entry.state = WVHealthIdle;
+    entry.generation = 0;
+    entry.attempts = 0;
+    entry.reconnects = 0;
+    entry.holdsSlot = false;
+    entry.openedAtMs = 0;
+    entry.lastProgressMs = 0;
+    entry.lastFrames = 0;
+    entry.retryAtMs = 0;
+    state.entries.push_back(entry);
+
+    if (!state.workerStarted) {
+        state.workerStarted = true;
+        std::thread(RunSupervisor).detach();
+    }
+}
+
+void WVReconnectSupervisor::Unregister(void* player) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (size_t i = 0; i < state.entries.size(); ++i) {
+        if (state.entries[i].player == player) {
+            ReleaseSlotLocked(state, state.entries[i]);
+            state.entries.erase(state.entries.begin() + i);
+            return;
+        }
+    }
+}
+
+void WVReconnectSupervisor::OnOpen(void* player, bool network) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    if (!entry) return;
+
+    ++entry->generation;
+    entry->retryAtMs = 0;
+    entry->lastFrames = 0;
+    entry->openedAtMs = WVClockNowMs();
+    if (!network) {
+        ReleaseSlotLocked(state, *entry);
+        entry->state = WVHealthIdle;
+        return;
+    }
+    // 重连打开的媒体保持 Reconnecting（继续占用名额与累计失败次数）
+    if (entry->state != WVHealthReconnecting) {
+        ReleaseSlotLocked(state, *entry);
+        entry->attempts = 0;
+        entry->state = WVHealthConnecting;
+    }
+}
+
+void WVReconnectSupervisor::OnClose(void* player) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    if (!entry) return;
+
+    ++entry->generation;
+    ReleaseSlotLocked(state, *entry);
+    entry->state = WVHealthIdle;
+    entry->attempts = 0;
+    entry->retryAtMs = 0;
+}
+
+bool WVReconnectSupervisor::IsCurrent(void* player, unsigned long long generation) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    return entry && entry->generation == generation && entry->state == WVHealthReconnecting;
+}
+
+int WVReconnectSupervisor::Health(void* player) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    return entry ? entry->state : WVHealthIdle;
+}
+
+void WVReconnectSupervisor::GetPlayerStats(void* player, int* attempts, int* reconnects) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Entry* entry = FindLocked(state, player);
+    if (attempts) *attempts = entry ? entry->attempts : 0;
+    if (reconnects) *reconnects = entry ? entry->reconnects : 0;
+}
+
+void WVReconnectSupervisor::Configure(const WVReconnectPolicy& policy) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.policy = policy;
+    if (state.policy.initialDelayMs <= 0) state.policy.initialDelayMs = 1000;
+    if (state.policy.maxDelayMs < state.policy.initialDelayMs) {
+        state.policy.maxDelayMs = state.policy.initialDelayMs > 30000 ? state.policy.initialDelayMs : 30000;
+    }
+    if (state.policy.maxAttempts < 0) state.policy.maxAttempts = 0;
+    if (state.policy.stallTimeoutMs <= 0) state.policy.stallTimeoutMs = 5000;
+    if (state.policy.maxConcurrent <= 0) state.policy.maxConcurrent = 4;
+
+    // 停用后不再执行已计划的重连
+    if (!state.policy.enabled) {
+        for (size_t i = 0; i < state.entries.size(); ++i) {
+            Entry& entry = state.entries[i];
+            if (entry.retryAtMs > 0) {
+                entry.retryAtMs = 0;
+                entry.state = WVHealthFailed;
+            }
+        }
+    }
+}
+
+void WVReconnectSupervisor::Poll() {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    EvaluateAllLocked(state);
+}
+
+void WVReconnectSupervisor::GetStats(int* inFlight, int* waiting) {
+    SupervisorState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (inFlight) *inFlight = state.inFlight;
+    if (waiting) {
+        int count = 0;
+        for (size_t i = 0; i < state.entries.size(); ++i) {
+            if (state.entries[i].retryAtMs > 0) ++count;
+        }
+        *waiting = count;
+    }
+}
@@ -0,0 +1,118 @@
+//
+//  WVReconnectSupervisor.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_RECONNECT_SUPERVISOR_H
+#define WV_RECONNECT_SUPERVISOR_H
+
+#include <functional>
+
+// ==================== 网络流断线重连 ====================
+//
+// 摄像头断线后播放器停在 Error 或 Ended 状态，之前要等 JavaScript 发现后再次调用 wv_player_play
+// （通常是紧凑的循环，50 路同时断线时形成重连风暴）。
+// 监督器在后台线程上按固定周期采样各播放器的状态与已显示帧数，维护健康状态：
+//   Connecting   打开后等待首帧（超时视为失败）
+//   Live         画面持续更新
+//   Stalled      连接失败、结束，或一段时间没有新的帧；等待退避时间与重连名额
+//   Reconnecting 重连进行中（占用一个名额，直到出现画面或失败）
+//   Failed       连续失败达到上限，或未启用自动重连时连接失败；等待再次调用播放
+// 重连间隔按指数退避（初始值每次翻倍，不超过上限），并在 [间隔/2, 间隔] 之间随机，
+// 避免同时断线的摄像头同时重连；同时进行的重连数不超过上限，其余排队等待名额。
+// 暂停与不可见（停止解码）的播放器不做无帧检测；新的连接排队期间不计时。
+// 所有方法线程安全；回调在监督器线程上、持有内部锁时调用，不能阻塞，也不能回调本类。
+
+enum WVHealthState {
+    WVHealthIdle = 0,             // 未播放网络流（停止、本地文件、已正常结束）
+    WVHealthConnecting = 1,
+    WVHealthLive = 2,
+    WVHealthStalled = 3,
+    WVHealthReconnecting = 4,
+    WVHealthFailed = 5
+};
+
+struct WVReconnectPolicy {
+    bool enabled;                 // 是否自动重连（默认启用；未启用时只维护健康状态）
+    int initialDelayMs;           // 第一次重连前的等待时间
+    int maxDelayMs;               // 退避时间上限
+    int maxAttempts;              // 连续失败的重连次数上限，0 表示不限
+    int stallTimeoutMs;           // 没有新帧多久视为卡住
+    int maxConcurrent;            // 同时进行的重连数上限
+};
+
+struct WVHealthSample {
+    unsigned long long frames;    // 当前媒体累计显示的帧数
+    bool active;                  // 正在打开、缓冲或播放
+    bool paused;
+    bool failed;                  // 出错，或直播流意外结束
+    bool finished;                // 有时长的媒体正常播放结束
+    bool suspended;               // 不可见，已停止解码（帧数不再增长）
+    bool queued;                  // 新的连接在连接调度器中排队（尚未打开，状态仍是之前的媒体）
+};
+
+class WVReconnectSupervisor {
+public:
+    typedef std::function<bool(WVHealthSample* sample)> Sampler;
+    typedef std::function<void(unsigned long long generation)> Reconnector;
+
+    /**
+     * 登记播放器，首次登记时启动监督器线程
+     * @param sampler 读取播放器状态，没有媒体时返回 false
+     * @param reconnector 重新打开当前源（应异步执行）；执行前用 IsCurrent 确认这次重连仍然有效
+     */
+    static void Register(void* player, const Sampler& sampler, const Reconnector& reconnector);
+
+    /**
+     * 注销播放器；返回后不会再调用它的回调，占用的名额随之释放
+     */
+    static void Unregister(void* player);
+
+    /**
+     * 播放器打开了新的媒体（播放、换源、重连都要调用）
+     * @param network 是否为网络流（只监督网络流）
+     */
+    static void OnOpen(void* player, bool network);
+
+    /**
+     * 播放器已停止，回到 Idle 并取消等待中的重连
+     */
+    static void OnClose(void* player);
+
+    /**
+     * 重连回调投递后、执行前调用：之后有新的打开或停止时返回 false
+     */
+    static bool IsCurrent(void* player, unsigned long long generation);
+
+    /**
+     * 播放器的健康状态 WVHealthState，未登记时返回 WVHealthIdle
+     */
+    static int Health(void* player);
+
+    /**
+     * @param attempts 当前连续失败的重连次数
+     * @param reconnects 重连成功的累计次数
+     */
+    static void GetPlayerStats(void* player, int* attempts, int* reconnects);
+
+    /**
+     * 设置策略，下一个周期生效
+     */
+    static void Configure(const WVReconnectPolicy& policy);
+
+    /**
+     * 立即对所有播放器采样一次（平时由后台线程每 500 ms 执行；使用模拟时钟时由调用方推进时间后调用，
+     * 见 WVClock.h）
+     */
+    static void Poll();
+
+    /**
+     * @param inFlight 正在进行的重连数
+     * @param waiting 等待重连（Stalled）的播放器数
+     */
+    static void GetStats(int* inFlight, int* waiting);
+};
+
+#endif // WV_RECONNECT_SUPERVISOR_H
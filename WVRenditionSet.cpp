@@ -0,0 +1,69 @@
+//
+//  WVRenditionSet.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVRenditionSet.h"
+
+bool WVRenditionSet::Add(const std::string& source, int width, int height) {
+    if (source.empty() || width <= 0 || height <= 0) return false;
+
+    int existing = Find(source);
+    if (existing >= 0) {
+        renditions[existing].width = width;
+        renditions[existing].height = height;
+        return true;
+    }
+    if (renditions.size() >= kMaxRenditions) return false;
+
+    Rendition rendition;
+    rendition.source = source;
+    rendition.width = width;
+    rendition.height = height;
+    renditions.push_back(rendition);
+    return true;
+}
+
+void WVRenditionSet::Clear() {
+    renditions.clear();
+}
+
+bool WVRenditionSet::Empty() const {
+    return renditions.empty();
+}
+
+int WVRenditionSet::Find(const std::string& source) const {
+    for (size_t i = 0; i < renditions.size(); ++i) {
+        if (renditions[i].source == source) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int WVRenditionSet::Select(int displayWidth, int displayHeight) const {
+    int covering = -1;
+    int largest = -1;
+    long long coveringPixels = 0;
+    long long largestPixels = 0;
+    bool known = displayWidth > 0 && displayHeight > 0;
+
+    for (size_t i = 0; i < renditions.size(); ++i) {
+        const Rendition& rendition = renditions[i];
+        long long pixels = static_cast<long long>(rendition.width) * rendition.height;
+        if (largest < 0 || pixels > largestPixels) {
+            largest = static_cast<int>(i);
+            largestPixels = pixels;
+        }
+        if (known && rendition.width >= displayWidth && rendition.height >= displayHeight &&
+            (covering < 0 || pixels < coveringPixels)) {
+            covering = static_cast<int>(i);
+            coveringPixels = pixels;
+        }
+    }
+    return covering >= 0 ? covering : largest;
+}
+
+const std::string& WVRenditionSet::Source(int index) const {
+    return renditions[index].source;
+}
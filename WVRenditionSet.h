@@ -0,0 +1,59 @@
+//
+//  WVRenditionSet.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_RENDITION_SET_H
+#define WV_RENDITION_SET_H
+
+#include <string>
+#include <vector>
+
+// ==================== 多码流选择 ====================
+//
+// 网络摄像头通常同时提供高分辨率的主码流与低分辨率的子码流。播放器登记同一画面的多个码流
+// （地址 + 分辨率），按窗口在屏幕上的实际像素尺寸选择能覆盖它的最小码流：
+// 监控墙中的小窗口播放子码流，解码量可以低一个数量级；放大后再切回主码流。
+// 本类只负责记录与选择，不做线程同步（由播放器的命令队列工作线程访问）。
+
+class WVRenditionSet {
+public:
+    static const size_t kMaxRenditions = 8;
+
+    /**
+     * 登记一个码流；地址已存在时更新其分辨率
+     * @return 是否成功（参数无效或已满时返回 false）
+     */
+    bool Add(const std::string& source, int width, int height);
+
+    void Clear();
+
+    bool Empty() const;
+
+    /**
+     * 查找地址对应的码流序号，不存在时返回 -1
+     */
+    int Find(const std::string& source) const;
+
+    /**
+     * 选择宽和高都不小于显示尺寸的码流中像素最少的一个；都不够大时选像素最多的一个。
+     * 显示尺寸未知（<= 0，如帧回调模式按原始尺寸输出）时选像素最多的一个
+     * @return 码流序号，没有码流时返回 -1
+     */
+    int Select(int displayWidth, int displayHeight) const;
+
+    const std::string& Source(int index) const;
+
+private:
+    struct Rendition {
+        std::string source;
+        int width;
+        int height;
+    };
+
+    std::vector<Rendition> renditions;
+};
+
+#endif // WV_RENDITION_SET_H
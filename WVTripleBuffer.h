@@ -0,0 +1,67 @@
+//
+//  WVTripleBuffer.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_TRIPLE_BUFFER_H
+#define WV_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+
+// ==================== 无锁三缓冲 ====================
+//
+// 生产者（VLC 显示回调）与消费者之间交换帧的原语，三个缓冲区分别为：
+//   back   - 生产者正在写入，只有生产者访问
+//   middle - 最新的完整帧，等待消费者取走
+//   front  - 消费者正在读取，只有消费者访问
+//
+// 共享状态只有一个 32 位原子量（middle 索引 + “有新帧”标记），可以放在共享内存中
+// 跨进程使用。发布与获取各是一次原子交换：生产者从不等待消费者，消费者总是拿到
+// 最新的完整帧，且读取期间不会被覆盖（不会撕裂）。
+// 仅支持单生产者、单消费者。
+
+class WVTripleBuffer {
+public:
+    static const uint32_t kIndexMask = 3u;
+    static const uint32_t kFreshBit = 4u;
+
+    /**
+     * 初始化共享状态：back=0，middle=1（无新帧），front=2
+     */
+    static void Initialize(std::atomic<uint32_t>& state) {
+        state.store(1u, std::memory_order_release);
+    }
+
+    static uint32_t InitialBackIndex() { return 0u; }
+    static uint32_t InitialFrontIndex() { return 2u; }
+
+    /**
+     * 生产者发布 back 中写好的帧，并换回新的 back 索引
+     * @param backIndex 输入当前 back 索引，输出新的 back 索引
+     * @return true 表示覆盖了一帧消费者尚未取走的帧
+     */
+    static bool Publish(std::atomic<uint32_t>& state, uint32_t* backIndex) {
+        uint32_t previous = state.exchange(*backIndex | kFreshBit, std::memory_order_acq_rel);
+        *backIndex = previous & kIndexMask;
+        return (previous & kFreshBit) != 0;
+    }
+
+    /**
+     * 消费者获取最新帧
+     * @param frontIndex 输入当前 front 索引，有新帧时输出新的 front 索引
+     * @return true 表示取到了新帧；false 表示没有新帧，front 保持不变
+     */
+    static bool Acquire(std::atomic<uint32_t>& state, uint32_t* frontIndex) {
+        if ((state.load(std::memory_order_acquire) & kFreshBit) == 0) {
+            return false;
+        }
+        uint32_t previous = state.exchange(*frontIndex, std::memory_order_acq_rel);
+        *frontIndex = previous & kIndexMask;
+        return true;
+    }
+};
+
+#endif // WV_TRIPLE_BUFFER_H
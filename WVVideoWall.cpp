@@ -0,0 +1,124 @@
+//
+//  WVVideoWall.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVVideoWall.h"
+#include <thread>
+
+namespace {
+
+const unsigned long long kReferencePixels = 1920ULL * 1080ULL;
+
+const double kMinWeight = 0.25;
+const double kMaxWeight = 4.0;
+
+// 记住的源分辨率上限，超出时整体清空（监控墙的源地址通常是固定的几十个）
+const size_t kMaxKnownSources = 256;
+
+int DefaultBudget() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 4;
+}
+
+// 单路解码线程数的上限：帧级/片级并行对低分辨率收益很小
+int MaxThreadsFor(unsigned long long pixels) {
+    if (pixels <= 1280ULL * 720ULL) return 2;
+    if (pixels <= kReferencePixels) return 4;
+    return 8;
+}
+
+} // namespace
+
+WVVideoWall::WVVideoWall(int tileCount, int budget)
+    : tiles(tileCount > 0 ? tileCount : 0), threadBudget(budget > 0 ? budget : DefaultBudget()) {
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        tiles[i].threads = 0;
+    }
+}
+
+int WVVideoWall::TileCount() const {
+    return static_cast<int>(tiles.size());
+}
+
+void WVVideoWall::SetThreadBudget(int budget) {
+    std::lock_guard<std::mutex> lock(mutex);
+    threadBudget = budget > 0 ? budget : DefaultBudget();
+}
+
+int WVVideoWall::ThreadBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return threadBudget;
+}
+
+unsigned long long WVVideoWall::PixelsLocked(const std::string& source) const {
+    std::map<std::string, unsigned long long>::const_iterator it = pixelsBySource.find(source);
+    return it != pixelsBySource.end() ? it->second : kReferencePixels;
+}
+
+double WVVideoWall::WeightLocked(const std::string& source) const {
+    double weight = static_cast<double>(PixelsLocked(source)) / kReferencePixels;
+    if (weight < kMinWeight) return kMinWeight;
+    if (weight > kMaxWeight) return kMaxWeight;
+    return weight;
+}
+
+// 块 index 改为播放 source 时分得的线程数（总权重中该块按 source 计）
+int WVVideoWall::ThreadsLocked(int index, const std::string& source) const {
+    double totalWeight = 0.0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        totalWeight += WeightLocked(static_cast<int>(i) == index ? source : tiles[i].source);
+    }
+
+    int threads = static_cast<int>(threadBudget * WeightLocked(source) / totalWeight);
+    int maxThreads = MaxThreadsFor(PixelsLocked(source));
+    if (threads > maxThreads) threads = maxThreads;
+    if (threads < 1) threads = 1;
+    return threads;
+}
+
+int WVVideoWall::BeginPlay(int index, const std::string& source) {
+    if (index < 0 || index >= static_cast<int>(tiles.size())) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Tile& tile = tiles[index];
+    tile.threads = ThreadsLocked(index, source);
+    tile.source = source;
+    return tile.threads;
+}
+
+int WVVideoWall::PlanPlay(int index, const std::string& source) const {
+    if (index < 0 || index >= static_cast<int>(tiles.size())) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return ThreadsLocked(index, source);
+}
+
+void WVVideoWall::CommitPlay(int index, const std::string& source, int threads) {
+    if (index < 0 || index >= static_cast<int>(tiles.size())) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    tiles[index].source = source;
+    tiles[index].threads = threads;
+}
+
+void WVVideoWall::ReportResolution(int index, unsigned int width, unsigned int height) {
+    if (index < 0 || index >= static_cast<int>(tiles.size()) || width == 0 || height == 0) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const Tile& tile = tiles[index];
+    if (tile.source.empty()) return;
+    if (pixelsBySource.size() >= kMaxKnownSources && pixelsBySource.find(tile.source) == pixelsBySource.end()) {
+        pixelsBySource.clear();
+    }
+    pixelsBySource[tile.source] = static_cast<unsigned long long>(width) * height;
+}
+
+int WVVideoWall::AssignedThreads(int index) const {
+    if (index < 0 || index >= static_cast<int>(tiles.size())) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return tiles[index].threads;
+}
@@ -0,0 +1,91 @@
+//
+//  WVVideoWall.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_VIDEO_WALL_H
+#define WV_VIDEO_WALL_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ==================== 多路监控墙的解码线程分配 ====================
+//
+// 监控墙同时播放 9-25 路摄像头。每路播放器默认按 CPU 核数创建 avcodec 解码线程，
+// 路数一多线程总数远超核数，线程切换与缓存争用反而拖慢每一路。
+// 墙内所有块共用同一组 libVLC 参数（因而共用同一个实例，见 WVInstancePool），
+// 并由本类在一个线程预算内为每块分配 avcodec 线程数：
+//   - 按分辨率加权：每块的权重为像素数相对 1080p 的比例（限制在 0.25-4），
+//     分辨率在首次出现画面时上报并按源地址记住，同一源再次播放时直接使用；
+//     尚未知道分辨率的源按 1080p 计；
+//   - 每块分得 预算 × 权重 / 全部块的总权重（向下取整），至少 1 个，且不超过该分辨率的上限
+//     （720p 及以下 2 个，1080p 4 个，更高 8 个，再多也无法提高单路吞吐）；
+//   - 总权重包含全部块（未播放的块按上次的源或 1080p 计）：各块依次开始播放时
+//     先开始的块不会占满预算，全部播放后总数不超过预算（块数多于预算时每块 1 个）；
+//   - 线程数在打开解码器时生效，因此在每次播放前计算，
+//     已经在播放的块保持原有线程数，直到下一次播放（如重连）；
+//   - 预先打开的源先按 PlanPlay 计算线程数，替换当前源时才由 CommitPlay 登记，
+//     放弃预先打开时块的登记保持为正在显示的源。
+// 所有方法线程安全（由各块的命令队列工作线程调用）。
+
+class WVVideoWall {
+public:
+    /**
+     * @param threadBudget 全部块的 avcodec 线程总数，<= 0 时取 CPU 逻辑核数
+     */
+    WVVideoWall(int tileCount, int threadBudget);
+
+    int TileCount() const;
+
+    void SetThreadBudget(int threadBudget);
+    int ThreadBudget() const;
+
+    /**
+     * 块开始播放 source，返回其解码线程数（加到媒体选项 :avcodec-threads）
+     */
+    int BeginPlay(int tile, const std::string& source);
+
+    /**
+     * 块改为播放 source 时将分得的解码线程数，不改变块的登记（预先打开新源时使用）
+     */
+    int PlanPlay(int tile, const std::string& source) const;
+
+    /**
+     * 登记块已改为播放 source（预先打开的源替换当前源时），threads 为 PlanPlay 的结果
+     */
+    void CommitPlay(int tile, const std::string& source, int threads);
+
+    /**
+     * 上报块当前源的分辨率（画面出现后）
+     */
+    void ReportResolution(int tile, unsigned int width, unsigned int height);
+
+    /**
+     * 块最近一次分配的解码线程数，未播放过返回 0
+     */
+    int AssignedThreads(int tile) const;
+
+private:
+    WVVideoWall(const WVVideoWall&);
+    WVVideoWall& operator=(const WVVideoWall&);
+
+    struct Tile {
+        std::string source;
+        int threads;
+    };
+
+    double WeightLocked(const std::string& source) const;
+    unsigned long long PixelsLocked(const std::string& source) const;
+    int ThreadsLocked(int tile, const std::string& source) const;
+
+    mutable std::mutex mutex;
+    std::vector<Tile> tiles;
+    std::map<std::string, unsigned long long> pixelsBySource;   // 已知源的分辨率（像素数）
+    int threadBudget;
+};
+
+#endif // WV_VIDEO_WALL_H
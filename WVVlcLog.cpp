@@ -0,0 +1,248 @@
+//
+//  WVVlcLog.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVVlcLog.h"
+#include "WVLog.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+
+namespace {
+
+// 重复消息汇总周期：持续重复时每隔该时间输出一次汇总
+const long long kRepeatReportUs = 1000000;
+// 检查未报告的汇总的周期（重复或限流停止后，没有新消息触发输出）
+const int kFlushIntervalMs = 500;
+// 来源状态超过该时间未使用时回收（VLC 对象随播放创建/销毁）
+const long long kSourceIdleUs = 30000000;
+const size_t kSourcePruneThreshold = 256;
+
+struct SourceState {
+    std::string module;         // 最近一条消息的模块名（汇总在回调之外输出时使用）
+    const char* lastFormat;     // VLC 的格式串是静态常量，可用指针判断重复
+    int lastLevel;              // 重复的消息的 VLC 级别，汇总按它输出
+    int repeatCount;            // 当前重复段中被抑制的条数
+    long long repeatStartUs;
+    double tokens;
+    long long lastRefillUs;
+    unsigned long long throttled;  // 因限速丢弃、尚未报告的条数
+    long long lastSeenUs;
+};
+
+struct VlcLogState {
+    std::mutex mutex;
+    std::map<std::string, int> moduleLevels;
+    int defaultLevel;
+    double ratePerSecond;
+    double burst;
+    std::map<uintptr_t, SourceState> sources;
+    bool flusherStarted;
+
+    VlcLogState() : defaultLevel(WVLogWarning), ratePerSecond(20.0), burst(50.0), flusherStarted(false) {}
+};
+
+// 在锁外输出的汇总
+struct PendingReport {
+    std::string module;
+    int level;                  // WVLogLevel
+    int repeats;
+    long long repeatSpanUs;
+    unsigned long long throttled;
+};
+
+VlcLogState& State() {
+    static VlcLogState* state = new VlcLogState();
+    return *state;
+}
+
+long long NowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+WVLogLevel MapLevel(int vlcLevel) {
+    switch (vlcLevel) {
+        case LIBVLC_ERROR: return WVLogError;
+        case LIBVLC_WARNING: return WVLogWarning;
+        case LIBVLC_NOTICE: return WVLogInfo;
+        default: return WVLogDebug;
+    }
+}
+
+void PruneSourcesLocked(VlcLogState& state, long long now) {
+    if (state.sources.size() < kSourcePruneThreshold) return;
+    for (std::map<uintptr_t, SourceState>::iterator it = state.sources.begin(); it != state.sources.end();) {
+        if (now - it->second.lastSeenUs > kSourceIdleUs) {
+            state.sources.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void WriteReport(const PendingReport& report) {
+    if (report.throttled > 0) {
+        WVLogWrite(WVLogWarning, "[VLC][%s] 日志过多，已限流丢弃 %llu 条", report.module.c_str(), report.throttled);
+    }
+    if (report.repeats > 0) {
+        WVLogWrite(static_cast<WVLogLevel>(report.level), "[VLC][%s] 上一条消息在 %.1f 秒内重复 %d 次",
+                   report.module.c_str(), report.repeatSpanUs / 1000000.0, report.repeats);
+    }
+}
+
+// 后台线程：输出重复或限流已经停止、之后没有新消息带出的汇总
+void FlushLoop() {
+    VlcLogState& state = State();
+    std::vector<PendingReport> reports;
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kFlushIntervalMs));
+        long long now = NowMicros();
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            for (std::map<uintptr_t, SourceState>::iterator it = state.sources.begin(); it != state.sources.end(); ++it) {
+                SourceState& source = it->second;
+                bool repeatDue = source.repeatCount > 0 && now - source.repeatStartUs >= kRepeatReportUs;
+                bool throttledDue = source.throttled > 0 && now - source.lastSeenUs >= kRepeatReportUs;
+                if (!repeatDue && !throttledDue) continue;
+
+                PendingReport report;
+                report.module = source.module;
+                report.level = MapLevel(source.lastLevel);
+                report.repeats = repeatDue ? source.repeatCount : 0;
+                report.repeatSpanUs = now - source.repeatStartUs;
+                report.throttled = throttledDue ? source.throttled : 0;
+                if (repeatDue) {
+                    source.repeatCount = 0;
+                    source.repeatStartUs = now;
+                }
+                if (throttledDue) source.throttled = 0;
+                reports.push_back(report);
+            }
+        }
+        for (size_t i = 0; i < reports.size(); ++i) {
+            WriteReport(reports[i]);
+        }
+        reports.clear();
+    }
+}
+
+} // namespace
+
+void WVVlcLogCallback(void*, int level, const libvlc_log_t* ctx, const char* fmt, va_list args) {
+    WVLogLevel bridgeLevel = MapLevel(level);
+    if (bridgeLevel > g_logLevel.load(std::memory_order_relaxed)) return;
+
+    const char* module = NULL;
+    const char* file = NULL;
+    unsigned line = 0;
+    libvlc_log_get_context(ctx, &module, &file, &line);
+    const char* objectName = NULL;
+    const char* header = NULL;
+    uintptr_t objectId = 0;
+    libvlc_log_get_object(ctx, &objectName, &header, &objectId);
+    if (!module) module = objectName ? objectName : "vlc";
+
+    VlcLogState& state = State();
+    long long now = NowMicros();
+    PendingReport report;
+    report.module = module;
+    report.repeats = 0;
+    report.repeatSpanUs = 0;
+    report.throttled = 0;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.flusherStarted) {
+            state.flusherStarted = true;
+            std::thread(FlushLoop).detach();
+        }
+
+        std::map<std::string, int>::const_iterator levelIt = state.moduleLevels.find(module);
+        int moduleLevel = levelIt == state.moduleLevels.end() ? state.defaultLevel : levelIt->second;
+        if (bridgeLevel > moduleLevel) return;
+
+        PruneSourcesLocked(state, now);
+        std::map<uintptr_t, SourceState>::iterator it = state.sources.find(objectId);
+        if (it == state.sources.end()) {
+            SourceState fresh;
+            fresh.lastFormat = NULL;
+            fresh.lastLevel = 0;
+            fresh.repeatCount = 0;
+            fresh.repeatStartUs = now;
+            fresh.tokens = state.burst;
+            fresh.lastRefillUs = now;
+            fresh.throttled = 0;
+            fresh.lastSeenUs = now;
+            it = state.sources.insert(std::make_pair(objectId, fresh)).first;
+        }
+        SourceState& source = it->second;
+        source.lastSeenUs = now;
+
+        // 重复抑制：与上一条相同时只计数，按周期输出汇总（级别是被重复的消息的级别）
+        report.level = MapLevel(source.lastLevel);
+        if (fmt == source.lastFormat && level == source.lastLevel) {
+            source.repeatCount++;
+            if (now - source.repeatStartUs < kRepeatReportUs) return;
+            report.module = source.module;
+            report.repeats = source.repeatCount;
+            report.repeatSpanUs = now - source.repeatStartUs;
+            source.repeatCount = 0;
+            source.repeatStartUs = now;
+            fmt = NULL;  // 本条已计入汇总，不再单独输出
+        } else {
+            report.module = source.module;
+            report.repeats = source.repeatCount;
+            report.repeatSpanUs = now - source.repeatStartUs;
+            source.module = module;
+            source.lastFormat = fmt;
+            source.lastLevel = level;
+            source.repeatCount = 0;
+            source.repeatStartUs = now;
+        }
+
+        // 令牌桶限速
+        source.tokens += (now - source.lastRefillUs) / 1000000.0 * state.ratePerSecond;
+        if (source.tokens > state.burst) source.tokens = state.burst;
+        source.lastRefillUs = now;
+        if (source.tokens < 1.0) {
+            // 这条消息带出的重复汇总同样受限流，被抑制的条数计入丢弃数（由后续消息或后台线程报告）
+            source.throttled += report.repeats + (fmt ? 1 : 0);
+            return;
+        }
+        source.tokens -= 1.0;
+        report.throttled = source.throttled;
+        source.throttled = 0;
+    }
+
+    // 格式化与输出在锁外进行
+    WriteReport(report);
+    if (fmt) {
+        char message[512];
+        vsnprintf(message, sizeof(message), fmt, args);
+        WVLogWrite(bridgeLevel, "[VLC][%s] %s", module, message);
+    }
+}
+
+void WVVlcLogSetModuleLevel(const char* module, int level) {
+    VlcLogState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!module || !*module) {
+        state.defaultLevel = level;
+    } else {
+        state.moduleLevels[module] = level;
+    }
+}
+
+void WVVlcLogSetRateLimit(double messagesPerSecond, int burst) {
+    VlcLogState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.ratePerSecond = messagesPerSecond > 0 ? messagesPerSecond : 0;
+    state.burst = burst > 1 ? burst : 1;
+}
@@ -0,0 +1,42 @@
+//
+//  WVVlcLog.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_VLC_LOG_H
+#define WV_VLC_LOG_H
+
+#include "WVLibVLC.h"
+
+// ==================== libVLC 内部日志转发 ====================
+//
+// 通过 libvlc_log_set 接管 VLC 自身的日志，送入桥接库的日志管线：
+// - 按模块设置级别过滤（未设置的模块使用默认级别，默认只保留 Warning 及以上）
+// - 同一来源连续重复的消息只输出一次，随后按该消息的级别汇总为“重复 N 次”；
+//   重复或限流停止后没有新消息时，由后台线程在约 1 秒内输出未报告的汇总
+// - 每个来源（VLC 对象，如某一路流的解码器/解复用器）一个令牌桶限速，
+//   异常摄像头每秒上千条日志时不会拖垮 CPU
+//
+// 日志回调按实例注册，实例在多个播放器间共享，因此限速粒度是 VLC 对象而不是播放器。
+
+/**
+ * libvlc_log_cb 实现，由实例池在创建实例时注册
+ */
+void WVVlcLogCallback(void* data, int level, const libvlc_log_t* ctx, const char* fmt, va_list args);
+
+/**
+ * 设置模块的日志级别（WVLogLevel）
+ * @param module 模块名（如 "avcodec"、"live555"），为 NULL 或空串时设置默认级别
+ */
+void WVVlcLogSetModuleLevel(const char* module, int level);
+
+/**
+ * 设置每个来源的限速参数
+ * @param messagesPerSecond 令牌补充速率
+ * @param burst 令牌桶容量
+ */
+void WVVlcLogSetRateLimit(double messagesPerSecond, int burst);
+
+#endif // WV_VLC_LOG_H
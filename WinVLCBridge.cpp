@@ -8,66 +8,28 @@
 #include "WinVLCBridge.h"
 #include <windows.h>
 
-// 在包含 VLC 头文件之前，定义缺失的类型
-// 这是 VLC SDK 3.0.20 的一个已知问题的解决方案
-#ifndef _SSIZE_T_DEFINED
-#define _SSIZE_T_DEFINED
-#ifdef _WIN64
-typedef __int64 ssize_t;
-#else
-typedef int ssize_t;
-#endif
-#endif
-
-#include <vlc/vlc.h>
+#include "WVPlayerWrapper.h"
+#include "WVLog.h"
+#include "WVOverlayWindow.h"
 #include <string>
-#include <iostream>
+#include <vector>
+#include <memory>
 
-// ==================== 日志辅助函数 ====================
+// 窗口模式（Windows）：视频窗口、切换用子窗口、覆盖层窗口与监控墙。
+// 播放控制等与平台无关的部分见 WVPlayerCore.cpp
 
-static void LogMessage(const char* format, ...) {
-    char buffer[1024];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    
-    // 使用 stderr 输出，因为它是无缓冲的，能立即显示在命令行中
-    fprintf(stderr, "[WinVLCBridge] %s\n", buffer);
-    fflush(stderr);  // 强制刷新输出缓冲区
-    
-    // 转换为宽字符并输出到 Windows 调试器（避免 DebugView 中文乱码）
-    wchar_t wideBuffer[1024];
-    wchar_t wideMessage[1100];
-    
-    // 将 UTF-8 字符串转换为宽字符（假设输入是 UTF-8 编码）
-    MultiByteToWideChar(CP_UTF8, 0, buffer, -1, wideBuffer, 1024);
-    
-    // 添加前缀
-    swprintf(wideMessage, 1100, L"[WinVLCBridge] %s\n", wideBuffer);
-    
-    // 输出到 Windows 调试器
-    OutputDebugStringW(wideMessage);
-}
-
-// ==================== 播放器包装结构 ====================
-
-struct WVPlayerWrapper {
-    libvlc_instance_t* vlcInstance;
-    libvlc_media_player_t* mediaPlayer;
-    libvlc_media_t* currentMedia;  // 当前媒体对象
-    HWND videoWindow;              // VLC 视频窗口
-    HWND parentWindow;             // 父窗口
-    int videoWidth;                // 视频窗口宽度
-    int videoHeight;               // 视频窗口高度
-    int offsetX;                   // 相对于父窗口的X偏移
-    int offsetY;                   // 相对于父窗口的Y偏移
-    float dpiScaleY;               // DPI 垂直缩放比例（用于计算菜单栏高度）
-    libvlc_event_manager_t* eventManager;  // 事件管理器
+// 监控墙句柄：墙对象与其全部块
+struct WVWallHandle {
+    std::shared_ptr<WVVideoWall> wall;
+    std::vector<WVPlayerWrapper*> tiles;
 };
 
 // ==================== 工具函数 ====================
 
+// 自动可见性模式下检测父窗口最小化的周期
+static const UINT_PTR kVisibilityTimerId = 1;
+static const UINT kVisibilityTimerIntervalMs = 250;
+
 // 视频窗口过程（确保黑色背景正确显示）
 static LRESULT CALLBACK VideoWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch (msg) {
@@ -89,6 +51,14 @@ static LRESULT CALLBACK VideoWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPAR
             EndPaint(hwnd, &ps);
             return 0;
         }
+        case WM_TIMER: {
+            // 自动可见性：GWLP_USERDATA 在释放播放器前清零，之后不再访问
+            WVPlayerWrapper* wrapper = reinterpret_cast<WVPlayerWrapper*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+            if (wrapper && wParam == kVisibilityTimerId) {
+                WVPlayerUpdateVisibility(wrapper);
+            }
+            return 0;
+        }
     }
     return DefWindowProc(hwnd, msg, wParam, lParam);
 }
@@ -120,72 +90,11 @@ static bool RegisterVideoWindowClass() {
     return false;
 }
 
-// VLC 事件回调：当视频开始播放时调整缩放
-static void OnMediaPlayerPlaying(const libvlc_event_t* event, void* userData) {
-    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(userData);
-    if (!wrapper || !wrapper->mediaPlayer) return;
-    
-    LogMessage("视频开始播放事件触发，正在设置视频适配模式...");
-    
-    // 等待视频输出准备好
-    Sleep(100);
-    
-    // 设置视频自动适配窗口，保持宽高比（letterbox/pillarbox效果）
-    // scale = 0 表示自动适配
-    libvlc_video_set_scale(wrapper->mediaPlayer, 0);
-    
-    // 获取视频实际尺寸
-    unsigned int videoWidth = 0, videoHeight = 0;
-    if (libvlc_video_get_size(wrapper->mediaPlayer, 0, &videoWidth, &videoHeight) == 0) {
-        LogMessage("视频原始尺寸: %ux%u", videoWidth, videoHeight);
-        LogMessage("窗口尺寸: %dx%d", wrapper->videoWidth, wrapper->videoHeight);
-        
-        // 计算宽高比
-        float videoAspect = (float)videoWidth / (float)videoHeight;
-        float windowAspect = (float)wrapper->videoWidth / (float)wrapper->videoHeight;
-        
-        if (videoAspect > windowAspect) {
-            LogMessage("视频更宽，将产生上下黑边（letterbox）");
-        } else {
-            LogMessage("视频更高，将产生左右黑边（pillarbox）");
-        }
-    }
-    
-    LogMessage("视频适配模式已设置完成");
-}
-
-// 判断字符串是否为网络流地址
-static bool IsNetworkStream(const std::string& source) {
-    std::string lower = source;
-    for (auto& c : lower) c = tolower(c);
-    
-    return lower.find("http://") == 0 ||
-           lower.find("https://") == 0 ||
-           lower.find("rtsp://") == 0 ||
-           lower.find("rtmp://") == 0 ||
-           lower.find("rtmps://") == 0 ||
-           lower.find("rtp://") == 0;
-}
-
-// 转换路径为标准格式
-static std::string NormalizePath(const std::string& path) {
-    if (IsNetworkStream(path)) {
-        return path;
-    }
-    
-    // 对于本地文件，确保使用正斜杠
-    std::string normalized = path;
-    for (auto& c : normalized) {
-        if (c == '\\') c = '/';
-    }
-    return normalized;
-}
-
 // ==================== 公共 API 实现 ====================
 
 void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, float height) {
     if (!hwnd_ptr) {
-        LogMessage("错误：父窗口句柄为空");
+        WV_LOG_ERROR("错误：父窗口句柄为空");
         return NULL;
     }
     
@@ -200,8 +109,8 @@ void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, f
     float scaleX = dpiX / 96.0f;  // 96 DPI 是 100% 缩放
     float scaleY = dpiY / 96.0f;
     
-    LogMessage("检测到 DPI: %d x %d, 缩放比例: %.2f x %.2f", dpiX, dpiY, scaleX, scaleY);
-    LogMessage("原始尺寸: %.0f x %.0f, 位置: (%.0f, %.0f)", width, height, x, y);
+    WV_LOG_DEBUG("检测到 DPI: %d x %d, 缩放比例: %.2f x %.2f", dpiX, dpiY, scaleX, scaleY);
+    WV_LOG_DEBUG("原始尺寸: %.0f x %.0f, 位置: (%.0f, %.0f)", width, height, x, y);
     
     // 应用 DPI 缩放到尺寸和位置
     int scaledWidth = static_cast<int>(width * scaleX);
@@ -209,11 +118,10 @@ void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, f
     int scaledX = static_cast<int>(x * scaleX);
     int scaledY = static_cast<int>(y * scaleY);
     
-    LogMessage("缩放后尺寸: %d x %d, 位置: (%d, %d)", scaledWidth, scaledHeight, scaledX, scaledY);
+    WV_LOG_DEBUG("缩放后尺寸: %d x %d, 位置: (%d, %d)", scaledWidth, scaledHeight, scaledX, scaledY);
     
     // 创建播放器包装对象
-    WVPlayerWrapper* wrapper = new WVPlayerWrapper();
-    memset(wrapper, 0, sizeof(WVPlayerWrapper));
+    WVPlayerWrapper* wrapper = new WVPlayerWrapper();  // 值初始化，所有成员清零
     
     // 保存窗口尺寸和父窗口信息（使用缩放后的值）
     wrapper->parentWindow = parentWindow;
@@ -221,64 +129,23 @@ void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, f
     wrapper->videoHeight = scaledHeight;
     wrapper->offsetX = scaledX;
     wrapper->offsetY = scaledY;
+    wrapper->dpiScaleX = scaleX;
     wrapper->dpiScaleY = scaleY;  // 保存 DPI 缩放比例
+    wrapper->activeRendition = -1;
+    wrapper->activeSurface = -1;
+    wrapper->renditionWidth = scaledWidth;
+    wrapper->renditionHeight = scaledHeight;
     
-    // 获取 DLL 所在目录，用于定位 VLC 插件
-    char dllPath[MAX_PATH];
-    HMODULE hModule = NULL;
-    GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
-                       (LPCSTR)&wv_create_player_for_view, &hModule);
-    GetModuleFileNameA(hModule, dllPath, MAX_PATH);
-    
-    // 获取 DLL 所在目录
-    std::string dllDir = dllPath;
-    size_t lastSlash = dllDir.find_last_of("\\/");
-    if (lastSlash != std::string::npos) {
-        dllDir = dllDir.substr(0, lastSlash);
-    }
-    
-    // 构建插件路径
-    std::string pluginPath = "--plugin-path=" + dllDir + "\\plugins";
-    
-    LogMessage("DLL 目录: %s", dllDir.c_str());
-    LogMessage("插件路径: %s", pluginPath.c_str());
-    
-    // 初始化 libVLC
-    const char* vlc_args[] = {
-        pluginPath.c_str(),
-        "--file-caching=50",
-        "--network-caching=100",
-        "--avcodec-fast",
-        "--no-sub-autodetect-file",
-        "--no-video-title-show",
-        "--no-snapshot-preview",
-        "--no-osd",
-        "--no-video-title",           // 不显示视频标题
-        "--no-mouse-events",          // 禁用鼠标事件
-        "--no-keyboard-events"        // 禁用键盘事件
-    };
-    
-    wrapper->vlcInstance = libvlc_new(sizeof(vlc_args) / sizeof(vlc_args[0]), vlc_args);
-    if (!wrapper->vlcInstance) {
-        LogMessage("错误：无法初始化 libVLC");
-        delete wrapper;
-        return NULL;
-    }
-    
-    // 创建媒体播放器
-    wrapper->mediaPlayer = libvlc_media_player_new(wrapper->vlcInstance);
-    if (!wrapper->mediaPlayer) {
-        LogMessage("错误：无法创建媒体播放器");
-        libvlc_release(wrapper->vlcInstance);
+    // 从预热池中取出媒体播放器（事件已挂接），池为空时同步创建
+    if (!WVPlayerCheckout(wrapper)) {
         delete wrapper;
         return NULL;
     }
     
     // 注册自定义视频窗口类（带黑色背景）
     if (!RegisterVideoWindowClass()) {
-        LogMessage("错误：无法注册视频窗口类");
-        libvlc_media_player_release(wrapper->mediaPlayer);
-        libvlc_release(wrapper->vlcInstance);
+        WV_LOG_ERROR("错误：无法注册视频窗口类");
+        WVPlayerPool::Return(wrapper->pooledPlayer);
         delete wrapper;
         return NULL;
     }
@@ -287,7 +154,7 @@ void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, f
     // 标准高度约 20-24 像素，应用 DPI 缩放
     int menuBarHeight = static_cast<int>(24 * scaleY);
     
-    LogMessage("Electron 菜单栏高度 (DPI 缩放后): %d 像素", menuBarHeight);
+    WV_LOG_DEBUG("Electron 菜单栏高度 (DPI 缩放后): %d 像素", menuBarHeight);
     
     // 将客户区坐标转换为屏幕坐标
     // 先加上菜单栏高度，因为传入的坐标是相对于 HTML 内容区域的
@@ -305,9 +172,9 @@ void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, f
     
     int titleBarHeight = clientPoint.y - parentRect.top - scaledY - menuBarHeight;
     
-    LogMessage("父窗口位置: (%d,%d), 标题栏高度=%d, 菜单栏高度=%d", 
-               parentRect.left, parentRect.top, titleBarHeight, menuBarHeight);
-    LogMessage("视频窗口屏幕坐标: (%d,%d)", screenX, screenY);
+    WV_LOG_DEBUG("父窗口位置: (%d,%d), 标题栏高度=%d, 菜单栏高度=%d", 
+                 parentRect.left, parentRect.top, titleBarHeight, menuBarHeight);
+    WV_LOG_DEBUG("视频窗口屏幕坐标: (%d,%d)", screenX, screenY);
     
     // 创建独立的顶层窗口（popup），使用缩放后的尺寸
     wrapper->videoWindow = CreateWindowExW(
@@ -324,195 +191,102 @@ void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, f
     );
     
     if (!wrapper->videoWindow) {
-        LogMessage("错误：无法创建视频窗口，错误码: %d", GetLastError());
-        libvlc_media_player_release(wrapper->mediaPlayer);
-        libvlc_release(wrapper->vlcInstance);
+        WV_LOG_ERROR("错误：无法创建视频窗口，错误码: %d", GetLastError());
+        WVPlayerPool::Return(wrapper->pooledPlayer);
         delete wrapper;
         return NULL;
     }
     
-    LogMessage("视频窗口创建成功（带黑色背景）: HWND=0x%p, 位置=(%d,%d), 大小=%dx%d", 
-               wrapper->videoWindow, scaledX, scaledY, scaledWidth, scaledHeight);
+    WV_LOG_DEBUG("视频窗口创建成功（带黑色背景）: HWND=0x%p, 位置=(%d,%d), 大小=%dx%d", 
+                 wrapper->videoWindow, scaledX, scaledY, scaledWidth, scaledHeight);
     
     // 将视频窗口置于 Z-order 顶层（在 Chromium WebView 之上）
     SetWindowPos(wrapper->videoWindow, HWND_TOPMOST, 0, 0, 0, 0, 
                  SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE | SWP_SHOWWINDOW);
     
-    LogMessage("视频窗口已设置为 Z-order 顶层");
+    WV_LOG_DEBUG("视频窗口已设置为 Z-order 顶层");
     
     // 设置 VLC 使用该窗口进行渲染
     libvlc_media_player_set_hwnd(wrapper->mediaPlayer, wrapper->videoWindow);
-    LogMessage("已设置 VLC 渲染窗口句柄");
+    WV_LOG_DEBUG("已设置 VLC 渲染窗口句柄");
     
-    // 注册事件监听器
-    wrapper->eventManager = libvlc_media_player_event_manager(wrapper->mediaPlayer);
-    if (wrapper->eventManager) {
-        libvlc_event_attach(wrapper->eventManager, libvlc_MediaPlayerPlaying, OnMediaPlayerPlaying, wrapper);
-        LogMessage("已注册视频播放事件监听器");
-    }
+    WVPlayerStart(wrapper);
     
-    LogMessage("播放器创建成功 - 原始尺寸: %.0fx%.0f, 实际窗口大小: %dx%d (DPI 缩放: %.2f)", 
-               width, height, scaledWidth, scaledHeight, scaleX);
+    WV_LOG_INFO("播放器创建成功 - 原始尺寸: %.0fx%.0f, 实际窗口大小: %dx%d (DPI 缩放: %.2f)", 
+                width, height, scaledWidth, scaledHeight, scaleX);
     
     return wrapper;
 }
 
-void wv_player_play(void* playerHandle, const char* source) {
-    if (!playerHandle) {
-        LogMessage("错误：播放器句柄为空");
-        return;
-    }
-    
-    if (!source) {
-        LogMessage("错误：视频源为空");
-        return;
+void* wv_wall_create(void* hwnd_ptr, float x, float y, float width, float height,
+                     int columns, int rows, float gap) {
+    if (columns < 1 || columns > 8 || rows < 1 || rows > 8) {
+        WV_LOG_ERROR("错误：监控墙网格无效 %dx%d（各 1-8）", columns, rows);
+        return NULL;
     }
-    
-    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
-    std::string sourcePath = source;
-    
-    LogMessage("原始路径: %s", source);
-    
-    // 创建媒体对象
-    libvlc_media_t* media = NULL;
-    
-    if (IsNetworkStream(sourcePath)) {
-        // 网络流
-        LogMessage("检测到网络流，使用 location 方式");
-        media = libvlc_media_new_location(wrapper->vlcInstance, sourcePath.c_str());
-        
-        // 设置网络流选项
-        if (media) {
-            libvlc_media_add_option(media, ":network-caching=300");
-            libvlc_media_add_option(media, ":live-caching=300");
-            libvlc_media_add_option(media, ":clock-jitter=0");
-            libvlc_media_add_option(media, ":clock-synchro=0");
-        }
-    } else {
-        // 本地文件 - 检查文件是否存在
-        DWORD fileAttr = GetFileAttributesA(sourcePath.c_str());
-        if (fileAttr == INVALID_FILE_ATTRIBUTES) {
-            LogMessage("错误：文件不存在: %s", sourcePath.c_str());
-            return;
-        }
-        
-        LogMessage("文件存在，准备创建媒体对象");
-        
-        // 将路径转换为 file:/// URI 格式（VLC 更可靠地支持这种格式）
-        std::string normalizedPath = NormalizePath(sourcePath);
-        std::string fileUri = "file:///" + normalizedPath;
-        
-        LogMessage("使用 URI: %s", fileUri.c_str());
-        
-        // 使用 location 方式创建本地文件媒体（比 new_path 更可靠）
-        media = libvlc_media_new_location(wrapper->vlcInstance, fileUri.c_str());
-        
-        if (!media) {
-            LogMessage("location 方式失败，尝试 path 方式");
-            // 如果失败，尝试使用 new_path（使用原始路径）
-            media = libvlc_media_new_path(wrapper->vlcInstance, sourcePath.c_str());
-        }
+    if (gap < 0.0f) gap = 0.0f;
+    float tileWidth = (width - gap * (columns - 1)) / columns;
+    float tileHeight = (height - gap * (rows - 1)) / rows;
+    if (tileWidth < 1.0f || tileHeight < 1.0f) {
+        WV_LOG_ERROR("错误：监控墙区域过小 %.0fx%.0f", width, height);
+        return NULL;
     }
     
-    if (!media) {
-        LogMessage("错误：无法创建媒体对象");
-        const char* vlcError = libvlc_errmsg();
-        if (vlcError) {
-            LogMessage("VLC 错误信息: %s", vlcError);
+    WVWallHandle* handle = new WVWallHandle();
+    handle->wall = std::make_shared<WVVideoWall>(columns * rows, 0);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            void* tile = wv_create_player_for_view(hwnd_ptr, x + column * (tileWidth + gap),
+                                                   y + row * (tileHeight + gap), tileWidth, tileHeight);
+            if (!tile) {
+                WV_LOG_ERROR("错误：监控墙第 %d 块创建失败", row * columns + column);
+                wv_wall_release(handle);
+                return NULL;
+            }
+            WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(tile);
+            wrapper->wall = handle->wall;
+            wrapper->wallTile = static_cast<int>(handle->tiles.size());
+            handle->tiles.push_back(wrapper);
         }
-        return;
-    }
-    
-    LogMessage("媒体对象创建成功");
-    
-    // 设置媒体并播放
-    // 释放旧的媒体对象（如果存在）
-    if (wrapper->currentMedia) {
-        libvlc_media_release(wrapper->currentMedia);
     }
     
-    // 保存当前媒体对象的引用
-    wrapper->currentMedia = media;
-    
-    libvlc_media_player_set_media(wrapper->mediaPlayer, media);
-    
-    int playResult = libvlc_media_player_play(wrapper->mediaPlayer);
-    
-    if (playResult == 0) {
-        LogMessage("开始播放: %s", sourcePath.c_str());
-        LogMessage("等待视频准备就绪，将在播放事件中设置缩放模式...");
-        
-        // 获取并记录视频窗口的实际位置和大小
-        RECT rect;
-        GetWindowRect(wrapper->videoWindow, &rect);
-        POINT pt = {rect.left, rect.top};
-        ScreenToClient(GetParent(wrapper->videoWindow), &pt);
-        LogMessage("视频窗口实际位置: (%d,%d), 大小: %dx%d", 
-                   pt.x, pt.y, rect.right - rect.left, rect.bottom - rect.top);
-        
-        // 确保视频窗口可见并在顶层（覆盖 WebView）
-        ShowWindow(wrapper->videoWindow, SW_SHOW);
-        UpdateWindow(wrapper->videoWindow);
-        BringWindowToTop(wrapper->videoWindow);
-        SetWindowPos(wrapper->videoWindow, HWND_TOPMOST, 0, 0, 0, 0, 
-                     SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE | SWP_SHOWWINDOW);
-        
-        LogMessage("视频窗口已更新并设置 Z-order 为顶层");
-    } else {
-        LogMessage("错误：播放失败，返回码: %d", playResult);
-        const char* vlcError = libvlc_errmsg();
-        if (vlcError) {
-            LogMessage("VLC 错误信息: %s", vlcError);
-        }
-    }
+    WV_LOG_INFO("监控墙创建成功 - %dx%d 块，解码线程预算: %d", columns, rows, handle->wall->ThreadBudget());
+    return handle;
 }
 
-void wv_player_pause(void* playerHandle) {
-    if (!playerHandle) {
-        LogMessage("错误：播放器句柄为空");
-        return;
-    }
-    
-    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
-    libvlc_media_player_pause(wrapper->mediaPlayer);
+void* wv_wall_get_tile(void* wallHandle, int index) {
+    if (!wallHandle) return NULL;
     
-    LogMessage("播放器已暂停");
+    WVWallHandle* handle = static_cast<WVWallHandle*>(wallHandle);
+    if (index < 0 || index >= static_cast<int>(handle->tiles.size())) return NULL;
+    return handle->tiles[index];
 }
 
-void wv_player_resume(void* playerHandle) {
-    if (!playerHandle) {
-        LogMessage("错误：播放器句柄为空");
-        return;
-    }
-    
-    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
+void wv_wall_set_thread_budget(void* wallHandle, int threads) {
+    if (!wallHandle) return;
     
-    // 检查播放器状态
-    libvlc_state_t state = libvlc_media_player_get_state(wrapper->mediaPlayer);
-    
-    if (state == libvlc_Paused) {
-        libvlc_media_player_play(wrapper->mediaPlayer);
-        LogMessage("播放器已恢复播放");
-    } else if (state == libvlc_Stopped) {
-        LogMessage("警告：播放器处于停止状态，无法恢复播放");
-    } else if (state == libvlc_Playing) {
-        LogMessage("提示：播放器已在播放中");
-    } else {
-        LogMessage("播放器状态：%d，尝试恢复播放", state);
-        libvlc_media_player_play(wrapper->mediaPlayer);
-    }
+    WVWallHandle* handle = static_cast<WVWallHandle*>(wallHandle);
+    handle->wall->SetThreadBudget(threads);
+    WV_LOG_INFO("监控墙解码线程预算: %d", handle->wall->ThreadBudget());
 }
 
-void wv_player_stop(void* playerHandle) {
-    if (!playerHandle) {
-        LogMessage("错误：播放器句柄为空");
-        return;
-    }
+int wv_wall_get_tile_threads(void* wallHandle, int index) {
+    if (!wallHandle) return 0;
     
-    WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
-    libvlc_media_player_stop(wrapper->mediaPlayer);
+    WVWallHandle* handle = static_cast<WVWallHandle*>(wallHandle);
+    return handle->wall->AssignedThreads(index);
+}
+
+void wv_wall_release(void* wallHandle) {
+    if (!wallHandle) return;
     
-    LogMessage("播放器已停止");
+    // 各块在自己的工作线程上停止并释放，并各自持有墙对象直到释放完成
+    WVWallHandle* handle = static_cast<WVWallHandle*>(wallHandle);
+    for (size_t i = 0; i < handle->tiles.size(); ++i) {
+        WVPlayerRelease(handle->tiles[i]);
+    }
+    delete handle;
+    WV_LOG_INFO("监控墙已释放");
 }
 
 void wv_update_window_position(void* playerHandle) {
@@ -529,50 +303,181 @@ void wv_update_window_position(void* playerHandle) {
     POINT clientPoint = { wrapper->offsetX, wrapper->offsetY + menuBarHeight };
     ClientToScreen(wrapper->parentWindow, &clientPoint);
 
-    // 移动子窗口到新位置
+    // 移动子窗口到新位置（不可见的播放器保持隐藏）
     SetWindowPos(wrapper->videoWindow, HWND_TOPMOST, clientPoint.x, clientPoint.y, 0, 0,
-                 SWP_NOSIZE | SWP_NOACTIVATE | SWP_SHOWWINDOW);
+                 SWP_NOSIZE | SWP_NOACTIVATE | (wrapper->hidden ? 0 : SWP_SHOWWINDOW));
+    
+    if (wrapper->overlayWindow) {
+        wrapper->overlayWindow->SyncPosition();
+    }
 }
 
-void wv_player_release(void* playerHandle) {
-    if (!playerHandle) {
-        LogMessage("错误：播放器句柄为空");
-        return;
-    }
+void wv_update_window_rect(void* playerHandle, float x, float y, float width, float height) {
+    if (!playerHandle) return;
     
     WVPlayerWrapper* wrapper = static_cast<WVPlayerWrapper*>(playerHandle);
-    
-    // 停止播放
-    libvlc_media_player_stop(wrapper->mediaPlayer);
-    
-    // 分离事件监听器
-    if (wrapper->eventManager) {
-        libvlc_event_detach(wrapper->eventManager, libvlc_MediaPlayerPlaying, OnMediaPlayerPlaying, wrapper);
-        LogMessage("已分离事件监听器");
+    if (!wrapper->videoWindow) {
+        WV_LOG_WARN("警告：帧回调播放器没有窗口，忽略窗口尺寸设置");
+        return;
     }
     
-    // 释放当前媒体对象
-    if (wrapper->currentMedia) {
-        libvlc_media_release(wrapper->currentMedia);
-        wrapper->currentMedia = NULL;
+    int scaledWidth = static_cast<int>(width * wrapper->dpiScaleX);
+    int scaledHeight = static_cast<int>(height * wrapper->dpiScaleY);
+    if (scaledWidth <= 0 || scaledHeight <= 0) {
+        WV_LOG_ERROR("错误：无效的窗口尺寸 %.0fx%.0f", width, height);
+        return;
     }
+    wrapper->offsetX = static_cast<int>(x * wrapper->dpiScaleX);
+    wrapper->offsetY = static_cast<int>(y * wrapper->dpiScaleY);
+    wrapper->videoWidth = scaledWidth;
+    wrapper->videoHeight = scaledHeight;
     
-    // 释放媒体播放器
-    if (wrapper->mediaPlayer) {
-        libvlc_media_player_release(wrapper->mediaPlayer);
+    SetWindowPos(wrapper->videoWindow, NULL, 0, 0, scaledWidth, scaledHeight,
+                 SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+    for (int i = 0; i < 2; ++i) {
+        if (wrapper->surfaces[i]) {
+            MoveWindow(wrapper->surfaces[i], 0, 0, scaledWidth, scaledHeight, TRUE);
+        }
     }
+    wv_update_window_position(playerHandle);   // 移动窗口并同步覆盖层
     
-    // 释放 VLC 实例
-    if (wrapper->vlcInstance) {
-        libvlc_release(wrapper->vlcInstance);
+    wrapper->commandQueue->Post(WVCommandQueue::KindTask, [wrapper, scaledWidth, scaledHeight] {
+        WVPlayerUpdateRendition(wrapper, scaledWidth, scaledHeight);
+    });
+    WV_LOG_DEBUG("视频窗口尺寸: %dx%d", scaledWidth, scaledHeight);
+}
+
+// ==================== 窗口模式的核心回调 ====================
+
+// 在 UI 线程上创建预先打开与切换用的两个子窗口（隐藏，填满视频窗口）
+bool WVWindowEnsureSurfaces(WVPlayerWrapper* wrapper) {
+    if (!wrapper->videoWindow) return false;
+    if (wrapper->surfaces[0]) return true;
+    
+    for (int i = 0; i < 2; ++i) {
+        wrapper->surfaces[i] = CreateWindowExW(0, L"VLCVideoWindow", L"", WS_CHILD | WS_CLIPSIBLINGS,
+                                               0, 0, wrapper->videoWidth, wrapper->videoHeight,
+                                               wrapper->videoWindow, NULL, GetModuleHandle(NULL), NULL);
+        if (!wrapper->surfaces[i]) {
+            WV_LOG_ERROR("错误：无法创建切换用的子窗口，错误码: %d", GetLastError());
+            if (i == 1) {
+                DestroyWindow(wrapper->surfaces[0]);
+                wrapper->surfaces[0] = NULL;
+            }
+            return false;
+        }
     }
-    
-    // 销毁视频窗口
+    return true;
+}
+
+// 在 UI 线程上按需创建覆盖层窗口
+static bool EnsureOverlayWindow(WVPlayerWrapper* wrapper) {
+    if (!wrapper->videoWindow) return false;
+    
+    if (!wrapper->overlayWindow) {
+        wrapper->overlayWindow = WVOverlayWindow::Create(wrapper->videoWindow,
+                                                         wrapper->dpiScaleX, wrapper->dpiScaleY);
+        if (wrapper->overlayWindow && wrapper->hidden) {
+            wrapper->overlayWindow->SetSuspended(true);
+        }
+    }
+    return wrapper->overlayWindow != NULL;
+}
+
+void WVWindowBindSurface(WVPlayerWrapper* wrapper, libvlc_media_player_t* mediaPlayer, int surface, bool show) {
+    libvlc_media_player_set_hwnd(mediaPlayer, wrapper->surfaces[surface]);
+    if (show) {
+        ShowWindowAsync(wrapper->surfaces[surface], SW_SHOWNA);
+    }
+}
+
+void WVWindowSwapSurface(WVPlayerWrapper* wrapper, int previous, int next) {
+    // 窗口属于 UI 线程，使用异步调用：先把新窗口显示在最上面，再隐藏旧窗口
+    SetWindowPos(wrapper->surfaces[next], HWND_TOP, 0, 0, 0, 0,
+                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE | SWP_SHOWWINDOW | SWP_ASYNCWINDOWPOS);
+    if (previous >= 0) {
+        ShowWindowAsync(wrapper->surfaces[previous], SW_HIDE);
+    }
+}
+
+void WVWindowRaise(WVPlayerWrapper* wrapper) {
+    if (!wrapper->videoWindow) return;
+    
+    // 获取并记录视频窗口的实际位置和大小
+    RECT rect;
+    GetWindowRect(wrapper->videoWindow, &rect);
+    POINT pt = {rect.left, rect.top};
+    ScreenToClient(GetParent(wrapper->videoWindow), &pt);
+    WV_LOG_DEBUG("视频窗口实际位置: (%d,%d), 大小: %dx%d", 
+                 pt.x, pt.y, rect.right - rect.left, rect.bottom - rect.top);
+    
+    // 确保视频窗口可见并在顶层（覆盖 WebView）
+    ShowWindow(wrapper->videoWindow, SW_SHOW);
+    UpdateWindow(wrapper->videoWindow);
+    BringWindowToTop(wrapper->videoWindow);
+    SetWindowPos(wrapper->videoWindow, HWND_TOPMOST, 0, 0, 0, 0, 
+                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE | SWP_SHOWWINDOW);
+}
+
+bool WVWindowIsMinimized(WVPlayerWrapper* wrapper) {
+    return wrapper->parentWindow && IsIconic(wrapper->parentWindow);
+}
+
+void WVWindowSetHidden(WVPlayerWrapper* wrapper, bool hidden) {
+    // 视频窗口是独立的顶层窗口，不会随父窗口最小化，需要自行隐藏
     if (wrapper->videoWindow) {
-        DestroyWindow(wrapper->videoWindow);
+        ShowWindow(wrapper->videoWindow, hidden ? SW_HIDE : SW_SHOWNOACTIVATE);
     }
+    if (wrapper->overlayWindow) {
+        wrapper->overlayWindow->SetSuspended(hidden);
+    }
+}
+
+void WVWindowSetAutoVisibility(WVPlayerWrapper* wrapper, bool enabled) {
+    if (!wrapper->videoWindow) return;
     
-    delete wrapper;
-    
-    LogMessage("播放器资源已释放");
+    if (enabled) {
+        SetWindowLongPtrW(wrapper->videoWindow, GWLP_USERDATA, reinterpret_cast<intptr_t>(wrapper));
+        SetTimer(wrapper->videoWindow, kVisibilityTimerId, kVisibilityTimerIntervalMs, NULL);
+    } else {
+        KillTimer(wrapper->videoWindow, kVisibilityTimerId);
+        SetWindowLongPtrW(wrapper->videoWindow, GWLP_USERDATA, 0);
+    }
+}
+
+void WVWindowRenderOverlay(WVPlayerWrapper* wrapper) {
+    if (EnsureOverlayWindow(wrapper)) {
+        wrapper->overlayWindow->Render(*wrapper->overlayScene);
+    }
+}
+
+void WVWindowAttachOverlayTimeline(WVPlayerWrapper* wrapper) {
+    if (EnsureOverlayWindow(wrapper)) {
+        wrapper->overlayWindow->AttachTimeline(wrapper->overlayScene, wrapper->overlayTimeline,
+                                               wrapper->mediaClock);
+    }
+}
+
+void WVWindowDetach(WVPlayerWrapper* wrapper) {
+    if (wrapper->videoWindow) {
+        KillTimer(wrapper->videoWindow, kVisibilityTimerId);
+        SetWindowLongPtrW(wrapper->videoWindow, GWLP_USERDATA, 0);
+    }
+    if (wrapper->overlayWindow) {
+        wrapper->overlayWindow->Detach();   // 之后定时器不会再访问场景与时间线
+    }
+    if (wrapper->videoWindow) {
+        ShowWindow(wrapper->videoWindow, SW_HIDE);
+    }
+}
+
+void WVWindowDestroy(WVPlayerWrapper* wrapper) {
+    // 窗口必须由创建它的线程销毁，发送 WM_CLOSE 由 UI 线程的 DefWindowProc 处理
+    if (wrapper->overlayWindow) {
+        wrapper->overlayWindow->Close();   // 对象随窗口销毁自行删除
+        wrapper->overlayWindow = NULL;
+    }
+    if (wrapper->videoWindow) {
+        PostMessageW(wrapper->videoWindow, WM_CLOSE, 0, 0);
+    }
 }
@@ -22,6 +22,20 @@
 extern "C" {
 #endif
 
+/**
+ * 控制命令状态（wv_command_status 返回值）
+ * 播放、暂停、恢复、停止、释放均为异步命令：调用只负责入队并立即返回命令 ID，
+ * 实际的 libVLC 调用在播放器的工作线程上串行执行
+ */
+#define WV_COMMAND_UNKNOWN   -1  /* ID 无效或记录已过期 */
+#define WV_COMMAND_PENDING    0  /* 排队中 */
+#define WV_COMMAND_RUNNING    1  /* 执行中 */
+#define WV_COMMAND_DONE       2  /* 已完成 */
+#define WV_COMMAND_COALESCED  3  /* 被后续命令合并，未执行（如 play→stop→play 中的前两条） */
+
+#ifdef _WIN32
+/* 窗口模式（视频窗口、监控墙）只在 Windows 上提供，其他平台使用帧回调模式 */
+
 /**
  * 创建播放器并关联到指定的窗口句柄
  * @param hwnd_ptr 父窗口句柄
@@ -32,32 +46,153 @@ extern "C" {
  * @return 播放器句柄
  */
 WINVLCBRIDGE_API void* wv_create_player_for_view(void* hwnd_ptr, float x, float y, float width, float height);
+#endif
+
+/**
+ * 创建帧回调模式的播放器（不需要窗口）
+ * VLC 输出平面 YUV，由桥接库用 SIMD 转换为 BGRA 写入命名共享内存帧环（三缓冲），渲染进程可通过
+ * wv_frame_ring_* 映射后直接作为 ArrayBuffer 读取（BGRA，无需拷贝）。
+ * 返回的句柄可用于 wv_player_play / stop / release 等函数
+ * @param sharedMemoryName 共享内存名称
+ * @param width 输出宽度（0 表示使用视频原始尺寸）
+ * @param height 输出高度（0 表示使用视频原始尺寸）
+ * @return 播放器句柄
+ */
+WINVLCBRIDGE_API void* wv_create_frame_player(const char* sharedMemoryName, int width, int height);
+
+/**
+ * 帧回调模式的 YUV → BGRA 转换参数（wv_frame_player_set_colorspace）
+ */
+#define WV_COLOR_AUTO          -1  /* 自动：高度 >= 720 用 BT.709，否则 BT.601；范围按 VLC 色度格式判断 */
+#define WV_COLOR_MATRIX_BT601   0
+#define WV_COLOR_MATRIX_BT709   1
+#define WV_COLOR_RANGE_LIMITED  0  /* Y 16-235（多数摄像头与网络流） */
+#define WV_COLOR_RANGE_FULL     1  /* Y 0-255 */
+
+/**
+ * 设置帧回调播放器的颜色矩阵与范围（窗口模式播放器无效），下一帧生效
+ * @param matrix WV_COLOR_MATRIX_* 或 WV_COLOR_AUTO
+ * @param range WV_COLOR_RANGE_* 或 WV_COLOR_AUTO
+ */
+WINVLCBRIDGE_API void wv_frame_player_set_colorspace(void* playerHandle, int matrix, int range);
+
+#ifdef _WIN32
+/**
+ * 创建监控墙：在父窗口的指定区域内按 columns x rows 网格创建多个播放块
+ * 所有块共用同一个 libVLC 实例，并在墙的线程预算内按分辨率分配 avcodec 解码线程数，
+ * 避免每路按核数创建解码线程导致线程总数远超核数
+ * @param hwnd_ptr 父窗口句柄
+ * @param x / y / width / height 整面墙的区域（与 wv_create_player_for_view 相同的坐标）
+ * @param columns / rows 网格列数与行数（各 1-8）
+ * @param gap 块之间的间距
+ * @return 监控墙句柄，失败返回 NULL
+ */
+WINVLCBRIDGE_API void* wv_wall_create(void* hwnd_ptr, float x, float y, float width, float height,
+                                      int columns, int rows, float gap);
+
+/**
+ * 获取监控墙中的块（按行优先编号），返回的是普通播放器句柄，
+ * 可用于 wv_player_play / stop / 覆盖层等函数；块由 wv_wall_release 统一释放，wv_player_release 会拒绝块的句柄
+ * @return 播放器句柄，序号越界返回 NULL
+ */
+WINVLCBRIDGE_API void* wv_wall_get_tile(void* wallHandle, int index);
+
+/**
+ * 设置监控墙的解码线程预算（全部块的 avcodec 线程总数），下一次播放时生效
+ * @param threads 线程总数，<= 0 时使用 CPU 逻辑核数（默认）
+ */
+WINVLCBRIDGE_API void wv_wall_set_thread_budget(void* wallHandle, int threads);
+
+/**
+ * 获取块最近一次播放分配到的解码线程数
+ * @return 线程数，尚未播放或序号越界返回 0
+ */
+WINVLCBRIDGE_API int wv_wall_get_tile_threads(void* wallHandle, int index);
+
+/**
+ * 释放监控墙及其全部块（各块异步停止并释放）
+ */
+WINVLCBRIDGE_API void wv_wall_release(void* wallHandle);
+#endif
 
 /**
  * 播放视频（自动识别本地文件或网络流）
  * @param playerHandle 播放器句柄
- * @param source 视频源路径（本地文件路径或网络流地址 http/rtsp）
+ * @param source 视频源路径（本地文件路径或网络流地址 http/rtsp）；
+ *               为 NULL、空串或 wv_player_add_rendition 登记过的地址时按显示尺寸选择登记的码流
+ * @return 命令 ID（失败返回 0）
+ */
+WINVLCBRIDGE_API unsigned long long wv_player_play(void* playerHandle, const char* source);
+
+/**
+ * 预先打开下一个源（切换摄像头时不出现黑屏）
+ * 在视频窗口内隐藏的子窗口中用另一个播放器（取自预热池，静音）连接并缓冲，首帧解码后保持等待
+ * （本地文件暂停在首帧，直播流继续接收），由 wv_player_swap 替换当前画面。
+ * 再次调用会放弃上一次预先打开的源；之后的播放、停止同样会放弃。
+ * 帧回调播放器只有一个输出，不做预先打开，wv_player_swap 时直接播放
+ * @param playerHandle 播放器句柄
+ * @param source 视频源，与 wv_player_play 相同（NULL 或空串时按显示尺寸选择登记的码流）
+ * @return 命令 ID（失败返回 0）
+ */
+WINVLCBRIDGE_API unsigned long long wv_player_prepare(void* playerHandle, const char* source);
+
+/**
+ * 切换到预先打开的源：已出现画面时立即显示新画面并隐藏旧画面，之后在后台停止并归还旧播放器；
+ * 尚未出现画面时旧画面继续显示，新源出现画面后再切换
+ * @param playerHandle 播放器句柄
+ * @return 命令 ID（失败返回 0）
  */
-WINVLCBRIDGE_API void wv_player_play(void* playerHandle, const char* source);
+WINVLCBRIDGE_API unsigned long long wv_player_swap(void* playerHandle);
+
+/**
+ * 获取最近一次切换源从请求到新源画面显示的耗时
+ * 直接播放替换正在显示的源时等于新源的首帧耗时（期间没有画面）；
+ * 预先打开后切换时从 wv_player_swap 起算（期间旧画面保持显示），码流自动切换时从尺寸变化起算
+ * @param playerHandle 播放器句柄
+ * @return 耗时（毫秒），尚未切换过时返回 -1
+ */
+WINVLCBRIDGE_API double wv_player_get_switch_gap(void* playerHandle);
+
+/**
+ * 登记同一画面的一个码流（如摄像头的主码流与子码流，最多 8 个）
+ * 播放时选择宽高都能覆盖窗口实际像素尺寸的最小码流（都不够大时选最大的）；
+ * 窗口尺寸变化（wv_update_window_rect）后在隐藏的子窗口中预先打开新码流，出现画面后再替换，不中断显示。
+ * 帧回调播放器按输出尺寸在播放时选择（输出尺寸为 0 时选最大的），不做切换
+ * @param playerHandle 播放器句柄
+ * @param source 码流地址，已登记时更新分辨率
+ * @param width / height 码流分辨率（像素）
+ * @return 0 成功，-1 参数无效
+ */
+WINVLCBRIDGE_API int wv_player_add_rendition(void* playerHandle, const char* source, int width, int height);
+
+/**
+ * 清除登记的码流（当前播放继续，下次播放不再按尺寸选择）
+ * @param playerHandle 播放器句柄
+ */
+WINVLCBRIDGE_API void wv_player_clear_renditions(void* playerHandle);
 
 /**
  * 暂停播放
  * @param playerHandle 播放器句柄
+ * @return 命令 ID（失败返回 0）
  */
-WINVLCBRIDGE_API void wv_player_pause(void* playerHandle);
+WINVLCBRIDGE_API unsigned long long wv_player_pause(void* playerHandle);
 
 /**
  * 恢复播放（从暂停状态继续播放）
  * @param playerHandle 播放器句柄
+ * @return 命令 ID（失败返回 0）
  */
-WINVLCBRIDGE_API void wv_player_resume(void* playerHandle);
+WINVLCBRIDGE_API unsigned long long wv_player_resume(void* playerHandle);
 
 /**
  * 停止播放
  * @param playerHandle 播放器句柄
+ * @return 命令 ID（失败返回 0）
  */
-WINVLCBRIDGE_API void wv_player_stop(void* playerHandle);
+WINVLCBRIDGE_API unsigned long long wv_player_stop(void* playerHandle);
 
+#ifdef _WIN32
 /**
  * 更新窗口位置（跟随父窗口移动）
  * @param playerHandle 播放器句柄
@@ -65,10 +200,448 @@ WINVLCBRIDGE_API void wv_player_stop(void* playerHandle);
 WINVLCBRIDGE_API void wv_update_window_position(void* playerHandle);
 
 /**
- * 释放播放器资源
+ * 更新窗口位置与尺寸（布局变化，如监控墙放大某一块）；登记了多码流时按新尺寸重新选择码流
+ * @param playerHandle 播放器句柄
+ * @param x / y / width / height 相对父窗口内容区域的位置与尺寸（CSS 像素，自动应用 DPI 缩放）
+ */
+WINVLCBRIDGE_API void wv_update_window_rect(void* playerHandle, float x, float y, float width, float height);
+#endif
+
+/**
+ * 释放播放器资源（监控墙的块由 wv_wall_release 统一释放，传入块的句柄时返回 0）
+ * @param playerHandle 播放器句柄
+ * @return 命令 ID（失败返回 0）
+ */
+WINVLCBRIDGE_API unsigned long long wv_player_release(void* playerHandle);
+
+/**
+ * 更新覆盖层的矩形框（替换全部矩形，第 i 个矩形的 ID 为 i + 1）
+ * 窗口模式坐标为相对视频区域的 CSS 像素（按 DPI 缩放），绘制在视频窗口上方的分层窗口中，
+ * 需在创建播放器的 UI 线程调用；帧回调模式坐标为输出帧像素，在下一帧合成进画面
+ * @param playerHandle 播放器句柄
+ * @param rects 矩形数组 [x, y, width, height] * rectCount
+ * @param rectCount 矩形数量
+ * @param lineWidth 边框宽度
+ * @param red / green / blue / alpha 颜色分量（0.0 - 1.0）
+ */
+WINVLCBRIDGE_API void wv_player_update_rectangles(void* playerHandle, const float* rects, int rectCount, float lineWidth,
+                                                  float red, float green, float blue, float alpha);
+
+/**
+ * 覆盖层增量命令操作码（wv_player_overlay_apply）
+ * 每条命令以 uint32 操作码和 uint32 图形 ID 开头，后跟参数（小端序，首尾相接）：
+ *   ADD    x, y, w, h, lineWidth (float32), color (uint32 0xAARRGGBB)   共 32 字节，ID 已存在时替换
+ *   MOVE   x, y, w, h (float32)                                         共 24 字节
+ *   STYLE  lineWidth (float32), color (uint32 0xAARRGGBB)               共 16 字节
+ *   REMOVE                                                               共 8 字节
+ *   CLEAR  （ID 忽略，清除全部图形）                                    共 8 字节
+ *   FILL   color (uint32 0xAARRGGBB，alpha 为 0 表示不填充)              共 12 字节，ADD 后默认不填充
+ *   LABEL  size (float32), color (uint32 0xAARRGGBB), byteLength (uint32), UTF-8 文本
+ *          共 20 字节 + 文本长度按 4 字节补齐；byteLength 为 0 时移除标签，超过 128 字节截断
+ *   POLYGON lineWidth (float32), strokeColor, fillColor (uint32 0xAARRGGBB), fillRule (uint32，0 奇偶 / 1 非零),
+ *          count (uint32), 顶点 [x, y] (float32) * count
+ *          共 28 + 8 * count 字节，ID 已存在时替换；最多 4096 个顶点，少于 3 个时忽略；
+ *          MOVE 的 x, y, w, h 对应顶点的包围盒，整个多边形随之平移缩放
+ *   MASK   x, y, w, h (float32), maskId (uint32), color (uint32 0xAARRGGBB)
+ *          共 32 字节，ID 已存在时替换；蒙版缩放到 x, y, w, h，需先用 wv_player_overlay_upload_mask 上传
+ */
+#define WV_OVERLAY_OP_ADD     1
+#define WV_OVERLAY_OP_MOVE    2
+#define WV_OVERLAY_OP_STYLE   3
+#define WV_OVERLAY_OP_REMOVE  4
+#define WV_OVERLAY_OP_CLEAR   5
+#define WV_OVERLAY_OP_FILL    6
+#define WV_OVERLAY_OP_LABEL   7
+#define WV_OVERLAY_OP_POLYGON 8
+#define WV_OVERLAY_OP_MASK    9
+
+/**
+ * 按图形 ID 增量更新覆盖层，一个缓冲区可包含任意条命令，整体一次生效
+ * 只有发生变化的图形区域会被重绘；与 wv_player_update_rectangles 共用同一场景（后者使用 ID 1..N）
+ * @param playerHandle 播放器句柄
+ * @param commands 命令缓冲区
+ * @param length 缓冲区字节数
+ * @return 执行的命令条数，格式错误返回 -1（错误之前的命令仍然生效）
+ */
+WINVLCBRIDGE_API int wv_player_overlay_apply(void* playerHandle, const void* commands, int length);
+
+/**
+ * 上传分割蒙版，之后的 MASK 命令通过 maskId 引用（每个对象只需上传一次）
+ * 蒙版为行优先的二值游程编码：runs 依次为连续 0、连续 1、连续 0 …… 的像素个数，从 0 开始，
+ * 总和不足 width * height 时其余为 0（COCO 的 RLE 为列优先，需要先转置）。
+ * 重新上传同一 maskId 只影响之后的 MASK 命令
+ * @param playerHandle 播放器句柄
+ * @param maskId 蒙版 ID（调用方分配）
+ * @param width / height 蒙版尺寸（像素，最大 4096）
+ * @param runs 游程数组
+ * @param runCount 游程个数
+ * @return 0 成功，-1 参数无效或超出存储上限（每个播放器 1024 个蒙版、64 MB）
+ */
+WINVLCBRIDGE_API int wv_player_overlay_upload_mask(void* playerHandle, unsigned int maskId, int width, int height,
+                                                   const unsigned int* runs, int runCount);
+
+/**
+ * 释放已上传的蒙版；已经显示的 MASK 图形不受影响，直到被移除
+ * @param playerHandle 播放器句柄
+ * @param maskId 蒙版 ID
+ */
+WINVLCBRIDGE_API void wv_player_overlay_release_mask(void* playerHandle, unsigned int maskId);
+
+/**
+ * 提交带媒体时间的覆盖层命令（格式同 wv_player_overlay_apply）
+ * 命令先进入播放器的覆盖层时间线，画面播放到 mediaTimeMs 时才显示，
+ * 用于检测方处理的是延迟副本、结果需要与显示帧对齐的场景。
+ * 提交按顺序累积（可以每次提交全集，也可以只提交变化）；过期的条目自动丢弃
+ * @param playerHandle 播放器句柄
+ * @param mediaTimeMs 检测所对应帧的媒体时间（毫秒，与 wv_player_get_media_time 同一时间轴）
+ * @param commands 命令缓冲区
+ * @param length 缓冲区字节数
+ * @return 执行的命令条数，格式错误返回 -1
+ */
+WINVLCBRIDGE_API int wv_player_overlay_submit(void* playerHandle, long long mediaTimeMs, const void* commands, int length);
+
+/**
+ * 设置带时间覆盖层的同步参数
+ * @param playerHandle 播放器句柄
+ * @param toleranceMs 条目时间不晚于当前媒体时间 + 容差即显示（默认 20）
+ * @param expiryMs 显示中的条目落后当前媒体时间超过该值时清除（默认 500）
+ * @param clockOffsetMs 加到媒体时间上的固定修正，用于补偿时钟与实际显示帧的偏差（默认 0）
+ */
+WINVLCBRIDGE_API void wv_player_overlay_set_sync(void* playerHandle, int toleranceMs, int expiryMs, int clockOffsetMs);
+
+// 覆盖层插值方式（wv_player_overlay_set_interpolation）
+#define WV_OVERLAY_INTERP_NONE     0  // 关键帧之间保持不动（默认）
+#define WV_OVERLAY_INTERP_LINEAR   1  // 在当前与下一关键帧之间线性插值（需要下一关键帧已提交）
+#define WV_OVERLAY_INTERP_VELOCITY 2  // 按最近两个关键帧的速度外推
+
+/**
+ * 设置带时间覆盖层在关键帧之间的插值方式
+ * 检测频率低于帧率时，按图形 ID 在 wv_player_overlay_submit 提交的关键帧之间计算每帧的位置和尺寸，
+ * 无需额外的调用即可平滑运动。只有前后关键帧中都存在的 ID 参与插值
+ * @param playerHandle 播放器句柄
+ * @param mode WV_OVERLAY_INTERP_*
+ * @param maxExtrapolationMs 恒速外推的最长时间（毫秒，默认 200，传负数使用默认值）
+ */
+WINVLCBRIDGE_API void wv_player_overlay_set_interpolation(void* playerHandle, int mode, int maxExtrapolationMs);
+
+/**
+ * 获取当前播放的媒体时间（由播放器事件驱动并在事件之间外推，不会阻塞）
+ * @param playerHandle 播放器句柄
+ * @return 毫秒，尚未开始播放返回 -1
+ */
+WINVLCBRIDGE_API long long wv_player_get_media_time(void* playerHandle);
+
+/**
+ * 清除覆盖层的全部矩形框
+ * @param playerHandle 播放器句柄
+ */
+WINVLCBRIDGE_API void wv_player_clear_rectangles(void* playerHandle);
+
+/**
+ * 播放器可见性（wv_player_set_visibility）
+ */
+#define WV_VISIBILITY_VISIBLE 0  /* 可见，正常解码（默认） */
+#define WV_VISIBILITY_HIDDEN  1  /* 不可见：隐藏窗口，停止视频解码与音频输出，只保持网络会话 */
+#define WV_VISIBILITY_AUTO    2  /* 自动：父窗口最小化时按不可见处理，还原后恢复 */
+
+/**
+ * 设置播放器可见性
+ * 大面积监控墙中滚动到屏幕外的块、最小化的窗口仍在全速解码，设为不可见后关闭视频与音频轨道
+ * （解码器与视频输出被销毁，输入与网络连接保持），恢复可见时重建解码器，画面从下一个关键帧开始。
+ * 媒体时钟与带时间的覆盖层照常运行
+ * @param playerHandle 播放器句柄
+ * @param visibility WV_VISIBILITY_*
+ */
+WINVLCBRIDGE_API void wv_player_set_visibility(void* playerHandle, int visibility);
+
+/**
+ * 获取最近一次播放从发起到首帧画面配置完成（视频输出已创建并设置缩放）的耗时
  * @param playerHandle 播放器句柄
+ * @return 耗时（毫秒），尚未完成时返回 -1
+ */
+WINVLCBRIDGE_API double wv_player_get_first_frame_latency(void* playerHandle);
+
+/**
+ * 获取当前媒体的解码统计（参数可为 NULL），可按时间间隔求差得到解码与显示帧率
+ * @param decoded 已解码的视频帧数
+ * @param displayed 已显示的帧数
+ * @param lost 丢弃的帧数
+ * @return 0 成功，-1 尚无媒体
+ */
+WINVLCBRIDGE_API int wv_player_get_decode_stats(void* playerHandle, unsigned long long* decoded,
+                                                unsigned long long* displayed, unsigned long long* lost);
+
+/**
+ * 画质级别（wv_player_get_quality_level 的返回值），级别越高包含越低级别的设置
+ */
+#define WV_QUALITY_FULL       0  /* 原始画质（默认） */
+#define WV_QUALITY_REDUCED    1  /* 跳过非参考帧的解码与环路滤波 */
+#define WV_QUALITY_SUBSTREAM  2  /* 改用子码流（未设置子码流的播放器跳过这一级） */
+#define WV_QUALITY_KEYFRAMES  3  /* 只解码关键帧 */
+
+/**
+ * 配置画质调节器（默认停用）
+ * 调节器每秒采样进程 CPU 占用与各播放器的丢帧率，有压力时按优先级从低到高逐路降一级，
+ * 压力解除数秒后按优先级从高到低逐路恢复。级别变化需要重新打开解码器：窗口模式下以新级别预先打开当前源，出现画面后替换，期间保持旧画面
+ * @param enabled 0 停用（所有播放器立即恢复原始画质），非 0 启用
+ * @param cpuHighPercent 进程 CPU 占用（占全部逻辑核的百分比）达到该值时降级，<= 0 时取 85
+ * @param cpuLowPercent 低于该值且没有丢帧时恢复，<= 0 时取 60
+ * @param lossHighPercent 单路丢帧率（丢弃帧数/解码帧数）达到该值时降级，<= 0 时取 5
+ * @param maxLevel 最多降到的级别 WV_QUALITY_*
+ */
+WINVLCBRIDGE_API void wv_quality_governor_configure(int enabled, float cpuHighPercent, float cpuLowPercent,
+                                                    float lossHighPercent, int maxLevel);
+
+/**
+ * 获取画质调节器的状态（参数可为 NULL）
+ * @param processCpuPercent 最近一秒的进程 CPU 占用（百分比）
+ * @param degradedCount 当前处于降级状态的播放器数量
+ */
+WINVLCBRIDGE_API void wv_quality_governor_get_stats(float* processCpuPercent, int* degradedCount);
+
+/**
+ * 设置播放器优先级，画质调节器先降级优先级低的播放器
+ * @param playerHandle 播放器句柄
+ * @param priority 0-100，默认 50；100 的播放器从不降级（设为 100 时立即恢复原始画质）
+ */
+WINVLCBRIDGE_API void wv_player_set_priority(void* playerHandle, int priority);
+
+/**
+ * 设置子码流地址，画质调节器降到 WV_QUALITY_SUBSTREAM 时改为播放该地址
+ * @param playerHandle 播放器句柄
+ * @param source 子码流地址，NULL 或空串表示没有子码流
+ */
+WINVLCBRIDGE_API void wv_player_set_substream(void* playerHandle, const char* source);
+
+/**
+ * 获取播放器当前的画质级别
+ * @param playerHandle 播放器句柄
+ * @return WV_QUALITY_*
+ */
+WINVLCBRIDGE_API int wv_player_get_quality_level(void* playerHandle);
+
+/**
+ * 网络缓存模式（wv_player_set_caching_policy 的 mode 参数）
+ */
+#define WV_CACHING_FIXED     0  /* 固定为目标值（默认 300 ms） */
+#define WV_CACHING_ADAPTIVE  1  /* 按测得的抖动与卡顿调整，尽量降低延迟 */
+#define WV_CACHING_TARGET    2  /* 以目标值为准，出现卡顿时临时加大，之后逐步回到目标值 */
+
+/**
+ * 设置网络流的缓存策略（:network-caching / :live-caching）
+ * 缓存时长只能在打开连接时设置：每次连接结束（停止、换源、重连）时按该连接的抖动、卡顿与丢帧
+ * 更新该源下次使用的值，下一次打开同一源时生效
+ * @param playerHandle 播放器句柄
+ * @param mode WV_CACHING_*
+ * @param minMs / maxMs 调整范围（毫秒），<= 0 时取 50 / 3000
+ * @param targetMs 固定模式的缓存时长与其他模式的初始值（毫秒），<= 0 时取 300
+ */
+WINVLCBRIDGE_API void wv_player_set_caching_policy(void* playerHandle, int mode, int minMs, int maxMs, int targetMs);
+
+/**
+ * 获取当前网络连接的缓存统计（参数可为 NULL）
+ * @param playerHandle 播放器句柄
+ * @param cachingMs 当前连接使用的缓存时长（毫秒）
+ * @param jitterMs 到达抖动估计（毫秒）
+ * @param stalls 开始播放后再次缓冲的次数
+ */
+WINVLCBRIDGE_API void wv_player_get_caching_stats(void* playerHandle, int* cachingMs, double* jitterMs, int* stalls);
+
+/**
+ * 网络流的健康状态（wv_player_get_health 的返回值）
+ */
+#define WV_HEALTH_IDLE          0  /* 未播放网络流（停止、本地文件、已正常结束） */
+#define WV_HEALTH_CONNECTING    1  /* 已打开，等待首帧 */
+#define WV_HEALTH_LIVE          2  /* 画面持续更新 */
+#define WV_HEALTH_STALLED       3  /* 连接失败、中断或没有新的帧，等待重连 */
+#define WV_HEALTH_RECONNECTING  4  /* 重连进行中 */
+#define WV_HEALTH_FAILED        5  /* 已放弃重连，等待再次调用 wv_player_play */
+
+/**
+ * 配置网络流的自动重连（全部播放器共用，默认启用，参数为 1000 / 30000 / 不限 / 5000 / 4）
+ * 连接失败、直播流结束、或播放中一段时间没有新的帧时，按指数退避重新打开当前源；
+ * 同时进行的重连数有上限，其余排队等待。未启用时只维护健康状态
+ * @param enabled 0 停用（已计划的重连取消，相应播放器进入 WV_HEALTH_FAILED），非 0 启用
+ * @param initialDelayMs 第一次重连前的等待时间，<= 0 时取 1000；之后每次翻倍，并随机缩短至多一半
+ * @param maxDelayMs 等待时间上限，小于 initialDelayMs 时取 30000
+ * @param maxAttempts 连续失败的重连次数上限，<= 0 表示不限
+ * @param stallTimeoutMs 没有新帧多久视为卡住，<= 0 时取 5000（暂停与不可见的播放器不检测）
+ * @param maxConcurrent 同时进行的重连数上限，<= 0 时取 4
+ */
+WINVLCBRIDGE_API void wv_reconnect_configure(int enabled, int initialDelayMs, int maxDelayMs, int maxAttempts,
+                                             int stallTimeoutMs, int maxConcurrent);
+
+/**
+ * 获取重连监督器的状态（参数可为 NULL）
+ * @param inFlight 正在进行的重连数
+ * @param waiting 等待重连的播放器数
+ */
+WINVLCBRIDGE_API void wv_reconnect_get_stats(int* inFlight, int* waiting);
+
+/**
+ * 获取播放器的健康状态
+ * @param playerHandle 播放器句柄
+ * @return WV_HEALTH_*
+ */
+WINVLCBRIDGE_API int wv_player_get_health(void* playerHandle);
+
+/**
+ * 获取播放器的重连统计（参数可为 NULL）
+ * @param playerHandle 播放器句柄
+ * @param attempts 当前连续失败的重连次数（恢复画面后清零）
+ * @param reconnects 重连成功的累计次数
+ */
+WINVLCBRIDGE_API void wv_player_get_reconnect_stats(void* playerHandle, int* attempts, int* reconnects);
+
+/**
+ * 配置网络流的连接调度（全部播放器共用）
+ * 播放网络流前先申请连接名额，名额用完时排队（当前画面保持不变）：可见的播放器先连接，
+ * 其次按 wv_player_set_priority 的优先级，相同时先到先得。连接出现首帧、出错、停止或超时后让出名额。
+ * 预先打开（wv_player_prepare、按显示尺寸切换码流）的网络流同样经过调度，排队期间保持当前画面；本地文件不经过调度
+ * @param maxConcurrent 同时进行的连接数上限，默认 4，<= 0 表示不限（所有连接同时开始）
+ * @param timeoutMs 一个连接最长占用名额的时间，<= 0 时取 10000
+ */
+WINVLCBRIDGE_API void wv_connection_scheduler_configure(int maxConcurrent, int timeoutMs);
+
+/**
+ * 获取连接调度器的状态（参数可为 NULL）
+ * @param queued 排队中的连接数
+ * @param inFlight 正在进行的连接数
+ * @param averageWaitMs 已开始的连接的平均排队时间（毫秒）
+ */
+WINVLCBRIDGE_API void wv_connection_scheduler_get_stats(int* queued, int* inFlight, double* averageWaitMs);
+
+/**
+ * 获取最近一次打开网络流在连接调度器中的排队时间
+ * 与 wv_player_get_first_frame_latency（从实际打开起算）相加即为从调用播放到出现画面的耗时
+ * @param playerHandle 播放器句柄
+ * @return 排队时间（毫秒），没有排队时返回 0
+ */
+WINVLCBRIDGE_API double wv_player_get_connect_wait(void* playerHandle);
+
+/**
+ * 查询异步命令的执行状态（播放器释放后仍可查询最近的命令）
+ * @param commandId wv_player_play 等函数返回的命令 ID
+ * @return WV_COMMAND_* 状态值
+ */
+WINVLCBRIDGE_API int wv_command_status(unsigned long long commandId);
+
+/**
+ * 日志级别（wv_set_log_level 的参数）
+ * 高于运行期级别的日志在格式化之前直接跳过；编译期级别（WV_LOG_COMPILE_LEVEL）
+ * 以上的日志调用在编译时被完全移除
+ */
+#define WV_LOG_LEVEL_ERROR    0
+#define WV_LOG_LEVEL_WARNING  1
+#define WV_LOG_LEVEL_INFO     2  /* 默认 */
+#define WV_LOG_LEVEL_DEBUG    3  /* 包含窗口几何等详细信息 */
+
+/**
+ * 设置运行期日志级别
+ * @param level WV_LOG_LEVEL_*
+ */
+WINVLCBRIDGE_API void wv_set_log_level(int level);
+
+/**
+ * 打开帧回调播放器发布的共享内存帧环（可在其他进程中调用）
+ * 帧环在收到第一帧格式时创建，之后名称在播放器释放前保持有效；
+ * 视频尺寸变化时由 wv_frame_ring_acquire 自动切换到新尺寸的区域（返回 2）
+ * @param sharedMemoryName 与 wv_create_frame_player 相同的名称
+ * @return 帧环句柄，不存在时返回 NULL
+ */
+WINVLCBRIDGE_API void* wv_frame_ring_open(const char* sharedMemoryName);
+
+/**
+ * 获取帧环映射信息（参数可为 NULL）
+ * @return 映射起始地址，可配合 size 包装为 ArrayBuffer
+ */
+WINVLCBRIDGE_API void* wv_frame_ring_get_info(void* ringHandle, unsigned long long* size, int* width, int* height,
+                                              int* pitch, int* slotCount);
+
+/**
+ * 取得最新的完整帧（同一帧环同一时刻只支持一个读取方）
+ * 返回的帧在下一次调用本函数之前不会被解码线程改写，读取期间无需校验
+ * @param frameNumber 返回帧号
+ * @param dataOffset 返回帧数据相对映射起始地址的偏移
+ * @return 1 表示新帧，0 表示自上次调用以来没有新帧（仍返回上一帧），-1 表示尚无帧；
+ *         2 表示视频尺寸已变化、已切换到新的映射区域：需重新调用 wv_frame_ring_get_info
+ *         取得映射地址与尺寸，之前取得的地址随之失效（frameNumber 为 0 表示新区域尚无帧）
+ */
+WINVLCBRIDGE_API int wv_frame_ring_acquire(void* ringHandle, unsigned long long* frameNumber, unsigned long long* dataOffset);
+
+/**
+ * 获取帧环统计（参数可为 NULL）
+ * @param published 返回已发布帧数
+ * @param overwritten 返回未被读取就被新帧替换的帧数
+ */
+WINVLCBRIDGE_API void wv_frame_ring_get_stats(void* ringHandle, unsigned long long* published, unsigned long long* overwritten);
+
+/**
+ * 关闭帧环映射
+ */
+WINVLCBRIDGE_API void wv_frame_ring_close(void* ringHandle);
+
+/**
+ * 设置 libVLC 内部日志的模块级别过滤
+ * VLC 自身的日志（解码器丢帧、RTSP 超时等）会转入桥接库日志，前缀为 [VLC][模块名]
+ * @param module 模块名（如 "avcodec"、"live555"），为 NULL 或空串时设置默认级别（默认 Warning）
+ * @param level WV_LOG_LEVEL_*
+ */
+WINVLCBRIDGE_API void wv_set_vlc_log_level(const char* module, int level);
+
+/**
+ * 设置 libVLC 内部日志的限速参数（按 VLC 对象分别计算令牌桶）
+ * 连续重复的消息只输出一次并汇总为“重复 N 次”，不消耗令牌
+ * @param messagesPerSecond 每个来源每秒允许的日志条数（默认 20）
+ * @param burst 突发容量（默认 50）
+ */
+WINVLCBRIDGE_API void wv_set_vlc_log_rate_limit(float messagesPerSecond, int burst);
+
+/**
+ * 日志输出目标（wv_set_log_sinks 的 sinks 参数，可组合）
+ * 日志由调用线程写入无锁环形缓冲区，后台线程统一输出；默认输出到 stderr 和调试器
+ */
+#define WV_LOG_SINK_STDERR    1  /* 标准错误输出 */
+#define WV_LOG_SINK_FILE      2  /* 追加写入文件 */
+#define WV_LOG_SINK_DEBUGGER  4  /* OutputDebugString（DebugView / VS 输出窗口） */
+
+/**
+ * 设置日志输出目标
+ * @param sinks WV_LOG_SINK_* 组合
+ * @param filePath 日志文件路径（UTF-8），为 NULL 时保持原路径
+ */
+WINVLCBRIDGE_API void wv_set_log_sinks(int sinks, const char* filePath);
+
+/**
+ * 获取因缓冲区满而丢弃的日志条数
+ */
+WINVLCBRIDGE_API unsigned long long wv_get_log_dropped_count(void);
+
+/**
+ * 等待缓冲区中的日志全部输出（退出前调用）
+ * @param timeoutMs 最长等待时间（毫秒）
+ */
+WINVLCBRIDGE_API void wv_log_flush(int timeoutMs);
+
+/**
+ * 配置预热播放器池（首次创建播放器时会以默认水位 2/8 自动配置）
+ * 空闲播放器少于低水位时后台补充，多于高水位时销毁多余的播放器。
+ * 最后一个播放器释放后保留低水位数量的空闲播放器，池保持预热，再次创建播放器不需要重新创建 libVLC 实例。
+ * 需要释放实例（插件、线程与内存）时调用 wv_player_pool_configure(0, 0)：空闲播放器立即销毁，
+ * 实例随最后一个播放器释放。调用本函数会立即按新水位预热或收缩
+ * @param lowWatermark 低水位（预热数量）
+ * @param highWatermark 高水位（最多保留的空闲数量）
+ */
+WINVLCBRIDGE_API void wv_player_pool_configure(int lowWatermark, int highWatermark);
+
+/**
+ * 获取播放器池统计信息（参数可为 NULL）
+ * @param hits 从池中直接取出的次数
+ * @param misses 池中无可用播放器、同步创建的次数
+ * @param idleCount 当前空闲播放器数量
+ * @param liveCount 当前存活的播放器总数（含使用中）
  */
-WINVLCBRIDGE_API void wv_player_release(void* playerHandle);
+WINVLCBRIDGE_API void wv_player_pool_get_stats(unsigned long long* hits, unsigned long long* misses, int* idleCount, int* liveCount);
 
 #ifdef __cplusplus
 }
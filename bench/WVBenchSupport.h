@@ -0,0 +1,101 @@
+//
+//  WVBenchSupport.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_BENCH_SUPPORT_H
+#define WV_BENCH_SUPPORT_H
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// ==================== 基准测试辅助 ====================
+//
+// 每个基准是独立的可执行文件，输出固定格式的结果行，便于不同机器、不同提交之间对比：
+//   <名称>  中位数 <ms>  最小 <ms>  [<吞吐量>]
+// 每项先预热，再采样若干次取中位数；--quick 参数减少采样次数（用于冒烟运行）。
+
+struct WVBenchOptions {
+    int warmup;
+    int samples;
+};
+
+inline WVBenchOptions WVBenchParseArgs(int argc, char** argv) {
+    WVBenchOptions options;
+    options.warmup = 5;
+    options.samples = 31;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            options.warmup = 1;
+            options.samples = 3;
+        }
+    }
+    return options;
+}
+
+struct WVBenchResult {
+    double medianMs;
+    double minMs;
+};
+
+// 每次采样调用一次 fn
+template <typename Fn>
+WVBenchResult WVBenchRun(const WVBenchOptions& options, Fn fn) {
+    for (int i = 0; i < options.warmup; ++i) fn();
+    std::vector<double> samples;
+    for (int i = 0; i < options.samples; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    WVBenchResult result;
+    result.medianMs = samples[samples.size() / 2];
+    result.minMs = samples[0];
+    return result;
+}
+
+inline void WVBenchReport(const char* name, const WVBenchResult& result, const char* extra) {
+    printf("%-48s 中位数 %9.3f ms  最小 %9.3f ms  %s\n", name, result.medianMs, result.minMs, extra ? extra : "");
+    fflush(stdout);
+}
+
+// 调用线程累计占用的 CPU 时间（毫秒），用于按节拍运行的基准统计每次更新的 CPU 开销
+inline double WVBenchThreadCpuMs() {
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) return 0.0;
+    unsigned long long total =
+        ((static_cast<unsigned long long>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime) +
+        ((static_cast<unsigned long long>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime);
+    return total / 10000.0;
+#else
+    struct timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) return 0.0;
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+#endif
+}
+
+inline bool WVBenchQuick(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--quick") == 0) return true;
+    }
+    return false;
+}
+
+#endif // WV_BENCH_SUPPORT_H
@@ -0,0 +1,55 @@
+//
+//  WVCachingHarness.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 网络缓存收敛：反复连接同一个网络流，每次会话结束后按测得的抖动与卡顿调整缓存时长，
+// 逐次输出本次使用的缓存、抖动估计、卡顿次数与丢帧数。
+// 用法：WVCachingHarness <rtsp/http 地址> [会话数 10] [每次秒数 30] [模式 1=自适应 2=目标 0=固定]
+// 抖动可以用 bench/netem_jitter.sh（Linux）在本机网卡上注入，见 README。
+
+#include "WVHarnessSupport.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "用法：%s <网络流地址> [会话数] [每次秒数] [模式]\n", argv[0]);
+        return 2;
+    }
+    const char* url = argv[1];
+    int sessions = WVHarnessIntArg(argc, argv, 2, 10);
+    int seconds = WVHarnessIntArg(argc, argv, 3, 30);
+    int mode = WVHarnessIntArg(argc, argv, 4, WV_CACHING_ADAPTIVE);
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+    std::string ring = WVHarnessRingName("wv_caching", 0);
+    void* player = wv_create_frame_player(ring.c_str(), 640, 360);
+    if (!player) {
+        fprintf(stderr, "无法创建帧回调播放器\n");
+        return 1;
+    }
+    wv_player_set_caching_policy(player, mode, 0, 0, 0);
+
+    printf("会话  缓存(ms)  抖动(ms)  卡顿  解码帧  丢帧\n");
+    for (int s = 0; s < sessions; ++s) {
+        wv_player_play(player, url);
+        WVHarnessSleepMs(seconds * 1000);
+
+        int cachingMs = 0, stalls = 0;
+        double jitterMs = 0.0;
+        unsigned long long decoded = 0, lost = 0;
+        wv_player_get_caching_stats(player, &cachingMs, &jitterMs, &stalls);
+        wv_player_get_decode_stats(player, &decoded, NULL, &lost);
+        printf("%4d  %8d  %8.1f  %4d  %6llu  %4llu\n", s + 1, cachingMs, jitterMs, stalls, decoded, lost);
+        fflush(stdout);
+
+        // 停止时结束会话、更新下次的缓存时长
+        wv_player_stop(player);
+        WVHarnessSleepMs(1000);
+    }
+
+    wv_player_release(player);
+    wv_log_flush(1000);
+    return 0;
+}
@@ -0,0 +1,55 @@
+//
+//  WVColorConvertBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 颜色转换基准：各实现（标量 / SSE2 / AVX2）转换 I420 与 NV12 的吞吐量（百万像素每秒）
+
+#include "WVColorConvert.h"
+#include "WVBenchSupport.h"
+
+int main(int argc, char** argv) {
+    WVBenchOptions options = WVBenchParseArgs(argc, argv);
+    static const int sizes[][2] = { { 640, 360 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+
+    WVColorKernel cpu = WVColorCpuKernel();
+    printf("CPU 支持的最高实现：%s\n", WVColorKernelName(cpu));
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int width = sizes[s][0];
+        int height = sizes[s][1];
+        std::vector<uint8_t> y(width * height), uv(width * height / 2);
+        std::vector<uint8_t> dst(width * height * 4);
+        for (size_t i = 0; i < y.size(); ++i) y[i] = static_cast<uint8_t>(i * 7);
+        for (size_t i = 0; i < uv.size(); ++i) uv[i] = static_cast<uint8_t>(i * 13);
+        const uint8_t* u = &uv[0];
+        const uint8_t* v = &uv[width * height / 4];
+
+        WVColorParams params;
+        WVColorParamsInit(&params, WVColorMatrixBT709, WVColorRangeLimited, WVPixelOrderBGRA);
+        double megapixels = width * height / 1e6;
+
+        for (int kernel = WVColorKernelScalar; kernel <= cpu; ++kernel) {
+            WVColorConvertSetKernel(static_cast<WVColorKernel>(kernel));
+            for (int format = 0; format < 2; ++format) {
+                WVBenchResult result = WVBenchRun(options, [&] {
+                    if (format == 0) {
+                        WVConvertI420(&y[0], width, u, width / 2, v, width / 2, &dst[0], width * 4,
+                                      width, height, params);
+                    } else {
+                        WVConvertNV12(&y[0], width, &uv[0], width, &dst[0], width * 4, width, height, params);
+                    }
+                });
+                char name[96], extra[64];
+                snprintf(name, sizeof(name), "color/%s/%s/%dx%d", WVColorKernelName(static_cast<WVColorKernel>(kernel)),
+                         format == 0 ? "I420" : "NV12", width, height);
+                snprintf(extra, sizeof(extra), "%8.1f MP/s", megapixels / (result.medianMs / 1000.0));
+                WVBenchReport(name, result, extra);
+            }
+        }
+    }
+    WVColorConvertSetKernel(cpu);
+    return 0;
+}
@@ -0,0 +1,148 @@
+//
+//  WVConnectionSchedulerBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 连接调度基准：9 / 25 / 50 个画面同时启动，在模拟时钟上比较不限制与限制 2 / 4 / 8 路同时连接时
+// 所有画面都出图的时间。NVR 模型与重连基准相同：握手时间为 600 ms 加每个同时进行的握手 250 ms，
+// 超过 6 秒的握手失败，失败的画面 1 秒后重新申请。没有随机数，结果可以重现。
+
+#include "WVConnectionScheduler.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include "WVBenchSupport.h"
+
+static long long g_nowMs = 1000000;
+
+static long long FakeNowMs() {
+    return g_nowMs;
+}
+
+static const int kStepMs = 50;
+static const int kHandshakeBaseMs = 600;
+static const int kHandshakePerPeerMs = 250;
+static const int kHandshakeTimeoutMs = 6000;
+static const int kRetryDelayMs = 1000;
+
+struct Tile {
+    bool live;
+    bool grantPending;               // opener 在调度器的锁内调用，只做标记
+    long long handshakeDoneAt;       // 0 表示没有正在进行的握手
+    bool handshakeFails;
+    long long retryAt;               // 0 表示不需要重新申请
+    int failures;
+};
+
+static std::vector<Tile> g_tiles;
+static int g_handshakes = 0;
+static int g_peakHandshakes = 0;
+
+static void RequestSlot(Tile& tile) {
+    Tile* self = &tile;
+    unsigned long long ticket = 0;
+    if (WVConnectionScheduler::Request(self, 0, [self](unsigned long long) { self->grantPending = true; }, &ticket)) {
+        self->grantPending = true;
+    }
+}
+
+static void StartHandshake(Tile& tile) {
+    int duration = kHandshakeBaseMs + kHandshakePerPeerMs * g_handshakes;
+    tile.handshakeFails = duration > kHandshakeTimeoutMs;
+    tile.handshakeDoneAt = g_nowMs + (tile.handshakeFails ? kHandshakeTimeoutMs : duration);
+    ++g_handshakes;
+    if (g_handshakes > g_peakHandshakes) g_peakHandshakes = g_handshakes;
+}
+
+static void Step() {
+    g_nowMs += kStepMs;
+    for (size_t i = 0; i < g_tiles.size(); ++i) {
+        Tile& tile = g_tiles[i];
+        if (tile.handshakeDoneAt > 0 && g_nowMs >= tile.handshakeDoneAt) {
+            tile.handshakeDoneAt = 0;
+            --g_handshakes;
+            if (tile.handshakeFails) {
+                ++tile.failures;
+                tile.retryAt = g_nowMs + kRetryDelayMs;
+            } else {
+                tile.live = true;
+            }
+            WVConnectionScheduler::Release(&tile);
+        }
+        if (tile.retryAt > 0 && g_nowMs >= tile.retryAt) {
+            tile.retryAt = 0;
+            RequestSlot(tile);
+        }
+    }
+    WVConnectionScheduler::Poll();
+    for (size_t i = 0; i < g_tiles.size(); ++i) {
+        Tile& tile = g_tiles[i];
+        if (!tile.grantPending) continue;
+        tile.grantPending = false;
+        StartHandshake(tile);
+    }
+}
+
+static void RunStartup(int tileCount, int maxConcurrent) {
+    WVConnectionScheduler::Configure(maxConcurrent, 10000);
+    Tile initial = { false, false, 0, false, 0, 0 };
+    g_tiles.assign(tileCount, initial);
+    g_handshakes = 0;
+    g_peakHandshakes = 0;
+    long long startedAt = g_nowMs;
+    for (int i = 0; i < tileCount; ++i) RequestSlot(g_tiles[i]);
+    for (int i = 0; i < tileCount; ++i) {
+        if (!g_tiles[i].grantPending) continue;
+        g_tiles[i].grantPending = false;
+        StartHandshake(g_tiles[i]);
+    }
+
+    long long allLiveAt = 0;
+    long long firstLiveAt = 0;
+    for (int i = 0; i < 600000 / kStepMs && allLiveAt == 0; ++i) {
+        Step();
+        int live = 0;
+        for (int t = 0; t < tileCount; ++t) live += g_tiles[t].live ? 1 : 0;
+        if (live > 0 && firstLiveAt == 0) firstLiveAt = g_nowMs;
+        if (live == tileCount) allLiveAt = g_nowMs;
+    }
+    int failures = 0;
+    for (int t = 0; t < tileCount; ++t) {
+        failures += g_tiles[t].failures;
+        WVConnectionScheduler::Cancel(&g_tiles[t]);
+    }
+    double averageWait = 0.0;
+    WVConnectionScheduler::GetStats(NULL, NULL, &averageWait);
+
+    char name[96];
+    if (maxConcurrent > 0) {
+        snprintf(name, sizeof(name), "startup/%d-tiles/max-%d", tileCount, maxConcurrent);
+    } else {
+        snprintf(name, sizeof(name), "startup/%d-tiles/unlimited", tileCount);
+    }
+    if (allLiveAt > 0) {
+        printf("%-48s 首个出图 %5.1f s  全部出图 %6.1f s  握手失败 %4d 次  同时握手最多 %d 路（模拟时间）\n", name,
+               (firstLiveAt - startedAt) / 1000.0, (allLiveAt - startedAt) / 1000.0, failures, g_peakHandshakes);
+    } else {
+        printf("%-48s 600 s 内没有全部出图  握手失败 %4d 次  同时握手最多 %d 路（模拟时间）\n", name, failures,
+               g_peakHandshakes);
+    }
+}
+
+int main(int argc, char** argv) {
+    WVBenchParseArgs(argc, argv);
+    WVLogSetLevel(WVLogError);
+    WVClockSetSource(FakeNowMs);
+
+    static const int tiles[] = { 9, 25, 50 };
+    static const int limits[] = { 0, 2, 4, 8 };
+    for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); ++t) {
+        for (size_t l = 0; l < sizeof(limits) / sizeof(limits[0]); ++l) {
+            RunStartup(tiles[t], limits[l]);
+        }
+    }
+
+    WVClockSetSource(NULL);
+    return 0;
+}
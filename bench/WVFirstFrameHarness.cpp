@@ -0,0 +1,100 @@
+//
+//  WVFirstFrameHarness.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 首帧耗时：依次播放给定的本地文件或网络流（每个源播放若干次），每次等到视频输出配置完成，
+// 记录 wv_player_get_first_frame_latency，最后按源和全部汇总输出最小值、中位数与 p95。
+// 用法：WVFirstFrameHarness [-n 每个源的次数 5] <源 1> [源 2 ...]
+// Windows 上使用画到隐藏窗口的窗口模式播放器，其他平台使用帧回调播放器。
+
+#include "WVHarnessSupport.h"
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+static void Summarize(const char* name, std::vector<double> samples, int failures) {
+    if (samples.empty()) {
+        printf("%-40s 没有出图（%d 次超时）\n", name, failures);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t p95 = (samples.size() * 95 + 99) / 100;
+    printf("%-40s 最小 %7.1f ms  中位数 %7.1f ms  p95 %7.1f ms  （%d 次", name, samples.front(),
+           samples[samples.size() / 2], samples[p95 > 0 ? p95 - 1 : 0], static_cast<int>(samples.size()));
+    if (failures > 0) printf("，%d 次超时", failures);
+    printf("）\n");
+}
+
+// 等待播放命令在工作线程上执行（首帧耗时在执行时清零），再等待视频输出配置完成
+static double PlayAndWait(void* player, const char* source) {
+    unsigned long long command = wv_player_play(player, source);
+    double startedAt = WVHarnessNowMs();
+    while (wv_command_status(command) < WV_COMMAND_DONE && WVHarnessNowMs() - startedAt < 15000.0) {
+        WVHarnessSleepMs(5);
+    }
+    while (WVHarnessNowMs() - startedAt < 15000.0) {
+        double latency = wv_player_get_first_frame_latency(player);
+        if (latency >= 0.0) return latency;
+        WVHarnessSleepMs(5);
+    }
+    return -1.0;
+}
+
+int main(int argc, char** argv) {
+    int rounds = 5;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        rounds = atoi(argv[2]);
+        first = 3;
+    }
+    if (argc <= first || rounds <= 0) {
+        fprintf(stderr, "用法：%s [-n 每个源的次数] <源 1> [源 2 ...]\n", argv[0]);
+        return 2;
+    }
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+#ifdef _WIN32
+    HWND window = CreateWindowExW(0, L"STATIC", L"WVFirstFrameHarness", WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN,
+                                  0, 0, 1280, 720, NULL, NULL, GetModuleHandleW(NULL), NULL);
+    void* player = window ? wv_create_player_for_view(window, 0, 0, 1280, 720) : NULL;
+#else
+    void* player = wv_create_frame_player(WVHarnessRingName("wv_first_frame", 0).c_str(), 1280, 720);
+#endif
+    if (!player) {
+        fprintf(stderr, "无法创建播放器\n");
+        return 1;
+    }
+
+    std::vector<double> all;
+    int allFailures = 0;
+    for (int s = first; s < argc; ++s) {
+        std::vector<double> samples;
+        int failures = 0;
+        for (int r = 0; r < rounds; ++r) {
+            double latency = PlayAndWait(player, argv[s]);
+            if (latency >= 0.0) {
+                samples.push_back(latency);
+            } else {
+                ++failures;
+            }
+            wv_player_stop(player);
+            WVHarnessSleepMs(500);
+        }
+        Summarize(argv[s], samples, failures);
+        fflush(stdout);
+        all.insert(all.end(), samples.begin(), samples.end());
+        allFailures += failures;
+    }
+    if (argc - first > 1) Summarize("全部", all, allFailures);
+
+    wv_player_release(player);
+#ifdef _WIN32
+    WVHarnessSleepMs(1000);
+    if (window) DestroyWindow(window);
+#endif
+    wv_log_flush(1000);
+    return allFailures > 0 ? 1 : 0;
+}
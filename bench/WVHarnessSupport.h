@@ -0,0 +1,106 @@
+//
+//  WVHarnessSupport.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_HARNESS_SUPPORT_H
+#define WV_HARNESS_SUPPORT_H
+
+#include "WinVLCBridge.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <process.h>
+#include <psapi.h>
+#define WV_HARNESS_PID _getpid()
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#define WV_HARNESS_PID getpid()
+#endif
+
+// ==================== 测量程序辅助 ====================
+//
+// 测量程序链接 WinVLCBridge 库，播放真实的媒体或网络流，只通过公共 API 取得统计。
+// 结果取决于媒体、网络与机器，不注册为 ctest 测试，用法见 README。
+
+// Windows 上等待期间处理本线程的窗口消息（VLC 的视频窗口是测量程序所建窗口的子窗口）
+inline void WVHarnessSleepMs(int ms) {
+#ifdef _WIN32
+    DWORD end = GetTickCount() + static_cast<DWORD>(ms);
+    for (;;) {
+        MSG msg;
+        while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+        DWORD now = GetTickCount();
+        if (static_cast<int>(end - now) <= 0) break;
+        MsgWaitForMultipleObjects(0, NULL, FALSE, end - now, QS_ALLINPUT);
+    }
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#endif
+}
+
+inline double WVHarnessNowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 帧回调播放器的共享内存名称（同一台机器上的多个测量程序互不冲突）
+inline std::string WVHarnessRingName(const char* prefix, int index) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s_%d_%d", prefix, static_cast<int>(WV_HARNESS_PID), index);
+    return name;
+}
+
+// 进程占用的物理内存（字节），无法取得时返回 -1
+inline long long WVHarnessRssBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return -1;
+    return static_cast<long long>(counters.WorkingSetSize);
+#else
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) return -1;
+    long long pages = 0, resident = 0;
+    int fields = fscanf(file, "%lld %lld", &pages, &resident);
+    fclose(file);
+    return fields == 2 ? resident * static_cast<long long>(sysconf(_SC_PAGESIZE)) : -1;
+#endif
+}
+
+// 进程累计的 CPU 时间（用户态 + 内核态，毫秒，所有线程合计）
+inline double WVHarnessCpuMs() {
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0.0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (k.QuadPart + u.QuadPart) / 10000.0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#endif
+}
+
+inline int WVHarnessIntArg(int argc, char** argv, int index, int fallback) {
+    return argc > index ? atoi(argv[index]) : fallback;
+}
+
+#endif // WV_HARNESS_SUPPORT_H
@@ -0,0 +1,87 @@
+//
+//  WVInstancePoolHarness.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 实例池：反复创建 N 个帧回调播放器（不需要窗口）、播放同一媒体直到全部出图、再全部释放，
+// 逐轮输出创建耗时（首个播放器包含 libvlc_new，其余共享实例）、全部出图的时间、
+// 每个播放器增加的物理内存，以及释放后剩余的内存增量（检查实例是否随最后一个播放器释放）。
+// 用法：WVInstancePoolHarness <媒体文件或网络流> [播放器数 16] [轮数 3]
+
+#include "WVHarnessSupport.h"
+#include <vector>
+
+static double ToMB(long long bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "用法：%s <媒体文件或网络流> [播放器数] [轮数]\n", argv[0]);
+        return 2;
+    }
+    int count = WVHarnessIntArg(argc, argv, 2, 16);
+    int rounds = WVHarnessIntArg(argc, argv, 3, 3);
+    if (count <= 0) count = 1;
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+    wv_connection_scheduler_configure(0, 0);
+    long long baseline = WVHarnessRssBytes();
+    printf("初始内存 %.1f MB\n", ToMB(baseline));
+    printf("轮次  首个创建(ms)  其余平均(ms)  全部出图(ms)  每个播放器(MB)  释放后增量(MB)\n");
+
+    for (int r = 0; r < rounds; ++r) {
+        long long before = WVHarnessRssBytes();
+        std::vector<void*> players(count, static_cast<void*>(NULL));
+        double firstCreateMs = 0.0;
+        double startedAt = WVHarnessNowMs();
+        for (int i = 0; i < count; ++i) {
+            double createdAt = WVHarnessNowMs();
+            players[i] = wv_create_frame_player(WVHarnessRingName("wv_pool", i).c_str(), 320, 180);
+            if (!players[i]) {
+                fprintf(stderr, "无法创建第 %d 个帧回调播放器\n", i + 1);
+                return 1;
+            }
+            if (i == 0) firstCreateMs = WVHarnessNowMs() - createdAt;
+        }
+        double restCreateMs = count > 1 ? (WVHarnessNowMs() - startedAt - firstCreateMs) / (count - 1) : 0.0;
+
+        double playAt = WVHarnessNowMs();
+        for (int i = 0; i < count; ++i) {
+            wv_player_play(players[i], argv[1]);
+        }
+        int live = 0;
+        while (live < count && WVHarnessNowMs() - playAt < 30000.0) {
+            WVHarnessSleepMs(20);
+            live = 0;
+            for (int i = 0; i < count; ++i) {
+                if (wv_player_get_first_frame_latency(players[i]) >= 0.0) ++live;
+            }
+        }
+        double allLiveMs = WVHarnessNowMs() - playAt;
+        // 出图后再播放一会儿，让解码缓冲与帧环达到稳定大小
+        WVHarnessSleepMs(2000);
+        long long playing = WVHarnessRssBytes();
+
+        for (int i = 0; i < count; ++i) {
+            wv_player_release(players[i]);
+        }
+        // 释放是异步的，等后台停止完成
+        WVHarnessSleepMs(3000);
+        long long after = WVHarnessRssBytes();
+
+        if (live == count) {
+            printf("%4d  %12.1f  %12.2f  %12.0f  %14.2f  %14.1f\n", r + 1, firstCreateMs, restCreateMs, allLiveMs,
+                   ToMB(playing - before) / count, ToMB(after - baseline));
+        } else {
+            printf("%4d  %12.1f  %12.2f  %12s  %14.2f  %14.1f（30 秒内只有 %d 个出图）\n", r + 1, firstCreateMs,
+                   restCreateMs, "-", ToMB(playing - before) / count, ToMB(after - baseline), live);
+        }
+        fflush(stdout);
+    }
+
+    wv_log_flush(1000);
+    return 0;
+}
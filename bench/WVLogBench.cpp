@@ -0,0 +1,117 @@
+//
+//  WVLogBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 日志基准：8 个线程同时写日志，比较原来的同步输出（格式化后 fprintf + fflush）与环形缓冲区
+// （WVLogWrite，后台线程输出），统计调用线程上每次调用的平均耗时与 p99。
+// 两种方式都写入当前目录下的同一个临时文件（不写终端，避免终端速度影响结果），结束后删除。
+// 分两轮：突发（总条数在缓冲区容量以内）与持续写入（缓冲区满时新日志被丢弃），
+// 环形缓冲区同时输出丢弃条数与后台线程写完全部日志的时间。
+
+#include "WVLog.h"
+#include "WVBenchSupport.h"
+#include <stdarg.h>
+#include <thread>
+
+static const int kThreads = 8;
+static const char* kLogPath = "WVLogBench.log";
+
+static FILE* g_file = NULL;
+
+// 原来的 LogMessage：调用线程上格式化并立即写出、刷新
+static void SyncLog(const char* format, ...) {
+    char buffer[1024];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    fprintf(g_file, "[WinVLCBridge] %s\n", buffer);
+    fflush(g_file);
+}
+
+static void RingLog(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    WVLogWriteV(WVLogInfo, format, args);
+    va_end(args);
+}
+
+typedef void (*LogFn)(const char* format, ...);
+
+// 每个线程写 calls 条，记录每次调用的耗时（微秒）
+static std::vector<double> RunThreads(LogFn log, int calls, double* wallMs) {
+    std::vector<std::vector<double> > perThread(kThreads);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([t, calls, log, &perThread] {
+            std::vector<double>& samples = perThread[t];
+            samples.reserve(calls);
+            for (int i = 0; i < calls; ++i) {
+                std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+                log("播放器 %d 第 %d 帧已显示，耗时 %.2f ms，来源 %s", t, i, i * 0.01, "rtsp://192.168.1.10/stream1");
+                samples.push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - before).count());
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+    *wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (int t = 0; t < kThreads; ++t) all.insert(all.end(), perThread[t].begin(), perThread[t].end());
+    return all;
+}
+
+static void Report(const char* name, std::vector<double> samples, double wallMs, const char* extra) {
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i) sum += samples[i];
+    size_t p99 = (samples.size() * 99 + 99) / 100;
+    printf("%-48s 每次 %8.3f us  p99 %8.3f us  最大 %9.1f us  总计 %8.1f ms  %s\n", name, sum / samples.size(),
+           samples[p99 > 0 ? p99 - 1 : 0], samples.back(), wallMs, extra ? extra : "");
+    fflush(stdout);
+}
+
+// 一轮：先同步输出，再环形缓冲区；每个线程写 calls 条
+static void RunRound(int calls) {
+    char name[64], extra[96];
+    double wallMs = 0.0;
+
+    g_file = fopen(kLogPath, "w");
+    if (!g_file) {
+        fprintf(stderr, "无法创建 %s\n", kLogPath);
+        exit(1);
+    }
+    std::vector<double> sync = RunThreads(SyncLog, calls, &wallMs);
+    fclose(g_file);
+    snprintf(name, sizeof(name), "log/sync-fflush/%d-threads/%d-calls", kThreads, calls);
+    Report(name, sync, wallMs, NULL);
+
+    WVLogSetSinks(WVLogSinkFile, kLogPath);
+    WVLogFlush(1000);
+    unsigned long long droppedBefore = WVLogDroppedCount();
+    std::vector<double> ring = RunThreads(RingLog, calls, &wallMs);
+    std::chrono::steady_clock::time_point drainStart = std::chrono::steady_clock::now();
+    WVLogFlush(10000);
+    double drainMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - drainStart).count();
+    unsigned long long dropped = WVLogDroppedCount() - droppedBefore;
+    snprintf(extra, sizeof(extra), "丢弃 %llu / %d 条，之后输出完毕 %.1f ms", dropped, kThreads * calls, drainMs);
+    snprintf(name, sizeof(name), "log/ring/%d-threads/%d-calls", kThreads, calls);
+    Report(name, ring, wallMs, extra);
+
+    // 空路径让后台线程关闭文件（在它下一次循环时），之后删除临时文件
+    WVLogSetSinks(WVLogSinkStderr, "");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    remove(kLogPath);
+}
+
+int main(int argc, char** argv) {
+    // 突发：总条数小于缓冲区容量（4096），不会丢弃；持续：远超后台线程的输出速度，多数被丢弃
+    RunRound(500);
+    RunRound(WVBenchQuick(argc, argv) ? 1000 : 20000);
+    return 0;
+}
@@ -0,0 +1,124 @@
+//
+//  WVOverlayGeometryBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 多边形与蒙版基准：1080p 帧上合成 20 / 100 个区域多边形（16 / 64 个顶点，半透明填充加描边）
+// 与 20 / 100 个分割蒙版（160x120 游程编码，缩放到 120-360 px 外框）。
+// static 为外框不变（命中覆盖率缓存，只做混合），moving 为每帧平移（每帧重新光栅化或缩放）。
+
+#include "WVOverlayGeometry.h"
+#include "WVOverlayRaster.h"
+#include "WVBenchSupport.h"
+
+#include <math.h>
+
+static const int kFrameWidth = 1920;
+static const int kFrameHeight = 1080;
+
+static void BuildPolygons(int count, int vertices, std::vector<WVOverlayShape>* shapes) {
+    srand(7);
+    shapes->clear();
+    std::vector<float> coordinates(vertices * 2);
+    for (int i = 0; i < count; ++i) {
+        float cx = static_cast<float>(150 + rand() % (kFrameWidth - 300));
+        float cy = static_cast<float>(150 + rand() % (kFrameHeight - 300));
+        for (int p = 0; p < vertices; ++p) {
+            float radius = static_cast<float>(60 + rand() % 80);
+            double angle = 2.0 * 3.14159265358979323846 * p / vertices;
+            coordinates[p * 2] = cx + radius * static_cast<float>(cos(angle));
+            coordinates[p * 2 + 1] = cy + radius * static_cast<float>(sin(angle));
+        }
+        WVOverlayShape shape = WVOverlayShape();
+        shape.id = static_cast<uint32_t>(i + 1);
+        shape.kind = WVOverlayShapePolygon;
+        shape.geometry = WVOverlayGeometry::CreatePolygon(&coordinates[0], vertices, &shape.x, &shape.y,
+                                                          &shape.width, &shape.height);
+        shape.lineWidth = 2.0f;
+        shape.strokeColor = WVOverlayPackColorARGB(0xFF00FF00u);
+        shape.fillColor = WVOverlayPackColorARGB(0x4CFF0000u);
+        shape.fillRule = WVOverlayFillNonZero;
+        shapes->push_back(shape);
+    }
+}
+
+static void BuildMasks(int count, std::vector<WVOverlayShape>* shapes) {
+    // 160x120 的椭圆目标
+    const int width = 160, height = 120;
+    std::vector<uint32_t> runs;
+    uint32_t pending = 0;
+    for (int row = 0; row < height; ++row) {
+        double dy = (row + 0.5 - height / 2.0) / (height / 2.0);
+        int half = dy * dy < 1.0 ? static_cast<int>(width / 2.0 * sqrt(1.0 - dy * dy)) : 0;
+        runs.push_back(pending + width / 2 - half);
+        runs.push_back(static_cast<uint32_t>(half * 2));
+        pending = width / 2 - half;
+    }
+
+    srand(11);
+    shapes->clear();
+    for (int i = 0; i < count; ++i) {
+        WVOverlayShape shape = WVOverlayShape();
+        shape.id = static_cast<uint32_t>(i + 1);
+        shape.kind = WVOverlayShapeMask;
+        // 每个图形持有自己的几何对象，各自缓存
+        shape.geometry = WVOverlayGeometry::CreateMask(width, height, &runs[0], runs.size());
+        shape.width = static_cast<float>(120 + rand() % 240);
+        shape.height = shape.width * 0.75f;
+        shape.x = static_cast<float>(rand() % (kFrameWidth - static_cast<int>(shape.width)));
+        shape.y = static_cast<float>(rand() % (kFrameHeight - static_cast<int>(shape.height)));
+        shape.fillColor = WVOverlayPackColorARGB(0x8000A0FFu);
+        shapes->push_back(shape);
+    }
+}
+
+static void Measure(const WVBenchOptions& options, const char* group, std::vector<WVOverlayShape>& shapes,
+                    const WVOverlaySurface& surface) {
+    char name[96];
+    WVBenchResult still = WVBenchRun(options, [&] {
+        WVOverlayRenderShapes(surface, shapes, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+    });
+    snprintf(name, sizeof(name), "geometry/%s/static", group);
+    WVBenchReport(name, still, NULL);
+
+    int frame = 0;
+    WVBenchResult moving = WVBenchRun(options, [&] {
+        float step = (++frame & 1) ? 0.5f : -0.5f;
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            shapes[i].x += step;
+        }
+        WVOverlayRenderShapes(surface, shapes, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+    });
+    snprintf(name, sizeof(name), "geometry/%s/moving", group);
+    char extra[64];
+    snprintf(extra, sizeof(extra), "光栅化 %.3f ms", moving.medianMs - still.medianMs);
+    WVBenchReport(name, moving, extra);
+}
+
+int main(int argc, char** argv) {
+    WVBenchOptions options = WVBenchParseArgs(argc, argv);
+    std::vector<uint8_t> frame(kFrameWidth * kFrameHeight * 4, 0x40);
+    WVOverlaySurface surface = { &frame[0], kFrameWidth, kFrameHeight, kFrameWidth * 4 };
+    static const int counts[] = { 20, 100 };
+    static const int vertices[] = { 16, 64 };
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        for (size_t v = 0; v < sizeof(vertices) / sizeof(vertices[0]); ++v) {
+            std::vector<WVOverlayShape> shapes;
+            BuildPolygons(counts[c], vertices[v], &shapes);
+            char group[64];
+            snprintf(group, sizeof(group), "polygon/%d-x-%d-points", counts[c], vertices[v]);
+            Measure(options, group, shapes, surface);
+        }
+    }
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        std::vector<WVOverlayShape> shapes;
+        BuildMasks(counts[c], &shapes);
+        char group[64];
+        snprintf(group, sizeof(group), "mask/%d-masks", counts[c]);
+        Measure(options, group, shapes, surface);
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+//
+//  WVOverlayLabelBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 覆盖层标签基准：1080p 帧上 100 / 300 / 500 个带标签的框（14 px，类别名 + 置信度，含中文），
+// 统计只有框、框加标签两种情况的耗时，差值即标签的开销。
+// 标签底色不透明时走缓存的合成底框，半透明时为填充加混合；cold 为每帧都是新文本（缓存未命中）。
+
+#include "WVOverlayRaster.h"
+#include "WVGlyphAtlas.h"
+#include "WVBenchSupport.h"
+
+static const int kFrameWidth = 1920;
+static const int kFrameHeight = 1080;
+
+static void BuildShapes(int count, uint32_t strokeColor, int textSerial, std::vector<WVOverlayShape>* plain,
+                        std::vector<WVOverlayShape>* labelled) {
+    static const char* classes[] = { "person", "car", "bicycle", "行人", "车辆", "dog" };
+    srand(1);
+    plain->clear();
+    labelled->clear();
+    for (int i = 0; i < count; ++i) {
+        WVOverlayShape shape = WVOverlayShape();
+        shape.id = static_cast<uint32_t>(i + 1);
+        shape.kind = WVOverlayShapeRect;
+        shape.width = static_cast<float>(40 + rand() % 120);
+        shape.height = static_cast<float>(40 + rand() % 160);
+        shape.x = static_cast<float>(rand() % (kFrameWidth - static_cast<int>(shape.width)));
+        shape.y = static_cast<float>(20 + rand() % (kFrameHeight - 20 - static_cast<int>(shape.height)));
+        shape.lineWidth = 2.0f;
+        shape.strokeColor = strokeColor;
+        plain->push_back(shape);
+
+        char text[64];
+        if (textSerial < 0) {
+            snprintf(text, sizeof(text), "%s %.2f", classes[i % 6], (rand() % 100) / 100.0);
+        } else {
+            snprintf(text, sizeof(text), "%s %d.%d", classes[i % 6], textSerial, i);
+        }
+        shape.label = text;
+        shape.labelSize = 14.0f;
+        shape.labelColor = WVOverlayPackColorARGB(0xFF000000u);
+        labelled->push_back(shape);
+    }
+}
+
+int main(int argc, char** argv) {
+    WVBenchOptions options = WVBenchParseArgs(argc, argv);
+    if (!WVGlyphAtlas::Label("A", 14)) {
+        printf("字体不可用（没有字形栅格化后端），标签不会绘制，以下结果只反映查找开销\n");
+    }
+
+    std::vector<uint8_t> frame(kFrameWidth * kFrameHeight * 4, 0x40);
+    WVOverlaySurface surface = { &frame[0], kFrameWidth, kFrameHeight, kFrameWidth * 4 };
+    static const int counts[] = { 100, 300, 500 };
+    struct Style {
+        const char* name;
+        uint32_t stroke;
+    } styles[] = {
+        { "opaque-tag", WVOverlayPackColorARGB(0xFF00FF00u) },
+        { "translucent-tag", WVOverlayPackColorARGB(0xA000FF00u) }
+    };
+
+    for (size_t s = 0; s < sizeof(styles) / sizeof(styles[0]); ++s) {
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+            std::vector<WVOverlayShape> plain, labelled;
+            BuildShapes(counts[c], styles[s].stroke, -1, &plain, &labelled);
+
+            WVBenchResult boxes = WVBenchRun(options, [&] {
+                WVOverlayRenderShapes(surface, plain, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+            });
+            WVBenchResult withLabels = WVBenchRun(options, [&] {
+                WVOverlayRenderShapes(surface, labelled, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+            });
+
+            char name[96], extra[64];
+            snprintf(name, sizeof(name), "labels/%s/%d-boxes/boxes-only", styles[s].name, counts[c]);
+            WVBenchReport(name, boxes, NULL);
+            snprintf(name, sizeof(name), "labels/%s/%d-boxes/with-labels", styles[s].name, counts[c]);
+            snprintf(extra, sizeof(extra), "标签开销 %.3f ms", withLabels.medianMs - boxes.medianMs);
+            WVBenchReport(name, withLabels, extra);
+        }
+    }
+
+    // 缓存未命中：每次采样都是没有见过的文本，包含栅格化与合成底框
+    int serial = 0;
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        std::vector<WVOverlayShape> plain, labelled;
+        WVBenchResult cold = WVBenchRun(options, [&] {
+            BuildShapes(counts[c], styles[0].stroke, ++serial, &plain, &labelled);
+            WVOverlayRenderShapes(surface, labelled, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+        });
+        char name[96];
+        snprintf(name, sizeof(name), "labels/cold/%d-boxes", counts[c]);
+        WVBenchReport(name, cold, "每帧全部为新文本");
+    }
+    return 0;
+}
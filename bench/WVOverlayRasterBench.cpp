@@ -0,0 +1,60 @@
+//
+//  WVOverlayRasterBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 覆盖层合成基准：在 1080p 帧上合成 0 / 50 / 500 个矩形（3 px 边框，40-240 px 大小），
+// 分别为只有边框与一半带半透明填充两种场景，对每种混合实现（标量 / SSE2 / AVX2）计时。
+
+#include "WVOverlayRaster.h"
+#include "WVBenchSupport.h"
+
+static const int kFrameWidth = 1920;
+static const int kFrameHeight = 1080;
+
+static void BuildShapes(int count, bool filled, std::vector<WVOverlayShape>* shapes) {
+    srand(42);
+    shapes->clear();
+    for (int i = 0; i < count; ++i) {
+        WVOverlayShape shape = WVOverlayShape();
+        shape.id = static_cast<uint32_t>(i + 1);
+        shape.kind = WVOverlayShapeRect;
+        shape.width = static_cast<float>(40 + rand() % 200);
+        shape.height = static_cast<float>(40 + rand() % 200);
+        shape.x = static_cast<float>(rand() % (kFrameWidth - static_cast<int>(shape.width)));
+        shape.y = static_cast<float>(rand() % (kFrameHeight - static_cast<int>(shape.height)));
+        shape.lineWidth = 3.0f;
+        shape.strokeColor = WVOverlayPackColorARGB(0xFF00FF00u);
+        shape.fillColor = filled && (i % 2) == 0 ? WVOverlayPackColorARGB(0x4CFF0000u) : 0;
+        shapes->push_back(shape);
+    }
+}
+
+int main(int argc, char** argv) {
+    WVBenchOptions options = WVBenchParseArgs(argc, argv);
+    std::vector<uint8_t> frame(kFrameWidth * kFrameHeight * 4, 0x40);
+    WVOverlaySurface surface = { &frame[0], kFrameWidth, kFrameHeight, kFrameWidth * 4 };
+    static const int counts[] = { 0, 50, 500 };
+
+    WVColorKernel cpu = WVColorCpuKernel();
+    for (int filled = 0; filled < 2; ++filled) {
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+            std::vector<WVOverlayShape> shapes;
+            BuildShapes(counts[c], filled != 0, &shapes);
+            for (int kernel = WVColorKernelScalar; kernel <= cpu; ++kernel) {
+                WVOverlayBlendSetKernel(static_cast<WVColorKernel>(kernel));
+                WVBenchResult result = WVBenchRun(options, [&] {
+                    WVOverlayRenderShapes(surface, shapes, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+                });
+                char name[96];
+                snprintf(name, sizeof(name), "raster/%s/%s/%d-shapes", WVColorKernelName(static_cast<WVColorKernel>(kernel)),
+                         filled ? "half-filled" : "stroke", counts[c]);
+                WVBenchReport(name, result, NULL);
+            }
+        }
+    }
+    WVOverlayBlendSetKernel(cpu);
+    return 0;
+}
@@ -0,0 +1,78 @@
+//
+//  WVOverlayTimelineBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 覆盖层时间线基准：检测方以 10 Hz 提交 50 个框（全集），显示方以 60 fps 呈现，
+// 媒体时间按帧推进（不等待真实时间）。统计每次提交与每帧呈现的耗时，分别对三种插值模式。
+
+#include "WVOverlayTimeline.h"
+#include "WVBenchSupport.h"
+#include <math.h>
+
+static const int kBoxes = 50;
+static const int kDetectIntervalMs = 100;
+static const int kDisplayLatencyMs = 300;     // 检测结果先于显示提交（network-caching）
+
+static void BuildBatch(int64_t mediaTimeMs, std::vector<uint8_t>* buffer) {
+    buffer->clear();
+    for (int i = 0; i < kBoxes; ++i) {
+        float words[8];
+        uint32_t* header = reinterpret_cast<uint32_t*>(words);
+        header[0] = 1;   // ADD
+        header[1] = static_cast<uint32_t>(i + 1);
+        words[2] = 100.0f + i * 30.0f + mediaTimeMs * 0.1f;
+        words[3] = 80.0f + 300.0f * sinf(mediaTimeMs * 0.001f + i);
+        words[4] = 60.0f;
+        words[5] = 120.0f;
+        words[6] = 2.0f;
+        header[7] = 0xFF00FF00u;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(words);
+        buffer->insert(buffer->end(), bytes, bytes + sizeof(words));
+    }
+}
+
+int main(int argc, char** argv) {
+    int frames = WVBenchQuick(argc, argv) ? 120 : 3600;
+    static const char* names[] = { "none", "linear", "velocity" };
+
+    for (int mode = WVOverlayInterpolationNone; mode <= WVOverlayInterpolationVelocity; ++mode) {
+        WVOverlayTimeline timeline;
+        WVOverlayScene scene;
+        timeline.SetInterpolation(static_cast<WVOverlayInterpolation>(mode), 200);
+        std::vector<uint8_t> batch;
+        std::vector<double> submitMs, presentMs;
+        int64_t nextDetection = 0;
+        int updates = 0;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            int64_t displayMs = frame * 1000 / 60;
+            // 检测结果比显示超前 kDisplayLatencyMs 到达
+            while (nextDetection <= displayMs + kDisplayLatencyMs) {
+                BuildBatch(nextDetection, &batch);
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                timeline.Submit(nextDetection, &batch[0], batch.size());
+                submitMs.push_back(std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count());
+                nextDetection += kDetectIntervalMs;
+            }
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            if (timeline.Present(displayMs, &scene)) ++updates;
+            presentMs.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::sort(submitMs.begin(), submitMs.end());
+        std::sort(presentMs.begin(), presentMs.end());
+        char name[96];
+        snprintf(name, sizeof(name), "timeline/%s/submit-%d-boxes", names[mode], kBoxes);
+        printf("%-48s 中位数 %9.3f ms  P99 %9.3f ms\n", name, submitMs[submitMs.size() / 2],
+               submitMs[submitMs.size() * 99 / 100]);
+        snprintf(name, sizeof(name), "timeline/%s/present", names[mode]);
+        printf("%-48s 中位数 %9.3f ms  P99 %9.3f ms  场景更新 %d/%d 帧\n", name, presentMs[presentMs.size() / 2],
+               presentMs[presentMs.size() * 99 / 100], updates, frames);
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+//  WVOverlayUpdateBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 矩形覆盖层更新基准：以 60 Hz 推送 200 个移动的矩形（wv_player_update_rectangles 的路径），
+// 分别统计调用方（替换场景）与帧回调模式合成方（取快照并合成进 1080p 帧）每次更新的 CPU 时间。
+
+#include "WVOverlayScene.h"
+#include "WVOverlayRaster.h"
+#include "WVBenchSupport.h"
+#include <atomic>
+#include <condition_variable>
+#include <math.h>
+#include <mutex>
+#include <thread>
+
+static const int kRectangles = 200;
+static const int kRateHz = 60;
+static const int kFrameWidth = 1920;
+static const int kFrameHeight = 1080;
+
+int main(int argc, char** argv) {
+    int seconds = WVBenchQuick(argc, argv) ? 1 : 5;
+    int updates = seconds * kRateHz;
+
+    WVOverlayScene scene;
+    std::vector<float> rects(kRectangles * 4);
+    uint32_t color = WVOverlayPackColor(0.0f, 1.0f, 0.0f, 1.0f);
+
+    // 合成方：模拟帧回调线程，每次场景变化后取快照并合成进一帧
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint64_t published = 0;
+    bool done = false;
+    double composeCpuMs = 0.0;
+    std::vector<double> composeMs;
+    std::thread compositor([&] {
+        std::vector<uint8_t> frame(kFrameWidth * kFrameHeight * 4, 0x40);
+        WVOverlaySurface surface = { &frame[0], kFrameWidth, kFrameHeight, kFrameWidth * 4 };
+        std::vector<WVOverlayShape> shapes;
+        uint64_t version = 0;
+        uint64_t seen = 0;
+        double cpuStart = WVBenchThreadCpuMs();
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return done || published != seen; });
+                if (published == seen && done) break;
+                seen = published;
+            }
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            scene.Snapshot(version, &shapes, &version, NULL, NULL);
+            WVOverlayRenderShapes(surface, shapes, 1.0f, 1.0f, 0, 0, kFrameWidth, kFrameHeight);
+            composeMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        composeCpuMs = WVBenchThreadCpuMs() - cpuStart;
+    });
+
+    // 调用方：按 60 Hz 节拍移动全部矩形并替换场景
+    std::vector<double> updateMs;
+    double updateCpuMs = 0.0;
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    for (int i = 0; i < updates; ++i) {
+        for (int r = 0; r < kRectangles; ++r) {
+            float phase = i * 0.05f + r;
+            rects[r * 4 + 0] = 960.0f + 800.0f * sinf(phase * 0.7f + r);
+            rects[r * 4 + 1] = 540.0f + 450.0f * cosf(phase * 0.5f + r * 0.3f);
+            rects[r * 4 + 2] = 40.0f + (r % 7) * 20.0f;
+            rects[r * 4 + 3] = 60.0f + (r % 5) * 30.0f;
+        }
+        double cpuStart = WVBenchThreadCpuMs();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        scene.ReplaceRectangles(&rects[0], kRectangles, 3.0f, color);
+        updateMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        updateCpuMs += WVBenchThreadCpuMs() - cpuStart;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++published;
+        }
+        cond.notify_one();
+
+        next += std::chrono::microseconds(1000000 / kRateHz);
+        std::this_thread::sleep_until(next);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    cond.notify_one();
+    compositor.join();
+
+    std::sort(updateMs.begin(), updateMs.end());
+    std::sort(composeMs.begin(), composeMs.end());
+    printf("%d 个矩形 @ %d Hz，%d 次更新（合成 %d 次），1080p，%s 混合\n", kRectangles, kRateHz, updates,
+           static_cast<int>(composeMs.size()), WVColorKernelName(WVOverlayBlendKernel()));
+    printf("%-48s 中位数 %9.3f ms  P99 %9.3f ms  CPU %7.3f ms/次\n", "overlay/update/replace-rectangles",
+           updateMs[updateMs.size() / 2], updateMs[updateMs.size() * 99 / 100], updateCpuMs / updates);
+    if (!composeMs.empty()) {
+        printf("%-48s 中位数 %9.3f ms  P99 %9.3f ms  CPU %7.3f ms/次\n", "overlay/update/frame-composite",
+               composeMs[composeMs.size() / 2], composeMs[composeMs.size() * 99 / 100],
+               composeCpuMs / composeMs.size());
+    }
+    return 0;
+}
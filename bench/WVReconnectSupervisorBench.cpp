@@ -0,0 +1,204 @@
+//
+//  WVReconnectSupervisorBench.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 重连监督基准：
+//   - poll：50 / 500 个播放器时一次采样的耗时（实际计时）；
+//   - storm：50 路摄像头同时断线、3 秒后 NVR 恢复，在模拟时钟上比较不同的同时重连数上限。
+//     NVR 模型：握手时间为 600 ms 加每个同时进行的握手 250 ms，超过 6 秒的握手失败。
+//     输出全部恢复画面的模拟时间、重连次数与同时握手数峰值（固定随机种子，结果可以重现）。
+
+#include "WVReconnectSupervisor.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include "WVBenchSupport.h"
+
+static long long g_nowMs = 1000000;
+
+static long long FakeNowMs() {
+    return g_nowMs;
+}
+
+static const int kStepMs = 50;
+static const int kHandshakeBaseMs = 600;
+static const int kHandshakePerPeerMs = 250;
+static const int kHandshakeTimeoutMs = 6000;
+
+struct Camera {
+    unsigned long long frames;
+    bool active;
+    bool failed;
+    long long handshakeDoneAt;       // 0 表示没有正在进行的握手
+    bool handshakeFails;
+    unsigned long long pendingGeneration;
+    int reconnects;
+};
+
+struct Storm {
+    std::vector<Camera> cameras;
+    bool nvrOnline;
+    int handshakes;
+    int peakHandshakes;
+};
+
+static Storm g_storm;
+
+static void Open(Camera& camera) {
+    int duration = kHandshakeBaseMs + kHandshakePerPeerMs * g_storm.handshakes;
+    if (!g_storm.nvrOnline) duration = kHandshakeBaseMs;
+    camera.frames = 0;
+    camera.active = true;
+    camera.failed = false;
+    camera.handshakeFails = !g_storm.nvrOnline || duration > kHandshakeTimeoutMs;
+    camera.handshakeDoneAt = g_nowMs + (duration > kHandshakeTimeoutMs ? kHandshakeTimeoutMs : duration);
+    ++g_storm.handshakes;
+    if (g_storm.handshakes > g_storm.peakHandshakes) g_storm.peakHandshakes = g_storm.handshakes;
+    WVReconnectSupervisor::OnOpen(&camera, true);
+}
+
+static void Step() {
+    g_nowMs += kStepMs;
+    for (size_t i = 0; i < g_storm.cameras.size(); ++i) {
+        Camera& camera = g_storm.cameras[i];
+        if (camera.handshakeDoneAt > 0 && g_nowMs >= camera.handshakeDoneAt) {
+            camera.handshakeDoneAt = 0;
+            --g_storm.handshakes;
+            if (camera.handshakeFails) {
+                camera.active = false;
+                camera.failed = true;
+            }
+        }
+        if (camera.active && camera.handshakeDoneAt == 0) {
+            if (g_storm.nvrOnline) {
+                camera.frames += 1;
+            } else {
+                camera.active = false;
+                camera.failed = true;
+            }
+        }
+    }
+    WVReconnectSupervisor::Poll();
+    for (size_t i = 0; i < g_storm.cameras.size(); ++i) {
+        Camera& camera = g_storm.cameras[i];
+        if (camera.pendingGeneration == 0) continue;
+        unsigned long long generation = camera.pendingGeneration;
+        camera.pendingGeneration = 0;
+        if (WVReconnectSupervisor::IsCurrent(&camera, generation)) {
+            ++camera.reconnects;
+            Open(camera);
+        }
+    }
+}
+
+static void RunStorm(int cameraCount, int maxConcurrent) {
+    WVReconnectPolicy policy;
+    policy.enabled = true;
+    policy.initialDelayMs = 1000;
+    policy.maxDelayMs = 30000;
+    policy.maxAttempts = 0;
+    policy.stallTimeoutMs = 5000;
+    policy.maxConcurrent = maxConcurrent;
+    WVReconnectSupervisor::Configure(policy);
+
+    g_storm.cameras.assign(cameraCount, Camera());
+    g_storm.nvrOnline = true;
+    g_storm.handshakes = 0;
+    g_storm.peakHandshakes = 0;
+    for (int i = 0; i < cameraCount; ++i) {
+        Camera* camera = &g_storm.cameras[i];
+        WVReconnectSupervisor::Register(camera, [camera](WVHealthSample* sample) {
+            sample->frames = camera->frames;
+            sample->active = camera->active;
+            sample->paused = false;
+            sample->failed = camera->failed;
+            sample->finished = false;
+            sample->suspended = false;
+            sample->queued = false;
+            return true;
+        }, [camera](unsigned long long generation) {
+            camera->pendingGeneration = generation;
+        });
+        // 初始连接已经完成
+        camera->active = true;
+        WVReconnectSupervisor::OnOpen(camera, true);
+    }
+    for (int i = 0; i < 20; ++i) Step();
+
+    // 同时断线，3 秒后 NVR 恢复
+    g_storm.nvrOnline = false;
+    for (int i = 0; i < 3000 / kStepMs; ++i) Step();
+    g_storm.nvrOnline = true;
+    g_storm.peakHandshakes = g_storm.handshakes;
+    long long restoredAt = g_nowMs;
+
+    long long allLiveAt = 0;
+    for (int i = 0; i < 600000 / kStepMs && allLiveAt == 0; ++i) {
+        Step();
+        bool allLive = true;
+        for (int c = 0; c < cameraCount && allLive; ++c) {
+            allLive = WVReconnectSupervisor::Health(&g_storm.cameras[c]) == WVHealthLive;
+        }
+        if (allLive) allLiveAt = g_nowMs;
+    }
+    int reconnects = 0;
+    for (int c = 0; c < cameraCount; ++c) {
+        reconnects += g_storm.cameras[c].reconnects;
+        WVReconnectSupervisor::Unregister(&g_storm.cameras[c]);
+    }
+
+    char name[96];
+    snprintf(name, sizeof(name), "storm/%d-cameras/max-%d", cameraCount, maxConcurrent);
+    if (allLiveAt > 0) {
+        printf("%-48s 全部恢复 %8.1f s  重连 %4d 次  同时握手最多 %d 路（模拟时间）\n", name,
+               (allLiveAt - restoredAt) / 1000.0, reconnects, g_storm.peakHandshakes);
+    } else {
+        printf("%-48s 600 s 内没有全部恢复  重连 %4d 次  同时握手最多 %d 路（模拟时间）\n", name, reconnects,
+               g_storm.peakHandshakes);
+    }
+}
+
+static void MeasurePoll(const WVBenchOptions& options, int players) {
+    std::vector<Camera> cameras(players, Camera());
+    for (int i = 0; i < players; ++i) {
+        Camera* camera = &cameras[i];
+        WVReconnectSupervisor::Register(camera, [camera](WVHealthSample* sample) {
+            sample->frames = ++camera->frames;
+            sample->active = true;
+            sample->paused = false;
+            sample->failed = false;
+            sample->finished = false;
+            sample->suspended = false;
+            sample->queued = false;
+            return true;
+        }, [](unsigned long long) {});
+        WVReconnectSupervisor::OnOpen(camera, true);
+    }
+    WVBenchResult result = WVBenchRun(options, [] { WVReconnectSupervisor::Poll(); });
+    char name[64], extra[64];
+    snprintf(name, sizeof(name), "supervisor/poll/%d-players", players);
+    snprintf(extra, sizeof(extra), "每个播放器 %.1f ns", result.medianMs * 1e6 / players);
+    WVBenchReport(name, result, extra);
+    for (int i = 0; i < players; ++i) {
+        WVReconnectSupervisor::Unregister(&cameras[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    WVBenchOptions options = WVBenchParseArgs(argc, argv);
+    WVLogSetLevel(WVLogError);
+    WVClockSetSource(FakeNowMs);
+
+    MeasurePoll(options, 50);
+    MeasurePoll(options, 500);
+
+    static const int limits[] = { 2, 4, 8, 50 };
+    for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); ++i) {
+        RunStorm(50, limits[i]);
+    }
+
+    WVClockSetSource(NULL);
+    return 0;
+}
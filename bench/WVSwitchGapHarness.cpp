@@ -0,0 +1,103 @@
+//
+//  WVSwitchGapHarness.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 切换源：在两个源之间来回切换，分别用直接播放（wv_player_play）与预先打开后切换
+// （wv_player_prepare，等待预先打开完成后 wv_player_swap），逐次输出 wv_player_get_switch_gap。
+// 直接播放时这段时间没有画面（黑屏）；预先打开时旧画面一直保持，这段时间只是从切换请求到新画面显示。
+// 用法：WVSwitchGapHarness <源 A> <源 B> [次数 10] [预先打开等待毫秒 3000]
+// 本地 RTSP 源可以用 VLC 把文件推成流：vlc file.mp4 --sout '#rtp{sdp=rtsp://:8554/a}' --loop，见 README。
+// 预先打开只在窗口模式下进行（Windows，画到隐藏窗口）；其他平台使用帧回调播放器，两种方式都等于直接播放。
+
+#include "WVHarnessSupport.h"
+
+// 等待切换耗时更新（播放命令是异步执行的，不能立即读取）
+static double WaitSwitchGap(void* player, double previous) {
+    double startedAt = WVHarnessNowMs();
+    while (WVHarnessNowMs() - startedAt < 15000.0) {
+        double gap = wv_player_get_switch_gap(player);
+        if (gap >= 0.0 && gap != previous) return gap;
+        WVHarnessSleepMs(10);
+    }
+    return -1.0;
+}
+
+static void Report(const char* mode, int index, double gap) {
+    if (gap < 0.0) {
+        printf("%-8s  %4d  15 秒内没有出现新画面\n", mode, index);
+    } else {
+        printf("%-8s  %4d  %10.1f\n", mode, index, gap);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "用法：%s <源 A> <源 B> [次数] [预先打开等待毫秒]\n", argv[0]);
+        return 2;
+    }
+    const char* sources[2] = { argv[1], argv[2] };
+    int switches = WVHarnessIntArg(argc, argv, 3, 10);
+    int prerollMs = WVHarnessIntArg(argc, argv, 4, 3000);
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+#ifdef _WIN32
+    HWND window = CreateWindowExW(0, L"STATIC", L"WVSwitchGapHarness", WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN,
+                                  0, 0, 1280, 720, NULL, NULL, GetModuleHandleW(NULL), NULL);
+    void* player = window ? wv_create_player_for_view(window, 0, 0, 1280, 720) : NULL;
+#else
+    void* player = wv_create_frame_player(WVHarnessRingName("wv_switch", 0).c_str(), 1280, 720);
+#endif
+    if (!player) {
+        fprintf(stderr, "无法创建播放器\n");
+        return 1;
+    }
+
+    // 先播放源 A 到出现画面
+    wv_player_play(player, sources[0]);
+    double startedAt = WVHarnessNowMs();
+    while (wv_player_get_first_frame_latency(player) < 0.0 && WVHarnessNowMs() - startedAt < 15000.0) {
+        WVHarnessSleepMs(20);
+    }
+    WVHarnessSleepMs(1000);
+
+    printf("方式      次数  切换耗时(ms)\n");
+    double previous = wv_player_get_switch_gap(player);
+    double sums[2] = { 0.0, 0.0 };
+    int counts[2] = { 0, 0 };
+    int current = 0;
+    for (int i = 0; i < switches * 2; ++i) {
+        int mode = i % 2;            // 0 直接播放，1 预先打开
+        current = 1 - current;
+        if (mode == 0) {
+            wv_player_play(player, sources[current]);
+        } else {
+            wv_player_prepare(player, sources[current]);
+            WVHarnessSleepMs(prerollMs);
+            wv_player_swap(player);
+        }
+        double gap = WaitSwitchGap(player, previous);
+        Report(mode == 0 ? "play" : "prepare", i / 2 + 1, gap);
+        if (gap >= 0.0) {
+            previous = gap;
+            sums[mode] += gap;
+            ++counts[mode];
+        }
+        // 新画面稳定后再切换下一次
+        WVHarnessSleepMs(1000);
+    }
+
+    if (counts[0] > 0) printf("直接播放平均 %.1f ms（%d 次，期间黑屏）\n", sums[0] / counts[0], counts[0]);
+    if (counts[1] > 0) printf("预先打开平均 %.1f ms（%d 次，期间保持旧画面）\n", sums[1] / counts[1], counts[1]);
+
+    wv_player_release(player);
+#ifdef _WIN32
+    WVHarnessSleepMs(1000);
+    if (window) DestroyWindow(window);
+#endif
+    wv_log_flush(1000);
+    return 0;
+}
@@ -0,0 +1,162 @@
+//
+//  WVWallLoadHarness.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 多画面负载：依次用 1 / 4 / 9 / 16 / 25 个画面播放同一媒体，出图并稳定 2 秒后统计一段时间内
+// 每个画面占用的 CPU（进程 CPU 时间 / 画面数，100% = 一个逻辑核）、平均与最低的显示帧率、丢帧数，
+// 以及（监控墙模式）每个画面分到的解码线程数。
+// 用法：WVWallLoadHarness <媒体文件或网络流> [最多画面数 25] [每级秒数 10] [线程预算 0=核数] [模式]
+// 模式 wall 为监控墙（Windows，画到隐藏窗口），frame 为帧回调播放器（不需要窗口，各平台都可以运行）。
+// 本地文件的时长应长于每级秒数加出图时间，否则播放结束后帧率偏低。
+
+#include "WVHarnessSupport.h"
+#include <string.h>
+#include <vector>
+
+struct Level {
+    void* wall;                      // 监控墙模式时的墙句柄，帧回调模式为 NULL
+    std::vector<void*> tiles;
+
+    Level() : wall(NULL) {}
+};
+
+#ifdef _WIN32
+static HWND g_window = NULL;
+
+static bool CreateWall(Level& level, int side, int budget) {
+    if (!g_window) {
+        g_window = CreateWindowExW(0, L"STATIC", L"WVWallLoadHarness", WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN,
+                                   0, 0, 1920, 1080, NULL, NULL, GetModuleHandleW(NULL), NULL);
+        if (!g_window) return false;
+    }
+    level.wall = wv_wall_create(g_window, 0, 0, 1920, 1080, side, side, 2);
+    if (!level.wall) return false;
+    wv_wall_set_thread_budget(level.wall, budget);
+    for (int i = 0; i < side * side; ++i) {
+        level.tiles.push_back(wv_wall_get_tile(level.wall, i));
+    }
+    return true;
+}
+#endif
+
+static bool CreateFramePlayers(Level& level, int side) {
+    for (int i = 0; i < side * side; ++i) {
+        void* player = wv_create_frame_player(WVHarnessRingName("wv_load", i).c_str(), 1920 / side, 1080 / side);
+        if (!player) return false;
+        level.tiles.push_back(player);
+    }
+    return true;
+}
+
+static void ReleaseLevel(Level& level) {
+#ifdef _WIN32
+    if (level.wall) {
+        wv_wall_release(level.wall);
+        level.tiles.clear();
+        return;
+    }
+#endif
+    for (size_t i = 0; i < level.tiles.size(); ++i) {
+        wv_player_release(level.tiles[i]);
+    }
+    level.tiles.clear();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "用法：%s <媒体文件或网络流> [最多画面数] [每级秒数] [线程预算] [wall|frame]\n", argv[0]);
+        return 2;
+    }
+    int maxTiles = WVHarnessIntArg(argc, argv, 2, 25);
+    int seconds = WVHarnessIntArg(argc, argv, 3, 10);
+    int budget = WVHarnessIntArg(argc, argv, 4, 0);
+#ifdef _WIN32
+    bool wallMode = argc <= 5 || strcmp(argv[5], "frame") != 0;
+#else
+    bool wallMode = false;
+#endif
+    if (seconds <= 0) seconds = 10;
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+    wv_connection_scheduler_configure(0, 0);
+    if (wallMode) {
+        printf("模式：监控墙，解码线程预算 %d（0 为逻辑核数）\n", budget);
+    } else {
+        printf("模式：帧回调播放器\n");
+    }
+    printf("画面  解码线程  每画面CPU(%%)  总CPU(%%)  平均帧率  最低帧率  丢帧\n");
+
+    for (int side = 1; side * side <= maxTiles && side <= 8; ++side) {
+        Level level;
+        bool created = false;
+#ifdef _WIN32
+        if (wallMode) created = CreateWall(level, side, budget);
+#endif
+        if (!wallMode) created = CreateFramePlayers(level, side);
+        if (!created) {
+            fprintf(stderr, "无法创建 %d 个画面\n", side * side);
+            ReleaseLevel(level);
+            return 1;
+        }
+        int tiles = static_cast<int>(level.tiles.size());
+
+        double playAt = WVHarnessNowMs();
+        for (int i = 0; i < tiles; ++i) {
+            wv_player_play(level.tiles[i], argv[1]);
+        }
+        int live = 0;
+        while (live < tiles && WVHarnessNowMs() - playAt < 30000.0) {
+            WVHarnessSleepMs(50);
+            live = 0;
+            for (int i = 0; i < tiles; ++i) {
+                if (wv_player_get_first_frame_latency(level.tiles[i]) >= 0.0) ++live;
+            }
+        }
+        WVHarnessSleepMs(2000);
+
+        std::vector<unsigned long long> displayedBefore(tiles, 0), lostBefore(tiles, 0);
+        for (int i = 0; i < tiles; ++i) {
+            wv_player_get_decode_stats(level.tiles[i], NULL, &displayedBefore[i], &lostBefore[i]);
+        }
+        double cpuBefore = WVHarnessCpuMs();
+        double startedAt = WVHarnessNowMs();
+        WVHarnessSleepMs(seconds * 1000);
+        double elapsedMs = WVHarnessNowMs() - startedAt;
+        double cpuMs = WVHarnessCpuMs() - cpuBefore;
+
+        double fpsSum = 0.0, fpsMin = 1e9;
+        unsigned long long lost = 0;
+        for (int i = 0; i < tiles; ++i) {
+            unsigned long long displayed = 0, tileLost = 0;
+            wv_player_get_decode_stats(level.tiles[i], NULL, &displayed, &tileLost);
+            double fps = (displayed - displayedBefore[i]) * 1000.0 / elapsedMs;
+            fpsSum += fps;
+            if (fps < fpsMin) fpsMin = fps;
+            lost += tileLost - lostBefore[i];
+        }
+        int threads = 0;
+#ifdef _WIN32
+        if (level.wall) threads = wv_wall_get_tile_threads(level.wall, 0);
+#endif
+        double totalCpu = cpuMs * 100.0 / elapsedMs;
+        char threadText[16] = "-";
+        if (threads > 0) snprintf(threadText, sizeof(threadText), "%d", threads);
+        printf("%4d  %8s  %12.1f  %8.1f  %8.1f  %8.1f  %4llu", tiles, threadText, totalCpu / tiles, totalCpu,
+               fpsSum / tiles, fpsMin, lost);
+        if (live < tiles) printf("（30 秒内只有 %d 个出图）", live);
+        printf("\n");
+        fflush(stdout);
+
+        ReleaseLevel(level);
+        WVHarnessSleepMs(2000);
+    }
+
+#ifdef _WIN32
+    if (g_window) DestroyWindow(g_window);
+#endif
+    wv_log_flush(1000);
+    return 0;
+}
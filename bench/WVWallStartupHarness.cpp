@@ -0,0 +1,93 @@
+//
+//  WVWallStartupHarness.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 多画面启动：同时在 N 个帧回调播放器上播放网络流，记录每个画面出图的时间与所有画面都出图的时间。
+// 每个画面的耗时 = 排队时间（wv_player_get_connect_wait）+ 打开到首帧（wv_player_get_first_frame_latency）。
+// 用法：WVWallStartupHarness <网络流地址> [画面数 16] [同时连接数 4，0=不限] [最长等待秒数 60]
+// 地址中的 %d 替换为画面序号（从 1 开始），可以让每个画面打开 NVR 的不同通道；
+// 比较不同的同时连接数时分别运行，见 README。
+
+#include "WVHarnessSupport.h"
+#include <vector>
+
+static std::string TileUrl(const char* pattern, int index) {
+    std::string url = pattern;
+    size_t pos = url.find("%d");
+    if (pos != std::string::npos) {
+        char number[16];
+        snprintf(number, sizeof(number), "%d", index + 1);
+        url.replace(pos, 2, number);
+    }
+    return url;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "用法：%s <网络流地址> [画面数] [同时连接数] [最长等待秒数]\n", argv[0]);
+        return 2;
+    }
+    int tiles = WVHarnessIntArg(argc, argv, 2, 16);
+    int maxConcurrent = WVHarnessIntArg(argc, argv, 3, 4);
+    int seconds = WVHarnessIntArg(argc, argv, 4, 60);
+    if (tiles <= 0) tiles = 1;
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+    wv_connection_scheduler_configure(maxConcurrent, 0);
+
+    std::vector<void*> players(tiles, static_cast<void*>(NULL));
+    for (int i = 0; i < tiles; ++i) {
+        players[i] = wv_create_frame_player(WVHarnessRingName("wv_startup", i).c_str(), 320, 180);
+        if (!players[i]) {
+            fprintf(stderr, "无法创建第 %d 个帧回调播放器\n", i + 1);
+            return 1;
+        }
+    }
+
+    std::vector<double> liveAt(tiles, -1.0);
+    int peakQueued = 0, peakInFlight = 0, live = 0;
+    double startedAt = WVHarnessNowMs();
+    for (int i = 0; i < tiles; ++i) {
+        wv_player_play(players[i], TileUrl(argv[1], i).c_str());
+    }
+    while (live < tiles && WVHarnessNowMs() - startedAt < seconds * 1000.0) {
+        WVHarnessSleepMs(20);
+        int queued = 0, inFlight = 0;
+        wv_connection_scheduler_get_stats(&queued, &inFlight, NULL);
+        if (queued > peakQueued) peakQueued = queued;
+        if (inFlight > peakInFlight) peakInFlight = inFlight;
+        for (int i = 0; i < tiles; ++i) {
+            if (liveAt[i] >= 0.0 || wv_player_get_first_frame_latency(players[i]) < 0.0) continue;
+            liveAt[i] = WVHarnessNowMs() - startedAt;
+            ++live;
+        }
+    }
+    double allLiveMs = WVHarnessNowMs() - startedAt;
+
+    printf("画面  出图(ms)  排队(ms)  打开到首帧(ms)\n");
+    for (int i = 0; i < tiles; ++i) {
+        double latency = wv_player_get_first_frame_latency(players[i]);
+        if (liveAt[i] < 0.0) {
+            printf("%4d  %8s  %8.0f  %14s\n", i + 1, "未出图", wv_player_get_connect_wait(players[i]), "-");
+        } else {
+            printf("%4d  %8.0f  %8.0f  %14.0f\n", i + 1, liveAt[i], wv_player_get_connect_wait(players[i]), latency);
+        }
+    }
+    double averageWait = 0.0;
+    wv_connection_scheduler_get_stats(NULL, NULL, &averageWait);
+    if (live == tiles) {
+        printf("%d 个画面、同时连接 %d：全部出图 %.0f ms", tiles, maxConcurrent, allLiveMs);
+    } else {
+        printf("%d 个画面、同时连接 %d：%d 秒内只有 %d 个出图", tiles, maxConcurrent, seconds, live);
+    }
+    printf("，平均排队 %.0f ms，排队最多 %d 个，同时连接最多 %d 个\n", averageWait, peakQueued, peakInFlight);
+
+    for (int i = 0; i < tiles; ++i) {
+        wv_player_release(players[i]);
+    }
+    wv_log_flush(1000);
+    return live == tiles ? 0 : 1;
+}
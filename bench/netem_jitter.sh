@@ -0,0 +1,26 @@
+#!/bin/sh
+#
+#  netem_jitter.sh
+#  WinVLCBridge
+#
+#  Created by Channing Kuo on 2025/10/7.
+#
+# 在网卡上注入延迟与抖动后运行一个测量程序，退出时恢复（Linux，需要 root 与 iproute2）。
+# 用法：sudo bench/netem_jitter.sh <网卡> <基础延迟ms> <抖动ms> <程序> [参数...]
+# 例如摄像头流经 eth0：
+#   sudo bench/netem_jitter.sh eth0 80 60 build/bin/WVCachingHarness rtsp://192.168.1.64/stream 12 30
+# 本机推流（如 mediamtx + ffmpeg 循环推送文件）时网卡用 lo。
+
+set -e
+if [ $# -lt 4 ]; then
+    echo "用法：$0 <网卡> <基础延迟ms> <抖动ms> <程序> [参数...]" >&2
+    exit 2
+fi
+DEV=$1
+DELAY=$2
+JITTER=$3
+shift 3
+
+tc qdisc add dev "$DEV" root netem delay "${DELAY}ms" "${JITTER}ms" distribution normal
+trap 'tc qdisc del dev "$DEV" root netem' EXIT INT TERM
+"$@"
@@ -16,16 +16,53 @@ const WinVLCBridge = ffi.Library(dllPath, {
     // 创建播放器
     'wv_create_player_for_view': ['pointer', ['pointer', 'float', 'float', 'float', 'float']],
     
-    // 播放控制
-    'wv_player_play': ['void', ['pointer', 'string']],
-    'wv_player_pause': ['void', ['pointer']],
-    'wv_player_resume': ['void', ['pointer']],
-    'wv_player_stop': ['void', ['pointer']],
-    'wv_player_release': ['void', ['pointer']],
+    // 监控墙
+    'wv_wall_create': ['pointer', ['pointer', 'float', 'float', 'float', 'float', 'int', 'int', 'float']],
+    'wv_wall_get_tile': ['pointer', ['pointer', 'int']],
+    'wv_wall_set_thread_budget': ['void', ['pointer', 'int']],
+    'wv_wall_get_tile_threads': ['int', ['pointer', 'int']],
+    'wv_wall_release': ['void', ['pointer']],
+    
+    // 播放控制（异步命令，返回命令 ID）
+    'wv_player_play': ['uint64', ['pointer', 'string']],
+    'wv_player_prepare': ['uint64', ['pointer', 'string']],
+    'wv_player_swap': ['uint64', ['pointer']],
+    'wv_player_get_switch_gap': ['double', ['pointer']],
+    'wv_player_add_rendition': ['int', ['pointer', 'string', 'int', 'int']],
+    'wv_player_clear_renditions': ['void', ['pointer']],
+    'wv_update_window_rect': ['void', ['pointer', 'float', 'float', 'float', 'float']],
+    'wv_player_pause': ['uint64', ['pointer']],
+    'wv_player_resume': ['uint64', ['pointer']],
+    'wv_player_stop': ['uint64', ['pointer']],
+    'wv_player_release': ['uint64', ['pointer']],
+    'wv_command_status': ['int', ['uint64']],
+    'wv_player_get_decode_stats': ['int', ['pointer', 'pointer', 'pointer', 'pointer']],
+    'wv_player_set_visibility': ['void', ['pointer', 'int']],
+    'wv_quality_governor_configure': ['void', ['int', 'float', 'float', 'float', 'int']],
+    'wv_quality_governor_get_stats': ['void', ['pointer', 'pointer']],
+    'wv_player_set_priority': ['void', ['pointer', 'int']],
+    'wv_player_set_substream': ['void', ['pointer', 'string']],
+    'wv_player_get_quality_level': ['int', ['pointer']],
+    'wv_player_set_caching_policy': ['void', ['pointer', 'int', 'int', 'int', 'int']],
+    'wv_player_get_caching_stats': ['void', ['pointer', 'pointer', 'pointer', 'pointer']],
+    'wv_reconnect_configure': ['void', ['int', 'int', 'int', 'int', 'int', 'int']],
+    'wv_reconnect_get_stats': ['void', ['pointer', 'pointer']],
+    'wv_player_get_health': ['int', ['pointer']],
+    'wv_player_get_reconnect_stats': ['void', ['pointer', 'pointer', 'pointer']],
+    'wv_connection_scheduler_configure': ['void', ['int', 'int']],
+    'wv_connection_scheduler_get_stats': ['void', ['pointer', 'pointer', 'pointer']],
+    'wv_player_get_connect_wait': ['double', ['pointer']],
     
     // 矩形覆盖层
     'wv_player_update_rectangles': ['void', ['pointer', 'pointer', 'int', 'float', 'float', 'float', 'float', 'float']],
-    'wv_player_clear_rectangles': ['void', ['pointer']]
+    'wv_player_clear_rectangles': ['void', ['pointer']],
+    'wv_player_overlay_apply': ['int', ['pointer', 'pointer', 'int']],
+    'wv_player_overlay_upload_mask': ['int', ['pointer', 'uint', 'int', 'int', 'pointer', 'int']],
+    'wv_player_overlay_release_mask': ['void', ['pointer', 'uint']],
+    'wv_player_overlay_submit': ['int', ['pointer', 'int64', 'pointer', 'int']],
+    'wv_player_overlay_set_sync': ['void', ['pointer', 'int', 'int', 'int']],
+    'wv_player_overlay_set_interpolation': ['void', ['pointer', 'int', 'int']],
+    'wv_player_get_media_time': ['int64', ['pointer']]
 });
 
 // ==================== 封装类 ====================
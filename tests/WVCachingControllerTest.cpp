@@ -0,0 +1,171 @@
+//
+//  WVCachingControllerTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 网络缓存控制：在模拟时钟上回放抖动的直播流，逐次会话检查缓存时长的收敛。
+// 流模型：每 40 ms 发出一帧，网络延迟为基础延迟加均匀抖动（可选偶发突发延迟），按顺序到达；
+// 播放从首帧到达后缓存时长开始，某帧到达晚于它的播放时间即为卡顿，重新缓冲一个缓存时长。
+// 输入时间随数据到达推进（与 VLC 直播流的 TimeChanged 相同）。
+
+#include "WVCachingController.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include "WVTestSupport.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static long long g_nowMs = 1000000;
+
+static long long FakeNowMs() {
+    return g_nowMs;
+}
+
+static void AdvanceTo(long long timeMs) {
+    if (timeMs > g_nowMs) g_nowMs = timeMs;
+}
+
+struct StreamModel {
+    const char* name;
+    double baseDelayMs;
+    double jitterMs;          // 延迟在 [base, base + jitter] 内均匀分布
+    double burstChance;       // 每帧出现突发延迟的概率
+    double burstMs;
+};
+
+static const int kFrameIntervalMs = 40;
+static const int kSessionFrames = 750;      // 30 秒，超过稳定会话的最短时长
+
+// [0, 1) 均匀分布；不用 std::uniform_real_distribution（各标准库的实现不同），各平台结果一致
+static double Uniform(std::minstd_rand& random) {
+    return (random() - std::minstd_rand::min()) / (static_cast<double>(std::minstd_rand::max()) + 1.0);
+}
+
+// 回放一次会话，返回卡顿次数
+static int RunSession(WVCachingController& controller, const StreamModel& model, std::minstd_rand& random) {
+    controller.BeginSession("rtsp://camera", false);
+    int cachingMs = 0;
+    controller.GetStats(&cachingMs, NULL, NULL);
+
+    long long sessionStart = g_nowMs + 500;
+    double lastArrival = 0.0;
+    double playbackStart = 0.0;             // 第 0 帧的播放时间（卡顿后顺延）
+    bool stalled = false;
+    double resumeAt = 0.0;
+    int stalls = 0;
+
+    for (int i = 0; i < kSessionFrames; ++i) {
+        double delay = model.baseDelayMs + Uniform(random) * model.jitterMs;
+        if (Uniform(random) < model.burstChance) delay += model.burstMs;
+        double arrival = std::max(lastArrival, static_cast<double>(i * kFrameIntervalMs) + delay);
+        lastArrival = arrival;
+
+        if (i == 0) {
+            AdvanceTo(sessionStart + static_cast<long long>(arrival));
+            controller.OnPlaying();
+            controller.OnTimeChanged(0);
+            playbackStart = arrival + cachingMs;
+            AdvanceTo(sessionStart + static_cast<long long>(playbackStart));
+            controller.OnBuffering(100.0f);
+            continue;
+        }
+
+        if (stalled && arrival >= resumeAt) {
+            AdvanceTo(sessionStart + static_cast<long long>(resumeAt));
+            controller.OnBuffering(100.0f);
+            stalled = false;
+        }
+        double playAt = playbackStart + i * kFrameIntervalMs;
+        if (!stalled && arrival > playAt) {
+            // 到达晚于播放时间：卡顿，数据到达后再缓冲一个缓存时长
+            AdvanceTo(sessionStart + static_cast<long long>(playAt));
+            controller.OnBuffering(0.0f);
+            stalled = true;
+            ++stalls;
+            resumeAt = arrival + cachingMs;
+            playbackStart += resumeAt - playAt;
+        }
+        AdvanceTo(sessionStart + static_cast<long long>(arrival));
+        controller.OnTimeChanged(static_cast<int64_t>(i) * kFrameIntervalMs);
+    }
+    AdvanceTo(sessionStart + static_cast<long long>(playbackStart) + kSessionFrames * kFrameIntervalMs);
+    controller.EndSession(kSessionFrames, 0);
+    return stalls;
+}
+
+// 连续回放 sessions 次会话，返回每次会话开始时的缓存时长与卡顿次数
+static void Simulate(WVCachingMode mode, int targetMs, const StreamModel& model, int sessions,
+                     std::vector<int>* caching, std::vector<int>* stalls) {
+    WVCachingController controller;
+    controller.Configure(mode, 50, 3000, targetMs);
+    std::minstd_rand random(12345);
+    caching->clear();
+    stalls->clear();
+    for (int s = 0; s < sessions; ++s) {
+        caching->push_back(controller.CachingFor("rtsp://camera"));
+        stalls->push_back(RunSession(controller, model, random));
+    }
+    printf("%-8s %-10s", mode == WVCachingAdaptive ? "自适应" : (mode == WVCachingTarget ? "目标" : "固定"), model.name);
+    for (int s = 0; s < sessions; ++s) {
+        printf(" %d%s", (*caching)[s], (*stalls)[s] ? "*" : "");
+    }
+    printf("\n");
+}
+
+static int CountStalledSessions(const std::vector<int>& stalls, size_t from) {
+    int count = 0;
+    for (size_t i = from; i < stalls.size(); ++i) {
+        if (stalls[i] > 0) ++count;
+    }
+    return count;
+}
+
+int main() {
+    WVLogSetLevel(WVLogWarning);
+    WVClockSetSource(FakeNowMs);
+
+    const StreamModel lan = { "局域网", 5.0, 6.0, 0.0, 0.0 };
+    const StreamModel vpn = { "VPN", 80.0, 800.0, 0.0, 0.0 };
+    const StreamModel bursty = { "突发", 20.0, 40.0, 0.002, 700.0 };
+    const int sessions = 24;
+    std::vector<int> caching, stalls;
+
+    // 局域网：从 300 ms 每次最多减少 100 ms，收敛到接近 4 倍抖动 + 50 ms，且不卡顿
+    Simulate(WVCachingAdaptive, 300, lan, sessions, &caching, &stalls);
+    WV_CHECK(caching[3] <= 70, "局域网第 4 次会话缓存 %d ms，期望已降到 70 ms 以内", caching[3]);
+    WV_CHECK(caching[1] >= 200, "每次会话最多减少 100 ms，第 2 次为 %d ms", caching[1]);
+    WV_CHECK(CountStalledSessions(stalls, 0) == 0, "局域网出现卡顿");
+
+    // VPN 与偶发突发延迟：固定 300 ms 经常卡顿；自适应增加缓存后卡顿的会话明显减少，缓存不会一路升到上限。
+    // 稳定的会话会逐步减小缓存（加性减少），但不回到卡顿过的值，所以之后只是偶尔有一次卡顿
+    const StreamModel* rough[] = { &vpn, &bursty };
+    for (size_t m = 0; m < sizeof(rough) / sizeof(rough[0]); ++m) {
+        std::vector<int> fixedCaching, fixedStalls;
+        Simulate(WVCachingFixed, 300, *rough[m], sessions, &fixedCaching, &fixedStalls);
+        WV_CHECK(fixedCaching.front() == 300 && fixedCaching.back() == 300, "固定模式缓存发生变化");
+        int fixedStalled = CountStalledSessions(fixedStalls, 4);
+        WV_CHECK(fixedStalled >= 10, "%s 固定 300 ms 只有 %d 次会话卡顿，模型不成立", rough[m]->name, fixedStalled);
+
+        Simulate(WVCachingAdaptive, 300, *rough[m], sessions, &caching, &stalls);
+        int adaptiveStalled = CountStalledSessions(stalls, 4);
+        printf("%s 第 5 次会话之后卡顿的会话：固定 %d 次，自适应 %d 次\n", rough[m]->name, fixedStalled, adaptiveStalled);
+        WV_CHECK(adaptiveStalled * 3 <= fixedStalled, "%s 第 5 次会话之后自适应卡顿 %d 次会话，固定 %d 次",
+                 rough[m]->name, adaptiveStalled, fixedStalled);
+        WV_CHECK(*std::max_element(caching.begin(), caching.end()) < 3000, "%s 缓存升到上限", rough[m]->name);
+    }
+
+    // 目标延迟：稳定时保持目标值；卡顿后增加，稳定后每次减少 100 ms 回到目标值
+    Simulate(WVCachingTarget, 150, lan, 6, &caching, &stalls);
+    WV_CHECK(caching.front() == 150 && caching.back() == 150, "局域网下目标模式偏离目标值 %d ms", caching.back());
+    Simulate(WVCachingTarget, 150, vpn, sessions, &caching, &stalls);
+    WV_CHECK(*std::max_element(caching.begin(), caching.end()) > 150, "VPN 卡顿后目标模式没有增加缓存");
+
+    WVClockSetSource(NULL);
+    return WVTestResult();
+}
@@ -0,0 +1,170 @@
+//
+//  WVColorConvertParityTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 颜色转换一致性测试：对所有矩阵 / 范围 / 像素顺序 / 输入格式组合，SSE2 与 AVX2 的输出
+// 必须与标量版本逐字节一致（包括各种行尾长度与奇数尺寸），且不写出行宽之外的字节。
+// 标量版本再与浮点公式比较，误差不超过 1。CPU 不支持的实现跳过。
+
+#include "WVColorConvert.h"
+#include "WVTestSupport.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static const uint8_t kCanary = 0xA5;
+static const int kStridePadding = 32;       // 目标行尾的保护字节
+
+struct Planes {
+    int width;
+    int height;
+    std::vector<uint8_t> y;
+    std::vector<uint8_t> u;
+    std::vector<uint8_t> v;
+    std::vector<uint8_t> uv;
+    int strideY;
+    int strideC;
+};
+
+// 随机内容，混入 0 / 255 等极值以覆盖饱和路径
+static void FillPlanes(Planes* planes, int width, int height, unsigned seed) {
+    srand(seed);
+    planes->width = width;
+    planes->height = height;
+    planes->strideY = width + 7;
+    planes->strideC = (width + 1) / 2 + 5;
+    int chromaLines = (height + 1) / 2;
+    planes->y.resize(planes->strideY * height);
+    planes->u.resize(planes->strideC * chromaLines);
+    planes->v.resize(planes->strideC * chromaLines);
+    planes->uv.resize(planes->strideC * 2 * chromaLines);
+    static const uint8_t extremes[] = { 0, 1, 16, 128, 235, 240, 254, 255 };
+    std::vector<uint8_t>* all[] = { &planes->y, &planes->u, &planes->v, &planes->uv };
+    for (int p = 0; p < 4; ++p) {
+        std::vector<uint8_t>& plane = *all[p];
+        for (size_t i = 0; i < plane.size(); ++i) {
+            int r = rand();
+            plane[i] = (r & 7) == 0 ? extremes[(r >> 3) & 7] : static_cast<uint8_t>(r >> 4);
+        }
+    }
+}
+
+static void Convert(const Planes& planes, bool nv12, const WVColorParams& params, std::vector<uint8_t>* dst,
+                    int dstStride) {
+    dst->assign(static_cast<size_t>(dstStride) * planes.height, kCanary);
+    if (nv12) {
+        WVConvertNV12(&planes.y[0], planes.strideY, &planes.uv[0], planes.strideC * 2,
+                      &(*dst)[0], dstStride, planes.width, planes.height, params);
+    } else {
+        WVConvertI420(&planes.y[0], planes.strideY, &planes.u[0], planes.strideC, &planes.v[0], planes.strideC,
+                      &(*dst)[0], dstStride, planes.width, planes.height, params);
+    }
+}
+
+static bool PaddingIntact(const std::vector<uint8_t>& dst, int width, int height, int dstStride) {
+    for (int line = 0; line < height; ++line) {
+        for (int x = width * 4; x < dstStride; ++x) {
+            if (dst[line * dstStride + x] != kCanary) return false;
+        }
+    }
+    return true;
+}
+
+// 浮点参考公式，返回与标量输出的最大误差
+static int ReferenceError(const Planes& planes, bool nv12, WVColorMatrix matrix, WVColorRange range,
+                          WVPixelOrder order, const std::vector<uint8_t>& dst, int dstStride) {
+    double kr = matrix == WVColorMatrixBT709 ? 0.2126 : 0.299;
+    double kb = matrix == WVColorMatrixBT709 ? 0.0722 : 0.114;
+    double kg = 1.0 - kr - kb;
+    double yScale = range == WVColorRangeFull ? 1.0 : 255.0 / 219.0;
+    double cScale = range == WVColorRangeFull ? 1.0 : 255.0 / 224.0;
+    double yOffset = range == WVColorRangeFull ? 0.0 : 16.0;
+
+    int maxError = 0;
+    for (int line = 0; line < planes.height; ++line) {
+        for (int x = 0; x < planes.width; ++x) {
+            int c = (line >> 1) * planes.strideC + (x >> 1);
+            double cb = (nv12 ? planes.uv[(line >> 1) * planes.strideC * 2 + (x >> 1) * 2] : planes.u[c]) - 128.0;
+            double cr = (nv12 ? planes.uv[(line >> 1) * planes.strideC * 2 + (x >> 1) * 2 + 1] : planes.v[c]) - 128.0;
+            double luma = (planes.y[line * planes.strideY + x] - yOffset) * yScale;
+            double rgb[3] = {
+                luma + 2.0 * (1.0 - kr) * cScale * cr,
+                luma - 2.0 * cScale * (kb * (1.0 - kb) * cb + kr * (1.0 - kr) * cr) / kg,
+                luma + 2.0 * (1.0 - kb) * cScale * cb
+            };
+            const uint8_t* pixel = &dst[line * dstStride + x * 4];
+            for (int i = 0; i < 3; ++i) {
+                double clamped = rgb[i] < 0.0 ? 0.0 : rgb[i] > 255.0 ? 255.0 : rgb[i];
+                int expected = static_cast<int>(floor(clamped + 0.5));
+                int actual = order == WVPixelOrderRGBA ? pixel[i] : pixel[2 - i];
+                int error = abs(expected - actual);
+                if (error > maxError) maxError = error;
+            }
+            if (pixel[3] != 255) maxError = 256;   // Alpha 必须不透明
+        }
+    }
+    return maxError;
+}
+
+int main() {
+    static const int sizes[][2] = {
+        { 1, 1 }, { 2, 2 }, { 3, 5 }, { 7, 3 }, { 15, 4 }, { 16, 2 }, { 17, 3 }, { 31, 2 }, { 32, 4 },
+        { 33, 5 }, { 47, 2 }, { 63, 3 }, { 64, 2 }, { 65, 3 }, { 127, 2 }, { 129, 3 }, { 352, 288 },
+        { 641, 9 }, { 1920, 8 }
+    };
+    const int sizeCount = static_cast<int>(sizeof(sizes) / sizeof(sizes[0]));
+
+    WVColorKernel cpu = WVColorCpuKernel();
+    printf("CPU 支持的最高实现：%s\n", WVColorKernelName(cpu));
+
+    int combinations = 0;
+    for (int s = 0; s < sizeCount; ++s) {
+        Planes planes;
+        FillPlanes(&planes, sizes[s][0], sizes[s][1], 1234u + s);
+        int dstStride = planes.width * 4 + kStridePadding;
+
+        for (int format = 0; format < 2; ++format) {
+            for (int matrix = WVColorMatrixBT601; matrix <= WVColorMatrixBT709; ++matrix) {
+                for (int range = WVColorRangeLimited; range <= WVColorRangeFull; ++range) {
+                    for (int order = WVPixelOrderBGRA; order <= WVPixelOrderRGBA; ++order) {
+                        WVColorParams params;
+                        WVColorParamsInit(&params, static_cast<WVColorMatrix>(matrix),
+                                          static_cast<WVColorRange>(range), static_cast<WVPixelOrder>(order));
+                        bool nv12 = format == 1;
+                        const char* formatName = nv12 ? "NV12" : "I420";
+
+                        std::vector<uint8_t> reference;
+                        WVColorConvertSetKernel(WVColorKernelScalar);
+                        Convert(planes, nv12, params, &reference, dstStride);
+                        int error = ReferenceError(planes, nv12, static_cast<WVColorMatrix>(matrix),
+                                                   static_cast<WVColorRange>(range),
+                                                   static_cast<WVPixelOrder>(order), reference, dstStride);
+                        WV_CHECK(error <= 1, "标量 %s %dx%d 矩阵 %d 范围 %d 顺序 %d：与浮点公式误差 %d",
+                                 formatName, planes.width, planes.height, matrix, range, order, error);
+                        WV_CHECK(PaddingIntact(reference, planes.width, planes.height, dstStride),
+                                 "标量 %s %dx%d 写出了行宽之外", formatName, planes.width, planes.height);
+
+                        for (int kernel = WVColorKernelSSE2; kernel <= cpu; ++kernel) {
+                            std::vector<uint8_t> output;
+                            WVColorConvertSetKernel(static_cast<WVColorKernel>(kernel));
+                            Convert(planes, nv12, params, &output, dstStride);
+                            const char* name = WVColorKernelName(static_cast<WVColorKernel>(kernel));
+                            WV_CHECK(output == reference, "%s %s %dx%d 矩阵 %d 范围 %d 顺序 %d：与标量输出不一致",
+                                     name, formatName, planes.width, planes.height, matrix, range, order);
+                        }
+                        ++combinations;
+                    }
+                }
+            }
+        }
+    }
+    WVColorConvertSetKernel(cpu);
+    printf("比较了 %d 个组合\n", combinations);
+    return WVTestResult();
+}
@@ -0,0 +1,143 @@
+//
+//  WVCommandQueueTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 命令队列测试：播放器命令通过 libVLC 桩执行，停止阻塞 kStopDelayMs，
+// 验证入队（调用方所在的 UI 线程）始终立即返回、冗余命令被合并、关闭不等待正在执行的命令。
+
+#include "WVCommandQueue.h"
+#include "WVLibVLCStub.h"
+#include "WVTestSupport.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static const int kStopDelayMs = 400;
+static const double kMaxPostMs = 20.0;       // 远小于停止的阻塞时长
+
+// 等待命令达到指定状态
+static bool WaitForStatus(unsigned long long id, int status, int timeoutMs) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (WVTestElapsedMs(start) < timeoutMs) {
+        if (WVCommandQueue::GetStatus(id) == status) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+static bool WaitForStopRunning(int timeoutMs) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (WVTestElapsedMs(start) < timeoutMs) {
+        if (WVLibVLCStubGetCounters().stopRunning) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+// 工作线程阻塞在停止中时，入队的耗时与合并结果
+static void TestPostDoesNotBlockDuringStop() {
+    WVLibVLCStubReset();
+    WVLibVLCStubSetStopDelay(kStopDelayMs);
+    libvlc_instance_t* instance = libvlc_new(0, NULL);
+    libvlc_media_player_t* player = libvlc_media_player_new(instance);
+    WVCommandQueue* queue = new WVCommandQueue();
+
+    queue->Post(WVCommandQueue::KindPlay, [player] { libvlc_media_player_play(player); });
+    unsigned long long stopId = queue->Post(WVCommandQueue::KindStop, [player] {
+        libvlc_media_player_stop(player);
+    });
+    WV_CHECK(WaitForStatus(stopId, WVCommandQueue::StatusRunning, 2000), "停止命令没有开始执行");
+    WV_CHECK(WaitForStopRunning(2000), "桩的停止没有被调用");
+
+    // 停止阻塞期间连续入队：每次都应立即返回
+    double maxPostMs = 0.0;
+    unsigned long long ids[60];
+    std::chrono::steady_clock::time_point burstStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < 60; ++i) {
+        WVCommandQueue::Kind kind = i % 3 == 0 ? WVCommandQueue::KindPlay :
+                                    i % 3 == 1 ? WVCommandQueue::KindStop : WVCommandQueue::KindPause;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (kind == WVCommandQueue::KindStop) {
+            ids[i] = queue->Post(kind, [player] { libvlc_media_player_stop(player); });
+        } else if (kind == WVCommandQueue::KindPlay) {
+            ids[i] = queue->Post(kind, [player] { libvlc_media_player_play(player); });
+        } else {
+            ids[i] = queue->Post(kind, [player] { libvlc_media_player_set_pause(player, 1); });
+        }
+        double elapsed = WVTestElapsedMs(start);
+        if (elapsed > maxPostMs) maxPostMs = elapsed;
+    }
+    double burstMs = WVTestElapsedMs(burstStart);
+    printf("停止阻塞 %d ms 期间入队 60 条：最长 %.3f ms，合计 %.3f ms\n", kStopDelayMs, maxPostMs, burstMs);
+    WV_CHECK(maxPostMs < kMaxPostMs, "入队耗时 %.3f ms", maxPostMs);
+    WV_CHECK(WVLibVLCStubGetCounters().stopRunning, "入队期间停止应仍在阻塞（阻塞时长不足以覆盖测试）");
+    WV_CHECK(WVCommandQueue::GetStatus(stopId) == WVCommandQueue::StatusRunning, "停止命令状态 %d",
+             WVCommandQueue::GetStatus(stopId));
+
+    // 只保留最后的停止与其后的暂停（暂停不取代停止），其余被合并
+    for (int i = 0; i < 58; ++i) {
+        WV_CHECK(WVCommandQueue::GetStatus(ids[i]) == WVCommandQueue::StatusCoalesced,
+                 "第 %d 条命令状态 %d", i, WVCommandQueue::GetStatus(ids[i]));
+    }
+    WV_CHECK(WVCommandQueue::GetStatus(ids[58]) == WVCommandQueue::StatusPending &&
+             WVCommandQueue::GetStatus(ids[59]) == WVCommandQueue::StatusPending,
+             "最后两条命令状态 %d / %d", WVCommandQueue::GetStatus(ids[58]), WVCommandQueue::GetStatus(ids[59]));
+
+    // 关闭同样立即返回，释放在停止与剩余命令完成后执行
+    std::atomic<bool> released(false);
+    std::chrono::steady_clock::time_point shutdownStart = std::chrono::steady_clock::now();
+    unsigned long long releaseId = queue->Shutdown([player, instance, &released] {
+        libvlc_media_player_stop(player);
+        libvlc_media_player_release(player);
+        libvlc_release(instance);
+        released = true;
+    });
+    double shutdownMs = WVTestElapsedMs(shutdownStart);
+    WV_CHECK(shutdownMs < kMaxPostMs, "关闭耗时 %.3f ms", shutdownMs);
+    WV_CHECK(WVCommandQueue::GetStatus(ids[58]) == WVCommandQueue::StatusCoalesced &&
+             WVCommandQueue::GetStatus(ids[59]) == WVCommandQueue::StatusCoalesced, "释放应合并未执行的命令");
+
+    WV_CHECK(WaitForStatus(releaseId, WVCommandQueue::StatusDone, kStopDelayMs * 4), "释放命令没有完成");
+    WV_CHECK(released, "释放回调没有执行");
+    WVLibVLCStubCounters counters = WVLibVLCStubGetCounters();
+    WV_CHECK(counters.stops == 2, "停止次数 %d", counters.stops);
+    WV_CHECK(counters.livePlayers == 0 && counters.liveInstances == 0, "播放器 %d、实例 %d 未释放",
+             counters.livePlayers, counters.liveInstances);
+}
+
+// 内部任务不被播放/停止合并，按入队顺序执行
+static void TestTasksRunInOrder() {
+    WVLibVLCStubReset();
+    libvlc_instance_t* instance = libvlc_new(0, NULL);
+    libvlc_media_player_t* player = libvlc_media_player_new(instance);
+    WVCommandQueue* queue = new WVCommandQueue();
+    std::vector<int> order;
+    unsigned long long lastTask = 0;
+    for (int i = 0; i < 10; ++i) {
+        lastTask = queue->Post(WVCommandQueue::KindTask, [&order, i] { order.push_back(i); });
+        queue->Post(i % 2 ? WVCommandQueue::KindStop : WVCommandQueue::KindPlay, [player] {
+            libvlc_media_player_play(player);
+        });
+    }
+    WV_CHECK(WaitForStatus(lastTask, WVCommandQueue::StatusDone, 2000), "任务没有执行完");
+    unsigned long long releaseId = queue->Shutdown([player, instance] {
+        libvlc_media_player_release(player);
+        libvlc_release(instance);
+    });
+    WV_CHECK(WaitForStatus(releaseId, WVCommandQueue::StatusDone, 2000), "释放命令没有完成");
+    WV_CHECK(order.size() == 10, "执行了 %d 个任务", static_cast<int>(order.size()));
+    for (size_t i = 0; i < order.size(); ++i) {
+        WV_CHECK(order[i] == static_cast<int>(i), "第 %d 个任务是 %d", static_cast<int>(i), order[i]);
+    }
+}
+
+int main() {
+    TestPostDoesNotBlockDuringStop();
+    TestTasksRunInOrder();
+    return WVTestResult();
+}
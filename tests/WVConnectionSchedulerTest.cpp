@@ -0,0 +1,175 @@
+//
+//  WVConnectionSchedulerTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 连接调度：同时连接数上限、优先级与先到先得、同一播放器的申请互相取代、
+// 调整优先级、取消、名额超时（模拟时钟上调用 Poll）、平均排队时间与不限数量。
+
+#include "WVConnectionScheduler.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include "WVTestSupport.h"
+
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static long long g_nowMs = 1000000;
+
+static long long FakeNowMs() {
+    return g_nowMs;
+}
+
+// 模拟播放器：记录取得名额的顺序（opener 在调度器持有内部锁时调用，只能记录）
+struct SimPlayer {
+    int id;
+    unsigned long long ticket;
+    unsigned long long grantedTicket;
+};
+
+static std::vector<int> g_grantOrder;
+
+static bool Request(SimPlayer& player, int priority) {
+    SimPlayer* self = &player;
+    self->grantedTicket = 0;
+    bool granted = WVConnectionScheduler::Request(self, priority, [self](unsigned long long ticket) {
+        self->grantedTicket = ticket;
+        g_grantOrder.push_back(self->id);
+    }, &self->ticket);
+    if (granted) self->grantedTicket = self->ticket;
+    return granted;
+}
+
+static bool Granted(SimPlayer& player) {
+    return WVConnectionScheduler::IsGranted(&player, player.ticket);
+}
+
+static void CancelAll(std::vector<SimPlayer>& players) {
+    for (size_t i = 0; i < players.size(); ++i) {
+        WVConnectionScheduler::Cancel(&players[i]);
+    }
+    g_grantOrder.clear();
+}
+
+static std::vector<SimPlayer> MakePlayers(int count) {
+    std::vector<SimPlayer> players(count);
+    for (int i = 0; i < count; ++i) {
+        players[i].id = i;
+        players[i].ticket = 0;
+        players[i].grantedTicket = 0;
+    }
+    return players;
+}
+
+static void TestLimitAndPriority() {
+    WVConnectionScheduler::Configure(2, 10000);
+    std::vector<SimPlayer> players = MakePlayers(6);
+
+    WV_CHECK(Request(players[0], 0) && Request(players[1], 0), "空闲名额没有立即取得");
+    WV_CHECK(!Request(players[2], 0), "名额用完时没有排队");
+    WV_CHECK(!Request(players[3], 5) && !Request(players[4], 5) && !Request(players[5], 0), "名额用完时没有排队");
+    int queued = 0, inFlight = 0;
+    WVConnectionScheduler::GetStats(&queued, &inFlight, NULL);
+    WV_CHECK(queued == 4 && inFlight == 2, "排队 %d、进行中 %d，期望 4 / 2", queued, inFlight);
+    WV_CHECK(!Granted(players[2]), "排队中的申请显示为已取得名额");
+
+    // 优先级高的先连接，相同时先到先得；没有占用名额的 Release 被忽略
+    WVConnectionScheduler::Release(&players[2]);
+    WV_CHECK(g_grantOrder.empty(), "排队中的播放器 Release 后分配了名额");
+    WVConnectionScheduler::Release(&players[0]);
+    WVConnectionScheduler::Release(&players[1]);
+    WVConnectionScheduler::Release(&players[3]);
+    WVConnectionScheduler::Release(&players[4]);
+    const int expected[] = { 3, 4, 2, 5 };
+    WV_CHECK(g_grantOrder == std::vector<int>(expected, expected + 4), "取得名额的顺序 %d %d %d %d",
+             g_grantOrder.size() > 0 ? g_grantOrder[0] : -1, g_grantOrder.size() > 1 ? g_grantOrder[1] : -1,
+             g_grantOrder.size() > 2 ? g_grantOrder[2] : -1, g_grantOrder.size() > 3 ? g_grantOrder[3] : -1);
+    WV_CHECK(Granted(players[2]) && Granted(players[5]), "opener 通知的申请 IsGranted 为 false");
+    WV_CHECK(players[2].grantedTicket == players[2].ticket, "opener 收到的编号不是申请编号");
+    CancelAll(players);
+}
+
+static void TestSupersedeAndCancel() {
+    WVConnectionScheduler::Configure(1, 10000);
+    std::vector<SimPlayer> players = MakePlayers(4);
+    Request(players[0], 0);
+    Request(players[1], 0);
+    Request(players[2], 0);
+
+    // 排队中的播放器再次申请：旧申请失效，排到队尾；调整优先级后排到最前
+    unsigned long long oldTicket = players[1].ticket;
+    Request(players[1], 0);
+    WV_CHECK(players[1].ticket != oldTicket && !WVConnectionScheduler::IsGranted(&players[1], oldTicket),
+             "新的申请没有取代旧申请");
+    int queued = 0;
+    WVConnectionScheduler::GetStats(&queued, NULL, NULL);
+    WV_CHECK(queued == 2, "重复申请后排队 %d 个，期望 2", queued);
+    Request(players[3], 0);
+    WVConnectionScheduler::SetPriority(&players[3], 9);
+
+    // 已占用名额的播放器换源：名额留给新的连接
+    WV_CHECK(Request(players[0], 0), "占用名额的播放器再次申请没有立即取得");
+
+    // 取消排队中的申请不分配名额；取消占用名额的申请把名额交给排在最前面的
+    WVConnectionScheduler::Cancel(&players[2]);
+    WV_CHECK(g_grantOrder.empty(), "取消排队中的申请后分配了名额");
+    WVConnectionScheduler::Cancel(&players[0]);
+    WV_CHECK(g_grantOrder.size() == 1 && g_grantOrder[0] == 3, "取消后没有把名额交给优先级最高的播放器");
+    WVConnectionScheduler::Release(&players[3]);
+    WV_CHECK(g_grantOrder.size() == 2 && g_grantOrder[1] == 1, "队尾的申请没有取得名额");
+    CancelAll(players);
+}
+
+static void TestTimeoutAndWait() {
+    // 名额占用 3000 ms 仍没有结果时让出；排队时间按模拟时钟统计
+    WVConnectionScheduler::Configure(1, 3000);
+    std::vector<SimPlayer> players = MakePlayers(2);
+    double waitBefore = 0.0;
+    Request(players[0], 0);
+    Request(players[1], 0);
+    WVConnectionScheduler::GetStats(NULL, NULL, &waitBefore);
+
+    g_nowMs += 2900;
+    WVConnectionScheduler::Poll();
+    WV_CHECK(g_grantOrder.empty(), "未到超时就让出了名额");
+    g_nowMs += 200;
+    WVConnectionScheduler::Poll();
+    WV_CHECK(g_grantOrder.size() == 1 && g_grantOrder[0] == 1, "超时后没有把名额交给排队的播放器");
+    WV_CHECK(!Granted(players[0]), "超时的申请仍显示为已取得名额");
+
+    double averageWait = 0.0;
+    WVConnectionScheduler::GetStats(NULL, NULL, &averageWait);
+    WV_CHECK(averageWait > waitBefore, "平均排队时间没有计入 3100 ms 的等待");
+    CancelAll(players);
+
+    // 不限数量时全部立即取得
+    WVConnectionScheduler::Configure(0, 10000);
+    std::vector<SimPlayer> many = MakePlayers(50);
+    bool all = true;
+    for (size_t i = 0; i < many.size(); ++i) all = Request(many[i], 0) && all;
+    WV_CHECK(all, "不限数量时有申请排队");
+    CancelAll(many);
+
+    // 提高上限时排队的申请立即开始
+    WVConnectionScheduler::Configure(1, 10000);
+    std::vector<SimPlayer> raised = MakePlayers(3);
+    for (size_t i = 0; i < raised.size(); ++i) Request(raised[i], 0);
+    WVConnectionScheduler::Configure(3, 10000);
+    WV_CHECK(g_grantOrder.size() == 2, "提高上限后只有 %d 个排队的申请开始", static_cast<int>(g_grantOrder.size()));
+    CancelAll(raised);
+}
+
+int main() {
+    WVLogSetLevel(WVLogError);
+    WVClockSetSource(FakeNowMs);
+
+    TestLimitAndPriority();
+    TestSupersedeAndCancel();
+    TestTimeoutAndWait();
+
+    WVClockSetSource(NULL);
+    return WVTestResult();
+}
@@ -0,0 +1,190 @@
+//
+//  WVFrameRingStressTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 三缓冲与共享内存帧环的压力测试：不限速的生产者与慢速消费者并发运行。
+// 生产者把帧号写满整帧，消费者在持有帧期间读取两次（中间等待），任何一个像素不等于帧号
+// 即为撕裂；同时检查帧号单调递增，以及 发布数 = 消费数 + 覆盖数。
+
+#include "WVTripleBuffer.h"
+#include "WVFrameRing.h"
+#include "WVTestSupport.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+WV_TEST_MAIN_STATE;
+
+static const int kRunMs = 600;
+static const int kConsumerHoldUs = 300;     // 消费者持有每一帧的时间（慢速消费者）
+static const int kResizeEveryFrames = 2000;
+
+// 整帧是否都等于帧号
+static bool FrameIntact(const uint32_t* pixels, size_t count, uint32_t value) {
+    for (size_t i = 0; i < count; ++i) {
+        if (pixels[i] != value) return false;
+    }
+    return true;
+}
+
+static void TestTripleBuffer() {
+    const size_t kPixels = 64 * 64;
+    std::vector<uint32_t> buffers[3];
+    for (int i = 0; i < 3; ++i) buffers[i].assign(kPixels, 0);
+    std::atomic<uint32_t> state;
+    WVTripleBuffer::Initialize(state);
+
+    std::atomic<bool> stop(false);
+    unsigned long long published = 0;
+    unsigned long long overwritten = 0;
+    std::thread producer([&] {
+        uint32_t back = WVTripleBuffer::InitialBackIndex();
+        uint32_t frame = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            ++frame;
+            std::vector<uint32_t>& target = buffers[back];
+            for (size_t i = 0; i < kPixels; ++i) target[i] = frame;
+            if (WVTripleBuffer::Publish(state, &back)) ++overwritten;
+            ++published;
+        }
+    });
+
+    uint32_t front = WVTripleBuffer::InitialFrontIndex();
+    unsigned long long consumed = 0;
+    unsigned long long torn = 0;
+    unsigned long long regressions = 0;
+    uint32_t lastFrame = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (WVTestElapsedMs(start) < kRunMs) {
+        if (!WVTripleBuffer::Acquire(state, &front)) continue;
+        ++consumed;
+        const std::vector<uint32_t>& frame = buffers[front];
+        uint32_t value = frame[0];
+        if (value <= lastFrame) ++regressions;
+        lastFrame = value;
+        if (!FrameIntact(&frame[0], kPixels, value)) ++torn;
+        std::this_thread::sleep_for(std::chrono::microseconds(kConsumerHoldUs));
+        if (!FrameIntact(&frame[0], kPixels, value)) ++torn;   // 持有期间不能被改写
+    }
+    stop.store(true);
+    producer.join();
+    if (WVTripleBuffer::Acquire(state, &front)) ++consumed;   // 取走最后一帧，之后计数应当平衡
+
+    printf("三缓冲：发布 %llu，消费 %llu，覆盖 %llu\n", published, consumed, overwritten);
+    WV_CHECK(torn == 0, "%llu 帧撕裂", torn);
+    WV_CHECK(regressions == 0, "%llu 次帧号未递增", regressions);
+    WV_CHECK(consumed > 0 && overwritten > 0, "慢速消费者应当既取到帧又有帧被覆盖");
+    WV_CHECK(published == consumed + overwritten, "发布 %llu != 消费 %llu + 覆盖 %llu",
+             published, consumed, overwritten);
+}
+
+// 生产者写满 back 槽位并发布；resize 为 true 时每 kResizeEveryFrames 帧在两种尺寸间切换一代
+static void RunFrameRing(bool resize) {
+    char name[64];
+    snprintf(name, sizeof(name), "wv_test_ring_%d_%d", static_cast<int>(getpid()), resize ? 1 : 0);
+    const uint32_t sizes[2][2] = { { 64, 48 }, { 96, 64 } };
+
+    WVFrameRing* ring = WVFrameRing::Create(name, sizes[0][0], sizes[0][1], sizes[0][0] * 4, sizes[0][1],
+                                            0x32335652u /* RV32 */);
+    WV_CHECK(ring != NULL, "无法创建帧环 %s", name);
+    if (!ring) return;
+    WVFrameRing* reader = WVFrameRing::Open(name);
+    WV_CHECK(reader != NULL, "无法打开帧环 %s", name);
+    if (!reader) {
+        delete ring;
+        return;
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned long long> resizes(0);
+    std::thread producer([&] {
+        unsigned long long frame = 0;
+        int current = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (resize && frame > 0 && frame % kResizeEveryFrames == 0) {
+                current = 1 - current;
+                if (ring->Resize(sizes[current][0], sizes[current][1], sizes[current][0] * 4,
+                                 sizes[current][1], 0x32335652u)) {
+                    resizes.fetch_add(1);
+                }
+            }
+            ++frame;
+            WVFrameRingHeader* header = ring->Header();
+            uint32_t* pixels = reinterpret_cast<uint32_t*>(ring->BackBuffer());
+            size_t count = static_cast<size_t>(header->pitch / 4) * header->height;
+            for (size_t i = 0; i < count; ++i) pixels[i] = static_cast<uint32_t>(frame);
+            ring->Publish(0);
+        }
+    });
+
+    unsigned long long consumed = 0;
+    unsigned long long torn = 0;
+    unsigned long long regressions = 0;
+    unsigned long long follows = 0;
+    unsigned long long lastFrame = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (WVTestElapsedMs(start) < kRunMs) {
+        if (reader->Follow()) ++follows;
+        bool fresh = false;
+        int slot = reader->Acquire(&fresh);
+        if (slot < 0 || !fresh) continue;
+        ++consumed;
+
+        WVFrameRingHeader* header = reader->Header();
+        unsigned long long frame = header->slots[slot].frameNumber;
+        const uint32_t* pixels = reinterpret_cast<const uint32_t*>(reader->SlotData(static_cast<uint32_t>(slot)));
+        size_t count = static_cast<size_t>(header->pitch / 4) * header->height;
+        if (frame <= lastFrame) ++regressions;
+        lastFrame = frame;
+        if (!FrameIntact(pixels, count, static_cast<uint32_t>(frame))) ++torn;
+        std::this_thread::sleep_for(std::chrono::microseconds(kConsumerHoldUs));
+        if (!FrameIntact(pixels, count, static_cast<uint32_t>(frame))) ++torn;
+    }
+    stop.store(true);
+    producer.join();
+
+    // 生产者停止后跟随到最后一代并取走最后一帧，这一代的计数应当平衡
+    reader->Follow();
+    bool fresh = false;
+    reader->Acquire(&fresh);
+    WVFrameRingHeader* header = reader->Header();
+    unsigned long long published = header->framesPublished.load();
+    unsigned long long overwritten = header->framesOverwritten.load();
+    unsigned long long ringConsumed = header->framesConsumed.load();
+
+    printf("帧环%s：读取 %llu 帧，切换 %llu 代（跟随 %llu 次）；最后一代 发布 %llu，消费 %llu，覆盖 %llu\n",
+           resize ? "（切换尺寸）" : "", consumed, resizes.load(), follows, published, ringConsumed, overwritten);
+    WV_CHECK(torn == 0, "%llu 帧撕裂", torn);
+    WV_CHECK(regressions == 0, "%llu 次帧号未递增", regressions);
+    WV_CHECK(consumed > 0, "没有读到帧");
+    WV_CHECK(published == ringConsumed + overwritten, "发布 %llu != 消费 %llu + 覆盖 %llu",
+             published, ringConsumed, overwritten);
+    if (resize) {
+        WV_CHECK(resizes.load() > 0 && follows > 0, "没有发生尺寸切换");
+        WV_CHECK(header->generation == ring->Generation(), "读取方停留在第 %u 代，生产者为第 %u 代",
+                 header->generation, ring->Generation());
+    } else {
+        WV_CHECK(overwritten > 0, "慢速消费者应当有帧被覆盖");
+    }
+
+    delete reader;
+    delete ring;
+}
+
+int main() {
+    TestTripleBuffer();
+    RunFrameRing(false);
+    RunFrameRing(true);
+    return WVTestResult();
+}
@@ -0,0 +1,90 @@
+//
+//  WVFrameSmokeTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 帧回调模式冒烟测试：只通过公共 API 创建帧回调播放器、播放本地文件，
+// 从帧环读取到第一帧后释放。不创建任何窗口，可在没有显示环境的机器上运行。
+// 用法：WVFrameSmokeTest <本地媒体文件>（也可用环境变量 WV_SMOKE_MEDIA 指定）
+
+#include "WinVLCBridge.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+static const int kSkip = 77;              // ctest SKIP_RETURN_CODE
+static const int kFirstFrameTimeoutMs = 20000;
+
+int main(int argc, char** argv) {
+    const char* media = argc > 1 && argv[1][0] ? argv[1] : getenv("WV_SMOKE_MEDIA");
+    if (!media || !*media) {
+        printf("跳过：未指定媒体文件（参数或 WV_SMOKE_MEDIA）\n");
+        return kSkip;
+    }
+
+    wv_set_log_level(WV_LOG_LEVEL_WARNING);
+
+    char name[64];
+    snprintf(name, sizeof(name), "wv_smoke_%d", static_cast<int>(getpid()));
+
+    void* player = wv_create_frame_player(name, 320, 240);
+    if (!player) {
+        fprintf(stderr, "失败：无法创建帧回调播放器\n");
+        return 1;
+    }
+
+    unsigned long long playId = wv_player_play(player, media);
+    if (playId == 0) {
+        fprintf(stderr, "失败：播放命令未入队\n");
+        wv_player_release(player);
+        return 1;
+    }
+
+    // 轮询帧环直到收到第一帧
+    int result = 1;
+    void* ring = NULL;
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(kFirstFrameTimeoutMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (!ring) ring = wv_frame_ring_open(name);
+        if (ring) {
+            unsigned long long frameNumber = 0;
+            unsigned long long dataOffset = 0;
+            int status = wv_frame_ring_acquire(ring, &frameNumber, &dataOffset);
+            if ((status == 1 || status == 2) && frameNumber > 0) {
+                unsigned long long size = 0;
+                int width = 0, height = 0, pitch = 0, slots = 0;
+                void* base = wv_frame_ring_get_info(ring, &size, &width, &height, &pitch, &slots);
+                if (base && width > 0 && height > 0 && pitch >= width * 4 && dataOffset < size) {
+                    printf("通过：第 %llu 帧 %dx%d（pitch %d，%d 个槽）\n",
+                           frameNumber, width, height, pitch, slots);
+                    result = 0;
+                } else {
+                    fprintf(stderr, "失败：帧环信息无效 %dx%d pitch=%d\n", width, height, pitch);
+                }
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (result != 0 && std::chrono::steady_clock::now() >= deadline) {
+        fprintf(stderr, "失败：%d ms 内没有收到帧（播放命令状态 %d）\n",
+                kFirstFrameTimeoutMs, wv_command_status(playId));
+    }
+
+    if (ring) wv_frame_ring_close(ring);
+    wv_player_release(player);
+    wv_log_flush(1000);
+    return result;
+}
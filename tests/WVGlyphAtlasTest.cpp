@@ -0,0 +1,94 @@
+//
+//  WVGlyphAtlasTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 标签缓存：同一文本返回同一份位图；合成好的底框与"先填充底色再混合文字蒙版"逐字节一致；
+// 大量不同文本（图集清空重建）后已持有的标签不变。没有字体后端时跳过。
+
+#include "WVGlyphAtlas.h"
+#include "WVOverlayRaster.h"
+#include "WVTestSupport.h"
+
+#include <string.h>
+
+WV_TEST_MAIN_STATE;
+
+static const int kSkip = 77;              // ctest SKIP_RETURN_CODE
+
+static void CheckTagMatchesBlend(const std::string& text, int pixelSize, int padding, uint32_t background,
+                                 uint32_t color) {
+    std::shared_ptr<const WVLabelBitmap> label = WVGlyphAtlas::Label(text, pixelSize);
+    std::shared_ptr<const WVLabelTag> tag = WVGlyphAtlas::Tag(text, pixelSize, padding, background, color);
+    WV_CHECK(label && tag, "\"%s\" %d px 没有结果", text.c_str(), pixelSize);
+    if (!label || !tag) {
+        return;
+    }
+    WV_CHECK(tag->width == label->width + padding * 2 && tag->height == label->height + padding * 2,
+             "\"%s\" 底框尺寸 %dx%d，文字 %dx%d，内边距 %d", text.c_str(), tag->width, tag->height,
+             label->width, label->height, padding);
+    if (tag->width != label->width + padding * 2 || tag->height != label->height + padding * 2) {
+        return;
+    }
+
+    std::vector<uint32_t> expected(static_cast<size_t>(tag->width) * tag->height, 0);
+    WVOverlaySurface surface = { reinterpret_cast<uint8_t*>(&expected[0]), tag->width, tag->height, tag->width * 4 };
+    WVOverlayFillRect(surface, 0, 0, tag->width, tag->height, background);
+    if (!label->coverage.empty()) {
+        WVOverlayBlendMask(surface, padding, padding, &label->coverage[0], label->width, label->width,
+                           label->height, color);
+    }
+    WV_CHECK(memcmp(&expected[0], &tag->pixels[0], expected.size() * 4) == 0,
+             "\"%s\" %d px 底框 0x%08X 文字 0x%08X 与填充加混合的结果不一致", text.c_str(), pixelSize,
+             background, color);
+}
+
+int main() {
+    if (!WVGlyphAtlas::Label("A", 14)) {
+        printf("字体不可用，跳过\n");
+        return kSkip;
+    }
+
+    // 缓存命中返回同一份位图，不同字号、颜色各自缓存
+    std::shared_ptr<const WVLabelBitmap> first = WVGlyphAtlas::Label("person 0.42", 14);
+    WV_CHECK(first && first == WVGlyphAtlas::Label("person 0.42", 14), "同一文本没有命中缓存");
+    WV_CHECK(first != WVGlyphAtlas::Label("person 0.42", 20), "不同字号共用了位图");
+    const uint32_t green = WVOverlayPackColorARGB(0xFF00FF00u);
+    const uint32_t black = WVOverlayPackColorARGB(0xFF000000u);
+    std::shared_ptr<const WVLabelTag> tag = WVGlyphAtlas::Tag("person 0.42", 14, 2, green, black);
+    WV_CHECK(tag && tag == WVGlyphAtlas::Tag("person 0.42", 14, 2, green, black), "同一底框没有命中缓存");
+    WV_CHECK(tag != WVGlyphAtlas::Tag("person 0.42", 14, 2, green, WVOverlayPackColorARGB(0xFFFFFFFFu)),
+             "不同文字颜色共用了底框");
+
+    // 不满足条件时返回空指针
+    WV_CHECK(!WVGlyphAtlas::Label("", 14), "空文本返回了位图");
+    WV_CHECK(!WVGlyphAtlas::Tag("car", 14, 2, WVOverlayPackColorARGB(0x8000FF00u), black), "半透明底色返回了底框");
+
+    // 底框与填充加混合逐字节一致（含中文、半透明文字、只有底色）
+    static const char* texts[] = { "person 0.42", "car 0.97", "行人 0.63", "车辆 1.00", "Wg|y", "?" };
+    static const int sizes[] = { 6, 11, 14, 24, 96 };
+    static const uint32_t colors[] = { 0xFF000000u, 0xFFFFFFFFu, 0x80FF0000u, 0x00000000u };
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); ++t) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+            for (size_t c = 0; c < sizeof(colors) / sizeof(colors[0]); ++c) {
+                CheckTagMatchesBlend(texts[t], sizes[s], static_cast<int>(s % 3),
+                                     WVOverlayPackColorARGB(0xFF2080C0u), WVOverlayPackColorARGB(colors[c]));
+            }
+        }
+    }
+
+    // 大量不同文本填满图集后，之前取得的标签内容不变，重新取得的结果与之一致
+    std::vector<uint8_t> snapshot = first->coverage;
+    for (int i = 0; i < 20000; ++i) {
+        char text[32];
+        snprintf(text, sizeof(text), "%d %c", i, 'A' + i % 26);
+        WVGlyphAtlas::Label(text, 10 + i % 40);
+    }
+    WV_CHECK(first->coverage == snapshot, "图集重建后已持有的标签被修改");
+    std::shared_ptr<const WVLabelBitmap> again = WVGlyphAtlas::Label("person 0.42", 14);
+    WV_CHECK(again && again->width == first->width && again->coverage == snapshot, "图集重建后同一文本的结果不同");
+
+    return WVTestResult();
+}
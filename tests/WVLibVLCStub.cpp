@@ -0,0 +1,131 @@
+//
+//  WVLibVLCStub.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#include "WVLibVLCStub.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+struct StubState {
+    std::mutex mutex;
+    int stopDelayMs;
+    WVLibVLCStubCounters counters;
+};
+
+StubState& State() {
+    static StubState* state = new StubState();
+    return *state;
+}
+
+} // namespace
+
+// libVLC 的句柄类型只有前向声明，桩以自己的对象代替
+struct libvlc_instance_t {
+    int refs;
+};
+
+struct libvlc_media_player_t {
+    libvlc_instance_t* instance;
+    bool playing;
+    bool paused;
+};
+
+void WVLibVLCStubSetStopDelay(int delayMs) {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.stopDelayMs = delayMs;
+}
+
+WVLibVLCStubCounters WVLibVLCStubGetCounters() {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.counters;
+}
+
+void WVLibVLCStubReset() {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.stopDelayMs = 0;
+    state.counters = WVLibVLCStubCounters();
+}
+
+extern "C" {
+
+libvlc_instance_t* libvlc_new(int, const char* const*) {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ++state.counters.liveInstances;
+    libvlc_instance_t* instance = new libvlc_instance_t();
+    instance->refs = 1;
+    return instance;
+}
+
+void libvlc_release(libvlc_instance_t* instance) {
+    if (!instance) return;
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (--instance->refs == 0) {
+        --state.counters.liveInstances;
+        delete instance;
+    }
+}
+
+libvlc_media_player_t* libvlc_media_player_new(libvlc_instance_t* instance) {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ++state.counters.livePlayers;
+    libvlc_media_player_t* player = new libvlc_media_player_t();
+    player->instance = instance;
+    return player;
+}
+
+void libvlc_media_player_release(libvlc_media_player_t* player) {
+    if (!player) return;
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    --state.counters.livePlayers;
+    delete player;
+}
+
+int libvlc_media_player_play(libvlc_media_player_t* player) {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ++state.counters.plays;
+    player->playing = true;
+    player->paused = false;
+    return 0;
+}
+
+void libvlc_media_player_set_pause(libvlc_media_player_t* player, int doPause) {
+    StubState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ++state.counters.pauses;
+    player->paused = doPause != 0;
+}
+
+void libvlc_media_player_stop(libvlc_media_player_t* player) {
+    StubState& state = State();
+    int delayMs;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        delayMs = state.stopDelayMs;
+        state.counters.stopRunning = true;
+    }
+    // 与真实实现一样在调用线程上等待（不持有桩的锁）
+    if (delayMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+    }
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ++state.counters.stops;
+    state.counters.stopRunning = false;
+    player->playing = false;
+    player->paused = false;
+}
+
+} // extern "C"
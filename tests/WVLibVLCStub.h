@@ -0,0 +1,35 @@
+//
+//  WVLibVLCStub.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_LIBVLC_STUB_H
+#define WV_LIBVLC_STUB_H
+
+#include "WVLibVLC.h"
+
+// ==================== 测试用 libVLC 桩 ====================
+//
+// 以 libVLC 的函数签名实现最小的播放器生命周期（实例、播放器、播放、暂停、停止），
+// 不解码也不输出。停止可以设置延迟，模拟真实 libvlc_media_player_stop 等待解码与
+// 输出线程退出时阻塞数百毫秒的情况。所有函数线程安全。
+
+struct WVLibVLCStubCounters {
+    int plays;
+    int pauses;
+    int stops;
+    int liveInstances;
+    int livePlayers;
+    bool stopRunning;          // 有线程正在 libvlc_media_player_stop 中等待
+};
+
+// 设置之后每次 libvlc_media_player_stop 阻塞的时长
+void WVLibVLCStubSetStopDelay(int delayMs);
+
+WVLibVLCStubCounters WVLibVLCStubGetCounters();
+
+void WVLibVLCStubReset();
+
+#endif // WV_LIBVLC_STUB_H
@@ -0,0 +1,150 @@
+//
+//  WVOverlayBlendParityTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 覆盖层混合一致性测试：纯色填充、覆盖率蒙版与整组矩形合成，在各种宽度 / 偏移 / 透明度下，
+// SSE2 与 AVX2 的结果必须与标量版本逐字节一致，且不写出表面（行尾保护字节不变）。
+
+#include "WVOverlayRaster.h"
+#include "WVTestSupport.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static const int kWidth = 157;          // 奇数宽度，覆盖各种 SIMD 行尾
+static const int kHeight = 61;
+static const int kPaddingBytes = 36;
+static const uint8_t kCanary = 0x5A;
+
+struct Canvas {
+    std::vector<uint8_t> bytes;
+    WVOverlaySurface surface;
+};
+
+// 随机预乘背景（模拟覆盖层窗口的半透明 DIB 与不透明视频帧两种情况）
+static void MakeCanvas(Canvas* canvas, unsigned seed, bool opaque) {
+    int stride = kWidth * 4 + kPaddingBytes;
+    canvas->bytes.assign(static_cast<size_t>(stride) * kHeight, kCanary);
+    srand(seed);
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            uint8_t* p = &canvas->bytes[y * stride + x * 4];
+            int a = opaque ? 255 : rand() & 255;
+            p[0] = static_cast<uint8_t>((rand() & 255) * a / 255);
+            p[1] = static_cast<uint8_t>((rand() & 255) * a / 255);
+            p[2] = static_cast<uint8_t>((rand() & 255) * a / 255);
+            p[3] = static_cast<uint8_t>(a);
+        }
+    }
+    canvas->surface.pixels = &canvas->bytes[0];
+    canvas->surface.width = kWidth;
+    canvas->surface.height = kHeight;
+    canvas->surface.stride = stride;
+}
+
+static bool PaddingIntact(const Canvas& canvas) {
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = kWidth * 4; x < canvas.surface.stride; ++x) {
+            if (canvas.bytes[y * canvas.surface.stride + x] != kCanary) return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t RandomColor() {
+    static const int alphas[] = { 0, 1, 64, 127, 128, 200, 254, 255 };
+    int a = rand() % 3 == 0 ? alphas[rand() % 8] : rand() & 255;
+    return WVOverlayPackColorARGB((static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(rand()) & 0xFFFFFFu));
+}
+
+// 对每个实现执行 draw，并与标量结果比较
+template <typename Draw>
+static void Compare(const char* what, unsigned seed, bool opaque, Draw draw) {
+    WVColorKernel cpu = WVColorCpuKernel();
+    Canvas reference;
+    MakeCanvas(&reference, seed, opaque);
+    WVOverlayBlendSetKernel(WVColorKernelScalar);
+    srand(seed * 7 + 1);
+    draw(reference.surface);
+    WV_CHECK(PaddingIntact(reference), "标量 %s（种子 %u）写出了表面", what, seed);
+
+    for (int kernel = WVColorKernelSSE2; kernel <= cpu; ++kernel) {
+        Canvas canvas;
+        MakeCanvas(&canvas, seed, opaque);
+        WVOverlayBlendSetKernel(static_cast<WVColorKernel>(kernel));
+        srand(seed * 7 + 1);
+        draw(canvas.surface);
+        const char* name = WVColorKernelName(static_cast<WVColorKernel>(kernel));
+        WV_CHECK(canvas.bytes == reference.bytes, "%s %s（种子 %u，%s背景）与标量结果不一致", name, what, seed,
+                 opaque ? "不透明" : "半透明");
+    }
+    WVOverlayBlendSetKernel(cpu);
+}
+
+int main() {
+    printf("CPU 支持的最高实现：%s\n", WVColorKernelName(WVColorCpuKernel()));
+    int cases = 0;
+    for (unsigned seed = 1; seed <= 40; ++seed) {
+        for (int opaque = 0; opaque < 2; ++opaque) {
+            Compare("FillRect", seed, opaque != 0, [](const WVOverlaySurface& surface) {
+                for (int i = 0; i < 20; ++i) {
+                    int x0 = rand() % (kWidth + 20) - 10;
+                    int y0 = rand() % (kHeight + 20) - 10;
+                    WVOverlayFillRect(surface, x0, y0, x0 + rand() % 80, y0 + rand() % 30, RandomColor());
+                }
+            });
+            Compare("BlendMask", seed, opaque != 0, [](const WVOverlaySurface& surface) {
+                for (int i = 0; i < 10; ++i) {
+                    int w = 1 + rand() % 90;
+                    int h = 1 + rand() % 25;
+                    std::vector<uint8_t> mask(w * h);
+                    for (size_t m = 0; m < mask.size(); ++m) {
+                        int r = rand();
+                        mask[m] = (r & 3) == 0 ? 0 : (r & 3) == 1 ? 255 : static_cast<uint8_t>(r >> 3);
+                    }
+                    WVOverlayBlendMask(surface, rand() % (kWidth + 20) - 10, rand() % (kHeight + 20) - 10,
+                                       &mask[0], w, w, h, RandomColor());
+                }
+            });
+            Compare("RenderShapes", seed, opaque != 0, [](const WVOverlaySurface& surface) {
+                std::vector<WVOverlayShape> shapes;
+                for (int i = 0; i < 30; ++i) {
+                    WVOverlayShape shape = WVOverlayShape();
+                    shape.id = static_cast<uint32_t>(i + 1);
+                    shape.kind = WVOverlayShapeRect;
+                    shape.x = (rand() % 2000) / 10.0f - 20.0f;
+                    shape.y = (rand() % 800) / 10.0f - 10.0f;
+                    shape.width = (rand() % 1200) / 10.0f;
+                    shape.height = (rand() % 600) / 10.0f;
+                    shape.lineWidth = (rand() % 60) / 10.0f;
+                    shape.strokeColor = RandomColor();
+                    shape.fillColor = rand() % 2 ? RandomColor() : 0;
+                    shapes.push_back(shape);
+                }
+                // 极端坐标按表面裁剪
+                WVOverlayShape huge = WVOverlayShape();
+                huge.id = 1000;
+                huge.x = -1e9f;
+                huge.y = -1e9f;
+                huge.width = 2e9f;
+                huge.height = 2e9f;
+                huge.lineWidth = 4.0f;
+                huge.strokeColor = RandomColor();
+                shapes.push_back(huge);
+                WVOverlayShape invalid = huge;
+                invalid.id = 1001;
+                invalid.x = NAN;
+                shapes.push_back(invalid);
+                WVOverlayRenderShapes(surface, shapes, 1.25f, 1.25f, 0, 0, kWidth, kHeight);
+            });
+            cases += 3;
+        }
+    }
+    printf("比较了 %d 组\n", cases);
+    return WVTestResult();
+}
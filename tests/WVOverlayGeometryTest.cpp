@@ -0,0 +1,253 @@
+//
+//  WVOverlayGeometryTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 多边形与蒙版：光栅化面积与解析面积一致（奇偶 / 非零规则、描边），
+// 蒙版缩放后面积按比例保持，局部（分块）重绘与整体重绘逐字节一致。
+
+#include "WVOverlayGeometry.h"
+#include "WVOverlayRaster.h"
+#include "WVTestSupport.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+WV_TEST_MAIN_STATE;
+
+typedef std::vector<WVOverlayPoint> Contour;
+
+static const double kPi = 3.14159265358979323846;
+
+static Contour Box(float x0, float y0, float x1, float y1, bool clockwise) {
+    WVOverlayPoint corners[4] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+    Contour contour(corners, corners + 4);
+    if (!clockwise) {
+        std::reverse(contour.begin(), contour.end());
+    }
+    return contour;
+}
+
+static double ShoelaceArea(const Contour& contour) {
+    double sum = 0.0;
+    for (size_t i = 0; i < contour.size(); ++i) {
+        const WVOverlayPoint& a = contour[i];
+        const WVOverlayPoint& b = contour[(i + 1) % contour.size()];
+        sum += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+    }
+    return fabs(sum) / 2.0;
+}
+
+static double CoverageArea(const WVCoverageBitmap& bitmap) {
+    double sum = 0.0;
+    for (size_t i = 0; i < bitmap.coverage.size(); ++i) {
+        sum += bitmap.coverage[i];
+    }
+    return sum / 255.0;
+}
+
+// 光栅化面积与期望面积的误差不超过 tolerance（像素）
+static void CheckArea(const char* name, const std::vector<Contour>& contours, bool nonZero, double expected,
+                      double tolerance) {
+    WVCoverageBitmap bitmap;
+    bool drawn = WVRasterizeContours(contours, nonZero, 4096, 4096, &bitmap);
+    double area = drawn ? CoverageArea(bitmap) : 0.0;
+    WV_CHECK(fabs(area - expected) <= tolerance, "%s（%s）面积 %.2f，期望 %.2f（容差 %.2f）", name,
+             nonZero ? "非零" : "奇偶", area, expected, tolerance);
+}
+
+static void TestPolygonArea() {
+    // 对齐与不对齐像素的矩形：水平方向精确，竖直方向 4 条子扫描线
+    std::vector<Contour> contours(1, Box(10.0f, 10.0f, 90.0f, 60.0f, true));
+    CheckArea("对齐矩形", contours, true, 4000.0, 0.5);
+    contours[0] = Box(10.25f, 10.5f, 90.3f, 60.75f, false);
+    CheckArea("亚像素矩形", contours, false, 80.05 * 50.25, 80.05 * 0.25);
+
+    // 正 96 边形（接近圆）与三角形：与鞋带公式一致
+    Contour circle;
+    for (int i = 0; i < 96; ++i) {
+        WVOverlayPoint point = { static_cast<float>(200.0 + 150.3 * cos(2.0 * kPi * i / 96)),
+                                 static_cast<float>(180.0 + 150.3 * sin(2.0 * kPi * i / 96)) };
+        circle.push_back(point);
+    }
+    contours.assign(1, circle);
+    CheckArea("96 边形", contours, true, ShoelaceArea(circle), 2.0 * kPi * 150.3 * 0.02);
+    WVOverlayPoint triangle[3] = { { 5.3f, 300.7f }, { 400.1f, 20.2f }, { 250.6f, 390.4f } };
+    contours.assign(1, Contour(triangle, triangle + 3));
+    CheckArea("三角形", contours, false, ShoelaceArea(contours[0]), 3.0);
+
+    // 两个部分重叠的正方形：同向时非零为并集、奇偶为并集减交集；反向时两种规则都去掉交集
+    contours.clear();
+    contours.push_back(Box(10.0f, 10.0f, 50.0f, 50.0f, true));
+    contours.push_back(Box(30.0f, 30.0f, 70.0f, 70.0f, true));
+    CheckArea("同向重叠", contours, true, 2800.0, 0.5);
+    CheckArea("同向重叠", contours, false, 2400.0, 0.5);
+    contours[1] = Box(30.0f, 30.0f, 70.0f, 70.0f, false);
+    CheckArea("反向重叠", contours, true, 2400.0, 0.5);
+    CheckArea("反向重叠", contours, false, 2400.0, 0.5);
+
+    // 五角星（自相交）：非零包含中心五边形，奇偶不包含
+    Contour star;
+    for (int i = 0; i < 5; ++i) {
+        double angle = -kPi / 2 + 2.0 * kPi * (i * 2 % 5) / 5;
+        WVOverlayPoint point = { static_cast<float>(300.0 + 200.0 * cos(angle)),
+                                 static_cast<float>(300.0 + 200.0 * sin(angle)) };
+        star.push_back(point);
+    }
+    // 内五边形的外接圆半径为 R * cos(72°) / cos(36°)
+    double innerRadius = 200.0 * cos(2.0 * kPi / 5) / cos(kPi / 5);
+    double pentagon = 2.5 * innerRadius * innerRadius * sin(2.0 * kPi / 5);
+    double tips = 5.0 * 0.5 * innerRadius * 2.0 * sin(kPi / 5) * (200.0 - innerRadius * cos(kPi / 5));
+    // 尖角处竖直方向的子扫描线误差不能相互抵消，容差按轮廓长度（约 1470 像素）的 1% 计
+    contours.assign(1, star);
+    CheckArea("五角星", contours, true, pentagon + tips, 15.0);
+    CheckArea("五角星", contours, false, tips, 15.0);
+
+    // 描边：以边为中心，面积约为 周长 * 线宽（转角的八边形连接略小于直角）
+    std::vector<Contour> stroke;
+    WVStrokeContours(Box(100.0f, 100.0f, 300.0f, 250.0f, true), 6.0f, &stroke);
+    double outer = 206.0 * 156.0, inner = 194.0 * 144.0;
+    CheckArea("描边", stroke, true, outer - inner, (outer - inner) * 0.01);
+
+    // 完全在裁剪区域外
+    WVCoverageBitmap bitmap;
+    contours.assign(1, Box(-50.0f, -50.0f, -10.0f, -10.0f, true));
+    WV_CHECK(!WVRasterizeContours(contours, true, 100, 100, &bitmap), "裁剪区域外的多边形返回了结果");
+}
+
+static void TestMaskScaling() {
+    // 64x48 蒙版：每行中间 20 个像素为 1
+    const int width = 64, height = 48;
+    std::vector<uint32_t> runs;
+    for (int row = 0; row < height; ++row) {
+        runs.push_back(row == 0 ? 22 : 44);
+        runs.push_back(20);
+    }
+    std::shared_ptr<const WVOverlayGeometry> mask = WVOverlayGeometry::CreateMask(width, height, &runs[0], runs.size());
+    WV_CHECK(mask && mask->IsMask(), "蒙版创建失败");
+    if (!mask) return;
+
+    static const float scales[][2] = { { 1.0f, 1.0f }, { 2.5f, 2.5f }, { 0.37f, 0.41f }, { 3.3f, 0.6f } };
+    for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]); ++i) {
+        // 外框对齐像素时面积按比例精确保持
+        float boxWidth = floorf(width * scales[i][0]), boxHeight = floorf(height * scales[i][1]);
+        std::shared_ptr<const WVCoverageBitmap> bitmap =
+            mask->RenderFill(17.0f, 9.0f, boxWidth, boxHeight, true, 1920, 1080);
+        double expected = 20.0 * height * (boxWidth / width) * (boxHeight / height);
+        double area = bitmap ? CoverageArea(*bitmap) : 0.0;
+        WV_CHECK(fabs(area - expected) <= expected * 0.01 + 1.0, "缩放 %.2fx%.2f 面积 %.2f，期望 %.2f",
+                 scales[i][0], scales[i][1], area, expected);
+    }
+
+    // 全 1 蒙版放大后内部完全覆盖
+    uint32_t full[2] = { 0, width * height };
+    std::shared_ptr<const WVOverlayGeometry> solid = WVOverlayGeometry::CreateMask(width, height, full, 2);
+    std::shared_ptr<const WVCoverageBitmap> bitmap = solid->RenderFill(10.0f, 10.0f, 200.0f, 150.0f, true, 1920, 1080);
+    WV_CHECK(bitmap && CoverageArea(*bitmap) == 200.0 * 150.0, "全 1 蒙版面积 %.2f",
+             bitmap ? CoverageArea(*bitmap) : 0.0);
+
+    // 游程总长超出尺寸时拒绝
+    uint32_t overflow[2] = { 10, width * height };
+    WV_CHECK(!WVOverlayGeometry::CreateMask(width, height, overflow, 2), "超长游程没有被拒绝");
+}
+
+// 场景：多边形（半透明填充与描边）、蒙版、矩形，互相重叠；每次调用创建新的几何对象（空缓存）
+static std::vector<WVOverlayShape> BuildScene() {
+    std::vector<WVOverlayShape> shapes;
+    srand(3);
+    for (int i = 0; i < 12; ++i) {
+        float coordinates[14];
+        float cx = static_cast<float>(40 + rand() % 560), cy = static_cast<float>(40 + rand() % 400);
+        for (int p = 0; p < 7; ++p) {
+            float radius = static_cast<float>(20 + rand() % 90) + 0.37f;
+            coordinates[p * 2] = cx + radius * static_cast<float>(cos(2.0 * kPi * p * 3 / 7));
+            coordinates[p * 2 + 1] = cy + radius * static_cast<float>(sin(2.0 * kPi * p * 3 / 7));
+        }
+        WVOverlayShape shape = WVOverlayShape();
+        shape.id = static_cast<uint32_t>(i + 1);
+        shape.kind = WVOverlayShapePolygon;
+        shape.geometry = WVOverlayGeometry::CreatePolygon(coordinates, 7, &shape.x, &shape.y, &shape.width,
+                                                          &shape.height);
+        shape.lineWidth = 1.5f + i % 4;
+        shape.strokeColor = WVOverlayPackColorARGB(i % 2 ? 0xC0FF4000u : 0xFF00FF00u);
+        shape.fillColor = WVOverlayPackColorARGB(0x60000000u | (rand() & 0xFFFFFF));
+        shape.fillRule = i % 2 ? WVOverlayFillNonZero : WVOverlayFillEvenOdd;
+        shapes.push_back(shape);
+    }
+    std::vector<uint32_t> runs;
+    for (int row = 0; row < 40; ++row) {
+        runs.push_back(static_cast<uint32_t>(row % 7 + 3));
+        runs.push_back(static_cast<uint32_t>(20 + row % 11));
+        runs.push_back(static_cast<uint32_t>(64 - (row % 7 + 3) - (20 + row % 11)));
+        runs.push_back(0);
+    }
+    for (int i = 0; i < 4; ++i) {
+        WVOverlayShape shape = WVOverlayShape();
+        shape.id = static_cast<uint32_t>(100 + i);
+        shape.kind = WVOverlayShapeMask;
+        shape.geometry = WVOverlayGeometry::CreateMask(64, 40, &runs[0], runs.size());
+        shape.x = 33.3f + i * 131.7f;
+        shape.y = 57.1f + i * 71.9f;
+        shape.width = 97.0f + i * 23.4f;
+        shape.height = 61.0f + i * 17.2f;
+        shape.fillColor = WVOverlayPackColorARGB(0x9000A0FFu);
+        shapes.push_back(shape);
+    }
+    WVOverlayShape rect = WVOverlayShape();
+    rect.id = 200;
+    rect.kind = WVOverlayShapeRect;
+    rect.x = 101.5f;
+    rect.y = 88.25f;
+    rect.width = 300.0f;
+    rect.height = 200.0f;
+    rect.lineWidth = 3.0f;
+    rect.strokeColor = WVOverlayPackColorARGB(0xFFFF0000u);
+    rect.fillColor = WVOverlayPackColorARGB(0x3000FF00u);
+    shapes.push_back(rect);
+    return shapes;
+}
+
+static void RenderTiled(const WVOverlaySurface& surface, const std::vector<WVOverlayShape>& shapes, float scale,
+                        int tile) {
+    for (int y = 0; y < surface.height; y += tile) {
+        for (int x = 0; x < surface.width; x += tile) {
+            int x1 = std::min(surface.width, x + tile), y1 = std::min(surface.height, y + tile);
+            WVOverlaySurface sub = WVOverlaySubSurface(surface, x, y, x1, y1);
+            WVOverlayRenderShapes(sub, shapes, scale, scale, x, y, surface.width, surface.height);
+        }
+    }
+}
+
+static void TestTiledRedraw() {
+    const int width = 960, height = 720;
+    static const float scales[] = { 1.0f, 1.5f };
+    static const int tiles[] = { 64, 37 };
+    for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); ++s) {
+        for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); ++t) {
+            std::vector<uint8_t> full(width * height * 4, 0), tiled(width * height * 4, 0);
+            WVOverlaySurface fullSurface = { &full[0], width, height, width * 4 };
+            WVOverlaySurface tiledSurface = { &tiled[0], width, height, width * 4 };
+
+            // 先分块（缓存为空）再整体，之后用同一份缓存再分块一次
+            std::vector<WVOverlayShape> shapes = BuildScene();
+            RenderTiled(tiledSurface, shapes, scales[s], tiles[t]);
+            WVOverlayRenderShapes(fullSurface, BuildScene(), scales[s], scales[s], 0, 0, width, height);
+            WV_CHECK(full == tiled, "缩放 %.1f、%d 像素分块与整体重绘不一致（空缓存）", scales[s], tiles[t]);
+
+            std::fill(tiled.begin(), tiled.end(), 0);
+            RenderTiled(tiledSurface, shapes, scales[s], tiles[t]);
+            WV_CHECK(full == tiled, "缩放 %.1f、%d 像素分块与整体重绘不一致（命中缓存）", scales[s], tiles[t]);
+        }
+    }
+}
+
+int main() {
+    TestPolygonArea();
+    TestMaskScaling();
+    TestTiledRedraw();
+    return WVTestResult();
+}
@@ -0,0 +1,168 @@
+//
+//  WVOverlayTimelineTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 覆盖层时间线测试：媒体时间由测试直接给出（相当于假时钟），检查条目按媒体时间呈现、
+// 容差与时钟偏移、过期清空、条目数上限，以及线性插值与恒速外推的结果。
+
+#include "WVOverlayTimeline.h"
+#include "WVTestSupport.h"
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+// 一条 ADD 命令：ID 为 id 的矩形，x 编码了它所属条目的时间
+static void AppendAdd(std::vector<uint8_t>* buffer, uint32_t id, float x, float y) {
+    uint32_t words[8];
+    float w = 40.0f, h = 30.0f, lineWidth = 2.0f;
+    words[0] = 1;   // ADD
+    words[1] = id;
+    memcpy(&words[2], &x, 4);
+    memcpy(&words[3], &y, 4);
+    memcpy(&words[4], &w, 4);
+    memcpy(&words[5], &h, 4);
+    memcpy(&words[6], &lineWidth, 4);
+    words[7] = 0xFF00FF00u;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(words);
+    buffer->insert(buffer->end(), bytes, bytes + sizeof(words));
+}
+
+static void SubmitBox(WVOverlayTimeline* timeline, int64_t mediaTimeMs, float x) {
+    std::vector<uint8_t> commands;
+    AppendAdd(&commands, 1, x, 10.0f);
+    timeline->Submit(mediaTimeMs, &commands[0], commands.size());
+}
+
+// 场景中 ID 1 的 x 坐标，没有图形时返回 -1
+static float PresentedX(const WVOverlayScene& scene) {
+    std::vector<WVOverlayShape> shapes;
+    scene.Shapes(&shapes);
+    return shapes.empty() ? -1.0f : shapes[0].x;
+}
+
+static void TestPresentsMatchingEntry() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(20, 500, 0);
+    SubmitBox(&timeline, 100, 100.0f);
+    SubmitBox(&timeline, 200, 200.0f);
+    SubmitBox(&timeline, 300, 300.0f);
+
+    timeline.Present(50, &scene);
+    WV_CHECK(PresentedX(scene) < 0, "条目时间之前不应呈现，得到 x=%.1f", PresentedX(scene));
+    timeline.Present(100, &scene);
+    WV_CHECK(PresentedX(scene) == 100.0f, "t=100 呈现 x=%.1f", PresentedX(scene));
+    timeline.Present(179, &scene);
+    WV_CHECK(PresentedX(scene) == 100.0f, "t=179 在容差之外，应仍为 100，得到 %.1f", PresentedX(scene));
+    timeline.Present(180, &scene);
+    WV_CHECK(PresentedX(scene) == 200.0f, "t=180 在 20 ms 容差内，应为 200，得到 %.1f", PresentedX(scene));
+    // 一次跳过多个条目时呈现其中最新的
+    SubmitBox(&timeline, 400, 400.0f);
+    timeline.Present(410, &scene);
+    WV_CHECK(PresentedX(scene) == 400.0f, "跳到 t=410 应呈现 400，得到 %.1f", PresentedX(scene));
+    WV_CHECK(!timeline.Present(420, &scene), "没有变化时不应修改场景");
+}
+
+static void TestOutOfOrderAndReplace() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(0, 500, 0);
+    SubmitBox(&timeline, 300, 300.0f);
+    SubmitBox(&timeline, 100, 100.0f);     // 迟到的条目按时间插入
+    SubmitBox(&timeline, 300, 301.0f);     // 同一时间替换
+    timeline.Present(100, &scene);
+    WV_CHECK(PresentedX(scene) == 100.0f, "乱序提交后 t=100 呈现 x=%.1f", PresentedX(scene));
+    timeline.Present(300, &scene);
+    WV_CHECK(PresentedX(scene) == 301.0f, "同一时间的条目应被替换，得到 %.1f", PresentedX(scene));
+}
+
+static void TestClockOffset() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(0, 500, -40);       // 显示比时钟晚 40 ms
+    SubmitBox(&timeline, 100, 100.0f);
+    timeline.Present(120, &scene);
+    WV_CHECK(PresentedX(scene) < 0, "偏移 -40 ms 时 t=120 还不应呈现");
+    timeline.Present(140, &scene);
+    WV_CHECK(PresentedX(scene) == 100.0f, "偏移 -40 ms 时 t=140 应呈现，得到 %.1f", PresentedX(scene));
+}
+
+static void TestExpiry() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(0, 500, 0);
+    SubmitBox(&timeline, 100, 100.0f);
+    timeline.Present(100, &scene);
+    timeline.Present(600, &scene);
+    WV_CHECK(PresentedX(scene) == 100.0f, "未超过过期时间时应保留");
+    WV_CHECK(timeline.Present(601, &scene) && PresentedX(scene) < 0, "超过过期时间应清空覆盖层");
+    WV_CHECK(timeline.Empty(), "过期后时间线应为空");
+
+    // 整体落后超过过期时间的条目被丢弃，不会闪现
+    SubmitBox(&timeline, 1000, 1000.0f);
+    timeline.Present(2000, &scene);
+    WV_CHECK(PresentedX(scene) < 0 && timeline.Empty(), "过期的条目不应呈现");
+}
+
+static void TestBounded() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(0, 500, 0);
+    for (int i = 0; i < 1000; ++i) {
+        SubmitBox(&timeline, i * 10, static_cast<float>(i * 10));
+    }
+    // 上限 120 条：只保留最后 120 个条目（t >= 8800）
+    timeline.Present(8790, &scene);
+    WV_CHECK(PresentedX(scene) < 0, "被淘汰的条目不应呈现，得到 %.1f", PresentedX(scene));
+    timeline.Present(8800, &scene);
+    WV_CHECK(PresentedX(scene) == 8800.0f, "最早保留的条目应为 8800，得到 %.1f", PresentedX(scene));
+}
+
+static void TestLinearInterpolation() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(0, 500, 0);
+    timeline.SetInterpolation(WVOverlayInterpolationLinear, 200);
+    SubmitBox(&timeline, 0, 0.0f);
+    SubmitBox(&timeline, 100, 100.0f);
+    static const int times[] = { 0, 25, 50, 99, 100 };
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); ++i) {
+        timeline.Present(times[i], &scene);
+        WV_CHECK(fabsf(PresentedX(scene) - times[i]) < 0.01f, "线性插值 t=%d 得到 x=%.2f", times[i],
+                 PresentedX(scene));
+    }
+    // 下一关键帧尚未提交时停在当前关键帧
+    timeline.Present(150, &scene);
+    WV_CHECK(PresentedX(scene) == 100.0f, "没有下一关键帧时应停在 100，得到 %.2f", PresentedX(scene));
+}
+
+static void TestVelocityExtrapolation() {
+    WVOverlayTimeline timeline;
+    WVOverlayScene scene;
+    timeline.Configure(0, 500, 0);
+    timeline.SetInterpolation(WVOverlayInterpolationVelocity, 200);
+    SubmitBox(&timeline, 0, 0.0f);
+    SubmitBox(&timeline, 100, 100.0f);
+    timeline.Present(0, &scene);
+    timeline.Present(100, &scene);
+    timeline.Present(150, &scene);
+    WV_CHECK(fabsf(PresentedX(scene) - 150.0f) < 0.01f, "外推 50 ms 应为 150，得到 %.2f", PresentedX(scene));
+    timeline.Present(400, &scene);
+    WV_CHECK(fabsf(PresentedX(scene) - 300.0f) < 0.01f, "外推上限 200 ms 应停在 300，得到 %.2f", PresentedX(scene));
+}
+
+int main() {
+    TestPresentsMatchingEntry();
+    TestOutOfOrderAndReplace();
+    TestClockOffset();
+    TestExpiry();
+    TestBounded();
+    TestLinearInterpolation();
+    TestVelocityExtrapolation();
+    return WVTestResult();
+}
@@ -0,0 +1,212 @@
+//
+//  WVQualityGovernorTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 画质调节：在模拟时钟上驱动模拟播放器（每秒推进一次并调用 Poll），用丢帧制造压力，检查
+// 按优先级从低到高逐路降级（最高优先级从不降级）、调整后等待 3 秒再调整、
+// 连续 5 个平稳周期后按优先级从高到低逐路恢复、停用时全部恢复。
+// 模拟时间远长于实际消耗的 CPU 时间，进程 CPU 占用接近 0，不会单独构成压力。
+
+#include "WVQualityGovernor.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include "WVTestSupport.h"
+
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static long long g_nowMs = 1000000;
+
+static long long FakeNowMs() {
+    return g_nowMs;
+}
+
+static const int kStepMs = 1000;
+
+// 模拟播放器：每秒解码 25 帧，lossy 时丢弃其中 5 帧（20%）
+struct SimPlayer {
+    int id;
+    bool lossy;
+    unsigned long long decoded;
+    unsigned long long lost;
+
+    SimPlayer(int id_) : id(id_), lossy(false), decoded(0), lost(0) {}
+};
+
+// 级别变化的顺序：播放器编号 * 10 + 新级别
+static std::vector<int> g_changes;
+
+static void Attach(SimPlayer& player, int priority) {
+    SimPlayer* self = &player;
+    WVQualityGovernor::Register(self, [self](WVQualitySample* sample) {
+        sample->decoded = self->decoded;
+        sample->lost = self->lost;
+        sample->playing = true;
+        return true;
+    }, [self](int level) {
+        // 调节器持有内部锁时调用：只记录
+        g_changes.push_back(self->id * 10 + level);
+    });
+    WVQualityGovernor::SetPriority(self, priority);
+}
+
+static void Detach(std::vector<SimPlayer*>& players) {
+    for (size_t i = 0; i < players.size(); ++i) {
+        WVQualityGovernor::Unregister(players[i]);
+    }
+    g_changes.clear();
+    // 与下一个测试隔开，上一次调整的等待时间不影响下一个测试
+    g_nowMs += 60000;
+}
+
+static void Run(std::vector<SimPlayer*>& players, int steps) {
+    for (int step = 0; step < steps; ++step) {
+        g_nowMs += kStepMs;
+        for (size_t i = 0; i < players.size(); ++i) {
+            players[i]->decoded += 25;
+            if (players[i]->lossy) players[i]->lost += 5;
+        }
+        WVQualityGovernor::Poll();
+    }
+}
+
+static void Configure(bool enabled) {
+    WVQualityPolicy policy;
+    policy.enabled = enabled;
+    policy.cpuHighPercent = 85.0f;
+    policy.cpuLowPercent = 60.0f;
+    policy.lossHighPercent = 5.0f;
+    policy.maxLevel = WVQualityKeyframes;
+    WVQualityGovernor::Configure(policy);
+}
+
+// 一路丢帧时先降级优先级最低的一路（没有子码流时跳过子码流级别），降到底后再降下一路
+static void TestDegradeLowestPriorityFirst() {
+    Configure(true);
+    SimPlayer important(1), low(2), middle(3), pinned(4);
+    important.lossy = true;
+    std::vector<SimPlayer*> players;
+    players.push_back(&important);
+    players.push_back(&low);
+    players.push_back(&middle);
+    players.push_back(&pinned);
+    Attach(important, 80);
+    Attach(low, 20);
+    Attach(middle, 50);
+    Attach(pinned, WVQualityGovernor::kMaxPriority);
+
+    Run(players, 1);   // 第一次采样只记录基准
+    WV_CHECK(g_changes.empty(), "没有基准时就调整了 %d 次", static_cast<int>(g_changes.size()));
+    Run(players, 1);
+    WV_CHECK(WVQualityGovernor::Level(&low) == WVQualityReduced && WVQualityGovernor::Level(&middle) == 0 &&
+             WVQualityGovernor::Level(&important) == 0,
+             "第一次降级后级别 %d / %d / %d", WVQualityGovernor::Level(&low),
+             WVQualityGovernor::Level(&middle), WVQualityGovernor::Level(&important));
+
+    Run(players, 30);
+    int expected[] = { 21, 23, 31, 33, 11, 13 };
+    std::vector<int> order(expected, expected + sizeof(expected) / sizeof(expected[0]));
+    WV_CHECK(g_changes == order, "降级顺序不对（%d 次调整）", static_cast<int>(g_changes.size()));
+    WV_CHECK(WVQualityGovernor::Level(&pinned) == WVQualityFull, "最高优先级的播放器被降级");
+
+    float cpu = -1.0f;
+    int degraded = 0;
+    WVQualityGovernor::GetStats(&cpu, &degraded);
+    WV_CHECK(degraded == 3 && cpu < 60.0f, "降级数量 %d，CPU %.1f%%", degraded, cpu);
+
+    Configure(false);
+    WV_CHECK(WVQualityGovernor::Level(&low) == 0 && WVQualityGovernor::Level(&middle) == 0 &&
+             WVQualityGovernor::Level(&important) == 0, "停用后没有全部恢复");
+    Detach(players);
+}
+
+// 调整后 3 秒内压力仍在也不再调整
+static void TestSettleTime() {
+    Configure(true);
+    SimPlayer lossy(1), low(2);
+    lossy.lossy = true;
+    std::vector<SimPlayer*> players;
+    players.push_back(&lossy);
+    players.push_back(&low);
+    Attach(lossy, 50);
+    Attach(low, 20);
+
+    Run(players, 2);
+    WV_CHECK(WVQualityGovernor::Level(&low) == WVQualityReduced, "丢帧时没有降级");
+    Run(players, 2);
+    WV_CHECK(WVQualityGovernor::Level(&low) == WVQualityReduced && g_changes.size() == 1,
+             "调整后 2 秒内又调整到级别 %d", WVQualityGovernor::Level(&low));
+    Run(players, 1);
+    WV_CHECK(WVQualityGovernor::Level(&low) == WVQualityKeyframes, "调整 3 秒后级别 %d",
+             WVQualityGovernor::Level(&low));
+
+    Configure(false);
+    Detach(players);
+}
+
+// 压力解除后连续 5 个平稳周期才恢复一级，先恢复优先级高的；有子码流时逐级经过子码流
+static void TestRecovery() {
+    Configure(true);
+    SimPlayer lossy(1), low(2), middle(3);
+    lossy.lossy = true;
+    std::vector<SimPlayer*> players;
+    players.push_back(&lossy);
+    players.push_back(&low);
+    players.push_back(&middle);
+    Attach(lossy, 80);
+    Attach(low, 20);
+    Attach(middle, 50);
+    WVQualityGovernor::SetSubstreamAvailable(&low, true);
+
+    // low 经过子码流降到只解码关键帧，之后 middle 降一级
+    Run(players, 2 + 3 + 3 + 3);
+    WV_CHECK(WVQualityGovernor::Level(&low) == WVQualityKeyframes &&
+             WVQualityGovernor::Level(&middle) == WVQualityReduced,
+             "降级后级别 %d / %d", WVQualityGovernor::Level(&low), WVQualityGovernor::Level(&middle));
+
+    lossy.lossy = false;
+    Run(players, 4);
+    WV_CHECK(WVQualityGovernor::Level(&middle) == WVQualityReduced, "平稳 4 个周期就恢复了");
+    Run(players, 1);
+    WV_CHECK(WVQualityGovernor::Level(&middle) == WVQualityFull &&
+             WVQualityGovernor::Level(&low) == WVQualityKeyframes,
+             "平稳 5 个周期后级别 %d / %d（应先恢复优先级高的）", WVQualityGovernor::Level(&middle),
+             WVQualityGovernor::Level(&low));
+
+    // 一个周期重新丢帧：再降级一路，平稳计数从头开始
+    Run(players, 3);
+    lossy.lossy = true;
+    Run(players, 1);
+    lossy.lossy = false;
+    WV_CHECK(WVQualityGovernor::Level(&middle) == WVQualityReduced, "重新丢帧时没有降级");
+    size_t changes = g_changes.size();
+    Run(players, 4);
+    WV_CHECK(g_changes.size() == changes, "重新丢帧后平稳 4 个周期就恢复了");
+
+    g_changes.clear();
+    Run(players, 1 + 5 + 5 + 5);
+    int expected[] = { 30, 22, 21, 20 };
+    std::vector<int> order(expected, expected + sizeof(expected) / sizeof(expected[0]));
+    WV_CHECK(g_changes == order, "恢复顺序不对（%d 次调整）", static_cast<int>(g_changes.size()));
+    WV_CHECK(WVQualityGovernor::Level(&low) == WVQualityFull && WVQualityGovernor::Level(&middle) == WVQualityFull,
+             "压力解除后没有全部恢复：%d / %d", WVQualityGovernor::Level(&low), WVQualityGovernor::Level(&middle));
+
+    Configure(false);
+    Detach(players);
+}
+
+int main() {
+    WVLogSetLevel(WVLogError);
+    WVClockSetSource(FakeNowMs);
+
+    TestDegradeLowestPriorityFirst();
+    TestSettleTime();
+    TestRecovery();
+
+    WVClockSetSource(NULL);
+    return WVTestResult();
+}
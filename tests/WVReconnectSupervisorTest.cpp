@@ -0,0 +1,351 @@
+//
+//  WVReconnectSupervisorTest.cpp
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+// 重连监督：在模拟时钟上驱动模拟摄像头（每 100 ms 推进一次并调用 Poll），检查
+// 首帧与连接超时、无帧检测、指数退避与随机区间、失败上限、同时重连数上限、
+// 暂停 / 不可见 / 排队期间不计时、过期的重连、默认启用与未启用自动重连。
+
+#include "WVReconnectSupervisor.h"
+#include "WVClock.h"
+#include "WVLog.h"
+#include "WVTestSupport.h"
+
+#include <vector>
+
+WV_TEST_MAIN_STATE;
+
+static long long g_nowMs = 1000000;
+
+static long long FakeNowMs() {
+    return g_nowMs;
+}
+
+static const int kStepMs = 100;
+static const int kFrameIntervalMs = 40;
+
+// 模拟摄像头：online 时连接 connectMs 后开始出帧，离线时连接 connectMs 后失败
+struct SimCamera {
+    bool online;
+    int connectMs;
+    bool dropWithError;          // 在线时断开：true 为出错，false 为卡住（不再出帧）
+    bool paused;
+    bool suspended;
+    bool queued;
+
+    unsigned long long frames;
+    bool active;
+    bool failed;
+    long long connectDoneAt;     // 0 表示没有正在进行的连接
+    double frameCarry;
+
+    unsigned long long pendingGeneration;   // 监督器投递、尚未执行的重连
+    std::vector<long long> reconnectCalls;  // 重连回调的时间
+
+    SimCamera()
+        : online(true), connectMs(300), dropWithError(false), paused(false), suspended(false), queued(false),
+          frames(0), active(false), failed(false), connectDoneAt(0), frameCarry(0.0), pendingGeneration(0) {
+    }
+};
+
+static void Open(SimCamera& camera) {
+    camera.frames = 0;
+    camera.active = true;
+    camera.failed = false;
+    camera.frameCarry = 0.0;
+    camera.connectDoneAt = g_nowMs + camera.connectMs;
+    WVReconnectSupervisor::OnOpen(&camera, true);
+}
+
+static void Attach(SimCamera& camera) {
+    SimCamera* self = &camera;
+    WVReconnectSupervisor::Register(self, [self](WVHealthSample* sample) {
+        sample->frames = self->frames;
+        sample->active = self->active;
+        sample->paused = self->paused;
+        sample->failed = self->failed;
+        sample->finished = false;
+        sample->suspended = self->suspended;
+        sample->queued = self->queued;
+        return true;
+    }, [self](unsigned long long generation) {
+        // 监督器持有内部锁时调用：与播放器一样只记录，之后在"工作线程"上执行
+        self->pendingGeneration = generation;
+        self->reconnectCalls.push_back(g_nowMs);
+    });
+    Open(camera);
+}
+
+static void Detach(SimCamera& camera) {
+    WVReconnectSupervisor::Unregister(&camera);
+}
+
+// 推进 totalMs：摄像头状态、监督器采样、执行投递的重连
+static void Run(std::vector<SimCamera*>& cameras, long long totalMs, int* peakInFlight = NULL) {
+    for (long long elapsed = 0; elapsed < totalMs; elapsed += kStepMs) {
+        g_nowMs += kStepMs;
+        for (size_t i = 0; i < cameras.size(); ++i) {
+            SimCamera& camera = *cameras[i];
+            if (camera.connectDoneAt > 0 && g_nowMs >= camera.connectDoneAt) {
+                camera.connectDoneAt = 0;
+                if (!camera.online) {
+                    camera.active = false;
+                    camera.failed = true;
+                }
+            }
+            if (camera.active && camera.connectDoneAt == 0 && !camera.online && camera.dropWithError) {
+                camera.active = false;
+                camera.failed = true;
+            }
+            bool streaming = camera.active && camera.connectDoneAt == 0 && camera.online &&
+                             !camera.paused && !camera.suspended;
+            if (streaming) {
+                camera.frameCarry += static_cast<double>(kStepMs) / kFrameIntervalMs;
+                unsigned long long whole = static_cast<unsigned long long>(camera.frameCarry);
+                camera.frames += whole;
+                camera.frameCarry -= static_cast<double>(whole);
+            }
+        }
+        WVReconnectSupervisor::Poll();
+        if (peakInFlight) {
+            int inFlight = 0;
+            WVReconnectSupervisor::GetStats(&inFlight, NULL);
+            if (inFlight > *peakInFlight) *peakInFlight = inFlight;
+        }
+        for (size_t i = 0; i < cameras.size(); ++i) {
+            SimCamera& camera = *cameras[i];
+            if (camera.pendingGeneration == 0) continue;
+            unsigned long long generation = camera.pendingGeneration;
+            camera.pendingGeneration = 0;
+            if (WVReconnectSupervisor::IsCurrent(&camera, generation)) Open(camera);
+        }
+    }
+}
+
+static WVReconnectPolicy Policy(bool enabled, int maxAttempts, int maxConcurrent) {
+    WVReconnectPolicy policy;
+    policy.enabled = enabled;
+    policy.initialDelayMs = 1000;
+    policy.maxDelayMs = 8000;
+    policy.maxAttempts = maxAttempts;
+    policy.stallTimeoutMs = 2000;
+    policy.maxConcurrent = maxConcurrent;
+    return policy;
+}
+
+// 未调用 Configure 时使用默认策略：自动重连已启用
+static void TestEnabledByDefault() {
+    SimCamera camera;
+    camera.dropWithError = true;
+    std::vector<SimCamera*> cameras(1, &camera);
+    Attach(camera);
+    Run(cameras, 1000);
+    camera.online = false;
+    Run(cameras, 10000);
+    WV_CHECK(!camera.reconnectCalls.empty(), "默认策略下出错后没有自动重连");
+    Detach(camera);
+}
+
+static void TestConnectAndStall() {
+    WVReconnectSupervisor::Configure(Policy(true, 0, 4));
+    SimCamera camera;
+    std::vector<SimCamera*> cameras(1, &camera);
+    Attach(camera);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthConnecting, "打开后不是 Connecting");
+    Run(cameras, 1000);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthLive, "出帧后不是 Live");
+
+    // 卡住：无帧超过 2000 ms 后进入 Stalled，在 [500, 1000] ms 后第一次重连
+    camera.online = false;
+    Run(cameras, 1900);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthLive, "未到无帧超时就离开了 Live");
+    Run(cameras, 300);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthStalled, "无帧超时后不是 Stalled");
+    long long stalledAt = g_nowMs;
+    Run(cameras, 1200);
+    WV_CHECK(camera.reconnectCalls.size() == 1, "重连回调 %d 次，期望 1 次", static_cast<int>(camera.reconnectCalls.size()));
+    if (!camera.reconnectCalls.empty()) {
+        long long delay = camera.reconnectCalls[0] - stalledAt;
+        WV_CHECK(delay >= 500 - kStepMs && delay <= 1000 + kStepMs, "第一次重连等待 %lld ms，期望 500-1000", delay);
+    }
+
+    // 离线期间的重连都失败：等待时间指数增长（上限 8000），每次在 [间隔/2, 间隔] 之内
+    Run(cameras, 40000);
+    const std::vector<long long>& calls = camera.reconnectCalls;
+    WV_CHECK(calls.size() >= 5, "40 秒内只重连 %d 次", static_cast<int>(calls.size()));
+    long long expected = 2000;
+    for (size_t i = 1; i < calls.size(); ++i) {
+        long long delay = calls[i] - (calls[i - 1] + camera.connectMs);
+        WV_CHECK(delay >= expected / 2 - kStepMs && delay <= expected + kStepMs,
+                 "第 %d 次重连等待 %lld ms，期望 %lld-%lld", static_cast<int>(i + 1), delay, expected / 2, expected);
+        expected = expected * 2 > 8000 ? 8000 : expected * 2;
+    }
+    int attempts = 0, reconnects = 0;
+    WVReconnectSupervisor::GetPlayerStats(&camera, &attempts, &reconnects);
+    WV_CHECK(attempts == static_cast<int>(calls.size()) && reconnects == 0, "重连统计 %d / %d", attempts, reconnects);
+
+    // 恢复在线：下一次重连成功，回到 Live，累计一次成功的重连
+    camera.online = true;
+    Run(cameras, 10000);
+    WVReconnectSupervisor::GetPlayerStats(&camera, &attempts, &reconnects);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthLive && attempts == 0 && reconnects == 1,
+             "恢复后状态 %d，重连统计 %d / %d", WVReconnectSupervisor::Health(&camera), attempts, reconnects);
+    Detach(camera);
+}
+
+static void TestConnectTimeoutAndLimit() {
+    // 连接一直没有首帧：10 秒后视为失败；连续失败 3 次后进入 Failed，不再重连
+    WVReconnectSupervisor::Configure(Policy(true, 3, 4));
+    SimCamera camera;
+    camera.connectMs = 60000;
+    std::vector<SimCamera*> cameras(1, &camera);
+    Attach(camera);
+    Run(cameras, 9800);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthConnecting, "未到连接超时就离开了 Connecting");
+    Run(cameras, 300);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthStalled, "连接超时后不是 Stalled");
+    Run(cameras, 80000);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthFailed, "连续失败后不是 Failed");
+    WV_CHECK(camera.reconnectCalls.size() == 3, "重连 %d 次，上限为 3", static_cast<int>(camera.reconnectCalls.size()));
+    Detach(camera);
+}
+
+static void TestConcurrencyLimit() {
+    // 50 路同时出错：同时进行的重连不超过 4 路，首次重连时间分散在 [500, 1000] ms，最终全部恢复
+    WVReconnectSupervisor::Configure(Policy(true, 0, 4));
+    std::vector<SimCamera> storage(50);
+    std::vector<SimCamera*> cameras;
+    for (size_t i = 0; i < storage.size(); ++i) {
+        storage[i].dropWithError = true;
+        storage[i].connectMs = 800;
+        cameras.push_back(&storage[i]);
+        Attach(storage[i]);
+    }
+    Run(cameras, 2000);
+    for (size_t i = 0; i < storage.size(); ++i) storage[i].online = false;
+    Run(cameras, 3000);
+    for (size_t i = 0; i < storage.size(); ++i) storage[i].online = true;
+
+    int peak = 0;
+    long long restoredAt = g_nowMs;
+    long long allLiveAt = 0;
+    for (int step = 0; step < 1200 && allLiveAt == 0; ++step) {
+        Run(cameras, kStepMs, &peak);
+        bool allLive = true;
+        for (size_t i = 0; i < storage.size() && allLive; ++i) {
+            allLive = WVReconnectSupervisor::Health(&storage[i]) == WVHealthLive;
+        }
+        if (allLive) allLiveAt = g_nowMs;
+    }
+    WV_CHECK(peak <= 4, "同时进行的重连达到 %d 路，上限 4", peak);
+    WV_CHECK(allLiveAt > 0, "恢复在线 120 秒后仍有摄像头没有画面");
+    printf("50 路同时断线：恢复在线后 %lld ms 全部恢复，同时重连最多 %d 路\n", allLiveAt - restoredAt, peak);
+
+    long long first = 0, last = 0;
+    for (size_t i = 0; i < storage.size(); ++i) {
+        if (storage[i].reconnectCalls.empty()) continue;
+        long long call = storage[i].reconnectCalls[0];
+        if (first == 0 || call < first) first = call;
+        if (call > last) last = call;
+    }
+    WV_CHECK(last > first, "所有摄像头在同一时刻第一次重连");
+    for (size_t i = 0; i < storage.size(); ++i) Detach(storage[i]);
+}
+
+static void TestNoStallWhileIdle() {
+    // 暂停、不可见时不做无帧检测；排队期间连接超时不计时
+    WVReconnectSupervisor::Configure(Policy(true, 0, 4));
+    SimCamera paused, suspended, queued;
+    std::vector<SimCamera*> cameras;
+    cameras.push_back(&paused);
+    cameras.push_back(&suspended);
+    cameras.push_back(&queued);
+    Attach(paused);
+    Attach(suspended);
+    queued.queued = true;
+    queued.connectMs = 1000000;
+    Attach(queued);
+    Run(cameras, 1000);
+    paused.paused = true;
+    suspended.suspended = true;
+    Run(cameras, 20000);
+    WV_CHECK(WVReconnectSupervisor::Health(&paused) == WVHealthLive, "暂停的播放器离开了 Live");
+    WV_CHECK(WVReconnectSupervisor::Health(&suspended) == WVHealthLive, "不可见的播放器离开了 Live");
+    WV_CHECK(WVReconnectSupervisor::Health(&queued) == WVHealthConnecting, "排队中的播放器连接超时");
+
+    // 出队后从实际打开时计时
+    queued.queued = false;
+    Run(cameras, 9500);
+    WV_CHECK(WVReconnectSupervisor::Health(&queued) == WVHealthConnecting, "出队后未到连接超时就失败");
+    Run(cameras, 1000);
+    WV_CHECK(WVReconnectSupervisor::Health(&queued) == WVHealthStalled, "出队后连接超时没有生效");
+    for (size_t i = 0; i < cameras.size(); ++i) Detach(*cameras[i]);
+}
+
+static void TestStaleReconnect() {
+    // 重连已投递但尚未执行时用户重新播放：IsCurrent 返回 false
+    WVReconnectSupervisor::Configure(Policy(true, 0, 4));
+    SimCamera camera;
+    camera.dropWithError = true;
+    std::vector<SimCamera*> cameras(1, &camera);
+    Attach(camera);
+    Run(cameras, 1000);
+    camera.online = false;
+    for (int step = 0; step < 40 && camera.reconnectCalls.empty(); ++step) {
+        g_nowMs += kStepMs;
+        if (camera.active) {
+            camera.active = false;
+            camera.failed = true;
+        }
+        WVReconnectSupervisor::Poll();
+    }
+    WV_CHECK(camera.pendingGeneration != 0, "没有投递重连");
+    unsigned long long generation = camera.pendingGeneration;
+    camera.pendingGeneration = 0;
+    camera.online = true;
+    Open(camera);
+    WV_CHECK(!WVReconnectSupervisor::IsCurrent(&camera, generation), "重新打开后旧的重连仍然有效");
+
+    // 新的连接沿用重连名额，出现画面后释放
+    Run(cameras, 1000);
+    int inFlight = -1;
+    WVReconnectSupervisor::GetStats(&inFlight, NULL);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthLive && inFlight == 0,
+             "重新打开后状态 %d，进行中的重连 %d", WVReconnectSupervisor::Health(&camera), inFlight);
+    WV_CHECK(camera.reconnectCalls.size() == 1, "过期的重连之后又重连了 %d 次",
+             static_cast<int>(camera.reconnectCalls.size()) - 1);
+    Detach(camera);
+}
+
+static void TestDisabled() {
+    WVReconnectSupervisor::Configure(Policy(false, 0, 4));
+    SimCamera camera;
+    camera.dropWithError = true;
+    std::vector<SimCamera*> cameras(1, &camera);
+    Attach(camera);
+    Run(cameras, 1000);
+    camera.online = false;
+    Run(cameras, 30000);
+    WV_CHECK(WVReconnectSupervisor::Health(&camera) == WVHealthFailed, "未启用自动重连时出错后不是 Failed");
+    WV_CHECK(camera.reconnectCalls.empty(), "未启用自动重连时仍然重连");
+    Detach(camera);
+}
+
+int main() {
+    WVLogSetLevel(WVLogError);
+    WVClockSetSource(FakeNowMs);
+
+    TestEnabledByDefault();
+    TestConnectAndStall();
+    TestConnectTimeoutAndLimit();
+    TestConcurrencyLimit();
+    TestNoStallWhileIdle();
+    TestStaleReconnect();
+    TestDisabled();
+
+    WVClockSetSource(NULL);
+    return WVTestResult();
+}
@@ -0,0 +1,47 @@
+//
+//  WVTestSupport.h
+//  WinVLCBridge
+//
+//  Created by Channing Kuo on 2025/10/7.
+//
+
+#ifndef WV_TEST_SUPPORT_H
+#define WV_TEST_SUPPORT_H
+
+#include <chrono>
+#include <stdio.h>
+
+// ==================== 测试辅助 ====================
+//
+// 测试程序不依赖测试框架：WV_CHECK 失败时打印位置并计数，main 返回 WVTestResult()。
+
+extern int g_wvTestFailures;
+
+#define WV_CHECK(condition, ...)                                             \
+    do {                                                                     \
+        if (!(condition)) {                                                  \
+            ++g_wvTestFailures;                                              \
+            fprintf(stderr, "%s:%d: 检查失败: %s\n  ", __FILE__, __LINE__,   \
+                    #condition);                                             \
+            fprintf(stderr, __VA_ARGS__);                                    \
+            fprintf(stderr, "\n");                                           \
+        }                                                                    \
+    } while (0)
+
+// 每个测试程序在一个翻译单元中定义一次
+#define WV_TEST_MAIN_STATE int g_wvTestFailures = 0
+
+inline int WVTestResult() {
+    if (g_wvTestFailures == 0) {
+        printf("全部通过\n");
+        return 0;
+    }
+    fprintf(stderr, "%d 项检查失败\n", g_wvTestFailures);
+    return 1;
+}
+
+inline double WVTestElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+#endif // WV_TEST_SUPPORT_H